@@ -7,6 +7,7 @@ include_guard(GLOBAL)
 # This ensures template paths work correctly regardless of where embed_resources is called from
 get_filename_component(_RESOURCE_TOOLS_CMAKE_DIR "${CMAKE_CURRENT_LIST_FILE}" DIRECTORY)
 set(RESOURCE_TOOLS_TEMPLATE_DIR "${_RESOURCE_TOOLS_CMAKE_DIR}/templates" CACHE INTERNAL "")
+set(RESOURCE_TOOLS_TOOLS_DIR "${_RESOURCE_TOOLS_CMAKE_DIR}/tools" CACHE INTERNAL "")
 
 # Helper macro to convert a filename to camelCase identifier
 # Input: InputBaseName - the base filename (without extension)
@@ -36,6 +37,486 @@ macro(_convert_to_camel_case InputBaseName)
     endforeach()
 endmacro()
 
+# Helper function to create the build-time packer tool on first use
+# The packer runs during the build, so it must run on the build host. It is
+# normally compiled from source with the project's own compiler, which works
+# the same way in-tree, via FetchContent and from an installed package. That
+# compiler targets another machine when cross-compiling, so then a packer
+# built for the host must be given as RESOURCE_TOOLS_PACKER instead.
+function(_resource_tools_add_packer)
+    if(TARGET resource_tools_packer)
+        return()
+    endif()
+
+    if(RESOURCE_TOOLS_PACKER)
+        add_executable(resource_tools_packer IMPORTED GLOBAL)
+        set_target_properties(resource_tools_packer PROPERTIES IMPORTED_LOCATION "${RESOURCE_TOOLS_PACKER}")
+        return()
+    endif()
+    if(CMAKE_CROSSCOMPILING)
+        message(FATAL_ERROR
+            "embed_resources: Cross-compiling needs a resource_tools_packer that runs on the build host\n"
+            "  Build one natively (it is built as resource_tools_packer whenever a conversion is used)\n"
+            "  and pass its path as -DRESOURCE_TOOLS_PACKER=<path>")
+    endif()
+
+    add_executable(resource_tools_packer "${RESOURCE_TOOLS_TOOLS_DIR}/resource_packer.cpp")
+    target_link_libraries(resource_tools_packer PRIVATE resource_tools::resource_tools)
+    target_compile_features(resource_tools_packer PRIVATE cxx_std_20)
+endfunction()
+
+# Helper function to pick the Content-Type of an HTTP resource from its
+# file extension
+function(_resource_tools_mime_type ResourceFile OutVar)
+    get_filename_component(Extension "${ResourceFile}" LAST_EXT)
+    string(TOLOWER "${Extension}" Extension)
+
+    set(MimeTypes
+        ".html=text/html" ".htm=text/html" ".css=text/css" ".js=text/javascript"
+        ".mjs=text/javascript" ".json=application/json" ".map=application/json"
+        ".txt=text/plain" ".md=text/markdown" ".csv=text/csv" ".xml=application/xml"
+        ".svg=image/svg+xml" ".png=image/png" ".jpg=image/jpeg" ".jpeg=image/jpeg"
+        ".gif=image/gif" ".webp=image/webp" ".avif=image/avif" ".ico=image/x-icon"
+        ".wasm=application/wasm" ".woff=font/woff" ".woff2=font/woff2" ".ttf=font/ttf"
+        ".otf=font/otf" ".pdf=application/pdf" ".webmanifest=application/manifest+json")
+
+    set(MimeType "application/octet-stream")
+    foreach(Entry IN LISTS MimeTypes)
+        string(REPLACE "=" ";" Entry "${Entry}")
+        list(GET Entry 0 EntryExtension)
+        if(EntryExtension STREQUAL Extension)
+            list(GET Entry 1 MimeType)
+            break()
+        endif()
+    endforeach()
+
+    # Text is always embedded as written, so declare the charset up front
+    if(MimeType MATCHES "^text/" OR MimeType MATCHES "(json|xml)$")
+        string(APPEND MimeType "; charset=utf-8")
+    endif()
+
+    set(${OutVar} "${MimeType}" PARENT_SCOPE)
+endfunction()
+
+# Helper function to convert a TRANSFORM glob into a regular expression
+# matched against resource paths. "*" and "?" stay within one directory and
+# "**" spans directories; a glob without "/" matches the file name anywhere.
+function(_resource_tools_glob_to_regex Glob OutVar)
+    set(Regex "${Glob}")
+    foreach(Special IN ITEMS "\\" "." "+" "^" "$" "(" ")" "{" "}" "|")
+        string(REPLACE "${Special}" "\\${Special}" Regex "${Regex}")
+    endforeach()
+    string(REPLACE "[" "\\[" Regex "${Regex}")
+    string(REPLACE "]" "\\]" Regex "${Regex}")
+    string(REPLACE "**/" "@ANY_DIRS@" Regex "${Regex}")
+    string(REPLACE "**" "@ANYTHING@" Regex "${Regex}")
+    string(REPLACE "*" "[^/]*" Regex "${Regex}")
+    string(REPLACE "?" "[^/]" Regex "${Regex}")
+    string(REPLACE "@ANY_DIRS@" "(.*/)?" Regex "${Regex}")
+    string(REPLACE "@ANYTHING@" ".*" Regex "${Regex}")
+
+    if(Glob MATCHES "/")
+        set(${OutVar} "^${Regex}$" PARENT_SCOPE)
+    else()
+        set(${OutVar} "(^|/)${Regex}$" PARENT_SCOPE)
+    endif()
+endfunction()
+
+# Helper function to split the TRANSFORM arguments into steps
+# A command given on its own applies to every resource; each
+# GLOB <pattern>... COMMAND <command>... group applies to the resources
+# matching one of its patterns. Sets <Prefix>_COUNT and, for each step N
+# from 1, <Prefix>_N_REGEX and <Prefix>_N_COMMAND in the calling scope.
+function(_resource_tools_parse_transforms Prefix)
+    set(Count 0)
+    set(Globs "")
+    set(Command "")
+    set(Reading COMMAND)
+    # A trailing GLOB closes the last step
+    foreach(Word IN LISTS ARGN ITEMS GLOB)
+        if(Word STREQUAL "GLOB")
+            if(Reading STREQUAL "GLOB" OR Globs OR Command)
+                list(JOIN Globs " " GlobList)
+                if(Reading STREQUAL "GLOB" AND NOT Globs)
+                    message(FATAL_ERROR "embed_resources: TRANSFORM GLOB needs at least one pattern")
+                elseif(NOT Command)
+                    message(FATAL_ERROR
+                        "embed_resources: TRANSFORM GLOB ${GlobList} has no COMMAND\n"
+                        "  Use TRANSFORM GLOB <pattern>... COMMAND <command> [<arg>...]")
+                endif()
+
+                math(EXPR Count "${Count} + 1")
+                if(Globs)
+                    set(Regex "")
+                    foreach(Glob IN LISTS Globs)
+                        _resource_tools_glob_to_regex("${Glob}" GlobRegex)
+                        list(APPEND Regex "${GlobRegex}")
+                    endforeach()
+                    list(JOIN Regex "|" Regex)
+                else()
+                    set(Regex ".")
+                endif()
+                set(${Prefix}_${Count}_REGEX "${Regex}" PARENT_SCOPE)
+                set(${Prefix}_${Count}_COMMAND "${Command}" PARENT_SCOPE)
+            endif()
+            set(Globs "")
+            set(Command "")
+            set(Reading GLOB)
+        elseif(Word STREQUAL "COMMAND" AND Reading STREQUAL "GLOB")
+            set(Reading COMMAND)
+        elseif(Reading STREQUAL "GLOB")
+            list(APPEND Globs "${Word}")
+        else()
+            list(APPEND Command "${Word}")
+        endif()
+    endforeach()
+
+    set(${Prefix}_COUNT ${Count} PARENT_SCOPE)
+endfunction()
+
+# Helper function to list the TRANSFORM steps that apply to a resource, in
+# order. Uses TRANSFORM_COUNT and TRANSFORM_<N>_REGEX from the calling
+# function.
+function(_resource_tools_transform_steps ResourceFile OutVar)
+    set(Steps "")
+    if(TRANSFORM_COUNT GREATER 0)
+        foreach(Step RANGE 1 ${TRANSFORM_COUNT})
+            if(ResourceFile MATCHES "${TRANSFORM_${Step}_REGEX}")
+                list(APPEND Steps ${Step})
+            endif()
+        endforeach()
+    endif()
+    set(${OutVar} "${Steps}" PARENT_SCOPE)
+endfunction()
+
+# Helper macro to append the accessor of a resource's embedded bytes,
+# get<Name>() or, for packed resources, get<Name>Packed()
+# In profiled builds a raw resource's accessor records the access and
+# forwards to an unrecorded twin in a nested detail namespace, which
+# allResources() lists so preloading and residency reports are not counted.
+# Uses RAW_ACCESSOR_BODY (statements returning the bytes), ER_PACKED and
+# RECORD_ACCESS from the calling function.
+macro(_append_raw_accessor AccessorName)
+    if(RECORD_ACCESS AND NOT ER_PACKED)
+        string(APPEND ACCESSOR_FUNCTIONS "namespace detail {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "inline auto ${AccessorName}() -> resource_tools::ResourceResult {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "${RAW_ACCESSOR_BODY}")
+        string(APPEND ACCESSOR_FUNCTIONS "}\n")
+        string(APPEND ACCESSOR_FUNCTIONS "} // namespace detail\n\n")
+        string(APPEND ACCESSOR_FUNCTIONS "inline auto ${AccessorName}() -> resource_tools::ResourceResult {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+        string(APPEND ACCESSOR_FUNCTIONS "    return detail::${AccessorName}();\n")
+        string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+    else()
+        string(APPEND ACCESSOR_FUNCTIONS "inline auto ${AccessorName}() -> resource_tools::ResourceResult {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "${RAW_ACCESSOR_BODY}")
+        string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+    endif()
+endmacro()
+
+# Helper macro to append the public accessor for a packed resource
+# The platform-specific accessor returns the embedded container as
+# get<Name>Packed(); get<Name>() decodes it once on first use and keeps it,
+# get<Name>Cached() goes through the budgeted process-wide cache,
+# get<Name>Shared() maps a copy shared by every process on the host, and
+# get<Name>Decoded() returns a copy allocated from a caller's memory resource.
+# In profiled builds get<Name>() (and get<Name>Http()) forward to unrecorded
+# twins in a nested detail namespace, which allResources() lists.
+# Uses ER_PACKED_REFERENCE (accessor of the container the encoding refers
+# to, e.g. the chunk store), ER_CHUNKED, ER_HTTP and RECORD_ACCESS from the
+# calling function.
+macro(_append_packed_accessor FunctionName)
+    set(_PackedReference "")
+    if(ER_HTTP)
+        # HTTP bundles are not decoded; the identity body is served in place
+        if(RECORD_ACCESS)
+            string(APPEND ACCESSOR_FUNCTIONS "namespace detail {\n")
+            string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Http() -> const resource_tools::HttpResource& {\n")
+            string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::HttpResource resource(get${FunctionName}Packed());\n")
+            string(APPEND ACCESSOR_FUNCTIONS "    return resource;\n")
+            string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+            string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}() -> resource_tools::ResourceResult {\n")
+            string(APPEND ACCESSOR_FUNCTIONS "    return get${FunctionName}Http().identity().body;\n")
+            string(APPEND ACCESSOR_FUNCTIONS "}\n")
+            string(APPEND ACCESSOR_FUNCTIONS "} // namespace detail\n\n")
+            string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Http() -> const resource_tools::HttpResource& {\n")
+            string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+            string(APPEND ACCESSOR_FUNCTIONS "    return detail::get${FunctionName}Http();\n")
+            string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+        else()
+            string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Http() -> const resource_tools::HttpResource& {\n")
+            string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::HttpResource resource(get${FunctionName}Packed());\n")
+            string(APPEND ACCESSOR_FUNCTIONS "    return resource;\n")
+            string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+        endif()
+        string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}() -> resource_tools::ResourceResult {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "    return get${FunctionName}Http().identity().body;\n")
+        string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+    elseif(ER_PACKED_REFERENCE AND NOT "get${FunctionName}Packed" STREQUAL "${ER_PACKED_REFERENCE}")
+        set(_PackedReference ", ${ER_PACKED_REFERENCE}()")
+    endif()
+
+    if(NOT ER_HTTP AND RECORD_ACCESS)
+        string(APPEND ACCESSOR_FUNCTIONS "namespace detail {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}() -> resource_tools::ResourceResult {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::PackedResource resource(get${FunctionName}Packed()${_PackedReference});\n")
+        string(APPEND ACCESSOR_FUNCTIONS "    return resource.get();\n")
+        string(APPEND ACCESSOR_FUNCTIONS "}\n")
+        string(APPEND ACCESSOR_FUNCTIONS "} // namespace detail\n\n")
+        string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}() -> resource_tools::ResourceResult {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+        string(APPEND ACCESSOR_FUNCTIONS "    return detail::get${FunctionName}();\n")
+        string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+    elseif(NOT ER_HTTP)
+        string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}() -> resource_tools::ResourceResult {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::PackedResource resource(get${FunctionName}Packed()${_PackedReference});\n")
+        string(APPEND ACCESSOR_FUNCTIONS "    return resource.get();\n")
+        string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+    endif()
+
+    if(NOT ER_HTTP)
+
+        string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Cached() -> resource_tools::ResourceHandle {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+        string(APPEND ACCESSOR_FUNCTIONS "    return resource_tools::ResourceCache::global().get(get${FunctionName}Packed()${_PackedReference});\n")
+        string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+
+        string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Shared() -> resource_tools::ResourceHandle {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+        string(APPEND ACCESSOR_FUNCTIONS "    return resource_tools::SharedCache::global().get(get${FunctionName}Packed()${_PackedReference});\n")
+        string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+
+        set(_DecodeReference "${_PackedReference}")
+        if(NOT _DecodeReference)
+            set(_DecodeReference ", {}")
+        endif()
+        string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Decoded(std::pmr::memory_resource* memory) -> resource_tools::PackedResource {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+        string(APPEND ACCESSOR_FUNCTIONS "    return resource_tools::PackedResource(get${FunctionName}Packed()${_DecodeReference}, memory);\n")
+        string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+    endif()
+
+    if(ER_CHUNKED AND _PackedReference)
+        string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Chunks() -> resource_tools::ChunkRange {\n")
+        string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+        string(APPEND ACCESSOR_FUNCTIONS "    return resource_tools::ChunkRange(get${FunctionName}Packed()${_PackedReference});\n")
+        string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+    endif()
+endmacro()
+
+# Helper macro to generate the NUMA-local accessor of a resource
+# Appends get<Name>Local(), which returns the copy of get<Name>() on the
+# calling thread's node. Uses ACCESSOR_FUNCTIONS, RECORD_ACCESS and
+# UnrecordedAccessor from the calling function.
+macro(_append_replicated_accessor FunctionName)
+    string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Local() -> resource_tools::ResourceResult {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+    string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::ReplicatedResource resource(${UnrecordedAccessor}());\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    return resource.get();\n")
+    string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+endmacro()
+
+# Helper function to map a numeric SCHEMA or ELEMENT_TYPE type to its C++
+# type and its resource_tools::ColumnType enumerator
+function(_resource_tools_element_type Type CppTypeVar EnumVar)
+    if(Type STREQUAL "float32")
+        set(CppType float)
+        set(Enum Float32)
+    elseif(Type STREQUAL "float64")
+        set(CppType double)
+        set(Enum Float64)
+    else()
+        set(CppType "${Type}_t")
+        string(REGEX REPLACE "^int" "Int" Enum "${Type}")
+        string(REGEX REPLACE "^uint" "UInt" Enum "${Enum}")
+    endif()
+    set(${CppTypeVar} "${CppType}" PARENT_SCOPE)
+    set(${EnumVar} "${Enum}" PARENT_SCOPE)
+endfunction()
+
+# Helper macro to generate the typed accessor of a columnar table
+# Appends a <Name>Table struct with one member per SCHEMA column (a
+# std::span of the column's type, or a resource_tools::StringColumn) and
+# get<Name>Table(), which fills it in once from get<Name>(). Uses ER_SCHEMA,
+# ACCESSOR_FUNCTIONS, RECORD_ACCESS and UnrecordedAccessor from the calling
+# function.
+macro(_append_columnar_accessor FunctionName)
+    set(_Members "")
+    set(_Assignments "")
+    set(_TypeChecks "")
+    set(_Index 0)
+    foreach(_Column IN LISTS ER_SCHEMA)
+        string(REPLACE ":" ";" _Column "${_Column}")
+        list(GET _Column 0 _ColumnName)
+        list(GET _Column 1 _ColumnType)
+        if(_ColumnType STREQUAL "string")
+            string(APPEND _Members "    resource_tools::StringColumn ${_ColumnName};\n")
+            string(APPEND _Assignments "            result.${_ColumnName} = table.strings(${_Index});\n")
+            set(_TypeEnum String)
+        else()
+            _resource_tools_element_type("${_ColumnType}" _CppType _TypeEnum)
+            string(APPEND _Members "    std::span<const ${_CppType}> ${_ColumnName};\n")
+            string(APPEND _Assignments "            result.${_ColumnName} = table.column<${_CppType}>(${_Index});\n")
+        endif()
+        string(APPEND _TypeChecks " ||\n            table.column_type(${_Index}) != resource_tools::ColumnType::${_TypeEnum}")
+        math(EXPR _Index "${_Index} + 1")
+    endforeach()
+
+    string(APPEND ACCESSOR_FUNCTIONS "struct ${FunctionName}Table {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    size_t rows = 0;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${_Members}")
+    string(APPEND ACCESSOR_FUNCTIONS "    resource_tools::ResourceError error = resource_tools::ResourceError::Success;\n\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    explicit operator bool() const { return error == resource_tools::ResourceError::Success; }\n")
+    string(APPEND ACCESSOR_FUNCTIONS "};\n\n")
+    string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Table() -> const ${FunctionName}Table& {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+    string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::ColumnarTable table(${UnrecordedAccessor}());\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    static const ${FunctionName}Table columns = [] {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "        ${FunctionName}Table result;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "        result.error = table.error();\n")
+    string(APPEND ACCESSOR_FUNCTIONS "        if (table && (table.columns() != ${_Index}${_TypeChecks})) {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "            result.error = resource_tools::ResourceError::CorruptData;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "        }\n")
+    string(APPEND ACCESSOR_FUNCTIONS "        if (result) {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "            result.rows = table.rows();\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${_Assignments}")
+    string(APPEND ACCESSOR_FUNCTIONS "        }\n")
+    string(APPEND ACCESSOR_FUNCTIONS "        return result;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    }();\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    return columns;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+endmacro()
+
+# Helper macro to generate the typed accessor of a numeric array
+# Appends get<Name>Array(), which views get<Name>() as a span of
+# ER_ELEMENT_TYPE. Uses ACCESSOR_FUNCTIONS, RECORD_ACCESS and
+# UnrecordedAccessor from the calling function.
+macro(_append_array_accessor FunctionName)
+    _resource_tools_element_type("${ER_ELEMENT_TYPE}" _CppType _TypeEnum)
+    string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Array() -> std::span<const ${_CppType}> {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+    string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::TypedArray<${_CppType}> array(${UnrecordedAccessor}());\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    return array.span();\n")
+    string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+endmacro()
+
+# Helper macro to generate the line accessor of a text resource
+# Appends get<Name>Text(), which reads the line index built by the TEXT
+# conversion. Uses ACCESSOR_FUNCTIONS, RECORD_ACCESS and UnrecordedAccessor
+# from the calling function.
+macro(_append_text_accessor FunctionName)
+    string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Text() -> const resource_tools::TextResource& {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+    string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::TextResource text(${UnrecordedAccessor}());\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    return text;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+endmacro()
+
+# Helper macro to generate the accessor of a string table
+# Appends get<Name>Strings(), which looks keys up in the table built by the
+# STRING_TABLE conversion, and records the table under its file name without
+# extension (its locale) in STRING_TABLE_LIST. Uses ACCESSOR_FUNCTIONS,
+# RECORD_ACCESS, UnrecordedAccessor and ResourceFile from the calling
+# function.
+macro(_append_string_table_accessor FunctionName)
+    string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Strings() -> const resource_tools::StringTable& {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+    string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::StringTable table(${UnrecordedAccessor}());\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    return table;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+    get_filename_component(_Locale "${ResourceFile}" NAME_WLE)
+    string(APPEND STRING_TABLE_LIST "        {\"${_Locale}\", &get${FunctionName}Strings},\n")
+endmacro()
+
+# Helper macro to look string tables up by locale
+# Appends stringTable(locale), which returns the table of the resource named
+# <locale>.<ext>, or an empty table whose error() is NotFound. Uses
+# STRING_TABLE_LIST, collected by _append_string_table_accessor().
+macro(_append_string_table_lookup)
+    string(APPEND ACCESSOR_FUNCTIONS "inline auto stringTable(std::string_view locale) -> const resource_tools::StringTable& {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    static constexpr std::pair<std::string_view, const resource_tools::StringTable& (*)()> tables[] = {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${STRING_TABLE_LIST}")
+    string(APPEND ACCESSOR_FUNCTIONS "    };\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    for (const auto& [name, table] : tables) {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "        if (name == locale) {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "            return table();\n")
+    string(APPEND ACCESSOR_FUNCTIONS "        }\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    }\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::StringTable missing({nullptr, 0, resource_tools::ResourceError::NotFound});\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    return missing;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+endmacro()
+
+# Helper macro to generate the accessor of a frozen map
+# Appends get<Name>Map(), which queries the hash table built by the
+# FROZEN_MAP conversion. Uses ACCESSOR_FUNCTIONS, RECORD_ACCESS and
+# UnrecordedAccessor from the calling function.
+macro(_append_frozen_map_accessor FunctionName)
+    string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Map() -> const resource_tools::FrozenMap& {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+    string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::FrozenMap map(${UnrecordedAccessor}());\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    return map;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+endmacro()
+
+# Helper macro to generate the accessor of a frozen set
+# Appends get<Name>Set(), which queries the sorted entries and Bloom filter
+# built by the SET conversion. Uses ACCESSOR_FUNCTIONS, RECORD_ACCESS and
+# UnrecordedAccessor from the calling function.
+macro(_append_set_accessor FunctionName)
+    string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Set() -> const resource_tools::FrozenSet& {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+    string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::FrozenSet set(${UnrecordedAccessor}());\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    return set;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+endmacro()
+
+# Helper macro to generate the accessor of an archive
+# Appends get<Name>Archive(), which looks up members in the index built by
+# the ARCHIVE conversion. Uses ACCESSOR_FUNCTIONS, RECORD_ACCESS and
+# UnrecordedAccessor from the calling function.
+macro(_append_archive_accessor FunctionName)
+    string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Archive() -> const resource_tools::ArchiveResource& {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+    string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::ArchiveResource archive(${UnrecordedAccessor}());\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    return archive;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+endmacro()
+
+# Helper macro to generate the accessor of a binary JSON document
+# Appends get<Name>Json(), which reads the document parsed by the FORMAT
+# json-binary conversion in place. Uses ACCESSOR_FUNCTIONS, RECORD_ACCESS
+# and UnrecordedAccessor from the calling function.
+macro(_append_json_accessor FunctionName)
+    string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}Json() -> const resource_tools::JsonDocument& {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${RECORD_ACCESS}")
+    string(APPEND ACCESSOR_FUNCTIONS "    static const resource_tools::JsonDocument document(${UnrecordedAccessor}());\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    return document;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+endmacro()
+
+# Helper macro to list every resource of the namespace
+# Appends allResources(), which pairs each file name with its get<Name>()
+# accessor and its undecoded bytes, and a resource_tools::ResourceGroup that
+# registers the list for resource_tools::preloadAllAndWait() and
+# resource_tools::residencyReport(). Profiled headers also register an
+# access counter for every resource at start-up, so the profile lists the
+# ones never accessed. Uses RESOURCE_LIST (one entry per resource, collected
+# by the calling function), ER_NAMESPACE and ER_PROFILING.
+macro(_append_resource_list)
+    string(APPEND ACCESSOR_FUNCTIONS "inline auto allResources() -> std::span<const resource_tools::ResourceEntry> {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    static constexpr resource_tools::ResourceEntry entries[] = {\n")
+    string(APPEND ACCESSOR_FUNCTIONS "${RESOURCE_LIST}")
+    string(APPEND ACCESSOR_FUNCTIONS "    };\n")
+    string(APPEND ACCESSOR_FUNCTIONS "    return entries;\n")
+    string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+    string(APPEND ACCESSOR_FUNCTIONS "inline resource_tools::ResourceGroup resourceGroup(allResources());\n\n")
+    if(ER_PROFILING)
+        string(APPEND ACCESSOR_FUNCTIONS
+            "inline const bool profileCountersRegistered = resource_tools::profile::registerCounters(allResources());\n\n")
+    endif()
+endmacro()
+
 #[=======================================================================[.rst:
 EmbedResources
 --------------
@@ -53,14 +534,258 @@ Commands
                    RESOURCES <file1> [<file2> ...]
                    [RESOURCE_DIR <directory>]
                    [HEADER_OUTPUT_DIR <directory>]
-                   [NAMESPACE <namespace>])
+                   [NAMESPACE <namespace>]
+                   [SPARSE [SPARSE_MIN_RUN <bytes>]]
+                   [DEDUPLICATE [CHUNK_SIZE <bytes>]]
+                   [VARIANT_OF <base>]
+                   [HTTP [HTTP_ENCODINGS <coding>...]]
+                   [PROFILE <file> [PROFILE_HOT_THRESHOLD <accesses>]]
+                   [HUGE_PAGES [HUGE_PAGE_THRESHOLD <bytes>]]
+                   [NUMA_REPLICATED]
+                   [FORMAT columnar SCHEMA <column>:<type>... | FORMAT json-binary]
+                   [ELEMENT_TYPE <type> [ENDIAN little|big]]
+                   [TEXT [NORMALIZE_NEWLINES]]
+                   [STRING_TABLE]
+                   [FROZEN_MAP]
+                   [SET [BLOOM_BITS_PER_KEY <bits>]]
+                   [ARCHIVE]
+                   [TRANSFORM <command> [<arg>...]]
+                   [TRANSFORM GLOB <pattern>... COMMAND <command> [<arg>...] ...])
+
+  ``SPARSE``
+    Detect long zero runs at build time. Resources made entirely of zeros
+    are stored as a size only and materialised as lazily zero-filled memory;
+    mostly-zero resources are stored as a map of their non-zero segments and
+    reconstructed on first access. Resources that do not benefit are stored
+    unchanged. The accessor API is the same either way.
+
+  ``SPARSE_MIN_RUN``
+    Shortest zero run, in bytes, that is elided (default: 4096).
+
+  ``DEDUPLICATE``
+    Split every resource into content-defined chunks with a rolling hash and
+    store each unique chunk once in a chunk store shared by all resources of
+    the call. Resources are reconstructed on first access, and can also be
+    streamed without reconstruction through ``get<Name>Chunks()``. Savings
+    per resource are written to ``<target>_dedup.report`` at build time and
+    shown by the ``<target>-manifest`` target. The chunk store is embedded
+    as ``<target>_chunks.bin``, so no resource of the call may have that
+    name.
+
+  ``CHUNK_SIZE``
+    Average chunk size for ``DEDUPLICATE``, a power of two (default: 8192).
+
+  ``VARIANT_OF``
+    Base resource (relative to ``RESOURCE_DIR``) that every resource of the
+    call is a variant of. The base is embedded once with its own accessor,
+    and each variant is stored as a binary delta against it, reconstructed
+    once on first access; a variant whose delta would be no smaller is
+    stored whole. Delta sizes are written to ``<target>_delta.report``
+    at build time and shown by the ``<target>-manifest`` target.
+
+  ``HTTP``
+    Prepare resources for serving over HTTP. Each resource is precompressed
+    at build time and embedded together with its SHA-256 content hash,
+    strong ETags, MIME type (from the file extension) and a prebuilt
+    response header per encoding. ``get<Name>Http()`` returns a
+    ``resource_tools::HttpResource`` that selects the best variant for an
+    ``Accept-Encoding`` header; ``get<Name>()`` returns the identity body.
+    Encodings that do not make a resource smaller are dropped.
+
+  ``HTTP_ENCODINGS``
+    Encodings to precompute for ``HTTP`` (default: ``gzip br zstd``). ``gzip``
+    and ``zstd`` use the command-line tools when found and CMake's built-in
+    compressors otherwise; ``br`` needs the ``brotli`` tool. Without it,
+    configuring fails if ``br`` was listed, and the default list drops
+    ``br`` with a warning.
+
+  ``PROFILE``
+    Access profile (relative to ``CMAKE_CURRENT_SOURCE_DIR``) used to pick a
+    storage tier per resource. Resources accessed at least
+    ``PROFILE_HOT_THRESHOLD`` times are hot and stored raw, so access is a
+    pointer return; the rest are cold and LZ-compressed, decompressed once on
+    first access. Each resource's tier is shown in the manifest. Without the
+    profile file every resource is stored raw.
+
+  ``PROFILE_HOT_THRESHOLD``
+    Accesses that make a resource hot (default: 2).
+
+  ``SPARSE``, ``DEDUPLICATE``, ``VARIANT_OF``, ``HTTP`` and ``PROFILE``
+  select how resources are stored and cannot be combined in one call.
+
+  ``HUGE_PAGES``
+    Start every large resource on a 2 MB boundary, so its data covers whole
+    huge pages and ``resource_tools::remapToHugePages()`` can back all of it
+    with huge pages at runtime. Each aligned resource can add up to 2 MB of
+    padding to the binary. Ignored on Windows, where resource sections cannot
+    be aligned. Can be combined with any storage mode; the stored form of the
+    resource is what gets aligned, and its size is what is compared with
+    ``HUGE_PAGE_THRESHOLD``, so a sparse or compressed resource that packs
+    small is not padded.
+
+  ``HUGE_PAGE_THRESHOLD``
+    Smallest embedded resource, in bytes, aligned by ``HUGE_PAGES``
+    (default: 2097152). Checked at build time against the file that is
+    actually embedded.
+
+  ``NUMA_REPLICATED``
+    Also generate ``get<Name>Local()``, which returns a copy of the resource
+    on the calling thread's NUMA node. Each node's copy is made the first
+    time a thread on that node asks for it; single-node machines read the
+    resource itself. See ``resource_tools::ReplicatedResource``.
+
+  ``FORMAT``
+    Convert resources into a ready-to-use binary form at build time.
+    ``columnar`` turns CSV tables (tab-separated for ``.tsv`` and ``.tab``
+    files) into one typed array per ``SCHEMA`` column, each 64-byte aligned
+    and in the target's byte order; string columns are dictionary-encoded.
+    ``get<Name>Table()`` returns a ``<Name>Table`` struct with the row count
+    and a ``std::span<const T>`` (or ``resource_tools::StringColumn``) per
+    column, so nothing is parsed at runtime. A value that does not parse as
+    its column's type fails the build; an empty float is NaN. Can be combined
+    with every storage mode except ``HTTP``; ``get<Name>()`` returns the
+    converted table, see ``resource_tools::ColumnarTable``.
+
+    ``json-binary`` parses JSON documents (RFC 8259, UTF-8) into records that
+    refer to each other by offset. ``get<Name>Json()`` returns a
+    ``resource_tools::JsonDocument`` whose values are read in place, so
+    opening a document of any size costs one header check. Malformed JSON,
+    duplicate keys and invalid UTF-8 fail the build with the file, line and
+    column. Can be combined with every storage mode except ``HTTP``.
+
+  ``SCHEMA``
+    Columns for ``FORMAT columnar``, as ``<column>:<type>``, in the order the
+    struct lists them. Each column is found by name in the header row, and
+    other columns are dropped. Types are ``int8``, ``int16``, ``int32``,
+    ``int64``, ``uint8``, ``uint16``, ``uint32``, ``uint64``, ``float32``,
+    ``float64`` and ``string``. Column names must be C++ identifiers other
+    than keywords, ``rows`` and ``error``.
+
+  ``ELEMENT_TYPE``
+    Embed resources as arrays of ``int8``, ``int16``, ``int32``, ``int64``,
+    ``uint8``, ``uint16``, ``uint32``, ``uint64``, ``float32`` or
+    ``float64``. The build fails if a resource is not a whole number of
+    elements, and converts the elements to the target's byte order. The
+    array starts on a 64-byte boundary, and ``get<Name>Array()`` returns it
+    as a ``std::span<const T>`` used in place. Can be combined with every
+    storage mode except ``HTTP``, but not with ``FORMAT``; see
+    ``resource_tools::TypedArray``.
+
+  ``ENDIAN``
+    Byte order the ``ELEMENT_TYPE`` files are written in (default:
+    ``little``).
+
+  ``TEXT``
+    Embed resources as UTF-8 text with a line index. The build fails on
+    the first invalid UTF-8 sequence, giving its line and column, and
+    records where every line starts, so ``get<Name>Text()`` can return any
+    line without scanning; see ``resource_tools::TextResource``.
+    ``get<Name>()`` returns the indexed container. Can be combined with
+    every storage mode except ``HTTP``, but not with ``FORMAT`` or
+    ``ELEMENT_TYPE``.
+
+  ``NORMALIZE_NEWLINES``
+    Convert ``\r\n`` and lone ``\r`` line endings in ``TEXT`` resources
+    to ``\n`` at build time. Without it the text is embedded as written
+    and lines still exclude a ``\r`` before their ``\n``.
+
+  ``STRING_TABLE``
+    Compile key/value catalogs, one per locale, into string tables. Each
+    line of a catalog is ``<key> = <value>``; blank lines and lines starting
+    with ``#`` are skipped, and values may use ``\n``, ``\t``, ``\\`` and
+    ``\#``. Duplicate keys and malformed lines fail the build. Every string
+    is stored once in a pool, indexed by a minimal perfect hash, so
+    ``get<Name>Strings()`` and ``stringTable(<locale>)``, where the locale
+    is the file name without its extension, return a
+    ``resource_tools::StringTable`` used in place. Two catalogs with the
+    same locale, such as ``en.strings`` and ``en.txt``, fail at configure
+    time. Can be combined with every storage mode except ``HTTP``, but not
+    with another conversion.
+
+  ``FROZEN_MAP``
+    Compile ``<key><TAB><value>`` files into open-addressing hash tables of
+    64-byte buckets, one cache line each. Blank lines are skipped, a line
+    without a tab or a duplicate key fails the build, and the table starts
+    on a 64-byte boundary. ``get<Name>Map()`` returns a
+    ``resource_tools::FrozenMap`` that is queried in place, with no startup
+    work. Can be combined with every storage mode except ``HTTP``, but not
+    with another conversion.
+
+  ``SET``
+    Compile word lists, one entry per line, into sorted, prefix-compressed
+    sets with a Bloom filter in front. Surrounding spaces, blank lines and
+    lines starting with ``#`` are skipped, and repeated entries are stored
+    once. ``get<Name>Set()`` returns a ``resource_tools::FrozenSet`` that
+    is queried in place: most absent keys are rejected by one filter probe,
+    and the rest by a binary search over the entries. Can be combined with
+    every storage mode except ``HTTP``, but not with another conversion.
+
+  ``BLOOM_BITS_PER_KEY``
+    Bloom filter bits per ``SET`` entry, from 0 to 64 (default: 10, about
+    1% false positives). 0 builds the set without a filter.
+
+  ``ARCHIVE``
+    Index tar files (ustar, GNU or pax; plain or compressed with gzip,
+    bzip2, xz or zstd) at build time so their regular files can be read
+    without extracting them. ``get<Name>Archive()`` returns a
+    ``resource_tools::ArchiveResource`` whose ``find(<path>)`` returns a
+    member's contents: in place for a plain tar, and decoded on first
+    access, one member at a time, for a compressed one. A compressed tar is
+    extracted by CMake into the build tree and its members recompressed
+    individually; a member outside the archive (an absolute path or ``..``)
+    or named with ``;``, ``[`` or ``]`` fails the build. Nothing is written
+    to the filesystem at run time. Can be combined with every storage mode
+    except ``HTTP``, but not with another conversion.
+
+  ``TRANSFORM``
+    Pre-process resources at build time before they are packed and
+    embedded, e.g. to minify JSON or strip comments from SQL. A command
+    given on its own runs on every resource. ``GLOB <pattern>... COMMAND
+    <command>`` groups run only on resources whose path matches one of the
+    patterns (``*`` and ``?`` stay within a directory, ``**`` spans
+    directories, and a pattern without ``/`` matches the file name).
+    Resources matching several groups go through each in order; resources
+    matching none are embedded as they are.
+
+    ``@INPUT@`` and ``@OUTPUT@`` in a command are replaced by the input and
+    output files. Without ``@INPUT@`` the input is fed on stdin, and without
+    ``@OUTPUT@`` stdout is the output. Commands run in
+    ``CMAKE_CURRENT_SOURCE_DIR``, and a command starting with an executable
+    target runs that target, built first. ``TRANSFORM`` can be repeated to
+    add more ``GLOB`` groups.
+
+    Each step is a custom command that re-runs only when its input, or a
+    file named on its command line, changes. Outputs are also cached by
+    input content and transform identity in
+    ``RESOURCE_TOOLS_TRANSFORM_CACHE_DIR``, so a clean build or a touched
+    but unchanged input copies the cached output instead of running the
+    command. The identity hashes the program and files on the command line
+    by content, not path. An empty output fails the build.
+
+Variables
+^^^^^^^^^
+
+``RESOURCE_TOOLS_PROFILING``
+  When set, accessors generated by ``embed_resources()`` count every access.
+  The counts of every resource, accessed or not, are written at exit to
+  ``$RESOURCE_TOOLS_PROFILE_OUTPUT`` if it is set, ready to be passed back
+  as ``PROFILE``.
+
+``RESOURCE_TOOLS_TRANSFORM_CACHE_DIR``
+  Where ``TRANSFORM`` outputs are cached (default:
+  ``resource_tools_transform_cache`` in the top-level build directory).
+  Point several build trees, or a CI cache, at one directory to share
+  outputs between them. Entries are never removed; delete the directory
+  to reclaim space.
 
 #]=======================================================================]
 
 function(embed_resources)
-    set(options "")
-    set(oneValueArgs TARGET RESOURCE_DIR HEADER_OUTPUT_DIR NAMESPACE)
-    set(multiValueArgs RESOURCES)
+    set(options SPARSE DEDUPLICATE HTTP HUGE_PAGES NUMA_REPLICATED TEXT NORMALIZE_NEWLINES STRING_TABLE
+        FROZEN_MAP SET ARCHIVE)
+    set(oneValueArgs TARGET RESOURCE_DIR HEADER_OUTPUT_DIR NAMESPACE SPARSE_MIN_RUN CHUNK_SIZE VARIANT_OF
+        PROFILE PROFILE_HOT_THRESHOLD HUGE_PAGE_THRESHOLD FORMAT ELEMENT_TYPE ENDIAN BLOOM_BITS_PER_KEY)
+    set(multiValueArgs RESOURCES HTTP_ENCODINGS TRANSFORM SCHEMA)
 
     cmake_parse_arguments(ER "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
 
@@ -88,6 +813,84 @@ function(embed_resources)
         set(ER_NAMESPACE "resources")
     endif()
 
+    if(NOT ER_SPARSE_MIN_RUN)
+        set(ER_SPARSE_MIN_RUN 4096)
+    endif()
+
+    if(NOT ER_SPARSE_MIN_RUN MATCHES "^[1-9][0-9]*$")
+        message(FATAL_ERROR
+            "embed_resources: Invalid SPARSE_MIN_RUN '${ER_SPARSE_MIN_RUN}'\n"
+            "  Must be a positive number of bytes")
+    endif()
+
+    if(NOT ER_CHUNK_SIZE)
+        set(ER_CHUNK_SIZE 8192)
+    endif()
+
+    if(NOT ER_CHUNK_SIZE MATCHES "^[0-9]+$" OR ER_CHUNK_SIZE LESS 64)
+        message(FATAL_ERROR
+            "embed_resources: Invalid CHUNK_SIZE '${ER_CHUNK_SIZE}'\n"
+            "  Must be a power of two of at least 64 bytes")
+    endif()
+
+    math(EXPR _ChunkSizeBits "${ER_CHUNK_SIZE} & (${ER_CHUNK_SIZE} - 1)")
+    if(NOT _ChunkSizeBits EQUAL 0)
+        message(FATAL_ERROR
+            "embed_resources: Invalid CHUNK_SIZE '${ER_CHUNK_SIZE}'\n"
+            "  Must be a power of two of at least 64 bytes")
+    endif()
+
+    set(HttpEncodingsGiven FALSE)
+    if(ER_HTTP_ENCODINGS)
+        set(HttpEncodingsGiven TRUE)
+    else()
+        set(ER_HTTP_ENCODINGS gzip br zstd)
+    endif()
+
+    foreach(Coding IN LISTS ER_HTTP_ENCODINGS)
+        if(NOT Coding MATCHES "^(gzip|br|zstd)$")
+            message(FATAL_ERROR
+                "embed_resources: Invalid HTTP_ENCODINGS entry '${Coding}'\n"
+                "  Supported encodings: gzip, br, zstd")
+        endif()
+    endforeach()
+
+    if(NOT ER_PROFILE_HOT_THRESHOLD)
+        set(ER_PROFILE_HOT_THRESHOLD 2)
+    endif()
+
+    if(NOT ER_PROFILE_HOT_THRESHOLD MATCHES "^[1-9][0-9]*$")
+        message(FATAL_ERROR
+            "embed_resources: Invalid PROFILE_HOT_THRESHOLD '${ER_PROFILE_HOT_THRESHOLD}'\n"
+            "  Must be a positive number of accesses")
+    endif()
+
+    if(NOT ER_HUGE_PAGE_THRESHOLD)
+        set(ER_HUGE_PAGE_THRESHOLD 2097152)
+    endif()
+
+    if(NOT ER_HUGE_PAGE_THRESHOLD MATCHES "^[1-9][0-9]*$")
+        message(FATAL_ERROR
+            "embed_resources: Invalid HUGE_PAGE_THRESHOLD '${ER_HUGE_PAGE_THRESHOLD}'\n"
+            "  Must be a positive number of bytes")
+    endif()
+
+    # VALIDATE STORAGE MODE - at most one way of packing resources per call
+    set(STORAGE_MODES "")
+    foreach(Mode IN ITEMS SPARSE DEDUPLICATE VARIANT_OF HTTP PROFILE)
+        if(ER_${Mode})
+            list(APPEND STORAGE_MODES ${Mode})
+        endif()
+    endforeach()
+
+    list(LENGTH STORAGE_MODES STORAGE_MODE_COUNT)
+    if(STORAGE_MODE_COUNT GREATER 1)
+        list(JOIN STORAGE_MODES ", " STORAGE_MODE_LIST)
+        message(FATAL_ERROR
+            "embed_resources: Storage modes cannot be combined: ${STORAGE_MODE_LIST}\n"
+            "  Use separate embed_resources() calls for each storage mode")
+    endif()
+
     # VALIDATE NAMESPACE - must be valid C++ identifier
     if(NOT ER_NAMESPACE MATCHES "^[a-zA-Z_][a-zA-Z0-9_]*$")
         message(FATAL_ERROR
@@ -97,6 +900,118 @@ function(embed_resources)
             "  Examples: 'my_resources', 'gameAssets', 'res_v2'")
     endif()
 
+    # VALIDATE CONVERSIONS - each call converts its resources one way at most
+    set(CONVERSIONS "")
+    foreach(Conversion IN ITEMS FORMAT ELEMENT_TYPE TEXT STRING_TABLE FROZEN_MAP SET ARCHIVE)
+        if(ER_${Conversion})
+            list(APPEND CONVERSIONS ${Conversion})
+        endif()
+    endforeach()
+    list(LENGTH CONVERSIONS ConversionCount)
+    if(ConversionCount GREATER 1)
+        list(JOIN CONVERSIONS ", " ConversionList)
+        message(FATAL_ERROR
+            "embed_resources: ${ConversionList} cannot be combined\n"
+            "  Use separate embed_resources() calls")
+    endif()
+
+    if(CONVERSIONS AND ER_HTTP)
+        message(FATAL_ERROR
+            "embed_resources: ${CONVERSIONS} cannot be combined with HTTP\n"
+            "  HTTP resources are served as they are")
+    endif()
+
+    # VALIDATE FORMAT - the schema becomes the members of a C++ struct
+    if(ER_FORMAT AND NOT ER_FORMAT MATCHES "^(columnar|json-binary)$")
+        message(FATAL_ERROR
+            "embed_resources: Invalid FORMAT '${ER_FORMAT}'\n"
+            "  Supported formats: columnar, json-binary")
+    endif()
+
+    if(ER_FORMAT STREQUAL "columnar" AND NOT ER_SCHEMA)
+        message(FATAL_ERROR
+            "embed_resources: FORMAT columnar requires a SCHEMA\n"
+            "  Example: SCHEMA id:uint32 name:string price:float64")
+    endif()
+
+    if(ER_SCHEMA AND NOT ER_FORMAT STREQUAL "columnar")
+        message(FATAL_ERROR "embed_resources: SCHEMA is only used with FORMAT columnar")
+    endif()
+
+    # Column names become members of the generated struct, so C++ keywords
+    # (and the alternative operator spellings) cannot be used
+    set(CXX_KEYWORDS
+        alignas alignof and and_eq asm auto bitand bitor bool break case catch char char8_t char16_t char32_t
+        class compl concept const consteval constexpr constinit const_cast continue co_await co_return
+        co_yield decltype default delete do double dynamic_cast else enum explicit export extern false
+        float for friend goto if inline int long mutable namespace new noexcept not not_eq nullptr
+        operator or or_eq private protected public register reinterpret_cast requires return short
+        signed sizeof static static_assert static_cast struct switch template this thread_local throw
+        true try typedef typeid typename union unsigned using virtual void volatile wchar_t while xor
+        xor_eq)
+    set(SCHEMA_COLUMNS "")
+    foreach(Column IN LISTS ER_SCHEMA)
+        if(NOT Column MATCHES "^([a-zA-Z_][a-zA-Z0-9_]*):(u?int(8|16|32|64)|float(32|64)|string)$")
+            message(FATAL_ERROR
+                "embed_resources: Invalid SCHEMA column '${Column}'\n"
+                "  Columns are <name>:<type>, the name a valid C++ identifier\n"
+                "  Types: int8 int16 int32 int64 uint8 uint16 uint32 uint64 float32 float64 string")
+        endif()
+        set(ColumnName "${CMAKE_MATCH_1}")
+        if(ColumnName IN_LIST CXX_KEYWORDS)
+            message(FATAL_ERROR
+                "embed_resources: SCHEMA column name '${ColumnName}' is a C++ keyword\n"
+                "  Columns become members of the generated struct; rename the column in the header row and SCHEMA")
+        endif()
+        if(ColumnName MATCHES "^(rows|error)$" OR ColumnName IN_LIST SCHEMA_COLUMNS)
+            message(FATAL_ERROR
+                "embed_resources: SCHEMA column name '${ColumnName}' is used twice or reserved\n"
+                "  Column names must be unique and not 'rows' or 'error'")
+        endif()
+        list(APPEND SCHEMA_COLUMNS "${ColumnName}")
+    endforeach()
+
+    # VALIDATE ELEMENT_TYPE - resources become spans of one numeric type
+    if(ER_ELEMENT_TYPE AND NOT ER_ELEMENT_TYPE MATCHES "^(u?int(8|16|32|64)|float(32|64))$")
+        message(FATAL_ERROR
+            "embed_resources: Invalid ELEMENT_TYPE '${ER_ELEMENT_TYPE}'\n"
+            "  Types: int8 int16 int32 int64 uint8 uint16 uint32 uint64 float32 float64")
+    endif()
+
+    if(ER_ENDIAN AND NOT ER_ELEMENT_TYPE)
+        message(FATAL_ERROR "embed_resources: ENDIAN is only used with ELEMENT_TYPE")
+    endif()
+
+    if(NOT ER_ENDIAN)
+        set(ER_ENDIAN little)
+    endif()
+
+    if(NOT ER_ENDIAN MATCHES "^(little|big)$")
+        message(FATAL_ERROR
+            "embed_resources: Invalid ENDIAN '${ER_ENDIAN}'\n"
+            "  Must be little or big")
+    endif()
+
+    # VALIDATE TEXT - resources become UTF-8 text with a line index
+    if(ER_NORMALIZE_NEWLINES AND NOT ER_TEXT)
+        message(FATAL_ERROR "embed_resources: NORMALIZE_NEWLINES is only used with TEXT")
+    endif()
+
+    # VALIDATE SET - resources become sorted sets behind a Bloom filter
+    if(DEFINED ER_BLOOM_BITS_PER_KEY AND NOT ER_SET)
+        message(FATAL_ERROR "embed_resources: BLOOM_BITS_PER_KEY is only used with SET")
+    endif()
+
+    if(NOT DEFINED ER_BLOOM_BITS_PER_KEY)
+        set(ER_BLOOM_BITS_PER_KEY 10)
+    endif()
+
+    if(NOT ER_BLOOM_BITS_PER_KEY MATCHES "^[0-9]+$" OR ER_BLOOM_BITS_PER_KEY GREATER 64)
+        message(FATAL_ERROR
+            "embed_resources: Invalid BLOOM_BITS_PER_KEY '${ER_BLOOM_BITS_PER_KEY}'\n"
+            "  Must be a number of bits from 0 (no filter) to 64")
+    endif()
+
     # VALIDATE RESOURCE_DIR exists
     if(NOT EXISTS "${ER_RESOURCE_DIR}")
         message(FATAL_ERROR
@@ -110,10 +1025,21 @@ function(embed_resources)
             "  Must be a directory containing resource files")
     endif()
 
+    # VALIDATE VARIANT_OF - the base is embedded alongside its variants
+    set(ALL_RESOURCES ${ER_RESOURCES})
+    if(ER_VARIANT_OF)
+        if("${ER_VARIANT_OF}" IN_LIST ER_RESOURCES)
+            message(FATAL_ERROR
+                "embed_resources: VARIANT_OF base '${ER_VARIANT_OF}' is also listed in RESOURCES\n"
+                "  The base is embedded automatically; list only its variants")
+        endif()
+        list(APPEND ALL_RESOURCES "${ER_VARIANT_OF}")
+    endif()
+
     # VALIDATE RESOURCES - check files exist and paths are safe
     set(MISSING_FILES "")
     set(INVALID_PATHS "")
-    foreach(ResourceFile IN LISTS ER_RESOURCES)
+    foreach(ResourceFile IN LISTS ALL_RESOURCES)
         # Check for directory traversal attempts
         if(ResourceFile MATCHES "\\.\\.")
             list(APPEND INVALID_PATHS "  - ${ResourceFile} (contains '..' - potential security issue)")
@@ -148,10 +1074,37 @@ function(embed_resources)
             "  Check that files exist and paths are correct")
     endif()
 
+    # PARSE TRANSFORMS - malformed GLOB groups fail here, not at build time
+    set(TRANSFORM_COUNT 0)
+    if(ER_TRANSFORM)
+        _resource_tools_parse_transforms(TRANSFORM ${ER_TRANSFORM})
+    endif()
+
+    # Transformed arrays are only checked by the build, once they exist
+    if(ER_ELEMENT_TYPE)
+        string(REGEX MATCH "[0-9]+$" ElementBits "${ER_ELEMENT_TYPE}")
+        math(EXPR ElementSize "${ElementBits} / 8")
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            _resource_tools_transform_steps("${ResourceFile}" Steps)
+            file(SIZE "${ER_RESOURCE_DIR}/${ResourceFile}" FileSize)
+            math(EXPR Remainder "${FileSize} % ${ElementSize}")
+            if(NOT Steps AND NOT Remainder EQUAL 0)
+                message(FATAL_ERROR
+                    "embed_resources: ${ResourceFile} is ${FileSize} bytes, not a whole number of ${ER_ELEMENT_TYPE} elements\n"
+                    "  Each element is ${ElementSize} bytes")
+            endif()
+        endforeach()
+    endif()
+
+    set(TRANSFORM_CACHE_DIR "${RESOURCE_TOOLS_TRANSFORM_CACHE_DIR}")
+    if(NOT TRANSFORM_CACHE_DIR)
+        set(TRANSFORM_CACHE_DIR "${CMAKE_BINARY_DIR}/resource_tools_transform_cache")
+    endif()
+
     # CHECK FOR DUPLICATE SYMBOLS
     set(SYMBOL_NAMES "")
     set(FUNCTION_NAMES "")
-    foreach(ResourceFile IN LISTS ER_RESOURCES)
+    foreach(ResourceFile IN LISTS ALL_RESOURCES)
         # Generate symbol name using same logic as templates
         get_filename_component(ResourceName ${ResourceFile} NAME)
         string(REGEX REPLACE "[^a-zA-Z0-9]" "_" BinarySymbol ${ResourceName})
@@ -198,6 +1151,49 @@ function(embed_resources)
         list(APPEND FUNCTION_NAMES "${FunctionName}")
     endforeach()
 
+    # CHECK FOR DUPLICATE LOCALES - stringTable() looks catalogs up by file
+    # name without extension, so en.strings and en.txt would both be "en"
+    if(ER_STRING_TABLE)
+        set(LOCALES "")
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            get_filename_component(Locale "${ResourceFile}" NAME_WLE)
+            if("${Locale}" IN_LIST LOCALES)
+                message(FATAL_ERROR
+                    "embed_resources: Duplicate string table locale '${Locale}'\n"
+                    "  ${ResourceFile} and another catalog have the same name without extension\n"
+                    "  Rename one of the files, or embed them with separate embed_resources() calls")
+            endif()
+            list(APPEND LOCALES "${Locale}")
+        endforeach()
+    endif()
+
+    # READ ACCESS PROFILE - one count per resource, in RESOURCES order
+    set(ACCESS_COUNTS "")
+    set(HOT_RESOURCES "")
+    if(ER_PROFILE)
+        get_filename_component(ER_PROFILE "${ER_PROFILE}" ABSOLUTE BASE_DIR "${CMAKE_CURRENT_SOURCE_DIR}")
+        set(ProfileLines "")
+        if(EXISTS "${ER_PROFILE}")
+            file(STRINGS "${ER_PROFILE}" ProfileLines REGEX "^[0-9]+ ${ER_NAMESPACE} ")
+            set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${ER_PROFILE}")
+        else()
+            message(STATUS "embed_resources: Profile ${ER_PROFILE} not found, ${ER_TARGET} resources are all stored raw")
+        endif()
+
+        foreach(ResourceFile IN LISTS ER_RESOURCES)
+            set(Accesses 0)
+            foreach(Line IN LISTS ProfileLines)
+                if(Line MATCHES "^([0-9]+) [^ ]+ (.+)$" AND CMAKE_MATCH_2 STREQUAL ResourceFile)
+                    math(EXPR Accesses "${Accesses} + ${CMAKE_MATCH_1}")
+                endif()
+            endforeach()
+            list(APPEND ACCESS_COUNTS ${Accesses})
+            if(NOT EXISTS "${ER_PROFILE}" OR NOT Accesses LESS ER_PROFILE_HOT_THRESHOLD)
+                list(APPEND HOT_RESOURCES "${ResourceFile}")
+            endif()
+        endforeach()
+    endif()
+
     # ============================================================================
     # VERBOSE/DIAGNOSTIC OUTPUT
     # ============================================================================
@@ -209,6 +1205,60 @@ function(embed_resources)
         message(STATUS "  Namespace: ${ER_NAMESPACE}")
         message(STATUS "  Resource dir: ${ER_RESOURCE_DIR}")
         message(STATUS "  Header output: ${ER_HEADER_OUTPUT_DIR}/${ER_NAMESPACE}")
+        if(ER_SPARSE)
+            message(STATUS "  Sparse: zero runs >= ${ER_SPARSE_MIN_RUN} bytes")
+        endif()
+        if(ER_DEDUPLICATE)
+            message(STATUS "  Deduplicate: ${ER_CHUNK_SIZE} byte average chunks")
+        endif()
+        if(ER_VARIANT_OF)
+            message(STATUS "  Variant of: ${ER_VARIANT_OF}")
+        endif()
+        if(ER_HTTP)
+            message(STATUS "  HTTP encodings: ${ER_HTTP_ENCODINGS}")
+        endif()
+        if(ER_PROFILE)
+            message(STATUS "  Profile: ${ER_PROFILE} (hot >= ${ER_PROFILE_HOT_THRESHOLD} accesses)")
+        endif()
+        if(RESOURCE_TOOLS_PROFILING)
+            message(STATUS "  Profiling: accesses are counted")
+        endif()
+        if(ER_HUGE_PAGES)
+            message(STATUS "  Huge pages: resources >= ${ER_HUGE_PAGE_THRESHOLD} bytes start on a 2 MB boundary")
+        endif()
+        if(ER_NUMA_REPLICATED)
+            message(STATUS "  NUMA: resources are replicated per node")
+        endif()
+        if(ER_SCHEMA)
+            message(STATUS "  Format: ${ER_FORMAT} (${ER_SCHEMA})")
+        elseif(ER_FORMAT)
+            message(STATUS "  Format: ${ER_FORMAT}")
+        endif()
+        if(ER_ELEMENT_TYPE)
+            message(STATUS "  Element type: ${ER_ELEMENT_TYPE} (${ER_ENDIAN}-endian files)")
+        endif()
+        if(ER_TEXT AND ER_NORMALIZE_NEWLINES)
+            message(STATUS "  Text: UTF-8 with a line index, line endings normalized to LF")
+        elseif(ER_TEXT)
+            message(STATUS "  Text: UTF-8 with a line index")
+        endif()
+        if(ER_STRING_TABLE)
+            message(STATUS "  String tables: one per catalog, perfect-hash indexed")
+        endif()
+        if(ER_FROZEN_MAP)
+            message(STATUS "  Frozen maps: one hash table per key/value file")
+        endif()
+        if(ER_SET AND ER_BLOOM_BITS_PER_KEY GREATER 0)
+            message(STATUS "  Sets: prefix-compressed, ${ER_BLOOM_BITS_PER_KEY}-bit-per-key Bloom filter")
+        elseif(ER_SET)
+            message(STATUS "  Sets: prefix-compressed, no Bloom filter")
+        endif()
+        if(ER_ARCHIVE)
+            message(STATUS "  Archives: tar members indexed by path")
+        endif()
+        if(TRANSFORM_COUNT GREATER 0)
+            message(STATUS "  Transforms: ${TRANSFORM_COUNT} step(s), cached in ${TRANSFORM_CACHE_DIR}")
+        endif()
         list(LENGTH ER_RESOURCES RESOURCE_COUNT)
         message(STATUS "  Resources (${RESOURCE_COUNT} files):")
         foreach(res IN LISTS ER_RESOURCES)
@@ -224,6 +1274,41 @@ function(embed_resources)
 
     set(LIBRARY_NAME "${ER_TARGET}-data")
 
+    # Deduplicated resources share one chunk store, embedded as an extra resource
+    # The packer writes a report of what it saved at build time
+    set(BUILD_REPORT "")
+    if(ER_DEDUPLICATE)
+        string(REGEX REPLACE "[^a-zA-Z0-9_-]" "_" ChunkStoreBase "${ER_TARGET}")
+        set(CHUNK_STORE "${ChunkStoreBase}_chunks.bin")
+        set(BUILD_REPORT "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_dedup.report")
+        _convert_to_camel_case("${ChunkStoreBase}_chunks")
+        set(CHUNK_STORE_ACCESSOR "get${CamelBaseName}BINPacked")
+
+        # The store sits beside the resources and gets an accessor named
+        # after its file, so no resource may share that name
+        string(TOLOWER "${CHUNK_STORE}" ChunkStoreLower)
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            get_filename_component(ResourceName "${ResourceFile}" NAME)
+            string(TOLOWER "${ResourceName}" ResourceName)
+            if(ResourceName STREQUAL ChunkStoreLower)
+                message(FATAL_ERROR
+                    "embed_resources: Resource '${ResourceFile}' has the name of the chunk store of ${ER_TARGET}\n"
+                    "  DEDUPLICATE embeds its chunks as ${CHUNK_STORE}; rename the resource")
+            endif()
+        endforeach()
+    endif()
+
+    # Variants are decoded against the base's accessor
+    if(ER_VARIANT_OF)
+        set(BUILD_REPORT "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_delta.report")
+        get_filename_component(BaseName ${ER_VARIANT_OF} NAME_WE)
+        get_filename_component(Extension ${ER_VARIANT_OF} EXT)
+        string(REPLACE "." "" Extension "${Extension}")
+        _convert_to_camel_case("${BaseName}")
+        string(TOUPPER "${Extension}" UpperExtension)
+        set(VARIANT_BASE_ACCESSOR "get${CamelBaseName}${UpperExtension}Packed")
+    endif()
+
     # Ensure output directory exists
     file(MAKE_DIRECTORY "${ER_HEADER_OUTPUT_DIR}/${ER_NAMESPACE}")
 
@@ -240,9 +1325,51 @@ function(embed_resources)
     file(APPEND "${MANIFEST_FILE}" "Resource Directory: ${ER_RESOURCE_DIR}\n")
     file(APPEND "${MANIFEST_FILE}" "Header Output: ${ER_HEADER_OUTPUT_DIR}/${ER_NAMESPACE}\n")
     file(APPEND "${MANIFEST_FILE}" "Platform: ${CMAKE_SYSTEM_NAME}\n")
+    if(ER_SPARSE)
+        file(APPEND "${MANIFEST_FILE}" "Storage: sparse (zero runs >= ${ER_SPARSE_MIN_RUN} bytes elided)\n")
+    elseif(ER_DEDUPLICATE)
+        file(APPEND "${MANIFEST_FILE}" "Storage: deduplicated (${ER_CHUNK_SIZE} byte average chunks)\n")
+        file(APPEND "${MANIFEST_FILE}" "Chunk Store: ${CHUNK_STORE}\n")
+        file(APPEND "${MANIFEST_FILE}" "Dedup Report: ${BUILD_REPORT} (written at build time)\n")
+    elseif(ER_VARIANT_OF)
+        file(APPEND "${MANIFEST_FILE}" "Storage: delta (variants of ${ER_VARIANT_OF})\n")
+        file(APPEND "${MANIFEST_FILE}" "Delta Report: ${BUILD_REPORT} (written at build time)\n")
+    elseif(ER_HTTP)
+        list(JOIN ER_HTTP_ENCODINGS ", " HttpEncodingList)
+        file(APPEND "${MANIFEST_FILE}" "Storage: http (precompressed: ${HttpEncodingList})\n")
+    elseif(ER_PROFILE)
+        file(APPEND "${MANIFEST_FILE}" "Storage: tiered (hot >= ${ER_PROFILE_HOT_THRESHOLD} accesses raw, cold compressed)\n")
+        file(APPEND "${MANIFEST_FILE}" "Profile: ${ER_PROFILE}\n")
+    else()
+        file(APPEND "${MANIFEST_FILE}" "Storage: raw\n")
+    endif()
+    if(ER_SCHEMA)
+        list(JOIN ER_SCHEMA ", " SchemaList)
+        file(APPEND "${MANIFEST_FILE}" "Format: ${ER_FORMAT} (${SchemaList})\n")
+    elseif(ER_FORMAT)
+        file(APPEND "${MANIFEST_FILE}" "Format: ${ER_FORMAT}\n")
+    endif()
+    if(ER_ELEMENT_TYPE)
+        file(APPEND "${MANIFEST_FILE}" "Element Type: ${ER_ELEMENT_TYPE} (${ER_ENDIAN}-endian files)\n")
+    endif()
+    if(ER_TEXT)
+        if(ER_NORMALIZE_NEWLINES)
+            file(APPEND "${MANIFEST_FILE}" "Text: UTF-8, line endings normalized to LF\n")
+        else()
+            file(APPEND "${MANIFEST_FILE}" "Text: UTF-8, line endings as written\n")
+        endif()
+    endif()
+    if(ER_STRING_TABLE)
+        file(APPEND "${MANIFEST_FILE}" "String Tables: ${ER_NAMESPACE}::stringTable(<locale>) -> const resource_tools::StringTable&\n")
+    endif()
+    if(ER_SET AND ER_BLOOM_BITS_PER_KEY GREATER 0)
+        file(APPEND "${MANIFEST_FILE}" "Sets: Bloom filter of ${ER_BLOOM_BITS_PER_KEY} bits per entry\n")
+    elseif(ER_SET)
+        file(APPEND "${MANIFEST_FILE}" "Sets: no Bloom filter\n")
+    endif()
     file(APPEND "${MANIFEST_FILE}" "\n# Resources:\n\n")
 
-    foreach(ResourceFile IN LISTS ER_RESOURCES)
+    foreach(ResourceFile IN LISTS ALL_RESOURCES)
         get_filename_component(ResourceName ${ResourceFile} NAME)
         string(REGEX REPLACE "[^a-zA-Z0-9]" "_" BinarySymbol ${ResourceName})
 
@@ -279,34 +1406,607 @@ function(embed_resources)
         file(APPEND "${MANIFEST_FILE}" "  Symbol: ${BinarySymbol}\n")
         file(APPEND "${MANIFEST_FILE}" "  Functions:\n")
         file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}() -> resource_tools::ResourceResult\n")
+        if(STORAGE_MODES)
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Packed() -> resource_tools::ResourceResult\n")
+        endif()
+        if(STORAGE_MODES AND NOT ER_HTTP)
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Cached() -> resource_tools::ResourceHandle\n")
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Shared() -> resource_tools::ResourceHandle\n")
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Decoded(std::pmr::memory_resource*) -> resource_tools::PackedResource\n")
+        endif()
+        if(ER_DEDUPLICATE)
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Chunks() -> resource_tools::ChunkRange\n")
+        endif()
+        if(ER_FORMAT STREQUAL "columnar")
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Table() -> const ${ER_NAMESPACE}::${FunctionName}Table&\n")
+        elseif(ER_FORMAT STREQUAL "json-binary")
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Json() -> const resource_tools::JsonDocument&\n")
+        endif()
+        if(ER_ELEMENT_TYPE)
+            _resource_tools_element_type("${ER_ELEMENT_TYPE}" CppType TypeEnum)
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Array() -> std::span<const ${CppType}>\n")
+        endif()
+        if(ER_TEXT)
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Text() -> const resource_tools::TextResource&\n")
+        endif()
+        if(ER_STRING_TABLE)
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Strings() -> const resource_tools::StringTable&\n")
+        endif()
+        if(ER_FROZEN_MAP)
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Map() -> const resource_tools::FrozenMap&\n")
+        endif()
+        if(ER_SET)
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Set() -> const resource_tools::FrozenSet&\n")
+        endif()
+        if(ER_ARCHIVE)
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Archive() -> const resource_tools::ArchiveResource&\n")
+        endif()
+        if(ER_HTTP)
+            _resource_tools_mime_type("${ResourceFile}" MimeType)
+            file(APPEND "${MANIFEST_FILE}" "    - ${ER_NAMESPACE}::get${FunctionName}Http() -> const resource_tools::HttpResource&\n")
+            file(APPEND "${MANIFEST_FILE}" "  Content-Type: ${MimeType}\n")
+        endif()
+        _resource_tools_transform_steps("${ResourceFile}" Steps)
+        foreach(Step IN LISTS Steps)
+            list(JOIN TRANSFORM_${Step}_COMMAND " " CommandLine)
+            file(APPEND "${MANIFEST_FILE}" "  Transform: ${CommandLine}\n")
+        endforeach()
+        if(ER_PROFILE)
+            list(FIND ER_RESOURCES "${ResourceFile}" ResourceIndex)
+            list(GET ACCESS_COUNTS ${ResourceIndex} Accesses)
+            if("${ResourceFile}" IN_LIST HOT_RESOURCES)
+                file(APPEND "${MANIFEST_FILE}" "  Tier: hot (${Accesses} accesses, stored raw)\n")
+            else()
+                file(APPEND "${MANIFEST_FILE}" "  Tier: cold (${Accesses} accesses, compressed)\n")
+            endif()
+        endif()
         file(APPEND "${MANIFEST_FILE}" "\n")
     endforeach()
 
     # Add custom target to display manifest
-    add_custom_target(${ER_TARGET}-manifest
+    # Build-time reports are only available once the data library is built
+    set(MANIFEST_COMMANDS
         COMMAND ${CMAKE_COMMAND} -E echo "=== Resource Manifest: ${MANIFEST_FILE} ==="
-        COMMAND ${CMAKE_COMMAND} -E cat "${MANIFEST_FILE}"
+        COMMAND ${CMAKE_COMMAND} -E cat "${MANIFEST_FILE}")
+    if(BUILD_REPORT)
+        list(APPEND MANIFEST_COMMANDS
+            COMMAND ${CMAKE_COMMAND} -E echo "=== Build Report: ${BUILD_REPORT} ==="
+            COMMAND ${CMAKE_COMMAND} -E cat "${BUILD_REPORT}")
+    endif()
+
+    add_custom_target(${ER_TARGET}-manifest
+        ${MANIFEST_COMMANDS}
         VERBATIM
         COMMENT "Displaying resource manifest for ${ER_TARGET}"
     )
 
+    if(BUILD_REPORT)
+        add_dependencies(${ER_TARGET}-manifest ${LIBRARY_NAME})
+    endif()
+
+    # ============================================================================
+    # BUILD-TIME TRANSFORMS
+    # ============================================================================
+
+    # Resources are transformed into a mirror of RESOURCE_DIR in the build
+    # tree, and every later step reads them from INPUT_DIR. Resources that
+    # no step applies to are copied there as they are.
+    set(INPUT_DIR "${ER_RESOURCE_DIR}")
+    set(TRANSFORM_ARGS "")
+
+    if(TRANSFORM_COUNT GREATER 0)
+        set(INPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_transformed")
+        set(STEP_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_transform_steps")
+        list(APPEND TRANSFORM_ARGS GENERATED)
+
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            set(StepInput "${ER_RESOURCE_DIR}/${ResourceFile}")
+            set(TransformedFile "${INPUT_DIR}/${ResourceFile}")
+            get_filename_component(TransformedDir "${TransformedFile}" DIRECTORY)
+            file(MAKE_DIRECTORY "${TransformedDir}")
+
+            file(SIZE "${StepInput}" FileSize)
+            if(FileSize EQUAL 0)
+                message(FATAL_ERROR "Cannot embed empty file: ${ResourceFile}\nEmbedding empty files is not supported as it serves no practical purpose.")
+            endif()
+
+            _resource_tools_transform_steps("${ResourceFile}" Steps)
+            if(NOT Steps)
+                add_custom_command(
+                    OUTPUT "${TransformedFile}"
+                    COMMAND ${CMAKE_COMMAND} -E copy "${StepInput}" "${TransformedFile}"
+                    DEPENDS "${StepInput}"
+                    VERBATIM
+                )
+                continue()
+            endif()
+
+            list(LENGTH Steps StepCount)
+            set(StepNumber 0)
+            foreach(Step IN LISTS Steps)
+                math(EXPR StepNumber "${StepNumber} + 1")
+                if(StepNumber EQUAL StepCount)
+                    set(StepOutput "${TransformedFile}")
+                else()
+                    set(StepOutput "${STEP_DIR}/${StepNumber}/${ResourceFile}")
+                    get_filename_component(StepOutputDir "${StepOutput}" DIRECTORY)
+                    file(MAKE_DIRECTORY "${StepOutputDir}")
+                endif()
+
+                # An executable target as the program is built before it runs
+                set(StepCommand ${TRANSFORM_${Step}_COMMAND})
+                set(StepDepends "")
+                list(GET StepCommand 0 Program)
+                if(TARGET "${Program}")
+                    list(REMOVE_AT StepCommand 0)
+                    list(PREPEND StepCommand "$<TARGET_FILE:${Program}>")
+                    list(APPEND StepDepends "${Program}")
+                endif()
+
+                # Editing a script named on the command line re-runs the step
+                foreach(Word IN LISTS StepCommand)
+                    get_filename_component(WordPath "${Word}" ABSOLUTE BASE_DIR "${CMAKE_CURRENT_SOURCE_DIR}")
+                    if(EXISTS "${WordPath}" AND NOT IS_DIRECTORY "${WordPath}")
+                        list(APPEND StepDepends "${WordPath}")
+                    endif()
+                endforeach()
+
+                add_custom_command(
+                    OUTPUT "${StepOutput}"
+                    COMMAND ${CMAKE_COMMAND} -DINPUT=${StepInput} -DOUTPUT=${StepOutput}
+                            -DCACHE_DIR=${TRANSFORM_CACHE_DIR}
+                            -P "${RESOURCE_TOOLS_TOOLS_DIR}/transform_resource.cmake" -- ${StepCommand}
+                    DEPENDS "${StepInput}" "${RESOURCE_TOOLS_TOOLS_DIR}/transform_resource.cmake" ${StepDepends}
+                    WORKING_DIRECTORY "${CMAKE_CURRENT_SOURCE_DIR}"
+                    COMMENT "Transforming resource ${ResourceFile} (${StepNumber}/${StepCount})"
+                    VERBATIM
+                )
+                set(StepInput "${StepOutput}")
+            endforeach()
+        endforeach()
+    endif()
+
+    # ============================================================================
+    # BUILD-TIME FORMAT CONVERSION
+    # ============================================================================
+
+    # Resources with a FORMAT are converted by resource_tools_packer into
+    # another mirror of RESOURCE_DIR, which later steps read instead
+    set(FORMAT_ARGS "")
+
+    if(ER_FORMAT STREQUAL "columnar")
+        _resource_tools_add_packer()
+        set(FORMAT_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_columnar")
+        list(JOIN ER_SCHEMA "," SchemaSpec)
+        set(EndianArgs "")
+        if(CMAKE_CXX_BYTE_ORDER STREQUAL "BIG_ENDIAN")
+            set(EndianArgs --big-endian)
+        endif()
+
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            set(ConvertedFile "${FORMAT_DIR}/${ResourceFile}")
+            get_filename_component(ConvertedDir "${ConvertedFile}" DIRECTORY)
+            file(MAKE_DIRECTORY "${ConvertedDir}")
+
+            get_filename_component(Extension "${ResourceFile}" LAST_EXT)
+            string(TOLOWER "${Extension}" Extension)
+            set(Delimiter comma)
+            if(Extension MATCHES "^\\.(tsv|tab)$")
+                set(Delimiter tab)
+            endif()
+
+            add_custom_command(
+                OUTPUT "${ConvertedFile}"
+                COMMAND resource_tools_packer columnar --schema "${SchemaSpec}" --delimiter ${Delimiter}
+                        ${EndianArgs} "${INPUT_DIR}/${ResourceFile}" "${ConvertedFile}"
+                DEPENDS "${INPUT_DIR}/${ResourceFile}" resource_tools_packer
+                COMMENT "Converting ${ResourceFile} to columnar arrays"
+                VERBATIM
+            )
+        endforeach()
+
+        set(INPUT_DIR "${FORMAT_DIR}")
+        list(APPEND FORMAT_ARGS GENERATED FORMAT columnar SCHEMA ${ER_SCHEMA} DATA_ALIGNMENT 64)
+    endif()
+
+    if(ER_FORMAT STREQUAL "json-binary")
+        _resource_tools_add_packer()
+        set(FORMAT_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_json")
+
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            set(ConvertedFile "${FORMAT_DIR}/${ResourceFile}")
+            get_filename_component(ConvertedDir "${ConvertedFile}" DIRECTORY)
+            file(MAKE_DIRECTORY "${ConvertedDir}")
+
+            add_custom_command(
+                OUTPUT "${ConvertedFile}"
+                COMMAND resource_tools_packer json "${INPUT_DIR}/${ResourceFile}" "${ConvertedFile}"
+                DEPENDS "${INPUT_DIR}/${ResourceFile}" resource_tools_packer
+                COMMENT "Converting ${ResourceFile} to binary JSON"
+                VERBATIM
+            )
+        endforeach()
+
+        set(INPUT_DIR "${FORMAT_DIR}")
+        list(APPEND FORMAT_ARGS GENERATED FORMAT json-binary DATA_ALIGNMENT 64)
+    endif()
+
+    if(ER_ELEMENT_TYPE)
+        _resource_tools_add_packer()
+        set(FORMAT_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_arrays")
+        set(EndianArgs --source-endian ${ER_ENDIAN})
+        if(CMAKE_CXX_BYTE_ORDER STREQUAL "BIG_ENDIAN")
+            list(APPEND EndianArgs --big-endian)
+        endif()
+
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            set(ConvertedFile "${FORMAT_DIR}/${ResourceFile}")
+            get_filename_component(ConvertedDir "${ConvertedFile}" DIRECTORY)
+            file(MAKE_DIRECTORY "${ConvertedDir}")
+
+            add_custom_command(
+                OUTPUT "${ConvertedFile}"
+                COMMAND resource_tools_packer array --element-type ${ER_ELEMENT_TYPE} ${EndianArgs}
+                        "${INPUT_DIR}/${ResourceFile}" "${ConvertedFile}"
+                DEPENDS "${INPUT_DIR}/${ResourceFile}" resource_tools_packer
+                COMMENT "Checking ${ER_ELEMENT_TYPE} array ${ResourceFile}"
+                VERBATIM
+            )
+        endforeach()
+
+        set(INPUT_DIR "${FORMAT_DIR}")
+        list(APPEND FORMAT_ARGS GENERATED ELEMENT_TYPE ${ER_ELEMENT_TYPE} DATA_ALIGNMENT 64)
+    endif()
+
+    if(ER_TEXT)
+        _resource_tools_add_packer()
+        set(FORMAT_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_text")
+        set(NewlineArgs "")
+        if(ER_NORMALIZE_NEWLINES)
+            set(NewlineArgs --normalize-newlines)
+        endif()
+
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            set(ConvertedFile "${FORMAT_DIR}/${ResourceFile}")
+            get_filename_component(ConvertedDir "${ConvertedFile}" DIRECTORY)
+            file(MAKE_DIRECTORY "${ConvertedDir}")
+
+            add_custom_command(
+                OUTPUT "${ConvertedFile}"
+                COMMAND resource_tools_packer text ${NewlineArgs} "${INPUT_DIR}/${ResourceFile}" "${ConvertedFile}"
+                DEPENDS "${INPUT_DIR}/${ResourceFile}" resource_tools_packer
+                COMMENT "Indexing lines of ${ResourceFile}"
+                VERBATIM
+            )
+        endforeach()
+
+        set(INPUT_DIR "${FORMAT_DIR}")
+        list(APPEND FORMAT_ARGS GENERATED TEXT)
+    endif()
+
+    if(ER_STRING_TABLE)
+        _resource_tools_add_packer()
+        set(FORMAT_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_strings")
+
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            set(ConvertedFile "${FORMAT_DIR}/${ResourceFile}")
+            get_filename_component(ConvertedDir "${ConvertedFile}" DIRECTORY)
+            file(MAKE_DIRECTORY "${ConvertedDir}")
+
+            add_custom_command(
+                OUTPUT "${ConvertedFile}"
+                COMMAND resource_tools_packer string-table "${INPUT_DIR}/${ResourceFile}" "${ConvertedFile}"
+                DEPENDS "${INPUT_DIR}/${ResourceFile}" resource_tools_packer
+                COMMENT "Compiling string table ${ResourceFile}"
+                VERBATIM
+            )
+        endforeach()
+
+        set(INPUT_DIR "${FORMAT_DIR}")
+        list(APPEND FORMAT_ARGS GENERATED STRING_TABLE)
+    endif()
+
+    if(ER_FROZEN_MAP)
+        _resource_tools_add_packer()
+        set(FORMAT_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_maps")
+
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            set(ConvertedFile "${FORMAT_DIR}/${ResourceFile}")
+            get_filename_component(ConvertedDir "${ConvertedFile}" DIRECTORY)
+            file(MAKE_DIRECTORY "${ConvertedDir}")
+
+            add_custom_command(
+                OUTPUT "${ConvertedFile}"
+                COMMAND resource_tools_packer frozen-map "${INPUT_DIR}/${ResourceFile}" "${ConvertedFile}"
+                DEPENDS "${INPUT_DIR}/${ResourceFile}" resource_tools_packer
+                COMMENT "Building frozen map ${ResourceFile}"
+                VERBATIM
+            )
+        endforeach()
+
+        set(INPUT_DIR "${FORMAT_DIR}")
+        list(APPEND FORMAT_ARGS GENERATED FROZEN_MAP DATA_ALIGNMENT 64)
+    endif()
+
+    if(ER_SET)
+        _resource_tools_add_packer()
+        set(FORMAT_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_sets")
+
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            set(ConvertedFile "${FORMAT_DIR}/${ResourceFile}")
+            get_filename_component(ConvertedDir "${ConvertedFile}" DIRECTORY)
+            file(MAKE_DIRECTORY "${ConvertedDir}")
+
+            add_custom_command(
+                OUTPUT "${ConvertedFile}"
+                COMMAND resource_tools_packer set --bloom-bits ${ER_BLOOM_BITS_PER_KEY}
+                        "${INPUT_DIR}/${ResourceFile}" "${ConvertedFile}"
+                DEPENDS "${INPUT_DIR}/${ResourceFile}" resource_tools_packer
+                COMMENT "Building set ${ResourceFile}"
+                VERBATIM
+            )
+        endforeach()
+
+        set(INPUT_DIR "${FORMAT_DIR}")
+        list(APPEND FORMAT_ARGS GENERATED SET DATA_ALIGNMENT 64)
+    endif()
+
+    if(ER_ARCHIVE)
+        _resource_tools_add_packer()
+        set(FORMAT_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_archives")
+
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            set(ConvertedFile "${FORMAT_DIR}/${ResourceFile}")
+            get_filename_component(ConvertedDir "${ConvertedFile}" DIRECTORY)
+            file(MAKE_DIRECTORY "${ConvertedDir}")
+
+            # Compressed tars are decompressed by CMake before the packer sees them
+            add_custom_command(
+                OUTPUT "${ConvertedFile}"
+                COMMAND ${CMAKE_COMMAND} -DPACKER=$<TARGET_FILE:resource_tools_packer>
+                        -DINPUT=${INPUT_DIR}/${ResourceFile} -DOUTPUT=${ConvertedFile}
+                        -P "${RESOURCE_TOOLS_TOOLS_DIR}/archive_resource.cmake"
+                DEPENDS "${INPUT_DIR}/${ResourceFile}" resource_tools_packer
+                        "${RESOURCE_TOOLS_TOOLS_DIR}/archive_resource.cmake"
+                COMMENT "Indexing archive ${ResourceFile}"
+                VERBATIM
+            )
+        endforeach()
+
+        set(INPUT_DIR "${FORMAT_DIR}")
+        list(APPEND FORMAT_ARGS GENERATED ARCHIVE DATA_ALIGNMENT 64)
+    endif()
+
+    # ============================================================================
+    # BUILD-TIME PACKING
+    # ============================================================================
+
+    # Packed resources are encoded by resource_tools_packer into a mirror of
+    # RESOURCE_DIR in the build tree, and that directory is embedded instead
+    set(EMBED_DIR "${INPUT_DIR}")
+    set(EMBED_RESOURCES ${ER_RESOURCES})
+    set(PACKED_ARGS "")
+
+    if(STORAGE_MODES)
+        _resource_tools_add_packer()
+        set(EMBED_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_packed")
+        list(APPEND PACKED_ARGS PACKED)
+
+        foreach(ResourceFile IN LISTS ALL_RESOURCES)
+            file(SIZE "${ER_RESOURCE_DIR}/${ResourceFile}" FileSize)
+            if(FileSize EQUAL 0)
+                message(FATAL_ERROR "Cannot embed empty file: ${ResourceFile}\nEmbedding empty files is not supported as it serves no practical purpose.")
+            endif()
+
+            get_filename_component(PackedDir "${EMBED_DIR}/${ResourceFile}" DIRECTORY)
+            file(MAKE_DIRECTORY "${PackedDir}")
+        endforeach()
+    endif()
+
+    if(ER_SPARSE)
+        foreach(ResourceFile IN LISTS ER_RESOURCES)
+            set(PackedFile "${EMBED_DIR}/${ResourceFile}")
+            add_custom_command(
+                OUTPUT "${PackedFile}"
+                COMMAND resource_tools_packer sparse --min-run ${ER_SPARSE_MIN_RUN}
+                        "${INPUT_DIR}/${ResourceFile}" "${PackedFile}"
+                DEPENDS "${INPUT_DIR}/${ResourceFile}" resource_tools_packer
+                COMMENT "Packing sparse resource ${ResourceFile}"
+                VERBATIM
+            )
+        endforeach()
+    endif()
+
+    if(ER_DEDUPLICATE)
+        # All resources are chunked together so chunks are shared between them
+        set(ChunkArgs "")
+        set(ChunkOutputs "${EMBED_DIR}/${CHUNK_STORE}" "${BUILD_REPORT}")
+        set(ChunkInputs "")
+        foreach(ResourceFile IN LISTS ER_RESOURCES)
+            list(APPEND ChunkArgs "${ResourceFile}" "${EMBED_DIR}/${ResourceFile}")
+            list(APPEND ChunkOutputs "${EMBED_DIR}/${ResourceFile}")
+            list(APPEND ChunkInputs "${INPUT_DIR}/${ResourceFile}")
+        endforeach()
+
+        add_custom_command(
+            OUTPUT ${ChunkOutputs}
+            COMMAND resource_tools_packer chunk --avg-size ${ER_CHUNK_SIZE}
+                    --store "${EMBED_DIR}/${CHUNK_STORE}" --report "${BUILD_REPORT}"
+                    ${ChunkArgs}
+            DEPENDS ${ChunkInputs} resource_tools_packer
+            WORKING_DIRECTORY "${INPUT_DIR}"
+            COMMENT "Deduplicating resources for ${ER_TARGET}"
+            VERBATIM
+        )
+
+        # The chunk store comes first so its accessor is declared before use
+        list(PREPEND EMBED_RESOURCES "${CHUNK_STORE}")
+        list(APPEND PACKED_ARGS PACKED_REFERENCE ${CHUNK_STORE_ACCESSOR} CHUNKED)
+    endif()
+
+    if(ER_VARIANT_OF)
+        # Every variant is encoded against the same base in one packer run
+        set(DeltaArgs "")
+        set(DeltaOutputs "${EMBED_DIR}/${ER_VARIANT_OF}" "${BUILD_REPORT}")
+        set(DeltaInputs "${INPUT_DIR}/${ER_VARIANT_OF}")
+        foreach(ResourceFile IN LISTS ER_RESOURCES)
+            list(APPEND DeltaArgs "${ResourceFile}" "${EMBED_DIR}/${ResourceFile}")
+            list(APPEND DeltaOutputs "${EMBED_DIR}/${ResourceFile}")
+            list(APPEND DeltaInputs "${INPUT_DIR}/${ResourceFile}")
+        endforeach()
+
+        add_custom_command(
+            OUTPUT ${DeltaOutputs}
+            COMMAND resource_tools_packer delta
+                    --base "${ER_VARIANT_OF}" "${EMBED_DIR}/${ER_VARIANT_OF}"
+                    --report "${BUILD_REPORT}"
+                    ${DeltaArgs}
+            DEPENDS ${DeltaInputs} resource_tools_packer
+            WORKING_DIRECTORY "${INPUT_DIR}"
+            COMMENT "Delta encoding variants of ${ER_VARIANT_OF} for ${ER_TARGET}"
+            VERBATIM
+        )
+
+        # The base comes first so its accessor is declared before use
+        list(PREPEND EMBED_RESOURCES "${ER_VARIANT_OF}")
+        list(APPEND PACKED_ARGS PACKED_REFERENCE ${VARIANT_BASE_ACCESSOR})
+    endif()
+
+    if(ER_PROFILE)
+        foreach(ResourceFile IN LISTS ER_RESOURCES)
+            set(PackedFile "${EMBED_DIR}/${ResourceFile}")
+            if("${ResourceFile}" IN_LIST HOT_RESOURCES)
+                set(PackCommand store)
+                set(Tier hot)
+            else()
+                set(PackCommand compress)
+                set(Tier cold)
+            endif()
+            add_custom_command(
+                OUTPUT "${PackedFile}"
+                COMMAND resource_tools_packer ${PackCommand} "${INPUT_DIR}/${ResourceFile}" "${PackedFile}"
+                DEPENDS "${INPUT_DIR}/${ResourceFile}" resource_tools_packer
+                COMMENT "Packing ${Tier} resource ${ResourceFile}"
+                VERBATIM
+            )
+        endforeach()
+    endif()
+
+    if(RESOURCE_TOOLS_PROFILING)
+        list(APPEND PACKED_ARGS PROFILING)
+    endif()
+
+    if(ER_NUMA_REPLICATED)
+        list(APPEND PACKED_ARGS NUMA_REPLICATED)
+    endif()
+
+    # Large resources are picked at build time by the size of what is
+    # embedded, since packed and converted files do not exist before then
+    if(ER_HUGE_PAGES)
+        list(APPEND PACKED_ARGS HUGE_PAGE_THRESHOLD ${ER_HUGE_PAGE_THRESHOLD})
+    endif()
+
+    if(ER_HTTP)
+        # Each resource is compressed with every requested coding, then the
+        # packer bundles the variants with their hashes and response headers
+        set(HTTP_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_http")
+        find_program(RESOURCE_TOOLS_GZIP_EXECUTABLE gzip)
+        find_program(RESOURCE_TOOLS_ZSTD_EXECUTABLE zstd)
+        find_program(RESOURCE_TOOLS_BROTLI_EXECUTABLE brotli)
+
+        set(HttpCodings ${ER_HTTP_ENCODINGS})
+        # br was asked for by name, or is only one of the defaults
+        if("br" IN_LIST HttpCodings AND NOT RESOURCE_TOOLS_BROTLI_EXECUTABLE)
+            if(HttpEncodingsGiven)
+                message(FATAL_ERROR
+                    "embed_resources: HTTP_ENCODINGS of ${ER_TARGET} lists br, but the brotli tool was not found\n"
+                    "  Install brotli, set RESOURCE_TOOLS_BROTLI_EXECUTABLE, or drop br")
+            endif()
+            message(WARNING "embed_resources: brotli not found, ${ER_TARGET} is embedded without br variants")
+            list(REMOVE_ITEM HttpCodings br)
+        endif()
+
+        foreach(ResourceFile IN LISTS ER_RESOURCES)
+            set(InputFile "${INPUT_DIR}/${ResourceFile}")
+            set(StagedFile "${HTTP_DIR}/${ResourceFile}")
+            get_filename_component(StagedDir "${StagedFile}" DIRECTORY)
+            file(MAKE_DIRECTORY "${StagedDir}")
+            _resource_tools_mime_type("${ResourceFile}" MimeType)
+
+            set(CompressCommands "")
+            set(VariantArgs "")
+            set(VariantFiles "")
+            foreach(Coding IN LISTS HttpCodings)
+                if(Coding STREQUAL "gzip")
+                    set(VariantFile "${StagedFile}.gz")
+                    if(RESOURCE_TOOLS_GZIP_EXECUTABLE)
+                        # gzip only writes next to its input; -n keeps the output reproducible
+                        list(APPEND CompressCommands
+                            COMMAND ${CMAKE_COMMAND} -E copy "${InputFile}" "${StagedFile}"
+                            COMMAND "${RESOURCE_TOOLS_GZIP_EXECUTABLE}" -9 -n -k -f "${StagedFile}")
+                    else()
+                        list(APPEND CompressCommands
+                            COMMAND ${CMAKE_COMMAND} -DINPUT=${InputFile} -DOUTPUT=${VariantFile} -DCODING=gzip
+                                    -P "${RESOURCE_TOOLS_TOOLS_DIR}/compress_resource.cmake")
+                    endif()
+                elseif(Coding STREQUAL "zstd")
+                    set(VariantFile "${StagedFile}.zst")
+                    if(RESOURCE_TOOLS_ZSTD_EXECUTABLE)
+                        list(APPEND CompressCommands
+                            COMMAND "${RESOURCE_TOOLS_ZSTD_EXECUTABLE}" -19 -q -f "${InputFile}" -o "${VariantFile}")
+                    else()
+                        list(APPEND CompressCommands
+                            COMMAND ${CMAKE_COMMAND} -DINPUT=${InputFile} -DOUTPUT=${VariantFile} -DCODING=zstd
+                                    -P "${RESOURCE_TOOLS_TOOLS_DIR}/compress_resource.cmake")
+                    endif()
+                else()
+                    set(VariantFile "${StagedFile}.br")
+                    list(APPEND CompressCommands
+                        COMMAND "${RESOURCE_TOOLS_BROTLI_EXECUTABLE}" -q 11 -f -o "${VariantFile}" "${InputFile}")
+                endif()
+                list(APPEND VariantArgs --variant ${Coding} "${VariantFile}")
+                list(APPEND VariantFiles "${VariantFile}")
+            endforeach()
+
+            set(PackedFile "${EMBED_DIR}/${ResourceFile}")
+            add_custom_command(
+                OUTPUT "${PackedFile}"
+                ${CompressCommands}
+                COMMAND resource_tools_packer http --mime "${MimeType}" ${VariantArgs}
+                        "${InputFile}" "${PackedFile}"
+                BYPRODUCTS ${VariantFiles}
+                DEPENDS "${InputFile}" resource_tools_packer
+                COMMENT "Precompressing HTTP resource ${ResourceFile}"
+                VERBATIM
+            )
+        endforeach()
+
+        list(APPEND PACKED_ARGS HTTP)
+    endif()
+
     if(WIN32)
         _embed_resources_windows(
             TARGET ${ER_TARGET}
             LIBRARY_NAME ${LIBRARY_NAME}
-            RESOURCES ${ER_RESOURCES}
-            RESOURCE_DIR ${ER_RESOURCE_DIR}
+            RESOURCES ${EMBED_RESOURCES}
+            RESOURCE_DIR ${EMBED_DIR}
             HEADER_OUTPUT_DIR ${ER_HEADER_OUTPUT_DIR}
             NAMESPACE ${ER_NAMESPACE}
+            ${PACKED_ARGS}
+            ${TRANSFORM_ARGS}
+            ${FORMAT_ARGS}
         )
     else()
         _embed_resources_unix(
             TARGET ${ER_TARGET}
             LIBRARY_NAME ${LIBRARY_NAME}
-            RESOURCES ${ER_RESOURCES}
-            RESOURCE_DIR ${ER_RESOURCE_DIR}
+            RESOURCES ${EMBED_RESOURCES}
+            RESOURCE_DIR ${EMBED_DIR}
             HEADER_OUTPUT_DIR ${ER_HEADER_OUTPUT_DIR}
             NAMESPACE ${ER_NAMESPACE}
+            ${PACKED_ARGS}
+            ${TRANSFORM_ARGS}
+            ${FORMAT_ARGS}
         )
     endif()
 
@@ -314,12 +2014,17 @@ endfunction()
 
 # Windows implementation using RC files
 function(_embed_resources_windows)
-    set(options "")
-    set(oneValueArgs TARGET LIBRARY_NAME RESOURCE_DIR HEADER_OUTPUT_DIR NAMESPACE)
-    set(multiValueArgs RESOURCES)
+    set(options PACKED CHUNKED HTTP PROFILING NUMA_REPLICATED GENERATED TEXT STRING_TABLE FROZEN_MAP SET ARCHIVE)
+    set(oneValueArgs TARGET LIBRARY_NAME RESOURCE_DIR HEADER_OUTPUT_DIR NAMESPACE PACKED_REFERENCE FORMAT
+        ELEMENT_TYPE DATA_ALIGNMENT HUGE_PAGE_THRESHOLD)
+    set(multiValueArgs RESOURCES SCHEMA)
 
     cmake_parse_arguments(ER "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
 
+    if(ER_HUGE_PAGE_THRESHOLD)
+        message(STATUS "embed_resources: Resource sections cannot be aligned on Windows, HUGE_PAGES is ignored for ${ER_TARGET}")
+    endif()
+
     enable_language(RC)
 
     set(RC_FILE "${CMAKE_CURRENT_BINARY_DIR}/${ER_TARGET}_resources.rc")
@@ -332,6 +2037,45 @@ function(_embed_resources_windows)
     set(ACCESSOR_FUNCTIONS "")
     set(ACCESSOR_FUNCTIONS "")
     set(BINARY_SYMBOLS "")
+    set(RESOURCE_FILES "")
+    set(RESOURCE_LIST "")
+    set(STRING_TABLE_LIST "")
+    set(EXTRA_INCLUDES "")
+
+    if(ER_HTTP)
+        set(EXTRA_INCLUDES "#include <resource_tools/http_resource.h>\n")
+    elseif(ER_PACKED)
+        set(EXTRA_INCLUDES "#include <resource_tools/packed_resource.h>\n#include <resource_tools/resource_cache.h>\n#include <resource_tools/shared_cache.h>\n")
+    endif()
+    if(ER_PROFILING)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/access_profile.h>\n")
+    endif()
+    if(ER_NUMA_REPLICATED)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/numa.h>\n")
+    endif()
+    if(ER_FORMAT STREQUAL "columnar")
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/columnar.h>\n")
+    elseif(ER_FORMAT STREQUAL "json-binary")
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/binary_json.h>\n")
+    endif()
+    if(ER_ELEMENT_TYPE)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/typed_array.h>\n")
+    endif()
+    if(ER_TEXT)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/text_resource.h>\n")
+    endif()
+    if(ER_STRING_TABLE)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/string_table.h>\n")
+    endif()
+    if(ER_FROZEN_MAP)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/frozen_map.h>\n")
+    endif()
+    if(ER_SET)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/frozen_set.h>\n")
+    endif()
+    if(ER_ARCHIVE)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/archive_resource.h>\n")
+    endif()
 
     # Generate unique base ID for this target to avoid duplicate resource IDs
     # Use deterministic hash of target name to get unique ID range per target
@@ -367,24 +2111,91 @@ function(_embed_resources_windows)
 
         # RC file entry
         string(APPEND RESOURCE_ENTRIES "k${ResourceIdUpper} RCDATA \"${ER_RESOURCE_DIR}/${ResourceFile}\"\n")
+        list(APPEND RESOURCE_FILES "${ER_RESOURCE_DIR}/${ResourceFile}")
+
+        string(REPLACE "\\" "\\\\" EscapedResource "${ResourceFile}")
+        string(REPLACE "\"" "\\\"" EscapedResource "${EscapedResource}")
+        # Profiled accessors count each call under the resource's path
+        set(RECORD_ACCESS "")
+        if(ER_PROFILING)
+            set(RECORD_ACCESS "    RESOURCE_TOOLS_RECORD_ACCESS(\"${ER_NAMESPACE}\", \"${EscapedResource}\");\n")
+        endif()
+
+        # Packed resources expose the raw container as get<Name>Packed()
+        if(ER_PACKED)
+            set(RawAccessorName "get${FunctionName}Packed")
+        else()
+            set(RawAccessorName "get${FunctionName}")
+        endif()
+        # Profiled builds list the unrecorded twins of the accessors, and
+        # build typed and NUMA-local accessors on them so a call counts once
+        set(UnrecordedAccessor "get${FunctionName}")
+        set(UnrecordedRawAccessor "${RawAccessorName}")
+        if(RECORD_ACCESS)
+            set(UnrecordedAccessor "detail::get${FunctionName}")
+            if(NOT ER_PACKED)
+                set(UnrecordedRawAccessor "detail::${RawAccessorName}")
+            endif()
+        endif()
+        string(APPEND RESOURCE_LIST "        {\"${ER_NAMESPACE}\", \"${EscapedResource}\", &${UnrecordedAccessor}, &${UnrecordedRawAccessor}},\n")
 
         # Safe accessor functions (Windows)
-        string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}() -> resource_tools::ResourceResult {\n")
-        string(APPEND ACCESSOR_FUNCTIONS "    HRSRC hResource = FindResource(nullptr, MAKEINTRESOURCE(k${ResourceIdUpper}), RT_RCDATA);\n")
-        string(APPEND ACCESSOR_FUNCTIONS "    if (hResource == nullptr) {\n")
-        string(APPEND ACCESSOR_FUNCTIONS "        return {nullptr, 0, resource_tools::ResourceError::NotFound};\n")
-        string(APPEND ACCESSOR_FUNCTIONS "    }\n")
-        string(APPEND ACCESSOR_FUNCTIONS "    HGLOBAL hMemory = LoadResource(nullptr, hResource);\n")
-        string(APPEND ACCESSOR_FUNCTIONS "    if (hMemory == nullptr) {\n")
-        string(APPEND ACCESSOR_FUNCTIONS "        return {nullptr, 0, resource_tools::ResourceError::NotFound};\n")
-        string(APPEND ACCESSOR_FUNCTIONS "    }\n")
-        string(APPEND ACCESSOR_FUNCTIONS "    auto* data = static_cast<const uint8_t*>(LockResource(hMemory));\n")
-        string(APPEND ACCESSOR_FUNCTIONS "    DWORD size = SizeofResource(nullptr, hResource);\n")
-        string(APPEND ACCESSOR_FUNCTIONS "    return {data, static_cast<size_t>(size), resource_tools::ResourceError::Success};\n")
-        string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+        set(RAW_ACCESSOR_BODY "")
+        string(APPEND RAW_ACCESSOR_BODY "    HRSRC hResource = FindResource(nullptr, MAKEINTRESOURCE(k${ResourceIdUpper}), RT_RCDATA);\n")
+        string(APPEND RAW_ACCESSOR_BODY "    if (hResource == nullptr) {\n")
+        string(APPEND RAW_ACCESSOR_BODY "        return {nullptr, 0, resource_tools::ResourceError::NotFound};\n")
+        string(APPEND RAW_ACCESSOR_BODY "    }\n")
+        string(APPEND RAW_ACCESSOR_BODY "    HGLOBAL hMemory = LoadResource(nullptr, hResource);\n")
+        string(APPEND RAW_ACCESSOR_BODY "    if (hMemory == nullptr) {\n")
+        string(APPEND RAW_ACCESSOR_BODY "        return {nullptr, 0, resource_tools::ResourceError::NotFound};\n")
+        string(APPEND RAW_ACCESSOR_BODY "    }\n")
+        string(APPEND RAW_ACCESSOR_BODY "    auto* data = static_cast<const uint8_t*>(LockResource(hMemory));\n")
+        string(APPEND RAW_ACCESSOR_BODY "    DWORD size = SizeofResource(nullptr, hResource);\n")
+        string(APPEND RAW_ACCESSOR_BODY "    return {data, static_cast<size_t>(size), resource_tools::ResourceError::Success};\n")
+        _append_raw_accessor(${RawAccessorName})
+
+        if(ER_PACKED)
+            _append_packed_accessor(${FunctionName})
+        endif()
+
+        if(ER_NUMA_REPLICATED)
+            _append_replicated_accessor(${FunctionName})
+        endif()
+
+        if(ER_FORMAT STREQUAL "columnar")
+            _append_columnar_accessor(${FunctionName})
+        elseif(ER_FORMAT STREQUAL "json-binary")
+            _append_json_accessor(${FunctionName})
+        endif()
+
+        if(ER_ELEMENT_TYPE)
+            _append_array_accessor(${FunctionName})
+        endif()
+
+        if(ER_TEXT)
+            _append_text_accessor(${FunctionName})
+        endif()
+
+        if(ER_STRING_TABLE)
+            _append_string_table_accessor(${FunctionName})
+        endif()
+
+        if(ER_FROZEN_MAP)
+            _append_frozen_map_accessor(${FunctionName})
+        endif()
+        if(ER_SET)
+            _append_set_accessor(${FunctionName})
+        endif()
+        if(ER_ARCHIVE)
+            _append_archive_accessor(${FunctionName})
+        endif()
 
         math(EXPR ID_COUNTER "${ID_COUNTER} + 1")
     endforeach()
+    _append_resource_list()
+    if(ER_STRING_TABLE)
+        _append_string_table_lookup()
+    endif()
 
     # Configure templates
     set(NAMESPACE ${ER_NAMESPACE})
@@ -416,8 +2227,11 @@ function(_embed_resources_windows)
         LINKER_LANGUAGE RC
         INCLUDE_DIRECTORIES "${ER_HEADER_OUTPUT_DIR}")
 
+    # The resource compiler reads the files, so packed and transformed ones
+    # must be generated first, and any change recompiles the RC file
     set_source_files_properties(${RC_FILE} PROPERTIES
-        INCLUDE_DIRECTORIES "${ER_HEADER_OUTPUT_DIR}")
+        INCLUDE_DIRECTORIES "${ER_HEADER_OUTPUT_DIR}"
+        OBJECT_DEPENDS "${RESOURCE_FILES}")
 
     # Make the generated headers available
     target_include_directories(${ER_LIBRARY_NAME} PUBLIC
@@ -427,9 +2241,10 @@ endfunction()
 
 # Unix implementation using object files
 function(_embed_resources_unix)
-    set(options "")
-    set(oneValueArgs TARGET LIBRARY_NAME RESOURCE_DIR HEADER_OUTPUT_DIR NAMESPACE)
-    set(multiValueArgs RESOURCES)
+    set(options PACKED CHUNKED HTTP PROFILING NUMA_REPLICATED GENERATED TEXT STRING_TABLE FROZEN_MAP SET ARCHIVE)
+    set(oneValueArgs TARGET LIBRARY_NAME RESOURCE_DIR HEADER_OUTPUT_DIR NAMESPACE PACKED_REFERENCE FORMAT
+        ELEMENT_TYPE DATA_ALIGNMENT HUGE_PAGE_THRESHOLD)
+    set(multiValueArgs RESOURCES SCHEMA)
 
     cmake_parse_arguments(ER "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
 
@@ -439,6 +2254,44 @@ function(_embed_resources_unix)
     set(EXTERN_DECLARATIONS "")
     set(ACCESSOR_FUNCTIONS "")
     set(ACCESSOR_FUNCTIONS "")
+    set(RESOURCE_LIST "")
+    set(STRING_TABLE_LIST "")
+    set(EXTRA_INCLUDES "")
+
+    if(ER_HTTP)
+        set(EXTRA_INCLUDES "#include <resource_tools/http_resource.h>\n")
+    elseif(ER_PACKED)
+        set(EXTRA_INCLUDES "#include <resource_tools/packed_resource.h>\n#include <resource_tools/resource_cache.h>\n#include <resource_tools/shared_cache.h>\n")
+    endif()
+    if(ER_PROFILING)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/access_profile.h>\n")
+    endif()
+    if(ER_NUMA_REPLICATED)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/numa.h>\n")
+    endif()
+    if(ER_FORMAT STREQUAL "columnar")
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/columnar.h>\n")
+    elseif(ER_FORMAT STREQUAL "json-binary")
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/binary_json.h>\n")
+    endif()
+    if(ER_ELEMENT_TYPE)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/typed_array.h>\n")
+    endif()
+    if(ER_TEXT)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/text_resource.h>\n")
+    endif()
+    if(ER_STRING_TABLE)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/string_table.h>\n")
+    endif()
+    if(ER_FROZEN_MAP)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/frozen_map.h>\n")
+    endif()
+    if(ER_SET)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/frozen_set.h>\n")
+    endif()
+    if(ER_ARCHIVE)
+        string(APPEND EXTRA_INCLUDES "#include <resource_tools/archive_resource.h>\n")
+    endif()
 
     foreach(ResourceFile IN LISTS ER_RESOURCES)
         get_filename_component(ResourceName ${ResourceFile} NAME)
@@ -458,15 +2311,19 @@ function(_embed_resources_unix)
 
         set(FullResourcePath "${ER_RESOURCE_DIR}/${ResourceFile}")
 
-        # Check if file is empty
-        file(SIZE "${FullResourcePath}" FileSize)
-        if(FileSize EQUAL 0)
-            message(FATAL_ERROR "Cannot embed empty file: ${ResourceFile}\nEmbedding empty files is not supported as it serves no practical purpose.")
+        # Check if file is empty (packed and transformed files are generated
+        # at build time and their sources were checked already)
+        if(NOT ER_PACKED AND NOT ER_GENERATED)
+            file(SIZE "${FullResourcePath}" FileSize)
+            if(FileSize EQUAL 0)
+                message(FATAL_ERROR "Cannot embed empty file: ${ResourceFile}\nEmbedding empty files is not supported as it serves no practical purpose.")
+            endif()
         endif()
 
         # Use hash for output filenames to avoid path length issues with very long resource names
-        # This is needed for both macOS (linker archive limits) and to avoid filesystem limits
-        string(MD5 ResourceHash "${ResourceFile}")
+        # This is needed for both macOS (linker archive limits) and to avoid filesystem limits.
+        # The target is part of the hash so the objects of two targets never share a path.
+        string(MD5 ResourceHash "${ER_TARGET}/${ResourceFile}")
         set(OutFile "${CMAKE_CURRENT_BINARY_DIR}/res_${ResourceHash}.o")
 
         # Generate binary symbol name
@@ -476,19 +2333,56 @@ function(_embed_resources_unix)
         # Symbol name for C linkage (with underscore prefix)
         set(BinarySymbolName "_binary_${BinarySymbol}")
 
+        # ld names the symbols after the file alone, so the objects define
+        # them with a hash of the target added: targets embedding the same
+        # file name never share a symbol, even in one executable. The header
+        # still offers the file-named symbols as references.
+        string(MD5 TargetHash "${ER_TARGET}")
+        string(SUBSTRING "${TargetHash}" 0 8 TargetHash)
+        set(LinkSymbol "${TargetHash}_${BinarySymbol}")
+        set(LinkSymbolName "_binary_${LinkSymbol}")
+
+        # Converted formats start on the boundary their arrays are laid out
+        # for, and with HUGE_PAGES resources that are large once built start
+        # on a 2 MB (2^21) boundary instead; only the build knows their size
+        set(AlignDirective "")
+        set(AlignCommand "")
+        if(ER_DATA_ALIGNMENT)
+            set(AlignBits 0)
+            set(AlignBytes 1)
+            while(AlignBytes LESS ER_DATA_ALIGNMENT)
+                math(EXPR AlignBits "${AlignBits} + 1")
+                math(EXPR AlignBytes "${AlignBytes} * 2")
+            endwhile()
+            set(AlignDirective ".p2align ${AlignBits}\\n")
+            set(AlignCommand COMMAND objcopy --set-section-alignment .data=${ER_DATA_ALIGNMENT} ${OutFile})
+        endif()
+        if(ER_HUGE_PAGE_THRESHOLD)
+            set(AlignCommand COMMAND ${CMAKE_COMMAND} -DOBJECT=${OutFile} -DRESOURCE=${FullResourcePath}
+                -DTHRESHOLD=${ER_HUGE_PAGE_THRESHOLD} -DALIGNMENT=${ER_DATA_ALIGNMENT}
+                -P "${RESOURCE_TOOLS_TOOLS_DIR}/align_resource.cmake")
+        endif()
+
         # Platform-specific linker commands
         if(APPLE)
             # macOS: The toolchain adds underscore prefix automatically
             # C++ extern "C" "_binary_*" -> compiler looks for "__binary_*"
             # Assembly declares "_binary_*" -> assembler produces "__binary_*"
             # So both C++ and assembly use the SAME name with single underscore
-            set(AsmSymbolName "${BinarySymbolName}")
+            set(AsmSymbolName "${LinkSymbolName}")
             # macOS: Generate assembly file and assemble it
             set(AsmFile "${CMAKE_CURRENT_BINARY_DIR}/res_${ResourceHash}.s")
             # Create a CMake script to generate the assembly file with ABSOLUTE path to resource
             # macOS assembler syntax: use .global (not .globl) and ensure proper symbol visibility
             set(GenScript "${CMAKE_CURRENT_BINARY_DIR}/res_${ResourceHash}_gen.cmake")
-            file(WRITE ${GenScript} "file(WRITE \"${AsmFile}\" \".section __DATA,__const\\n.global ${AsmSymbolName}_start\\n${AsmSymbolName}_start:\\n.incbin \\\"${FullResourcePath}\\\"\\n.global ${AsmSymbolName}_end\\n${AsmSymbolName}_end:\\n\")")
+            # The script runs at build time, so HUGE_PAGES can check the size
+            # of the file being embedded
+            set(GenAlign "set(Align \"${AlignDirective}\")\n")
+            if(ER_HUGE_PAGE_THRESHOLD)
+                string(APPEND GenAlign "file(SIZE \"${FullResourcePath}\" Size)\n"
+                    "if(NOT Size LESS ${ER_HUGE_PAGE_THRESHOLD})\n    set(Align \".p2align 21\\n\")\nendif()\n")
+            endif()
+            file(WRITE ${GenScript} "${GenAlign}file(WRITE \"${AsmFile}\" \".section __DATA,__const\\n\${Align}.global ${AsmSymbolName}_start\\n${AsmSymbolName}_start:\\n.incbin \\\"${FullResourcePath}\\\"\\n.global ${AsmSymbolName}_end\\n${AsmSymbolName}_end:\\n\")")
             add_custom_command(
                 OUTPUT ${OutFile}
                 MAIN_DEPENDENCY ${FullResourcePath}
@@ -502,7 +2396,12 @@ function(_embed_resources_unix)
                 OUTPUT ${OutFile}
                 MAIN_DEPENDENCY ${FullResourcePath}
                 COMMAND "${CMAKE_LINKER}" --relocatable --format binary --output=${OutFile} ${ResourceName}
-                COMMAND objcopy --add-section .note.GNU-stack=/dev/null --set-section-flags .note.GNU-stack=noload ${OutFile}
+                COMMAND objcopy --add-section .note.GNU-stack=/dev/null --set-section-flags .note.GNU-stack=noload
+                        --redefine-sym ${BinarySymbolName}_start=${LinkSymbolName}_start
+                        --redefine-sym ${BinarySymbolName}_end=${LinkSymbolName}_end
+                        --redefine-sym ${BinarySymbolName}_size=${LinkSymbolName}_size
+                        ${OutFile}
+                ${AlignCommand}
                 DEPENDS ${FullResourcePath}
                 WORKING_DIRECTORY ${ER_RESOURCE_DIR}
             )
@@ -514,18 +2413,87 @@ function(_embed_resources_unix)
         # Linux: GNU ld generates _binary_*, no compiler prefix -> header needs _binary_* (with underscore)
         if(APPLE)
             set(HeaderSymbolName "binary_${BinarySymbol}")
+            set(HeaderLinkName "binary_${LinkSymbol}")
         else()
             set(HeaderSymbolName "${BinarySymbolName}")
+            set(HeaderLinkName "${LinkSymbolName}")
         endif()
 
-        string(APPEND EXTERN_DECLARATIONS "extern \"C\" const uint8_t ${HeaderSymbolName}_start;\n")
-        string(APPEND EXTERN_DECLARATIONS "extern \"C\" const uint8_t ${HeaderSymbolName}_end;\n\n")
+        string(APPEND EXTERN_DECLARATIONS "extern \"C\" const uint8_t ${HeaderLinkName}_start;\n")
+        string(APPEND EXTERN_DECLARATIONS "extern \"C\" const uint8_t ${HeaderLinkName}_end;\n")
+        string(APPEND EXTERN_DECLARATIONS "inline const uint8_t& ${HeaderSymbolName}_start = ${HeaderLinkName}_start;\n")
+        string(APPEND EXTERN_DECLARATIONS "inline const uint8_t& ${HeaderSymbolName}_end = ${HeaderLinkName}_end;\n\n")
+
+        string(REPLACE "\\" "\\\\" EscapedResource "${ResourceFile}")
+        string(REPLACE "\"" "\\\"" EscapedResource "${EscapedResource}")
+        # Profiled accessors count each call under the resource's path
+        set(RECORD_ACCESS "")
+        if(ER_PROFILING)
+            set(RECORD_ACCESS "    RESOURCE_TOOLS_RECORD_ACCESS(\"${ER_NAMESPACE}\", \"${EscapedResource}\");\n")
+        endif()
+
+        # Packed resources expose the raw container as get<Name>Packed()
+        if(ER_PACKED)
+            set(RawAccessorName "get${FunctionName}Packed")
+        else()
+            set(RawAccessorName "get${FunctionName}")
+        endif()
+        # Profiled builds list the unrecorded twins of the accessors, and
+        # build typed and NUMA-local accessors on them so a call counts once
+        set(UnrecordedAccessor "get${FunctionName}")
+        set(UnrecordedRawAccessor "${RawAccessorName}")
+        if(RECORD_ACCESS)
+            set(UnrecordedAccessor "detail::get${FunctionName}")
+            if(NOT ER_PACKED)
+                set(UnrecordedRawAccessor "detail::${RawAccessorName}")
+            endif()
+        endif()
+        string(APPEND RESOURCE_LIST "        {\"${ER_NAMESPACE}\", \"${EscapedResource}\", &${UnrecordedAccessor}, &${UnrecordedRawAccessor}},\n")
 
         # Safe accessor functions (Unix)
-        string(APPEND ACCESSOR_FUNCTIONS "inline auto get${FunctionName}() -> resource_tools::ResourceResult {\n")
-        string(APPEND ACCESSOR_FUNCTIONS "    return resource_tools::getResource(&${HeaderSymbolName}_start, &${HeaderSymbolName}_end);\n")
-        string(APPEND ACCESSOR_FUNCTIONS "}\n\n")
+        set(RAW_ACCESSOR_BODY "    return resource_tools::getResource(&${HeaderLinkName}_start, &${HeaderLinkName}_end);\n")
+        _append_raw_accessor(${RawAccessorName})
+
+        if(ER_PACKED)
+            _append_packed_accessor(${FunctionName})
+        endif()
+
+        if(ER_NUMA_REPLICATED)
+            _append_replicated_accessor(${FunctionName})
+        endif()
+
+        if(ER_FORMAT STREQUAL "columnar")
+            _append_columnar_accessor(${FunctionName})
+        elseif(ER_FORMAT STREQUAL "json-binary")
+            _append_json_accessor(${FunctionName})
+        endif()
+
+        if(ER_ELEMENT_TYPE)
+            _append_array_accessor(${FunctionName})
+        endif()
+
+        if(ER_TEXT)
+            _append_text_accessor(${FunctionName})
+        endif()
+
+        if(ER_STRING_TABLE)
+            _append_string_table_accessor(${FunctionName})
+        endif()
+
+        if(ER_FROZEN_MAP)
+            _append_frozen_map_accessor(${FunctionName})
+        endif()
+        if(ER_SET)
+            _append_set_accessor(${FunctionName})
+        endif()
+        if(ER_ARCHIVE)
+            _append_archive_accessor(${FunctionName})
+        endif()
     endforeach()
+    _append_resource_list()
+    if(ER_STRING_TABLE)
+        _append_string_table_lookup()
+    endif()
 
     # Configure template
     string(TOUPPER ${ER_NAMESPACE} NAMESPACE_UPPER)
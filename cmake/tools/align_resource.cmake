@@ -0,0 +1,32 @@
+# align_resource.cmake
+# Build-time alignment of an embedded resource's object file for
+# embed_resources(HUGE_PAGES). The decision needs the size of the file that
+# is actually embedded, which for packed and converted resources only exists
+# at build time.
+#
+# Usage:
+#   cmake -DOBJECT=<file.o> -DRESOURCE=<file> -DTHRESHOLD=<bytes>
+#         [-DALIGNMENT=<bytes>] -P align_resource.cmake
+#
+# Resources of at least THRESHOLD bytes start on a 2 MB boundary; smaller
+# ones keep ALIGNMENT, if given.
+
+if(NOT OBJECT OR NOT RESOURCE OR NOT THRESHOLD)
+    message(FATAL_ERROR "align_resource: OBJECT, RESOURCE and THRESHOLD are required")
+endif()
+
+file(SIZE "${RESOURCE}" Size)
+if(NOT Size LESS THRESHOLD)
+    set(Alignment 2097152)
+elseif(ALIGNMENT)
+    set(Alignment ${ALIGNMENT})
+else()
+    return()
+endif()
+
+execute_process(
+    COMMAND objcopy --set-section-alignment .data=${Alignment} "${OBJECT}"
+    RESULT_VARIABLE Result)
+if(NOT Result EQUAL 0)
+    message(FATAL_ERROR "align_resource: objcopy failed to align ${OBJECT}")
+endif()
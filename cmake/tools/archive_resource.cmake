@@ -0,0 +1,102 @@
+# archive_resource.cmake
+# Build-time indexing of a tar file for embed_resources(ARCHIVE). A plain tar
+# goes straight to resource_tools_packer. A compressed one (gzip, bzip2, xz
+# or zstd) is extracted with the libarchive built into CMake, and the packer
+# then reads the extracted files back and compresses them one by one.
+#
+# Usage:
+#   cmake -DPACKER=<resource_tools_packer> -DINPUT=<file> -DOUTPUT=<file>
+#         -P archive_resource.cmake
+
+if(NOT PACKER OR NOT INPUT OR NOT OUTPUT)
+    message(FATAL_ERROR "archive_resource: PACKER, INPUT and OUTPUT are required")
+endif()
+
+file(READ "${INPUT}" Magic LIMIT 6 HEX)
+if(NOT Magic MATCHES "^(1f8b|28b52ffd|fd377a585a00|425a68)")
+    execute_process(COMMAND "${PACKER}" archive "${INPUT}" "${OUTPUT}" RESULT_VARIABLE Result)
+    if(NOT Result EQUAL 0)
+        message(FATAL_ERROR "archive_resource: Failed to index ${INPUT}")
+    endif()
+    return()
+endif()
+
+# Members are named by `tar tf`, one per line. Only entries that no other
+# entry is below are extracted, so no symlink is created that a later
+# member could be written through; the packer then reads back the regular
+# files among them.
+set(Work "${OUTPUT}.extract")
+file(REMOVE_RECURSE "${Work}")
+file(MAKE_DIRECTORY "${Work}/members")
+execute_process(
+    COMMAND "${CMAKE_COMMAND}" -E tar tf "${INPUT}"
+    OUTPUT_FILE "${Work}/listing.txt"
+    RESULT_VARIABLE Result)
+file(READ "${Work}/listing.txt" Listing)
+if(NOT Result EQUAL 0)
+    file(REMOVE_RECURSE "${Work}")
+    message(FATAL_ERROR "archive_resource: Cannot list the members of ${INPUT}")
+endif()
+# CMake lists cannot hold these, and extraction patterns are lists
+if(Listing MATCHES "[];[]")
+    file(REMOVE_RECURSE "${Work}")
+    message(FATAL_ERROR
+        "archive_resource: ${INPUT}: member names containing ';', '[' or ']' are only supported in plain tar files")
+endif()
+string(REPLACE "\n" ";" Names "${Listing}")
+
+# Each name once, without "./" and with a trailing "/", so in sorted order
+# an entry is followed by the entries below it
+set(Keys "")
+foreach(Name IN LISTS Names)
+    string(REGEX REPLACE "^(\\./)+" "" Key "${Name}")
+    string(REGEX REPLACE "/+$" "" Key "${Key}")
+    if(Key STREQUAL "" OR Key STREQUAL ".")
+        continue()
+    endif()
+    if(Key MATCHES "^/" OR Key MATCHES "(^|/)\\.\\.(/|$)")
+        file(REMOVE_RECURSE "${Work}")
+        message(FATAL_ERROR "archive_resource: ${INPUT}: member '${Name}' is outside the archive")
+    endif()
+    list(APPEND Keys "${Key}/")
+endforeach()
+list(REMOVE_DUPLICATES Keys)
+list(SORT Keys)
+
+set(Leaves "")
+set(Previous "")
+foreach(Key IN LISTS Keys ITEMS "")
+    if(NOT Previous STREQUAL "")
+        string(FIND "${Key}" "${Previous}" Position)
+        if(NOT Position EQUAL 0)
+            string(REGEX REPLACE "/$" "" Leaf "${Previous}")
+            list(APPEND Leaves "${Leaf}")
+        endif()
+    endif()
+    set(Previous "${Key}")
+endforeach()
+
+if(Leaves)
+    # Extraction patterns are globs
+    string(REGEX REPLACE "([*?\\])" "\\\\\\1" Patterns "${Leaves}")
+    file(ARCHIVE_EXTRACT INPUT "${INPUT}" DESTINATION "${Work}/members" PATTERNS ${Patterns})
+    # Files may be stored without read permission. Links are left alone, as
+    # chmod would follow them.
+    set(Files "")
+    foreach(Leaf IN LISTS Leaves)
+        set(Path "${Work}/members/${Leaf}")
+        if(EXISTS "${Path}" AND NOT IS_SYMLINK "${Path}" AND NOT IS_DIRECTORY "${Path}")
+            list(APPEND Files "${Path}")
+        endif()
+    endforeach()
+    if(Files)
+        file(CHMOD ${Files} FILE_PERMISSIONS OWNER_READ OWNER_WRITE)
+    endif()
+endif()
+execute_process(
+    COMMAND "${PACKER}" archive --compress --tree "${Work}/members" "${Work}/listing.txt" "${OUTPUT}"
+    RESULT_VARIABLE Result)
+file(REMOVE_RECURSE "${Work}")
+if(NOT Result EQUAL 0)
+    message(FATAL_ERROR "archive_resource: Failed to index ${INPUT}")
+endif()
@@ -0,0 +1,26 @@
+# compress_resource.cmake
+# Build-time fallback compressor for embed_resources(HTTP) when no gzip or
+# zstd command-line tool is available. Uses the compressors built into CMake.
+#
+# Usage:
+#   cmake -DINPUT=<file> -DOUTPUT=<file> -DCODING=<gzip|zstd> -P compress_resource.cmake
+
+if(NOT INPUT OR NOT OUTPUT OR NOT CODING)
+    message(FATAL_ERROR "compress_resource: INPUT, OUTPUT and CODING are required")
+endif()
+
+if(CODING STREQUAL "gzip")
+    set(Compression GZip)
+elseif(CODING STREQUAL "zstd")
+    set(Compression Zstd)
+else()
+    message(FATAL_ERROR "compress_resource: Unsupported coding '${CODING}'")
+endif()
+
+# A raw archive is just the compressed stream of the single input file
+file(ARCHIVE_CREATE
+    OUTPUT "${OUTPUT}"
+    PATHS "${INPUT}"
+    FORMAT raw
+    COMPRESSION ${Compression}
+    COMPRESSION_LEVEL 9)
@@ -0,0 +1,2618 @@
+// resource_packer
+// Build-time helper for embed_resources(). Encodes resource files into the
+// packed container format decoded by <resource_tools/packed_resource.h>.
+//
+// Usage:
+//   resource_packer sparse [--min-run <bytes>] <input> <output>
+//   resource_packer chunk [--avg-size <bytes>] --store <output> --report <file>
+//                         <input> <output> [<input> <output> ...]
+//   resource_packer delta --base <input> <output> --report <file>
+//                         <input> <output> [<input> <output> ...]
+//   resource_packer compress <input> <output>
+//   resource_packer store <input> <output>
+//   resource_packer http --mime <type> [--variant <coding> <file> ...]
+//                        <input> <output>
+//   resource_packer columnar --schema <name>:<type>[,...] [--delimiter <name>]
+//                            [--big-endian] <input> <output>
+//   resource_packer array --element-type <type> [--source-endian little|big]
+//                         [--big-endian] <input> <output>
+//   resource_packer text [--normalize-newlines] <input> <output>
+//   resource_packer string-table <input> <output>
+//   resource_packer frozen-map <input> <output>
+//   resource_packer set [--bloom-bits <bits per entry>] <input> <output>
+//   resource_packer archive [--compress] <input> <output>
+//   resource_packer archive [--compress] --tree <dir> <listing> <output>
+//   resource_packer json <input> <output>
+
+#include <resource_tools/archive_resource.h>
+#include <resource_tools/binary_json.h>
+#include <resource_tools/columnar.h>
+#include <resource_tools/content_hash.h>
+#include <resource_tools/frozen_map.h>
+#include <resource_tools/frozen_set.h>
+#include <resource_tools/http_resource.h>
+#include <resource_tools/packed_resource.h>
+#include <resource_tools/string_table.h>
+#include <resource_tools/text_resource.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+namespace packed = resource_tools::packed;
+
+auto readFile(const std::string& path, Bytes& out) -> bool {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "resource_packer: cannot open " << path << "\n";
+        return false;
+    }
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+auto writeFile(const std::string& path, const Bytes& data) -> bool {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "resource_packer: cannot write " << path << "\n";
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(out);
+}
+
+void appendLe64(Bytes& out, uint64_t value) {
+    uint8_t buf[8];
+    packed::store_le64(buf, value);
+    out.insert(out.end(), buf, buf + 8);
+}
+
+// Wrap `payload` as the container of `resource`, recording the key that
+// names its shared cache segment so processes never hash it at run time
+auto makeContainer(packed::Encoding encoding, const Bytes& resource, const Bytes& payload) -> Bytes {
+    Bytes out(packed::kHeaderSize);
+    packed::Header header;
+    header.encoding = encoding;
+    header.size = resource.size();
+    header.payload_size = payload.size();
+    header.key = packed::load_le64(resource_tools::sha256(resource.data(), resource.size()).data());
+    packed::writeHeader(out.data(), header);
+    out.insert(out.end(), payload.begin(), payload.end());
+    return out;
+}
+
+// Decode the container we just produced and compare it with the input, so a
+// packer bug fails the build instead of shipping a corrupt resource
+auto verifyContainer(const Bytes& container, const Bytes& original, const Bytes& reference = {}) -> bool {
+    resource_tools::ResourceResult blob{container.data(), container.size(), resource_tools::ResourceError::Success};
+    resource_tools::ResourceResult ref{reference.data(), reference.size(), resource_tools::ResourceError::Success};
+    Bytes decoded(original.size());
+    auto err = resource_tools::decodePacked(blob, decoded.data(), decoded.size(), ref);
+    if (err != resource_tools::ResourceError::Success || decoded != original) {
+        std::cerr << "resource_packer: round-trip verification failed ("
+                  << resource_tools::to_string(err) << ")\n";
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// SPARSE ENCODING
+// ============================================================================
+
+// Split the input into non-zero segments separated by zero runs of at least
+// min_run bytes. Shorter zero runs stay inside their segment.
+auto encodeSparse(const Bytes& input, uint64_t min_run) -> Bytes {
+    std::vector<packed::SparseSegment> segments;
+    const uint64_t size = input.size();
+    uint64_t segment_start = 0;
+    bool in_segment = false;
+    uint64_t i = 0;
+
+    while (i < size) {
+        if (input[i] != 0) {
+            if (!in_segment) {
+                segment_start = i;
+                in_segment = true;
+            }
+            ++i;
+            continue;
+        }
+
+        uint64_t run_end = i;
+        while (run_end < size && input[run_end] == 0) {
+            ++run_end;
+        }
+        if (run_end - i >= min_run || run_end == size) {
+            if (in_segment) {
+                segments.push_back({segment_start, i - segment_start});
+                in_segment = false;
+            }
+        } else if (!in_segment) {
+            segment_start = i;
+            in_segment = true;
+        }
+        i = run_end;
+    }
+    if (in_segment) {
+        segments.push_back({segment_start, size - segment_start});
+    }
+
+    Bytes payload;
+    appendLe64(payload, segments.size());
+    for (const auto& segment : segments) {
+        appendLe64(payload, segment.offset);
+        appendLe64(payload, segment.length);
+    }
+    for (const auto& segment : segments) {
+        auto first = input.begin() + static_cast<std::ptrdiff_t>(segment.offset);
+        payload.insert(payload.end(), first, first + static_cast<std::ptrdiff_t>(segment.length));
+    }
+
+    // Only keep the sparse form if it actually saves space
+    if (payload.size() >= input.size()) {
+        return makeContainer(packed::Encoding::Stored, input, input);
+    }
+    return makeContainer(packed::Encoding::Sparse, input, payload);
+}
+
+auto runSparse(const std::vector<std::string_view>& args) -> int {
+    uint64_t min_run = 4096;
+    std::vector<std::string> paths;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--min-run" && i + 1 < args.size()) {
+            min_run = std::strtoull(std::string(args[++i]).c_str(), nullptr, 10);
+        } else {
+            paths.emplace_back(args[i]);
+        }
+    }
+    if (paths.size() != 2 || min_run == 0) {
+        std::cerr << "usage: resource_packer sparse [--min-run <bytes>] <input> <output>\n";
+        return 2;
+    }
+
+    Bytes input;
+    if (!readFile(paths[0], input)) {
+        return 1;
+    }
+    Bytes container = encodeSparse(input, min_run);
+    if (!verifyContainer(container, input)) {
+        return 1;
+    }
+    return writeFile(paths[1], container) ? 0 : 1;
+}
+
+// ============================================================================
+// CONTENT-DEFINED CHUNKING
+// ============================================================================
+
+// Gear table for the rolling hash, generated with splitmix64 so the chunk
+// boundaries (and therefore the build output) are reproducible
+auto gearTable() -> const std::array<uint64_t, 256>& {
+    static const std::array<uint64_t, 256> table = [] {
+        std::array<uint64_t, 256> t{};
+        uint64_t state = 0x9E3779B97F4A7C15ull;
+        for (auto& value : t) {
+            state += 0x9E3779B97F4A7C15ull;
+            uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            value = z ^ (z >> 31);
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Split data into chunks whose boundaries depend only on local content, so an
+// insertion early in a file does not shift every later chunk. Chunks are kept
+// between avg/4 and avg*8 bytes.
+auto findChunks(const Bytes& data, uint64_t avg_size) -> std::vector<packed::ChunkRef> {
+    const auto& gear = gearTable();
+    const uint64_t mask = avg_size - 1;
+    const uint64_t min_size = avg_size / 4;
+    const uint64_t max_size = avg_size * 8;
+
+    std::vector<packed::ChunkRef> chunks;
+    uint64_t start = 0;
+    uint64_t hash = 0;
+    for (uint64_t i = 0; i < data.size(); ++i) {
+        hash = (hash << 1) + gear[data[i]];
+        const uint64_t length = i + 1 - start;
+        if ((length >= min_size && (hash & mask) == 0) || length >= max_size) {
+            chunks.push_back({start, length});
+            start = i + 1;
+            hash = 0;
+        }
+    }
+    if (start < data.size()) {
+        chunks.push_back({start, data.size() - start});
+    }
+    return chunks;
+}
+
+struct ChunkInput {
+    std::string input;
+    std::string output;
+};
+
+auto runChunk(const std::vector<std::string_view>& args) -> int {
+    uint64_t avg_size = 8192;
+    std::string store_path;
+    std::string report_path;
+    std::vector<std::string> paths;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--avg-size" && i + 1 < args.size()) {
+            avg_size = std::strtoull(std::string(args[++i]).c_str(), nullptr, 10);
+        } else if (args[i] == "--store" && i + 1 < args.size()) {
+            store_path = args[++i];
+        } else if (args[i] == "--report" && i + 1 < args.size()) {
+            report_path = args[++i];
+        } else {
+            paths.emplace_back(args[i]);
+        }
+    }
+    const bool power_of_two = avg_size >= 64 && (avg_size & (avg_size - 1)) == 0;
+    if (store_path.empty() || report_path.empty() || paths.empty() || paths.size() % 2 != 0 || !power_of_two) {
+        std::cerr << "usage: resource_packer chunk [--avg-size <power of two>] --store <output> --report <file>\n"
+                  << "                             <input> <output> [<input> <output> ...]\n";
+        return 2;
+    }
+
+    Bytes store;
+    std::unordered_map<std::string_view, uint64_t> known;  // chunk bytes -> store offset
+    std::vector<Bytes> inputs(paths.size() / 2);
+    std::vector<Bytes> recipes(paths.size() / 2);
+    std::ofstream report(report_path, std::ios::trunc);
+    uint64_t total_size = 0;
+
+    // Keep every input alive so the map's string_views stay valid
+    for (size_t r = 0; r < inputs.size(); ++r) {
+        if (!readFile(paths[r * 2], inputs[r])) {
+            return 1;
+        }
+    }
+
+    report << "# Chunk Deduplication Report\n";
+    report << "# Generated by resource_tools (average chunk size " << avg_size << " bytes)\n\n";
+
+    std::vector<std::vector<packed::ChunkRef>> tables(inputs.size());
+    for (size_t r = 0; r < inputs.size(); ++r) {
+        const Bytes& input = inputs[r];
+        uint64_t new_bytes = 0;
+        uint64_t new_chunks = 0;
+        auto chunks = findChunks(input, avg_size);
+
+        for (const auto& chunk : chunks) {
+            std::string_view key(reinterpret_cast<const char*>(input.data() + chunk.offset), chunk.length);
+            auto [it, inserted] = known.try_emplace(key, store.size());
+            if (inserted) {
+                store.insert(store.end(), input.begin() + static_cast<std::ptrdiff_t>(chunk.offset),
+                             input.begin() + static_cast<std::ptrdiff_t>(chunk.offset + chunk.length));
+                new_bytes += chunk.length;
+                ++new_chunks;
+            }
+            tables[r].push_back({it->second, chunk.length});
+        }
+
+        const uint64_t saved = input.size() - new_bytes;
+        total_size += input.size();
+        report << "Resource: " << paths[r * 2] << "\n";
+        report << "  Size: " << input.size() << " bytes\n";
+        report << "  Chunks: " << chunks.size() << " (" << new_chunks << " new)\n";
+        report << "  Stored: " << new_bytes << " bytes\n";
+        report << "  Saved: " << saved << " bytes (" << (input.empty() ? 0 : saved * 100 / input.size()) << "%)\n\n";
+    }
+
+    report << "Total resource size: " << total_size << " bytes\n";
+    report << "Chunk store size: " << store.size() << " bytes\n";
+    report << "Total saved: " << (total_size - store.size()) << " bytes\n";
+
+    Bytes store_container = makeContainer(packed::Encoding::Stored, store, store);
+    for (size_t r = 0; r < inputs.size(); ++r) {
+        Bytes payload;
+        appendLe64(payload, tables[r].size());
+        for (const auto& ref : tables[r]) {
+            appendLe64(payload, ref.offset);
+            appendLe64(payload, ref.length);
+        }
+        Bytes container = makeContainer(packed::Encoding::Chunked, inputs[r], payload);
+        if (!verifyContainer(container, inputs[r], store_container) || !writeFile(paths[r * 2 + 1], container)) {
+            return 1;
+        }
+    }
+    return writeFile(store_path, store_container) && report ? 0 : 1;
+}
+
+// ============================================================================
+// DELTA ENCODING
+// ============================================================================
+
+constexpr size_t kDeltaBlock = 16;
+
+auto hashBlock(const uint8_t* p) -> uint64_t {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < kDeltaBlock; ++i) {
+        hash = (hash ^ p[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+struct DeltaStats {
+    uint64_t copied = 0;
+    uint64_t inserted = 0;
+    bool stored = false;
+};
+
+// Greedy copy/insert encoding: every aligned block of the base is indexed,
+// every offset of the target is looked up, and matches are extended in both
+// directions before being emitted as a copy
+auto encodeDelta(const Bytes& base, const Bytes& target, DeltaStats& stats) -> Bytes {
+    std::unordered_map<uint64_t, uint64_t> index;
+    for (size_t off = 0; off + kDeltaBlock <= base.size(); off += kDeltaBlock) {
+        index.try_emplace(hashBlock(base.data() + off), off);
+    }
+
+    Bytes ops;
+    uint64_t op_count = 0;
+    auto emitInsert = [&](size_t from, size_t to) {
+        if (to <= from) {
+            return;
+        }
+        ops.push_back(static_cast<uint8_t>(packed::DeltaOp::Insert));
+        appendLe64(ops, to - from);
+        ops.insert(ops.end(), target.begin() + static_cast<std::ptrdiff_t>(from),
+                   target.begin() + static_cast<std::ptrdiff_t>(to));
+        stats.inserted += to - from;
+        ++op_count;
+    };
+    auto emitCopy = [&](uint64_t offset, uint64_t length) {
+        ops.push_back(static_cast<uint8_t>(packed::DeltaOp::Copy));
+        appendLe64(ops, offset);
+        appendLe64(ops, length);
+        stats.copied += length;
+        ++op_count;
+    };
+
+    size_t pending = 0;
+    size_t i = 0;
+    while (i + kDeltaBlock <= target.size()) {
+        auto it = index.find(hashBlock(target.data() + i));
+        if (it == index.end() || std::memcmp(target.data() + i, base.data() + it->second, kDeltaBlock) != 0) {
+            ++i;
+            continue;
+        }
+
+        size_t target_start = i;
+        size_t base_start = static_cast<size_t>(it->second);
+        while (target_start > pending && base_start > 0 && target[target_start - 1] == base[base_start - 1]) {
+            --target_start;
+            --base_start;
+        }
+        size_t target_end = i + kDeltaBlock;
+        size_t base_end = base_start + (target_end - target_start);
+        while (target_end < target.size() && base_end < base.size() && target[target_end] == base[base_end]) {
+            ++target_end;
+            ++base_end;
+        }
+
+        emitInsert(pending, target_start);
+        emitCopy(base_start, target_end - target_start);
+        pending = target_end;
+        i = target_end;
+    }
+    emitInsert(pending, target.size());
+
+    Bytes payload;
+    appendLe64(payload, op_count);
+    payload.insert(payload.end(), ops.begin(), ops.end());
+
+    // A variant that shares too little with the base is stored whole
+    if (payload.size() >= target.size()) {
+        stats.stored = true;
+        return makeContainer(packed::Encoding::Stored, target, target);
+    }
+    return makeContainer(packed::Encoding::Delta, target, payload);
+}
+
+auto runDelta(const std::vector<std::string_view>& args) -> int {
+    std::string base_path;
+    std::string base_output;
+    std::string report_path;
+    std::vector<std::string> paths;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--base" && i + 2 < args.size()) {
+            base_path = args[++i];
+            base_output = args[++i];
+        } else if (args[i] == "--report" && i + 1 < args.size()) {
+            report_path = args[++i];
+        } else {
+            paths.emplace_back(args[i]);
+        }
+    }
+    if (base_path.empty() || report_path.empty() || paths.empty() || paths.size() % 2 != 0) {
+        std::cerr << "usage: resource_packer delta --base <input> <output> --report <file>\n"
+                  << "                             <input> <output> [<input> <output> ...]\n";
+        return 2;
+    }
+
+    Bytes base;
+    if (!readFile(base_path, base)) {
+        return 1;
+    }
+    Bytes base_container = makeContainer(packed::Encoding::Stored, base, base);
+
+    std::ofstream report(report_path, std::ios::trunc);
+    report << "# Delta Encoding Report\n";
+    report << "# Generated by resource_tools\n\n";
+    report << "Base: " << base_path << " (" << base.size() << " bytes)\n\n";
+
+    uint64_t total_size = 0;
+    uint64_t total_stored = 0;
+    for (size_t r = 0; r < paths.size(); r += 2) {
+        Bytes input;
+        if (!readFile(paths[r], input)) {
+            return 1;
+        }
+
+        DeltaStats stats;
+        Bytes container = encodeDelta(base, input, stats);
+        if (!verifyContainer(container, input, base_container) || !writeFile(paths[r + 1], container)) {
+            return 1;
+        }
+
+        const uint64_t saved = input.size() > container.size() ? input.size() - container.size() : 0;
+        total_size += input.size();
+        total_stored += container.size();
+        report << "Variant: " << paths[r] << "\n";
+        report << "  Size: " << input.size() << " bytes\n";
+        report << (stats.stored ? "  Stored: " : "  Delta: ") << container.size() << " bytes\n";
+        report << "  Copied from base: " << stats.copied << " bytes\n";
+        report << "  Inserted: " << stats.inserted << " bytes\n";
+        report << "  Saved: " << saved << " bytes (" << (input.empty() ? 0 : saved * 100 / input.size()) << "%)\n\n";
+    }
+
+    report << "Total variant size: " << total_size << " bytes\n";
+    report << "Total delta size: " << total_stored << " bytes\n";
+
+    return writeFile(base_output, base_container) && report ? 0 : 1;
+}
+
+// ============================================================================
+// LZ COMPRESSION
+// ============================================================================
+
+constexpr size_t kLzHashBits = 16;
+constexpr size_t kLzMaxChain = 64;
+
+void appendLzLength(Bytes& out, size_t length) {
+    length -= 15;
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+// A match length of zero marks the final, literals-only sequence
+void appendLzSequence(Bytes& out, const uint8_t* literals, size_t literal_count, size_t offset, size_t match) {
+    const size_t match_code = match > 0 ? match - packed::kLzMinMatch : 0;
+    out.push_back(static_cast<uint8_t>((std::min<size_t>(literal_count, 15) << 4) | std::min<size_t>(match_code, 15)));
+    if (literal_count >= 15) {
+        appendLzLength(out, literal_count);
+    }
+    out.insert(out.end(), literals, literals + literal_count);
+    if (match > 0) {
+        uint8_t buf[2];
+        packed::store_le16(buf, static_cast<uint16_t>(offset));
+        out.insert(out.end(), buf, buf + 2);
+        if (match_code >= 15) {
+            appendLzLength(out, match_code);
+        }
+    }
+}
+
+// Greedy LZ77 with hash chains; slow but only ever run at build time
+auto encodeLz(const Bytes& input) -> Bytes {
+    const size_t n = input.size();
+    std::vector<int64_t> head(size_t{1} << kLzHashBits, -1);
+    std::vector<int64_t> chain(n, -1);
+
+    auto hash4 = [&](size_t pos) {
+        uint32_t v;
+        std::memcpy(&v, input.data() + pos, 4);
+        return (v * 2654435761u) >> (32 - kLzHashBits);
+    };
+    auto insert = [&](size_t pos) {
+        if (pos + 4 <= n) {
+            const uint32_t h = hash4(pos);
+            chain[pos] = head[h];
+            head[h] = static_cast<int64_t>(pos);
+        }
+    };
+
+    Bytes payload;
+    size_t anchor = 0;
+    size_t i = 0;
+    while (i + packed::kLzMinMatch <= n) {
+        size_t best_length = 0;
+        size_t best_offset = 0;
+        size_t depth = 0;
+        for (int64_t candidate = head[hash4(i)];
+             candidate >= 0 && i - static_cast<size_t>(candidate) <= packed::kLzWindow && depth < kLzMaxChain;
+             candidate = chain[static_cast<size_t>(candidate)], ++depth) {
+            const size_t from = static_cast<size_t>(candidate);
+            size_t length = 0;
+            while (i + length < n && input[from + length] == input[i + length]) {
+                ++length;
+            }
+            if (length > best_length) {
+                best_length = length;
+                best_offset = i - from;
+                if (i + length == n) {
+                    break;
+                }
+            }
+        }
+
+        if (best_length < packed::kLzMinMatch) {
+            insert(i);
+            ++i;
+            continue;
+        }
+
+        appendLzSequence(payload, input.data() + anchor, i - anchor, best_offset, best_length);
+        for (size_t pos = i; pos < i + best_length; ++pos) {
+            insert(pos);
+        }
+        i += best_length;
+        anchor = i;
+    }
+    if (anchor < n) {
+        appendLzSequence(payload, input.data() + anchor, n - anchor, 0, 0);
+    }
+    return makeContainer(packed::Encoding::Lz, input, payload);
+}
+
+auto runCompress(const std::vector<std::string_view>& args) -> int {
+    if (args.size() != 2) {
+        std::cerr << "usage: resource_packer compress <input> <output>\n";
+        return 2;
+    }
+
+    Bytes input;
+    if (!readFile(std::string(args[0]), input)) {
+        return 1;
+    }
+
+    Bytes container = encodeLz(input);
+    if (container.size() >= input.size() + packed::kHeaderSize) {
+        // Incompressible data is cheaper to store than to decode
+        container = makeContainer(packed::Encoding::Stored, input, input);
+    }
+    if (!verifyContainer(container, input)) {
+        return 1;
+    }
+    return writeFile(std::string(args[1]), container) ? 0 : 1;
+}
+
+auto runStore(const std::vector<std::string_view>& args) -> int {
+    if (args.size() != 2) {
+        std::cerr << "usage: resource_packer store <input> <output>\n";
+        return 2;
+    }
+
+    Bytes input;
+    if (!readFile(std::string(args[0]), input)) {
+        return 1;
+    }
+    return writeFile(std::string(args[1]), makeContainer(packed::Encoding::Stored, input, input)) ? 0 : 1;
+}
+
+// ============================================================================
+// HTTP BUNDLES
+// ============================================================================
+
+struct HttpInput {
+    resource_tools::ContentCoding coding;
+    Bytes body;
+};
+
+auto parseCoding(std::string_view name, resource_tools::ContentCoding& out) -> bool {
+    for (auto coding : {resource_tools::ContentCoding::Gzip, resource_tools::ContentCoding::Brotli,
+                        resource_tools::ContentCoding::Zstd}) {
+        if (name == resource_tools::to_string(coding)) {
+            out = coding;
+            return true;
+        }
+    }
+    return false;
+}
+
+auto makeResponseHeader(const std::string& mime_type, const HttpInput& variant, const std::string& etag) -> std::string {
+    std::string header = "HTTP/1.1 200 OK\r\n";
+    header += "Content-Type: " + mime_type + "\r\n";
+    header += "Content-Length: " + std::to_string(variant.body.size()) + "\r\n";
+    if (variant.coding != resource_tools::ContentCoding::Identity) {
+        header += std::string("Content-Encoding: ") + resource_tools::to_string(variant.coding) + "\r\n";
+    }
+    header += "ETag: " + etag + "\r\n";
+    header += "Vary: Accept-Encoding\r\n\r\n";
+    return header;
+}
+
+// Lay out an HTTP bundle as described in <resource_tools/http_resource.h>
+auto encodeHttpBundle(const std::string& mime_type, const std::vector<HttpInput>& variants) -> Bytes {
+    const auto hash = resource_tools::toHex(resource_tools::sha256(variants[0].body.data(), variants[0].body.size()));
+    const std::string hash_hex(hash.data(), 64);
+
+    std::vector<std::string> etags;
+    std::string strings = hash_hex + mime_type;
+    for (const auto& variant : variants) {
+        std::string etag = "\"" + hash_hex;
+        if (variant.coding != resource_tools::ContentCoding::Identity) {
+            etag += std::string("-") + resource_tools::to_string(variant.coding);
+        }
+        etag += "\"";
+        etags.push_back(etag);
+        strings += etag;
+    }
+
+    const size_t strings_offset = resource_tools::http::kHeaderSize + variants.size() * resource_tools::http::kEntrySize;
+    Bytes out(strings_offset);
+    packed::store_le32(out.data(), resource_tools::http::kMagic);
+    packed::store_le16(out.data() + 4, resource_tools::http::kVersion);
+    packed::store_le16(out.data() + 6, static_cast<uint16_t>(variants.size()));
+    packed::store_le32(out.data() + 8, static_cast<uint32_t>(strings_offset));
+    packed::store_le32(out.data() + 12, static_cast<uint32_t>(hash_hex.size()));
+    packed::store_le32(out.data() + 16, static_cast<uint32_t>(strings_offset + hash_hex.size()));
+    packed::store_le32(out.data() + 20, static_cast<uint32_t>(mime_type.size()));
+    out.insert(out.end(), strings.begin(), strings.end());
+
+    size_t etag_offset = strings_offset + hash_hex.size() + mime_type.size();
+    for (size_t i = 0; i < variants.size(); ++i) {
+        const std::string header = makeResponseHeader(mime_type, variants[i], etags[i]);
+        uint8_t* entry = out.data() + resource_tools::http::kHeaderSize + i * resource_tools::http::kEntrySize;
+        packed::store_le16(entry, static_cast<uint16_t>(variants[i].coding));
+        packed::store_le32(entry + 4, static_cast<uint32_t>(etag_offset));
+        packed::store_le32(entry + 8, static_cast<uint32_t>(etags[i].size()));
+        packed::store_le64(entry + 12, out.size());
+        packed::store_le32(entry + 20, static_cast<uint32_t>(header.size()));
+        packed::store_le64(entry + 24, variants[i].body.size());
+        etag_offset += etags[i].size();
+
+        out.insert(out.end(), header.begin(), header.end());
+        out.insert(out.end(), variants[i].body.begin(), variants[i].body.end());
+    }
+    return out;
+}
+
+auto runHttp(const std::vector<std::string_view>& args) -> int {
+    std::string mime_type;
+    std::string identity_path;
+    std::string output_path;
+    std::vector<std::pair<std::string, std::string>> variant_paths;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--mime" && i + 1 < args.size()) {
+            mime_type = args[++i];
+        } else if (args[i] == "--variant" && i + 2 < args.size()) {
+            std::string coding(args[++i]);
+            variant_paths.emplace_back(coding, std::string(args[++i]));
+        } else if (identity_path.empty()) {
+            identity_path = args[i];
+        } else if (output_path.empty()) {
+            output_path = args[i];
+        } else {
+            output_path.clear();
+            break;
+        }
+    }
+    if (mime_type.empty() || identity_path.empty() || output_path.empty()) {
+        std::cerr << "usage: resource_packer http --mime <type> [--variant <coding> <file> ...] <input> <output>\n";
+        return 2;
+    }
+
+    std::vector<HttpInput> variants(1);
+    variants[0].coding = resource_tools::ContentCoding::Identity;
+    if (!readFile(identity_path, variants[0].body)) {
+        return 1;
+    }
+
+    for (const auto& [name, path] : variant_paths) {
+        HttpInput variant;
+        if (!parseCoding(name, variant.coding)) {
+            std::cerr << "resource_packer: unknown content coding '" << name << "'\n";
+            return 2;
+        }
+        if (!readFile(path, variant.body)) {
+            return 1;
+        }
+        // Serving an encoding that does not save bytes only costs the client CPU
+        if (variant.body.size() < variants[0].body.size()) {
+            variants.push_back(std::move(variant));
+        }
+    }
+
+    Bytes bundle = encodeHttpBundle(mime_type, variants);
+
+    resource_tools::HttpResource check({bundle.data(), bundle.size(), resource_tools::ResourceError::Success});
+    auto identity = check.identity();
+    if (!check || check.variant_count() != variants.size() || identity.body.size != variants[0].body.size() ||
+        std::memcmp(identity.body.data, variants[0].body.data(), identity.body.size) != 0) {
+        std::cerr << "resource_packer: HTTP bundle verification failed\n";
+        return 1;
+    }
+
+    return writeFile(output_path, bundle) ? 0 : 1;
+}
+
+// ============================================================================
+// COLUMNAR TABLES
+// ============================================================================
+
+struct ColumnSpec {
+    std::string name;
+    resource_tools::ColumnType type;
+};
+
+auto parseColumnType(std::string_view name, resource_tools::ColumnType& out) -> bool {
+    for (uint16_t t = 1; t <= static_cast<uint16_t>(resource_tools::ColumnType::String); ++t) {
+        const auto type = static_cast<resource_tools::ColumnType>(t);
+        if (name == resource_tools::to_string(type)) {
+            out = type;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Parse "name:type,name:type,..."
+auto parseSchema(std::string_view schema, std::vector<ColumnSpec>& out) -> bool {
+    while (!schema.empty()) {
+        const size_t comma = schema.find(',');
+        const std::string_view item = schema.substr(0, comma);
+        schema = comma == std::string_view::npos ? std::string_view{} : schema.substr(comma + 1);
+
+        const size_t colon = item.find(':');
+        ColumnSpec column;
+        if (colon == std::string_view::npos || colon == 0 || !parseColumnType(item.substr(colon + 1), column.type)) {
+            std::cerr << "resource_packer: invalid schema entry '" << item << "'\n";
+            return false;
+        }
+        column.name = item.substr(0, colon);
+        out.push_back(std::move(column));
+    }
+    return !out.empty();
+}
+
+// Split delimited text into records of fields, following RFC 4180: fields
+// may be quoted, quotes inside quoted fields are doubled, and quoted fields
+// may span lines. Records end at LF or CRLF; blank lines are skipped.
+auto parseDelimited(const Bytes& input, char delimiter, std::vector<std::vector<std::string>>& records) -> bool {
+    std::vector<std::string> record;
+    std::string field;
+    bool quoted = false;
+    bool was_quoted = false;
+    size_t line = 1;
+
+    auto end_record = [&] {
+        record.push_back(std::move(field));
+        field.clear();
+        was_quoted = false;
+        if (record.size() > 1 || !record[0].empty()) {
+            records.push_back(std::move(record));
+        }
+        record.clear();
+    };
+
+    for (size_t i = 0; i < input.size(); ++i) {
+        const char c = static_cast<char>(input[i]);
+        if (quoted) {
+            if (c == '"' && i + 1 < input.size() && input[i + 1] == '"') {
+                field += '"';
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                line += c == '\n';
+                field += c;
+            }
+        } else if (c == '"' && field.empty() && !was_quoted) {
+            quoted = true;
+            was_quoted = true;
+        } else if (c == delimiter) {
+            record.push_back(std::move(field));
+            field.clear();
+            was_quoted = false;
+        } else if (c == '\n' || (c == '\r' && i + 1 < input.size() && input[i + 1] == '\n')) {
+            i += c == '\r';
+            ++line;
+            end_record();
+        } else if (was_quoted) {
+            std::cerr << "resource_packer: unexpected character after closing quote on line " << line << "\n";
+            return false;
+        } else {
+            field += c;
+        }
+    }
+    if (quoted) {
+        std::cerr << "resource_packer: unterminated quoted field\n";
+        return false;
+    }
+    if (!field.empty() || was_quoted || !record.empty()) {
+        end_record();
+    }
+    return true;
+}
+
+// Store one value in the target's byte order
+template <typename T>
+void appendValue(Bytes& out, T value, bool big_endian) {
+    uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if (big_endian != (std::endian::native == std::endian::big)) {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+auto appendParsed(Bytes& out, std::string_view text, bool big_endian) -> bool {
+    T value{};
+    if constexpr (std::is_floating_point_v<T>) {
+        // A missing measurement is NaN rather than a build failure
+        if (text.empty()) {
+            appendValue(out, std::numeric_limits<T>::quiet_NaN(), big_endian);
+            return true;
+        }
+        if (text.front() == '+') {
+            text.remove_prefix(1);
+        }
+    }
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc() || end != text.data() + text.size() || text.empty()) {
+        return false;
+    }
+    appendValue(out, value, big_endian);
+    return true;
+}
+
+auto appendNumeric(Bytes& out, resource_tools::ColumnType type, std::string_view text, bool big_endian) -> bool {
+    using resource_tools::ColumnType;
+    switch (type) {
+        case ColumnType::Int8: return appendParsed<int8_t>(out, text, big_endian);
+        case ColumnType::Int16: return appendParsed<int16_t>(out, text, big_endian);
+        case ColumnType::Int32: return appendParsed<int32_t>(out, text, big_endian);
+        case ColumnType::Int64: return appendParsed<int64_t>(out, text, big_endian);
+        case ColumnType::UInt8: return appendParsed<uint8_t>(out, text, big_endian);
+        case ColumnType::UInt16: return appendParsed<uint16_t>(out, text, big_endian);
+        case ColumnType::UInt32: return appendParsed<uint32_t>(out, text, big_endian);
+        case ColumnType::UInt64: return appendParsed<uint64_t>(out, text, big_endian);
+        case ColumnType::Float32: return appendParsed<float>(out, text, big_endian);
+        case ColumnType::Float64: return appendParsed<double>(out, text, big_endian);
+        case ColumnType::String: break;
+    }
+    return false;
+}
+
+void padTo(Bytes& out, size_t alignment) {
+    out.resize((out.size() + alignment - 1) / alignment * alignment, 0);
+}
+
+// Lay out a columnar table as described in <resource_tools/columnar.h>
+auto encodeColumnar(const std::vector<ColumnSpec>& schema, const std::vector<std::vector<std::string>>& records,
+                    bool big_endian, Bytes& out) -> bool {
+    namespace columnar = resource_tools::columnar;
+    using resource_tools::ColumnType;
+
+    // The header row names the columns; the schema picks and orders them
+    const std::vector<std::string>& header = records[0];
+    std::vector<size_t> source(schema.size());
+    for (size_t c = 0; c < schema.size(); ++c) {
+        auto it = std::find(header.begin(), header.end(), schema[c].name);
+        if (it == header.end()) {
+            std::cerr << "resource_packer: column '" << schema[c].name << "' is not in the header row\n";
+            return false;
+        }
+        source[c] = static_cast<size_t>(it - header.begin());
+    }
+    const size_t rows = records.size() - 1;
+
+    out.assign(columnar::kHeaderSize + schema.size() * columnar::kEntrySize, 0);
+    packed::store_le32(out.data(), columnar::kMagic);
+    packed::store_le16(out.data() + 4, columnar::kVersion);
+    packed::store_le16(out.data() + 6, big_endian ? columnar::kBigEndian : 0);
+    packed::store_le64(out.data() + 8, rows);
+    packed::store_le32(out.data() + 16, static_cast<uint32_t>(schema.size()));
+
+    for (size_t c = 0; c < schema.size(); ++c) {
+        uint8_t* entry = out.data() + columnar::kHeaderSize + c * columnar::kEntrySize;
+        packed::store_le16(entry, static_cast<uint16_t>(schema[c].type));
+        packed::store_le32(entry + 4, static_cast<uint32_t>(schema[c].name.size()));
+        packed::store_le64(entry + 8, out.size());
+        out.insert(out.end(), schema[c].name.begin(), schema[c].name.end());
+    }
+
+    for (size_t c = 0; c < schema.size(); ++c) {
+        // Entries are re-addressed on every pass, as appending moves the buffer
+        auto entry = [&] { return out.data() + columnar::kHeaderSize + c * columnar::kEntrySize; };
+        padTo(out, columnar::kAlignment);
+        packed::store_le64(entry() + 16, out.size());
+
+        if (schema[c].type != ColumnType::String) {
+            for (size_t r = 0; r < rows; ++r) {
+                const auto& record = records[r + 1];
+                const std::string_view text = source[c] < record.size() ? record[source[c]] : std::string_view{};
+                if (!appendNumeric(out, schema[c].type, text, big_endian)) {
+                    std::cerr << "resource_packer: row " << r + 1 << ", column '" << schema[c].name << "': '"
+                              << text << "' is not a valid " << resource_tools::to_string(schema[c].type) << "\n";
+                    return false;
+                }
+            }
+            continue;
+        }
+
+        // Sorted dictionary, so codes compare like the strings and lookups
+        // can binary search
+        std::vector<std::string_view> dictionary;
+        for (size_t r = 0; r < rows; ++r) {
+            const auto& record = records[r + 1];
+            dictionary.push_back(source[c] < record.size() ? std::string_view(record[source[c]]) : std::string_view{});
+        }
+        std::sort(dictionary.begin(), dictionary.end());
+        dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+        if (dictionary.size() >= UINT32_MAX) {
+            std::cerr << "resource_packer: column '" << schema[c].name << "' has too many distinct values\n";
+            return false;
+        }
+
+        for (size_t r = 0; r < rows; ++r) {
+            const auto& record = records[r + 1];
+            const std::string_view text = source[c] < record.size() ? std::string_view(record[source[c]]) : std::string_view{};
+            const auto code = std::lower_bound(dictionary.begin(), dictionary.end(), text) - dictionary.begin();
+            appendValue(out, static_cast<uint32_t>(code), big_endian);
+        }
+
+        padTo(out, columnar::kAlignment);
+        packed::store_le64(entry() + 24, dictionary.size());
+        packed::store_le64(entry() + 32, out.size());
+        uint64_t offset = 0;
+        appendValue(out, offset, big_endian);
+        for (const auto& value : dictionary) {
+            offset += value.size();
+            appendValue(out, offset, big_endian);
+        }
+        packed::store_le64(entry() + 40, out.size());
+        for (const auto& value : dictionary) {
+            out.insert(out.end(), value.begin(), value.end());
+        }
+    }
+    padTo(out, columnar::kAlignment);
+    return true;
+}
+
+auto runColumnar(const std::vector<std::string_view>& args) -> int {
+    std::string schema_spec;
+    char delimiter = ',';
+    bool big_endian = false;
+    std::string input_path;
+    std::string output_path;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--schema" && i + 1 < args.size()) {
+            schema_spec = args[++i];
+        } else if (args[i] == "--delimiter" && i + 1 < args.size()) {
+            const std::string_view name = args[++i];
+            delimiter = name == "tab" ? '\t' : name == "comma" ? ',' : name == "semicolon" ? ';' : '\0';
+        } else if (args[i] == "--big-endian") {
+            big_endian = true;
+        } else if (input_path.empty()) {
+            input_path = args[i];
+        } else if (output_path.empty()) {
+            output_path = args[i];
+        } else {
+            output_path.clear();
+            break;
+        }
+    }
+    if (schema_spec.empty() || delimiter == '\0' || input_path.empty() || output_path.empty()) {
+        std::cerr << "usage: resource_packer columnar --schema <name>:<type>[,...] [--delimiter comma|tab|semicolon]\n"
+                  << "                                [--big-endian] <input> <output>\n";
+        return 2;
+    }
+
+    std::vector<ColumnSpec> schema;
+    if (!parseSchema(schema_spec, schema)) {
+        return 2;
+    }
+
+    Bytes input;
+    if (!readFile(input_path, input)) {
+        return 1;
+    }
+    std::vector<std::vector<std::string>> records;
+    if (!parseDelimited(input, delimiter, records)) {
+        std::cerr << "resource_packer: in " << input_path << "\n";
+        return 1;
+    }
+    if (records.empty()) {
+        std::cerr << "resource_packer: " << input_path << " has no header row\n";
+        return 1;
+    }
+
+    Bytes table;
+    if (!encodeColumnar(schema, records, big_endian, table)) {
+        std::cerr << "resource_packer: in " << input_path << "\n";
+        return 1;
+    }
+
+    // Values in the target's byte order can only be read back on a host of
+    // the same order
+    if (big_endian == (std::endian::native == std::endian::big)) {
+        resource_tools::ColumnarTable check({table.data(), table.size(), resource_tools::ResourceError::Success});
+        if (!check || check.rows() != records.size() - 1 || check.columns() != schema.size()) {
+            std::cerr << "resource_packer: columnar table verification failed\n";
+            return 1;
+        }
+    }
+
+    return writeFile(output_path, table) ? 0 : 1;
+}
+
+// ============================================================================
+// TYPED ARRAYS
+// ============================================================================
+
+auto runArray(const std::vector<std::string_view>& args) -> int {
+    resource_tools::ColumnType type = resource_tools::ColumnType::String;
+    bool source_big_endian = false;
+    bool big_endian = false;
+    bool valid = true;
+    std::string input_path;
+    std::string output_path;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--element-type" && i + 1 < args.size()) {
+            valid = parseColumnType(args[++i], type) && type != resource_tools::ColumnType::String;
+        } else if (args[i] == "--source-endian" && i + 1 < args.size()) {
+            const std::string_view order = args[++i];
+            valid = valid && (order == "little" || order == "big");
+            source_big_endian = order == "big";
+        } else if (args[i] == "--big-endian") {
+            big_endian = true;
+        } else if (input_path.empty()) {
+            input_path = args[i];
+        } else if (output_path.empty()) {
+            output_path = args[i];
+        } else {
+            output_path.clear();
+            break;
+        }
+    }
+    if (!valid || type == resource_tools::ColumnType::String || input_path.empty() || output_path.empty()) {
+        std::cerr << "usage: resource_packer array --element-type <type> [--source-endian little|big]\n"
+                  << "                             [--big-endian] <input> <output>\n";
+        return 2;
+    }
+
+    Bytes data;
+    if (!readFile(input_path, data)) {
+        return 1;
+    }
+    const size_t width = resource_tools::detail::column_width(type);
+    if (data.size() % width != 0) {
+        std::cerr << "resource_packer: " << input_path << " is " << data.size() << " bytes, not a whole number of "
+                  << resource_tools::to_string(type) << " elements\n";
+        return 1;
+    }
+
+    if (source_big_endian != big_endian) {
+        for (size_t i = 0; i < data.size(); i += width) {
+            std::reverse(data.begin() + static_cast<std::ptrdiff_t>(i),
+                         data.begin() + static_cast<std::ptrdiff_t>(i + width));
+        }
+    }
+
+    return writeFile(output_path, data) ? 0 : 1;
+}
+
+// ============================================================================
+// TEXT
+// ============================================================================
+
+// Length of the well-formed UTF-8 sequence at data[i], or 0 if it is not
+// one. Overlong forms, surrogates and code points above U+10FFFF are
+// rejected, as in RFC 3629.
+auto utf8SequenceLength(const Bytes& data, size_t i) -> size_t {
+    const uint8_t lead = data[i];
+    if (lead < 0x80) {
+        return 1;
+    }
+    size_t length = 0;
+    uint8_t low = 0x80;
+    uint8_t high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        low = lead == 0xE0 ? 0xA0 : 0x80;
+        high = lead == 0xED ? 0x9F : 0xBF;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        low = lead == 0xF0 ? 0x90 : 0x80;
+        high = lead == 0xF4 ? 0x8F : 0xBF;
+    } else {
+        return 0;
+    }
+    if (data.size() - i < length || data[i + 1] < low || data[i + 1] > high) {
+        return 0;
+    }
+    for (size_t k = 2; k < length; ++k) {
+        if (data[i + k] < 0x80 || data[i + k] > 0xBF) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+// Lay out a text resource as described in <resource_tools/text_resource.h>
+auto encodeText(const Bytes& text, bool normalized) -> Bytes {
+    std::vector<uint64_t> starts{0};
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\n') {
+            starts.push_back(i + 1);
+        }
+    }
+    // A final line without a newline still counts; its end is placed where
+    // the newline would be
+    if (!text.empty() && text.back() != '\n') {
+        starts.push_back(text.size() + 1);
+    }
+    const uint64_t lines = starts.size() - 1;
+    const bool wide = starts.back() > std::numeric_limits<uint32_t>::max();
+
+    Bytes out(resource_tools::text::kHeaderSize);
+    out.insert(out.end(), text.begin(), text.end());
+    out.resize((out.size() + 7) & ~size_t{7}, 0);
+    const uint64_t index_offset = out.size();
+    for (const uint64_t start : starts) {
+        uint8_t buf[8];
+        if (wide) {
+            packed::store_le64(buf, start);
+        } else {
+            packed::store_le32(buf, static_cast<uint32_t>(start));
+        }
+        out.insert(out.end(), buf, buf + (wide ? 8 : 4));
+    }
+
+    const auto flags = static_cast<uint16_t>((normalized ? resource_tools::text::kNormalized : 0) |
+                                             (wide ? resource_tools::text::kWideIndex : 0));
+    packed::store_le32(out.data(), resource_tools::text::kMagic);
+    packed::store_le16(out.data() + 4, resource_tools::text::kVersion);
+    packed::store_le16(out.data() + 6, flags);
+    packed::store_le64(out.data() + 8, text.size());
+    packed::store_le64(out.data() + 16, lines);
+    packed::store_le64(out.data() + 24, index_offset);
+    return out;
+}
+
+auto runText(const std::vector<std::string_view>& args) -> int {
+    bool normalize = false;
+    std::string input_path;
+    std::string output_path;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--normalize-newlines") {
+            normalize = true;
+        } else if (input_path.empty()) {
+            input_path = args[i];
+        } else if (output_path.empty()) {
+            output_path = args[i];
+        } else {
+            output_path.clear();
+            break;
+        }
+    }
+    if (input_path.empty() || output_path.empty()) {
+        std::cerr << "usage: resource_packer text [--normalize-newlines] <input> <output>\n";
+        return 2;
+    }
+
+    Bytes data;
+    if (!readFile(input_path, data)) {
+        return 1;
+    }
+
+    size_t line = 1;
+    size_t line_start = 0;
+    for (size_t i = 0; i < data.size();) {
+        const size_t length = utf8SequenceLength(data, i);
+        if (length == 0) {
+            std::cerr << "resource_packer: " << input_path << ":" << line << ":" << (i - line_start + 1)
+                      << ": invalid UTF-8 at byte " << i << "\n";
+            return 1;
+        }
+        if (data[i] == '\n') {
+            ++line;
+            line_start = i + 1;
+        }
+        i += length;
+    }
+
+    // CRLF and lone CR both become LF
+    if (normalize) {
+        size_t out = 0;
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (data[i] == '\r') {
+                data[out++] = '\n';
+                if (i + 1 < data.size() && data[i + 1] == '\n') {
+                    ++i;
+                }
+            } else {
+                data[out++] = data[i];
+            }
+        }
+        data.resize(out);
+    }
+
+    return writeFile(output_path, encodeText(data, normalize)) ? 0 : 1;
+}
+
+// ============================================================================
+// STRING TABLES
+// ============================================================================
+
+auto trimSpace(std::string_view text) -> std::string_view {
+    const size_t first = text.find_first_not_of(" \t");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+}
+
+// Parse a catalog of "key = value" lines. Blank lines and lines starting
+// with '#' are skipped; values may use \n, \t, \\ and \# escapes.
+auto parseCatalog(const Bytes& input, const std::string& path,
+                  std::vector<std::pair<std::string, std::string>>& entries) -> bool {
+    const std::string_view text(reinterpret_cast<const char*>(input.data()), input.size());
+    std::unordered_map<std::string, size_t> seen;
+    size_t line_number = 0;
+    for (size_t start = 0; start < text.size();) {
+        size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        std::string_view line = text.substr(start, end - start);
+        start = end + 1;
+        ++line_number;
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        line = trimSpace(line);
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        const size_t equals = line.find('=');
+        const std::string_view key =
+            equals == std::string_view::npos ? std::string_view{} : trimSpace(line.substr(0, equals));
+        if (key.empty()) {
+            std::cerr << "resource_packer: " << path << ":" << line_number << ": expected <key> = <value>\n";
+            return false;
+        }
+        const auto [previous, inserted] = seen.emplace(std::string(key), line_number);
+        if (!inserted) {
+            std::cerr << "resource_packer: " << path << ":" << line_number << ": duplicate key '" << key
+                      << "', first defined on line " << previous->second << "\n";
+            return false;
+        }
+
+        const std::string_view raw = trimSpace(line.substr(equals + 1));
+        std::string value;
+        for (size_t i = 0; i < raw.size(); ++i) {
+            if (raw[i] != '\\') {
+                value += raw[i];
+                continue;
+            }
+            const char escaped = i + 1 < raw.size() ? raw[++i] : '\0';
+            if (escaped == 'n') {
+                value += '\n';
+            } else if (escaped == 't') {
+                value += '\t';
+            } else if (escaped == '\\' || escaped == '#') {
+                value += escaped;
+            } else {
+                std::cerr << "resource_packer: " << path << ":" << line_number << ": unknown escape in value of '"
+                          << key << "'\n";
+                return false;
+            }
+        }
+        entries.emplace_back(std::string(key), std::move(value));
+    }
+    return true;
+}
+
+// Lay out a string table as described in <resource_tools/string_table.h>
+auto encodeStringTable(const std::vector<std::pair<std::string, std::string>>& entries, Bytes& out) -> bool {
+    namespace st = resource_tools::string_table;
+    const auto count = static_cast<uint32_t>(entries.size());
+    const uint32_t buckets = std::max<uint32_t>(1, (count + 3) / 4);
+
+    // Hash and displace: place the largest buckets first, trying
+    // displacements until every key of the bucket lands in a free slot
+    std::vector<uint64_t> hashes(count);
+    std::vector<std::vector<uint32_t>> bucket_keys(buckets);
+    for (uint32_t i = 0; i < count; ++i) {
+        hashes[i] = resource_tools::keyHash(entries[i].first);
+        bucket_keys[st::bucket_of(hashes[i], buckets)].push_back(i);
+    }
+    std::vector<uint32_t> order(buckets);
+    for (uint32_t b = 0; b < buckets; ++b) {
+        order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t a, uint32_t b) { return bucket_keys[a].size() > bucket_keys[b].size(); });
+
+    constexpr uint32_t kMaxDisplacement = 1u << 24;
+    std::vector<uint32_t> displacements(buckets, 0);
+    std::vector<int64_t> slots(count, -1);
+    std::vector<uint32_t> candidate;
+    for (const uint32_t b : order) {
+        if (bucket_keys[b].empty()) {
+            break;
+        }
+        uint32_t d = 0;
+        for (; d < kMaxDisplacement; ++d) {
+            candidate.clear();
+            bool fits = true;
+            for (const uint32_t key : bucket_keys[b]) {
+                const uint32_t slot = st::slot_of(hashes[key], d, count);
+                if (slots[slot] >= 0 || std::find(candidate.begin(), candidate.end(), slot) != candidate.end()) {
+                    fits = false;
+                    break;
+                }
+                candidate.push_back(slot);
+            }
+            if (fits) {
+                break;
+            }
+        }
+        if (d == kMaxDisplacement) {
+            std::cerr << "resource_packer: no perfect hash found for " << count << " keys\n";
+            return false;
+        }
+        displacements[b] = d;
+        for (size_t k = 0; k < candidate.size(); ++k) {
+            slots[candidate[k]] = bucket_keys[b][k];
+        }
+    }
+
+    // Pool: every distinct string once, NUL-terminated
+    Bytes pool;
+    std::unordered_map<std::string, uint32_t> pooled;
+    auto intern = [&](const std::string& s) -> uint32_t {
+        const auto [it, inserted] = pooled.emplace(s, static_cast<uint32_t>(pool.size()));
+        if (inserted) {
+            pool.insert(pool.end(), s.begin(), s.end());
+            pool.push_back(0);
+        }
+        return it->second;
+    };
+
+    const uint64_t pool_offset = st::kHeaderSize + uint64_t{buckets} * 4 + uint64_t{count} * st::kEntrySize;
+    out.assign(pool_offset, 0);
+    for (uint32_t b = 0; b < buckets; ++b) {
+        packed::store_le32(out.data() + st::kHeaderSize + size_t{b} * 4, displacements[b]);
+    }
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        const auto& [key, value] = entries[static_cast<size_t>(slots[slot])];
+        uint8_t* entry = out.data() + st::kHeaderSize + size_t{buckets} * 4 + size_t{slot} * st::kEntrySize;
+        packed::store_le32(entry, intern(key));
+        packed::store_le32(entry + 4, static_cast<uint32_t>(key.size()));
+        packed::store_le32(entry + 8, intern(value));
+        packed::store_le32(entry + 12, static_cast<uint32_t>(value.size()));
+        if (pool.size() > std::numeric_limits<uint32_t>::max()) {
+            std::cerr << "resource_packer: string table is larger than 4 GB\n";
+            return false;
+        }
+    }
+    out.insert(out.end(), pool.begin(), pool.end());
+
+    packed::store_le32(out.data(), st::kMagic);
+    packed::store_le16(out.data() + 4, st::kVersion);
+    packed::store_le32(out.data() + 8, count);
+    packed::store_le32(out.data() + 12, buckets);
+    packed::store_le64(out.data() + 16, pool_offset);
+    packed::store_le64(out.data() + 24, pool.size());
+    return true;
+}
+
+auto runStringTable(const std::vector<std::string_view>& args) -> int {
+    if (args.size() != 2) {
+        std::cerr << "usage: resource_packer string-table <input> <output>\n";
+        return 2;
+    }
+    const std::string input_path(args[0]);
+
+    Bytes input;
+    if (!readFile(input_path, input)) {
+        return 1;
+    }
+    std::vector<std::pair<std::string, std::string>> entries;
+    if (!parseCatalog(input, input_path, entries)) {
+        return 1;
+    }
+    if (entries.size() > std::numeric_limits<uint32_t>::max()) {
+        std::cerr << "resource_packer: " << input_path << " has too many entries\n";
+        return 1;
+    }
+
+    Bytes table;
+    if (!encodeStringTable(entries, table)) {
+        std::cerr << "resource_packer: in " << input_path << "\n";
+        return 1;
+    }
+
+    // Every key must find its own value
+    resource_tools::StringTable check({table.data(), table.size(), resource_tools::ResourceError::Success});
+    for (const auto& [key, value] : entries) {
+        if (!check || check.find(key) != std::optional<std::string_view>(value)) {
+            std::cerr << "resource_packer: string table verification failed\n";
+            return 1;
+        }
+    }
+
+    return writeFile(std::string(args[1]), table) ? 0 : 1;
+}
+
+// ============================================================================
+// FROZEN MAPS
+// ============================================================================
+
+// Parse "key<TAB>value" lines, keeping views into the input. Blank lines are
+// skipped; the value is everything after the first tab.
+auto parseKeyValues(const Bytes& input, const std::string& path,
+                    std::vector<std::pair<std::string_view, std::string_view>>& entries) -> bool {
+    const std::string_view text(reinterpret_cast<const char*>(input.data()), input.size());
+    std::unordered_set<std::string_view> seen;
+    seen.reserve(static_cast<size_t>(std::count(input.begin(), input.end(), '\n')) + 1);
+    size_t line_number = 0;
+    for (size_t start = 0; start < text.size();) {
+        size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        std::string_view line = text.substr(start, end - start);
+        start = end + 1;
+        ++line_number;
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (line.empty()) {
+            continue;
+        }
+
+        const size_t tab = line.find('\t');
+        if (tab == std::string_view::npos) {
+            std::cerr << "resource_packer: " << path << ":" << line_number << ": expected <key><TAB><value>\n";
+            return false;
+        }
+        const std::string_view key = line.substr(0, tab);
+        if (!seen.insert(key).second) {
+            std::cerr << "resource_packer: " << path << ":" << line_number << ": duplicate key '" << key << "'\n";
+            return false;
+        }
+        entries.emplace_back(key, line.substr(tab + 1));
+    }
+    return true;
+}
+
+// Lay out a frozen map as described in <resource_tools/frozen_map.h>, with
+// buckets at most 80% full so probes rarely leave the first cache line
+auto encodeFrozenMap(const std::vector<std::pair<std::string_view, std::string_view>>& entries) -> Bytes {
+    namespace fm = resource_tools::frozen_map;
+    const uint64_t count = entries.size();
+    const uint64_t buckets = std::max<uint64_t>(1, (count * 5 + 27) / 28);
+    const uint64_t records_offset = fm::kHeaderSize + buckets * fm::kBucketSize;
+
+    Bytes out(records_offset, 0);
+    for (const auto& [key, value] : entries) {
+        const uint64_t record = out.size() - records_offset;
+        uint8_t sizes[fm::kRecordHeaderSize];
+        packed::store_le32(sizes, static_cast<uint32_t>(key.size()));
+        packed::store_le32(sizes + 4, static_cast<uint32_t>(value.size()));
+        out.insert(out.end(), sizes, sizes + fm::kRecordHeaderSize);
+        out.insert(out.end(), key.begin(), key.end());
+        out.insert(out.end(), value.begin(), value.end());
+
+        const uint64_t hash = resource_tools::keyHash(key);
+        uint64_t bucket = fm::bucket_of(hash, buckets);
+        for (;;) {
+            uint8_t* line = out.data() + fm::kHeaderSize + bucket * fm::kBucketSize;
+            const auto free_slot = std::find(line, line + fm::kSlotsPerBucket, uint8_t{0});
+            if (free_slot != line + fm::kSlotsPerBucket) {
+                const auto slot = static_cast<size_t>(free_slot - line);
+                line[slot] = fm::tag_of(hash);
+                packed::store_le64(line + 8 + slot * 8, record);
+                break;
+            }
+            bucket = bucket + 1 == buckets ? 0 : bucket + 1;
+        }
+    }
+
+    packed::store_le32(out.data(), fm::kMagic);
+    packed::store_le16(out.data() + 4, fm::kVersion);
+    packed::store_le64(out.data() + 8, count);
+    packed::store_le64(out.data() + 16, buckets);
+    packed::store_le64(out.data() + 24, records_offset);
+    packed::store_le64(out.data() + 32, out.size() - records_offset);
+    return out;
+}
+
+auto runFrozenMap(const std::vector<std::string_view>& args) -> int {
+    if (args.size() != 2) {
+        std::cerr << "usage: resource_packer frozen-map <input> <output>\n";
+        return 2;
+    }
+    const std::string input_path(args[0]);
+
+    Bytes input;
+    if (!readFile(input_path, input)) {
+        return 1;
+    }
+    std::vector<std::pair<std::string_view, std::string_view>> entries;
+    if (!parseKeyValues(input, input_path, entries)) {
+        return 1;
+    }
+    for (const auto& [key, value] : entries) {
+        if (key.size() > std::numeric_limits<uint32_t>::max() || value.size() > std::numeric_limits<uint32_t>::max()) {
+            std::cerr << "resource_packer: " << input_path << ": keys and values must be under 4 GB\n";
+            return 1;
+        }
+    }
+
+    const Bytes map = encodeFrozenMap(entries);
+
+    // Every key must find its own value
+    resource_tools::FrozenMap check({map.data(), map.size(), resource_tools::ResourceError::Success});
+    for (const auto& [key, value] : entries) {
+        if (!check || check.find(key) != std::optional<std::string_view>(value)) {
+            std::cerr << "resource_packer: frozen map verification failed\n";
+            return 1;
+        }
+    }
+
+    return writeFile(std::string(args[1]), map) ? 0 : 1;
+}
+
+// ============================================================================
+// FROZEN SETS
+// ============================================================================
+
+void appendVarint(Bytes& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Lay out a frozen set as described in <resource_tools/frozen_set.h>. The
+// words must be sorted and distinct.
+auto encodeFrozenSet(const std::vector<std::string_view>& words, uint64_t bloom_bits) -> Bytes {
+    namespace fs = resource_tools::frozen_set;
+    const uint64_t count = words.size();
+    const uint64_t restarts = (count + fs::kRestartInterval - 1) / fs::kRestartInterval;
+    const uint64_t filter_blocks =
+        bloom_bits == 0 ? 0 : std::max<uint64_t>(1, (count * bloom_bits + 255) / 256);
+
+    Bytes filter(filter_blocks * fs::kFilterBlockSize, 0);
+    Bytes index;
+    Bytes data;
+    std::string_view previous;
+    for (uint64_t i = 0; i < count; ++i) {
+        const std::string_view word = words[i];
+        size_t shared = 0;
+        if (i % fs::kRestartInterval == 0) {
+            appendLe64(index, data.size());
+        } else {
+            const size_t limit = std::min(previous.size(), word.size());
+            while (shared < limit && previous[shared] == word[shared]) {
+                ++shared;
+            }
+        }
+        appendVarint(data, static_cast<uint32_t>(shared));
+        appendVarint(data, static_cast<uint32_t>(word.size() - shared));
+        data.insert(data.end(), word.begin() + static_cast<std::ptrdiff_t>(shared), word.end());
+        previous = word;
+
+        if (filter_blocks > 0) {
+            const uint64_t hash = resource_tools::keyHash(word);
+            uint32_t masks[8];
+            fs::filter_masks(hash, masks);
+            uint8_t* block = filter.data() + fs::filter_block_of(hash, filter_blocks) * fs::kFilterBlockSize;
+            for (int w = 0; w < 8; ++w) {
+                packed::store_le32(block + w * 4, packed::load_le32(block + w * 4) | masks[w]);
+            }
+        }
+    }
+
+    Bytes out(fs::kHeaderSize, 0);
+    const uint64_t index_offset = fs::kHeaderSize + filter.size();
+    const uint64_t data_offset = index_offset + index.size();
+    packed::store_le32(out.data(), fs::kMagic);
+    packed::store_le16(out.data() + 4, fs::kVersion);
+    packed::store_le64(out.data() + 8, count);
+    packed::store_le64(out.data() + 16, restarts);
+    packed::store_le32(out.data() + 24, fs::kRestartInterval);
+    packed::store_le64(out.data() + 32, filter_blocks);
+    packed::store_le64(out.data() + 40, index_offset);
+    packed::store_le64(out.data() + 48, data_offset);
+    packed::store_le64(out.data() + 56, data.size());
+    out.insert(out.end(), filter.begin(), filter.end());
+    out.insert(out.end(), index.begin(), index.end());
+    out.insert(out.end(), data.begin(), data.end());
+    return out;
+}
+
+auto runSet(const std::vector<std::string_view>& args) -> int {
+    uint64_t bloom_bits = 0;
+    std::vector<std::string> paths;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--bloom-bits" && i + 1 < args.size()) {
+            bloom_bits = std::strtoull(std::string(args[++i]).c_str(), nullptr, 10);
+        } else {
+            paths.emplace_back(args[i]);
+        }
+    }
+    if (paths.size() != 2 || bloom_bits > 64) {
+        std::cerr << "usage: resource_packer set [--bloom-bits <bits per entry>] <input> <output>\n";
+        return 2;
+    }
+
+    Bytes input;
+    if (!readFile(paths[0], input)) {
+        return 1;
+    }
+
+    // One entry per line; surrounding spaces, blank lines and '#' comments
+    // are dropped, and repeats are merged
+    const std::string_view text(reinterpret_cast<const char*>(input.data()), input.size());
+    std::vector<std::string_view> words;
+    for (size_t start = 0; start < text.size();) {
+        size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        std::string_view line = text.substr(start, end - start);
+        start = end + 1;
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        line = trimSpace(line);
+        if (!line.empty() && line.front() != '#') {
+            words.push_back(line);
+        }
+    }
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    for (const std::string_view word : words) {
+        if (word.size() > std::numeric_limits<uint32_t>::max()) {
+            std::cerr << "resource_packer: " << paths[0] << ": entries must be under 4 GB\n";
+            return 1;
+        }
+    }
+
+    const Bytes set = encodeFrozenSet(words, bloom_bits);
+
+    // Every word must be found
+    resource_tools::FrozenSet check({set.data(), set.size(), resource_tools::ResourceError::Success});
+    for (const std::string_view word : words) {
+        if (!check || !check.contains(word)) {
+            std::cerr << "resource_packer: set verification failed\n";
+            return 1;
+        }
+    }
+
+    return writeFile(paths[1], set) ? 0 : 1;
+}
+
+// ============================================================================
+// ARCHIVES
+// ============================================================================
+
+constexpr size_t kTarBlockSize = 512;
+
+struct TarMember {
+    size_t offset;
+    size_t size;
+};
+
+// Octal, or base-256 when the top bit of the first byte is set (GNU)
+auto tarNumber(const uint8_t* field, size_t width, uint64_t& value) -> bool {
+    value = 0;
+    if (field[0] & 0x80) {
+        value = field[0] & 0x7F;
+        for (size_t i = 1; i < width; ++i) {
+            if (value >> 55 != 0) {
+                return false;
+            }
+            value = (value << 8) | field[i];
+        }
+        return true;
+    }
+    size_t i = 0;
+    while (i < width && field[i] == ' ') {
+        ++i;
+    }
+    for (; i < width && field[i] != 0 && field[i] != ' '; ++i) {
+        if (field[i] < '0' || field[i] > '7' || value >> 61 != 0) {
+            return false;
+        }
+        value = (value << 3) | static_cast<uint64_t>(field[i] - '0');
+    }
+    return true;
+}
+
+auto tarString(const uint8_t* field, size_t width) -> std::string {
+    const auto* text = reinterpret_cast<const char*>(field);
+    return {text, std::find(text, text + width, '\0')};
+}
+
+// The path and size records of a pax extended header, each record being
+// "<length> <key>=<value>\n"
+auto parsePax(std::string_view records, std::string& path, std::optional<uint64_t>& size) -> bool {
+    while (!records.empty()) {
+        size_t length = 0;
+        const auto [end, error] = std::from_chars(records.data(), records.data() + records.size(), length);
+        if (error != std::errc() || length == 0 || length > records.size()) {
+            return false;
+        }
+        const std::string_view record = records.substr(0, length);
+        records.remove_prefix(length);
+        const size_t space = record.find(' ');
+        const size_t equals = record.find('=');
+        if (space == std::string_view::npos || equals == std::string_view::npos || equals < space ||
+            record.back() != '\n') {
+            return false;
+        }
+        const std::string_view key = record.substr(space + 1, equals - space - 1);
+        const std::string_view value = record.substr(equals + 1, record.size() - equals - 2);
+        if (key == "path") {
+            path = value;
+        } else if (key == "size") {
+            uint64_t parsed = 0;
+            const auto [value_end, value_error] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+            if (value_error != std::errc() || value_end != value.data() + value.size()) {
+                return false;
+            }
+            size = parsed;
+        }
+    }
+    return true;
+}
+
+// Regular files of a ustar, GNU or pax tar by path. A path that appears
+// twice keeps its last contents, as extracting would.
+auto parseTar(const Bytes& tar, const std::string& path, std::map<std::string, TarMember>& members) -> bool {
+    std::string next_name;                // From a GNU long name or pax header
+    std::optional<uint64_t> next_size;    // From a pax header
+    size_t pos = 0;
+    while (true) {
+        if (pos == tar.size()) {
+            break;
+        }
+        if (tar.size() - pos < kTarBlockSize) {
+            std::cerr << "resource_packer: " << path << ": truncated tar header at byte " << pos << "\n";
+            return false;
+        }
+        const uint8_t* header = tar.data() + pos;
+        if (std::all_of(header, header + kTarBlockSize, [](uint8_t byte) { return byte == 0; })) {
+            break;
+        }
+
+        uint64_t checksum = 0;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < kTarBlockSize; ++i) {
+            sum += (i >= 148 && i < 156) ? uint8_t{' '} : header[i];
+        }
+        uint64_t size = 0;
+        if (!tarNumber(header + 148, 8, checksum) || checksum != sum || !tarNumber(header + 124, 12, size)) {
+            std::cerr << "resource_packer: " << path << ": invalid tar header at byte " << pos << "\n";
+            return false;
+        }
+        if (next_size) {
+            size = *next_size;
+        }
+        const size_t data = pos + kTarBlockSize;
+        if (size > tar.size() - data) {
+            std::cerr << "resource_packer: " << path << ": tar member at byte " << pos << " is truncated\n";
+            return false;
+        }
+        const std::string_view content(reinterpret_cast<const char*>(tar.data() + data), static_cast<size_t>(size));
+        pos = data + static_cast<size_t>((size + kTarBlockSize - 1) / kTarBlockSize * kTarBlockSize);
+        pos = std::min(pos, tar.size());
+
+        const char type = static_cast<char>(header[156]);
+        if (type == 'L') {
+            next_name = content.substr(0, content.find('\0'));
+            continue;
+        }
+        if (type == 'x') {
+            if (!parsePax(content, next_name, next_size)) {
+                std::cerr << "resource_packer: " << path << ": invalid pax header at byte " << data - kTarBlockSize
+                          << "\n";
+                return false;
+            }
+            continue;
+        }
+        if (type == 'g' || type == 'K') {
+            // Global pax defaults and long link targets name no member
+            continue;
+        }
+
+        std::string name = next_name;
+        if (name.empty()) {
+            name = tarString(header, 100);
+            if (std::memcmp(header + 257, "ustar", 6) == 0 && header[345] != 0) {
+                name = tarString(header + 345, 155) + "/" + name;
+            }
+        }
+        next_name.clear();
+        next_size.reset();
+
+        // Directories, links and devices are not members
+        if (type != '0' && type != '\0' && type != '7') {
+            continue;
+        }
+        while (name.starts_with("./")) {
+            name.erase(0, 2);
+        }
+        if (name.empty()) {
+            std::cerr << "resource_packer: " << path << ": tar member at byte " << data - kTarBlockSize
+                      << " has no name\n";
+            return false;
+        }
+        members[name] = {data, static_cast<size_t>(size)};
+    }
+    return true;
+}
+
+// Regular files of a tar that CMake extracted to `dir`, in the order
+// `cmake -E tar tf` listed them in `listing`, read end to end into
+// `contents`. Symlinks are not members, and neither is a hard link to an
+// earlier member or to a file outside the tree, so a compressed tar has the
+// members parseTar() finds in the same tar uncompressed.
+auto readTree(const std::string& dir, const std::string& listing, Bytes& contents,
+              std::map<std::string, TarMember>& members) -> bool {
+    namespace fs = std::filesystem;
+    Bytes lines;
+    if (!readFile(listing, lines)) {
+        return false;
+    }
+
+    struct File {
+        std::string name;
+        fs::path path;
+        uintmax_t links;
+    };
+    std::vector<File> files;
+    std::unordered_set<std::string> seen;
+    std::string_view rest(reinterpret_cast<const char*>(lines.data()), lines.size());
+    while (!rest.empty()) {
+        const size_t end = std::min(rest.find('\n'), rest.size());
+        std::string name(rest.substr(0, end));
+        rest.remove_prefix(std::min(end + 1, rest.size()));
+        while (name.starts_with("./")) {
+            name.erase(0, 2);
+        }
+        if (name.empty() || name.ends_with('/') || !seen.insert(name).second) {
+            continue;
+        }
+        // Directories, links and entries that were not extracted are skipped
+        const fs::path path = fs::path(dir) / name;
+        std::error_code error;
+        if (!fs::is_regular_file(fs::symlink_status(path, error))) {
+            continue;
+        }
+        const uintmax_t links = fs::hard_link_count(path, error);
+        if (error) {
+            std::cerr << "resource_packer: cannot inspect " << path.string() << "\n";
+            return false;
+        }
+        files.push_back({std::move(name), path, links});
+    }
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (files[i].links > 1) {
+            // Hard links are rare; keep the first of each set, and only if
+            // every link to it is in the archive
+            uintmax_t listed = 0;
+            bool first = true;
+            for (size_t j = 0; j < files.size(); ++j) {
+                std::error_code error;
+                if (files[j].links > 1 && fs::equivalent(files[j].path, files[i].path, error)) {
+                    ++listed;
+                    first = first && j >= i;
+                }
+            }
+            if (!first || listed != files[i].links) {
+                continue;
+            }
+        }
+        Bytes data;
+        if (!readFile(files[i].path.string(), data)) {
+            return false;
+        }
+        members[files[i].name] = {contents.size(), data.size()};
+        contents.insert(contents.end(), data.begin(), data.end());
+    }
+    return true;
+}
+
+// Lay out an archive as described in <resource_tools/archive_resource.h>,
+// storing each member as a packed container if `compress` is set
+auto encodeArchive(const Bytes& tar, const std::map<std::string, TarMember>& members, bool compress) -> Bytes {
+    namespace ar = resource_tools::archive;
+    Bytes index;
+    Bytes names;
+    Bytes data;
+    for (const auto& [name, member] : members) {
+        data.resize((data.size() + ar::kDataAlignment - 1) / ar::kDataAlignment * ar::kDataAlignment, 0);
+        const auto first = tar.begin() + static_cast<std::ptrdiff_t>(member.offset);
+        Bytes stored(first, first + static_cast<std::ptrdiff_t>(member.size));
+        if (compress) {
+            Bytes container = encodeLz(stored);
+            if (container.size() >= stored.size() + packed::kHeaderSize) {
+                container = makeContainer(packed::Encoding::Stored, stored, stored);
+            }
+            stored = std::move(container);
+        }
+
+        uint8_t entry[ar::kEntrySize];
+        packed::store_le32(entry, static_cast<uint32_t>(names.size()));
+        packed::store_le32(entry + 4, static_cast<uint32_t>(name.size()));
+        packed::store_le64(entry + 8, data.size());
+        packed::store_le64(entry + 16, stored.size());
+        packed::store_le64(entry + 24, member.size);
+        index.insert(index.end(), entry, entry + ar::kEntrySize);
+        names.insert(names.end(), name.begin(), name.end());
+        names.push_back(0);
+        data.insert(data.end(), stored.begin(), stored.end());
+    }
+
+    const uint64_t names_offset = ar::kHeaderSize + index.size();
+    const uint64_t data_offset =
+        (names_offset + names.size() + ar::kDataAlignment - 1) / ar::kDataAlignment * ar::kDataAlignment;
+    Bytes out(ar::kHeaderSize, 0);
+    packed::store_le32(out.data(), ar::kMagic);
+    packed::store_le16(out.data() + 4, ar::kVersion);
+    packed::store_le16(out.data() + 6, compress ? ar::kCompressed : 0);
+    packed::store_le64(out.data() + 8, members.size());
+    packed::store_le64(out.data() + 16, ar::kHeaderSize);
+    packed::store_le64(out.data() + 24, names_offset);
+    packed::store_le64(out.data() + 32, names.size());
+    packed::store_le64(out.data() + 40, data_offset);
+    packed::store_le64(out.data() + 48, data.size());
+    out.insert(out.end(), index.begin(), index.end());
+    out.insert(out.end(), names.begin(), names.end());
+    out.resize(data_offset, 0);
+    out.insert(out.end(), data.begin(), data.end());
+    return out;
+}
+
+// Index a plain tar. Compressed tars are extracted by CMake before they get
+// here (see archive_resource.cmake) and read back with --tree, and
+// --compress then recompresses each member on its own so it can be decoded
+// without the others.
+auto runArchive(const std::vector<std::string_view>& args) -> int {
+    bool compress = false;
+    std::string tree;
+    std::string path;
+    std::string output_path;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--compress") {
+            compress = true;
+        } else if (args[i] == "--tree" && i + 1 < args.size()) {
+            tree = args[++i];
+        } else if (path.empty()) {
+            path = args[i];
+        } else if (output_path.empty()) {
+            output_path = args[i];
+        } else {
+            output_path.clear();
+            break;
+        }
+    }
+    if (path.empty() || output_path.empty()) {
+        std::cerr << "usage: resource_packer archive [--compress] <input> <output>\n"
+                  << "       resource_packer archive [--compress] --tree <dir> <listing> <output>\n";
+        return 2;
+    }
+
+    // The tar itself, or with --tree the extracted files end to end
+    Bytes tar;
+    std::map<std::string, TarMember> members;
+    if (!tree.empty()) {
+        if (!readTree(tree, path, tar, members)) {
+            return 1;
+        }
+    } else {
+        if (!readFile(path, tar)) {
+            return 1;
+        }
+        if ((tar.size() >= 2 && tar[0] == 0x1F && tar[1] == 0x8B) ||
+            (tar.size() >= 4 && std::memcmp(tar.data(), "\x28\xB5\x2F\xFD", 4) == 0) ||
+            (tar.size() >= 6 && std::memcmp(tar.data(), "\xFD" "7zXZ\0", 6) == 0) ||
+            (tar.size() >= 3 && std::memcmp(tar.data(), "BZh", 3) == 0)) {
+            std::cerr << "resource_packer: " << path << ": compressed tar files must be decompressed first\n";
+            return 1;
+        }
+        if (!parseTar(tar, path, members)) {
+            return 1;
+        }
+    }
+    uint64_t name_bytes = 0;
+    for (const auto& [name, member] : members) {
+        name_bytes += name.size() + 1;
+    }
+    if (name_bytes > std::numeric_limits<uint32_t>::max()) {
+        std::cerr << "resource_packer: " << path << ": member names must total under 4 GB\n";
+        return 1;
+    }
+
+    const Bytes archive = encodeArchive(tar, members, compress);
+
+    // Every member must read back as it is in the tar
+    resource_tools::ArchiveResource check({archive.data(), archive.size(), resource_tools::ResourceError::Success});
+    for (const auto& [name, member] : members) {
+        const auto entry = check.find(name);
+        if (!entry || entry.size != member.size ||
+            (member.size > 0 && std::memcmp(entry.data, tar.data() + member.offset, member.size) != 0)) {
+            std::cerr << "resource_packer: archive verification failed\n";
+            return 1;
+        }
+    }
+
+    return writeFile(output_path, archive) ? 0 : 1;
+}
+
+// ============================================================================
+// BINARY JSON
+// ============================================================================
+
+constexpr size_t kJsonMaxDepth = 512;
+
+// Recursive-descent parser for RFC 8259 JSON that writes each value's
+// record as soon as the value is complete, so children always come before
+// their parents. Laid out as described in <resource_tools/binary_json.h>.
+class JsonEncoder {
+public:
+    JsonEncoder(const Bytes& text, std::string path)
+        : text_(text), path_(std::move(path)), out_(resource_tools::binary_json::kHeaderSize, 0) {}
+
+    auto encode(Bytes& out) -> bool {
+        // A UTF-8 byte order mark is allowed and dropped
+        if (text_.size() >= 3 && text_[0] == 0xEF && text_[1] == 0xBB && text_[2] == 0xBF) {
+            pos_ = 3;
+        }
+        skipSpace();
+        uint64_t root = 0;
+        if (!value(root, 0)) {
+            return false;
+        }
+        skipSpace();
+        if (pos_ != text_.size()) {
+            return fail("unexpected content after the document");
+        }
+
+        align();
+        packed::store_le32(out_.data(), resource_tools::binary_json::kMagic);
+        packed::store_le16(out_.data() + 4, resource_tools::binary_json::kVersion);
+        packed::store_le64(out_.data() + 8, root);
+        packed::store_le64(out_.data() + 16, out_.size());
+        out = std::move(out_);
+        return true;
+    }
+
+private:
+    using JsonType = resource_tools::JsonType;
+
+    auto fail(std::string_view message) -> bool {
+        size_t line = 1;
+        size_t line_start = 0;
+        for (size_t i = 0; i < pos_ && i < text_.size(); ++i) {
+            if (text_[i] == '\n') {
+                ++line;
+                line_start = i + 1;
+            }
+        }
+        std::cerr << "resource_packer: " << path_ << ":" << line << ":" << (pos_ - line_start + 1) << ": " << message
+                  << "\n";
+        return false;
+    }
+
+    auto peek(char c) const -> bool { return pos_ < text_.size() && text_[pos_] == static_cast<uint8_t>(c); }
+
+    void skipSpace() {
+        while (pos_ < text_.size() &&
+               (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r')) {
+            ++pos_;
+        }
+    }
+
+    void align() { out_.resize((out_.size() + 7) & ~size_t{7}, 0); }
+
+    auto reference(uint64_t offset, JsonType type) -> uint64_t { return offset | static_cast<uint64_t>(type); }
+
+    auto value(uint64_t& ref, size_t depth) -> bool {
+        if (pos_ == text_.size()) {
+            return fail("unexpected end of document");
+        }
+        switch (text_[pos_]) {
+            case '{': return object(ref, depth);
+            case '[': return array(ref, depth);
+            case '"': {
+                std::string text;
+                if (!string(text)) {
+                    return false;
+                }
+                ref = intern(text);
+                return true;
+            }
+            case 't': return literal("true", JsonType::True, ref);
+            case 'f': return literal("false", JsonType::False, ref);
+            case 'n': return literal("null", JsonType::Null, ref);
+            default: return number(ref);
+        }
+    }
+
+    auto literal(std::string_view word, JsonType type, uint64_t& ref) -> bool {
+        if (text_.size() - pos_ < word.size() || std::memcmp(text_.data() + pos_, word.data(), word.size()) != 0) {
+            return fail("invalid literal");
+        }
+        pos_ += word.size();
+        ref = static_cast<uint64_t>(type) << 3 | resource_tools::binary_json::kConstantTag;
+        return true;
+    }
+
+    auto number(uint64_t& ref) -> bool {
+        const size_t start = pos_;
+        auto digits = [&] {
+            const size_t first = pos_;
+            while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+                ++pos_;
+            }
+            return pos_ > first;
+        };
+
+        bool integral = true;
+        if (peek('-')) {
+            ++pos_;
+        }
+        if (peek('0')) {
+            ++pos_;
+            if (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+                return fail("leading zeros are not allowed");
+            }
+        } else if (!digits()) {
+            pos_ = start;
+            return fail("expected a value");
+        }
+        if (peek('.')) {
+            ++pos_;
+            integral = false;
+            if (!digits()) {
+                return fail("expected digits after '.'");
+            }
+        }
+        if (peek('e') || peek('E')) {
+            ++pos_;
+            integral = false;
+            if (peek('+') || peek('-')) {
+                ++pos_;
+            }
+            if (!digits()) {
+                return fail("expected digits in exponent");
+            }
+        }
+
+        const char* first = reinterpret_cast<const char*>(text_.data() + start);
+        const char* last = reinterpret_cast<const char*>(text_.data() + pos_);
+        align();
+        const uint64_t offset = out_.size();
+        if (integral) {
+            int64_t parsed = 0;
+            if (std::from_chars(first, last, parsed).ec == std::errc()) {
+                // Most integers fit in the reference and need no record
+                if (parsed >= resource_tools::binary_json::kInlineIntMin &&
+                    parsed <= resource_tools::binary_json::kInlineIntMax) {
+                    ref = static_cast<uint64_t>(parsed) << 3 | resource_tools::binary_json::kInlineIntTag;
+                    return true;
+                }
+                appendLe64(out_, static_cast<uint64_t>(parsed));
+                ref = reference(offset, JsonType::Int);
+                return true;
+            }
+        }
+        double parsed = 0.0;
+        if (std::from_chars(first, last, parsed).ec != std::errc()) {
+            pos_ = start;
+            return fail("number out of range");
+        }
+        appendLe64(out_, std::bit_cast<uint64_t>(parsed));
+        ref = reference(offset, JsonType::Double);
+        return true;
+    }
+
+    auto hex4(uint32_t& code) -> bool {
+        if (text_.size() - pos_ < 4) {
+            return false;
+        }
+        code = 0;
+        for (int i = 0; i < 4; ++i) {
+            const uint8_t c = text_[pos_++];
+            const int digit = (c >= '0' && c <= '9')   ? c - '0'
+                              : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+                              : (c >= 'A' && c <= 'F') ? c - 'A' + 10
+                                                       : -1;
+            if (digit < 0) {
+                return false;
+            }
+            code = (code << 4) | static_cast<uint32_t>(digit);
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    auto string(std::string& out) -> bool {
+        ++pos_;
+        while (true) {
+            if (pos_ == text_.size()) {
+                return fail("unterminated string");
+            }
+            const uint8_t c = text_[pos_];
+            if (c == '"') {
+                ++pos_;
+                return true;
+            }
+            if (c < 0x20) {
+                return fail("control character in string");
+            }
+            if (c >= 0x80) {
+                const size_t length = utf8SequenceLength(text_, pos_);
+                if (length == 0) {
+                    return fail("invalid UTF-8");
+                }
+                out.append(reinterpret_cast<const char*>(text_.data() + pos_), length);
+                pos_ += length;
+                continue;
+            }
+            ++pos_;
+            if (c != '\\') {
+                out += static_cast<char>(c);
+                continue;
+            }
+
+            if (pos_ == text_.size()) {
+                return fail("unterminated string");
+            }
+            const uint8_t escape = text_[pos_++];
+            switch (escape) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t code = 0;
+                    if (!hex4(code)) {
+                        return fail("invalid \\u escape");
+                    }
+                    if (code >= 0xDC00 && code <= 0xDFFF) {
+                        return fail("unpaired surrogate in \\u escape");
+                    }
+                    if (code >= 0xD800 && code <= 0xDBFF) {
+                        uint32_t low = 0;
+                        if (!peek('\\') || text_.size() - pos_ < 2 || text_[pos_ + 1] != 'u') {
+                            return fail("unpaired surrogate in \\u escape");
+                        }
+                        pos_ += 2;
+                        if (!hex4(low) || low < 0xDC00 || low > 0xDFFF) {
+                            return fail("unpaired surrogate in \\u escape");
+                        }
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default: pos_ -= 1; return fail("invalid escape");
+            }
+        }
+    }
+
+    // Every distinct string is written once
+    auto intern(const std::string& text) -> uint64_t {
+        const auto found = strings_.find(text);
+        if (found != strings_.end()) {
+            return found->second;
+        }
+        align();
+        const uint64_t ref = reference(out_.size(), JsonType::String);
+        appendLe64(out_, text.size());
+        out_.insert(out_.end(), text.begin(), text.end());
+        out_.push_back(0);
+        strings_.emplace(text, ref);
+        return ref;
+    }
+
+    auto array(uint64_t& ref, size_t depth) -> bool {
+        if (depth == kJsonMaxDepth) {
+            return fail("nested deeper than 512 levels");
+        }
+        ++pos_;
+        std::vector<uint64_t> elements;
+        skipSpace();
+        if (peek(']')) {
+            ++pos_;
+        } else {
+            while (true) {
+                skipSpace();
+                uint64_t element = 0;
+                if (!value(element, depth + 1)) {
+                    return false;
+                }
+                elements.push_back(element);
+                skipSpace();
+                if (peek(',')) {
+                    ++pos_;
+                } else if (peek(']')) {
+                    ++pos_;
+                    break;
+                } else {
+                    return fail("expected ',' or ']'");
+                }
+            }
+        }
+
+        align();
+        ref = reference(out_.size(), JsonType::Array);
+        appendLe64(out_, elements.size());
+        for (const uint64_t element : elements) {
+            appendLe64(out_, element);
+        }
+        return true;
+    }
+
+    auto object(uint64_t& ref, size_t depth) -> bool {
+        if (depth == kJsonMaxDepth) {
+            return fail("nested deeper than 512 levels");
+        }
+        ++pos_;
+        std::vector<std::string> keys;
+        std::vector<size_t> key_positions;
+        std::vector<uint64_t> members;
+        skipSpace();
+        if (peek('}')) {
+            ++pos_;
+        } else {
+            while (true) {
+                skipSpace();
+                if (!peek('"')) {
+                    return fail("expected a string key");
+                }
+                key_positions.push_back(pos_);
+                std::string key;
+                if (!string(key)) {
+                    return false;
+                }
+                skipSpace();
+                if (!peek(':')) {
+                    return fail("expected ':'");
+                }
+                ++pos_;
+                skipSpace();
+                uint64_t member = 0;
+                if (!value(member, depth + 1)) {
+                    return false;
+                }
+                members.push_back(intern(key));
+                members.push_back(member);
+                keys.push_back(std::move(key));
+                skipSpace();
+                if (peek(',')) {
+                    ++pos_;
+                } else if (peek('}')) {
+                    ++pos_;
+                    break;
+                } else {
+                    return fail("expected ',' or '}'");
+                }
+            }
+        }
+        if (keys.size() > std::numeric_limits<uint32_t>::max()) {
+            return fail("object has too many members");
+        }
+
+        // Lookups binary-search the keys, so they must be distinct
+        std::vector<uint32_t> sorted(keys.size());
+        for (uint32_t i = 0; i < sorted.size(); ++i) {
+            sorted[i] = i;
+        }
+        std::stable_sort(sorted.begin(), sorted.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+        for (size_t i = 1; i < sorted.size(); ++i) {
+            if (keys[sorted[i - 1]] == keys[sorted[i]]) {
+                pos_ = key_positions[sorted[i]];
+                return fail("duplicate key \"" + keys[sorted[i]] + "\"");
+            }
+        }
+
+        align();
+        ref = reference(out_.size(), JsonType::Object);
+        appendLe64(out_, keys.size());
+        for (const uint64_t member : members) {
+            appendLe64(out_, member);
+        }
+        for (const uint32_t index : sorted) {
+            uint8_t buf[4];
+            packed::store_le32(buf, index);
+            out_.insert(out_.end(), buf, buf + 4);
+        }
+        return true;
+    }
+
+    const Bytes& text_;
+    std::string path_;
+    Bytes out_;
+    size_t pos_ = 0;
+    std::unordered_map<std::string, uint64_t> strings_;
+};
+
+// Visit every value, checking each member is also found by key
+auto verifyJson(const resource_tools::JsonValue& value, size_t depth = 0) -> bool {
+    if (!value || depth > kJsonMaxDepth) {
+        return false;
+    }
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value.is_array() && !verifyJson(value[i], depth + 1)) {
+            return false;
+        }
+        if (value.is_object() && (!verifyJson(value.value(i), depth + 1) || !value[value.key(i)] ||
+                                  value[value.key(i)].type() != value.value(i).type())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto runJson(const std::vector<std::string_view>& args) -> int {
+    if (args.size() != 2) {
+        std::cerr << "usage: resource_packer json <input> <output>\n";
+        return 2;
+    }
+
+    Bytes input;
+    if (!readFile(std::string(args[0]), input)) {
+        return 1;
+    }
+
+    Bytes document;
+    if (!JsonEncoder(input, std::string(args[0])).encode(document)) {
+        return 1;
+    }
+
+    resource_tools::JsonDocument check({document.data(), document.size(), resource_tools::ResourceError::Success});
+    if (!check || !verifyJson(check.root())) {
+        std::cerr << "resource_packer: binary JSON verification failed\n";
+        return 1;
+    }
+
+    return writeFile(std::string(args[1]), document) ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: resource_packer <command> [args...]\n"
+                  << "commands: sparse, chunk, delta, compress, store, http, columnar, array, text, string-table,\n"
+                  << "          frozen-map, set, archive, json\n";
+        return 2;
+    }
+
+    std::string_view command = argv[1];
+    std::vector<std::string_view> args(argv + 2, argv + argc);
+
+    if (command == "sparse") {
+        return runSparse(args);
+    }
+    if (command == "chunk") {
+        return runChunk(args);
+    }
+    if (command == "delta") {
+        return runDelta(args);
+    }
+    if (command == "compress") {
+        return runCompress(args);
+    }
+    if (command == "store") {
+        return runStore(args);
+    }
+    if (command == "http") {
+        return runHttp(args);
+    }
+    if (command == "columnar") {
+        return runColumnar(args);
+    }
+    if (command == "array") {
+        return runArray(args);
+    }
+    if (command == "text") {
+        return runText(args);
+    }
+    if (command == "string-table") {
+        return runStringTable(args);
+    }
+    if (command == "frozen-map") {
+        return runFrozenMap(args);
+    }
+    if (command == "set") {
+        return runSet(args);
+    }
+    if (command == "archive") {
+        return runArchive(args);
+    }
+    if (command == "json") {
+        return runJson(args);
+    }
+
+    std::cerr << "resource_packer: unknown command '" << command << "'\n";
+    return 2;
+}
@@ -0,0 +1,143 @@
+# transform_resource.cmake
+# Build-time step of embed_resources(TRANSFORM): runs one transform command
+# on one resource, or reuses its output from the transform cache when the
+# same transform has already been applied to the same content.
+#
+# Usage:
+#   cmake -DINPUT=<file> -DOUTPUT=<file> -DCACHE_DIR=<dir>
+#         -P transform_resource.cmake -- <command> [<arg>...]
+#
+# @INPUT@ and @OUTPUT@ in the command are replaced by the input and output
+# paths. A command without @INPUT@ reads the input on stdin, and one without
+# @OUTPUT@ writes the output to stdout.
+#
+# Cache entries are named after the SHA-256 of the input's content and the
+# transform's identity: the CMake version and the command line, with every
+# file it names, the program included, replaced by the file's content hash.
+# Editing a transform script or upgrading the tool therefore misses the
+# cache, while touching or checking out an unchanged input, or building in
+# a fresh tree at another path, does not.
+#
+# A transform that exits successfully but writes nothing fails the build,
+# as embedding an empty file would.
+
+# Without policies, "@INPUT@" in a quoted argument would expand as a variable
+cmake_minimum_required(VERSION 3.20)
+
+if(NOT INPUT OR NOT OUTPUT OR NOT CACHE_DIR)
+    message(FATAL_ERROR "transform_resource: INPUT, OUTPUT and CACHE_DIR are required")
+endif()
+
+# The command is everything after "--"
+set(Command "")
+set(InCommand FALSE)
+math(EXPR LastArg "${CMAKE_ARGC} - 1")
+foreach(Index RANGE ${LastArg})
+    if(InCommand)
+        list(APPEND Command "${CMAKE_ARGV${Index}}")
+    elseif(CMAKE_ARGV${Index} STREQUAL "--")
+        set(InCommand TRUE)
+    endif()
+endforeach()
+
+if(NOT Command)
+    message(FATAL_ERROR "transform_resource: No command given after --")
+endif()
+
+# TRANSFORM IDENTITY
+list(GET Command 0 Program)
+if(NOT IS_ABSOLUTE "${Program}")
+    find_program(ProgramPath "${Program}" NO_CACHE)
+    if(ProgramPath)
+        set(Program "${ProgramPath}")
+    endif()
+endif()
+
+# Files stand for their content rather than their path, so the build tree,
+# the tool's install prefix and the checkout location do not matter
+set(Identity "resource_tools transform v2\ncmake ${CMAKE_VERSION}\n")
+set(WordIndex 0)
+foreach(Word IN LISTS Command)
+    if(WordIndex EQUAL 0)
+        set(WordPath "${Program}")
+    else()
+        get_filename_component(WordPath "${Word}" ABSOLUTE)
+    endif()
+    math(EXPR WordIndex "${WordIndex} + 1")
+    if(NOT Word STREQUAL "" AND EXISTS "${WordPath}" AND NOT IS_DIRECTORY "${WordPath}")
+        file(SHA256 "${WordPath}" WordHash)
+        string(APPEND Identity "file ${WordHash}\n")
+    else()
+        string(APPEND Identity "word ${Word}\n")
+    endif()
+endforeach()
+
+file(SHA256 "${INPUT}" InputHash)
+string(SHA256 Key "${Identity}${InputHash}")
+set(CachedFile "${CACHE_DIR}/${Key}")
+
+# CACHE HIT
+if(EXISTS "${CachedFile}")
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} -E copy "${CachedFile}" "${OUTPUT}"
+        RESULT_VARIABLE Result)
+    if(Result EQUAL 0)
+        # Newer than the input, so the build sees the step as done
+        file(TOUCH "${OUTPUT}")
+        return()
+    endif()
+endif()
+
+# CACHE MISS - run the command into a partial file, so a failed run never
+# leaves an output that looks up to date
+set(Partial "${OUTPUT}.partial")
+file(REMOVE "${Partial}")
+string(REPLACE "@INPUT@" "${INPUT}" Expanded "${Command}")
+string(REPLACE "@OUTPUT@" "${Partial}" Expanded "${Expanded}")
+
+set(ProcessOptions "")
+if(NOT Command MATCHES "@INPUT@")
+    list(APPEND ProcessOptions INPUT_FILE "${INPUT}")
+endif()
+if(NOT Command MATCHES "@OUTPUT@")
+    list(APPEND ProcessOptions OUTPUT_FILE "${Partial}")
+endif()
+
+execute_process(
+    COMMAND ${Expanded}
+    ${ProcessOptions}
+    RESULT_VARIABLE Result)
+
+if(NOT Result EQUAL 0 OR NOT EXISTS "${Partial}")
+    file(REMOVE "${Partial}")
+    list(JOIN Command " " CommandLine)
+    message(FATAL_ERROR
+        "transform_resource: Transform failed (${Result}) for ${INPUT}\n"
+        "  Command: ${CommandLine}")
+endif()
+
+file(SIZE "${Partial}" OutputSize)
+if(OutputSize EQUAL 0)
+    file(REMOVE "${Partial}")
+    list(JOIN Command " " CommandLine)
+    message(FATAL_ERROR
+        "transform_resource: Transform produced an empty output for ${INPUT}\n"
+        "  Command: ${CommandLine}\n"
+        "Embedding empty files is not supported as it serves no practical purpose.")
+endif()
+
+# Publish to the cache under a unique name first: builds sharing the cache
+# can run the same transform at once, and rename never exposes a partial
+# entry
+file(MAKE_DIRECTORY "${CACHE_DIR}")
+string(RANDOM LENGTH 16 Suffix)
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E copy "${Partial}" "${CachedFile}.${Suffix}.tmp"
+    RESULT_VARIABLE Result)
+if(Result EQUAL 0)
+    file(RENAME "${CachedFile}.${Suffix}.tmp" "${CachedFile}")
+else()
+    file(REMOVE "${CachedFile}.${Suffix}.tmp")
+endif()
+
+file(RENAME "${Partial}" "${OUTPUT}")
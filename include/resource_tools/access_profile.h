@@ -0,0 +1,184 @@
+#ifndef RESOURCE_TOOLS_ACCESS_PROFILE_H
+#define RESOURCE_TOOLS_ACCESS_PROFILE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/resource_registry.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// ACCESS PROFILING
+// ============================================================================
+
+/**
+ * Per-resource access counting for profile-guided storage
+ *
+ * Accessors generated while RESOURCE_TOOLS_PROFILING is set count every call.
+ * The counts are written to a profile when the process exits if
+ * RESOURCE_TOOLS_PROFILE_OUTPUT names a file, and embed_resources(PROFILE
+ * <file>) reads that profile to decide which resources are stored raw (hot)
+ * and which are compressed (cold).
+ *
+ * Profile format, one resource per line:
+ *   <accesses> <namespace> <resource>
+ * Lines starting with '#' are comments.
+ */
+namespace profile {
+
+/**
+ * Access counter for one embedded resource
+ */
+struct AccessCounter {
+    const char* ns = nullptr;
+    const char* resource = nullptr;
+    std::atomic<uint64_t> count{0};
+    AccessCounter* next = nullptr;
+};
+
+namespace detail {
+    inline std::atomic<AccessCounter*> g_counters{nullptr};
+    inline std::atomic<bool> g_exit_writer_registered{false};
+
+    inline void write_profile_at_exit();
+}
+
+/**
+ * Counter for a resource, registered on first use
+ *
+ * Called for every resource of a profiled header at start-up, and once per
+ * generated accessor; all of them share one counter per resource. Counters
+ * are intentionally never freed, so they remain readable while the profile
+ * is written at exit.
+ */
+inline auto registerCounter(const char* ns, const char* resource) -> AccessCounter* {
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto* c = detail::g_counters.load(std::memory_order_acquire); c; c = c->next) {
+        if (std::string_view(ns) == c->ns && std::string_view(resource) == c->resource) {
+            return c;
+        }
+    }
+
+    auto* counter = new AccessCounter;
+    counter->ns = ns;
+    counter->resource = resource;
+
+    AccessCounter* head = detail::g_counters.load(std::memory_order_relaxed);
+    do {
+        counter->next = head;
+    } while (!detail::g_counters.compare_exchange_weak(head, counter, std::memory_order_release,
+                                                       std::memory_order_relaxed));
+
+    if (!detail::g_exit_writer_registered.exchange(true)) {
+        std::atexit(detail::write_profile_at_exit);
+    }
+    return counter;
+}
+
+/**
+ * Register a counter for each resource of a generated header, so resources
+ * that are never accessed are still written to the profile
+ *
+ * @return true, for initialising a variable
+ */
+inline auto registerCounters(std::span<const ResourceEntry> entries) -> bool {
+    for (const ResourceEntry& entry : entries) {
+        registerCounter(entry.ns, entry.name);
+    }
+    return true;
+}
+
+/**
+ * Number of recorded accesses to a resource since start-up or the last reset
+ */
+inline auto accessCount(std::string_view ns, std::string_view resource) -> uint64_t {
+    uint64_t total = 0;
+    for (auto* c = detail::g_counters.load(std::memory_order_acquire); c; c = c->next) {
+        if (ns == c->ns && resource == c->resource) {
+            total += c->count.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+/**
+ * Reset all access counts to zero, e.g. to skip start-up from a profile
+ */
+inline void resetAccessCounts() {
+    for (auto* c = detail::g_counters.load(std::memory_order_acquire); c; c = c->next) {
+        c->count.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Write the current access counts as a profile, most accessed first
+ *
+ * Every resource of a profiled header included in the program is listed,
+ * those never accessed with a count of zero, so the profile also shows
+ * which resources are dead weight.
+ *
+ * @param path Output file
+ * @return true on success
+ */
+inline auto writeAccessProfile(const char* path) -> bool {
+    std::vector<const AccessCounter*> counters;
+    for (auto* c = detail::g_counters.load(std::memory_order_acquire); c; c = c->next) {
+        counters.push_back(c);
+    }
+    std::stable_sort(counters.begin(), counters.end(), [](const AccessCounter* a, const AccessCounter* b) {
+        return a->count.load(std::memory_order_relaxed) > b->count.load(std::memory_order_relaxed);
+    });
+
+    std::FILE* file = std::fopen(path, "w");
+    if (!file) {
+        resource_tools::detail::diagnostic_log("resource_tools: cannot write access profile");
+        return false;
+    }
+    std::fputs("# resource_tools access profile\n# accesses namespace resource\n", file);
+    for (const auto* c : counters) {
+        std::fprintf(file, "%llu %s %s\n",
+                     static_cast<unsigned long long>(c->count.load(std::memory_order_relaxed)), c->ns, c->resource);
+    }
+    return std::fclose(file) == 0;
+}
+
+/**
+ * Where the profile is written at exit: $RESOURCE_TOOLS_PROFILE_OUTPUT.
+ * Empty, and nothing is written, if the variable is unset or empty.
+ */
+inline auto profileOutputPath() -> const char* {
+    const char* path = std::getenv("RESOURCE_TOOLS_PROFILE_OUTPUT");
+    return path ? path : "";
+}
+
+inline void detail::write_profile_at_exit() {
+    const char* path = profileOutputPath();
+    if (path[0] != '\0') {
+        writeAccessProfile(path);
+    }
+}
+
+} // namespace profile
+} // namespace resource_tools
+
+/**
+ * Count one access to a resource; used by generated accessors
+ */
+#define RESOURCE_TOOLS_RECORD_ACCESS(ns, resource)                                          \
+    do {                                                                                    \
+        static ::resource_tools::profile::AccessCounter* const resource_tools_counter_ =    \
+            ::resource_tools::profile::registerCounter(ns, resource);                       \
+        resource_tools_counter_->count.fetch_add(1, std::memory_order_relaxed);             \
+    } while (false)
+
+#endif // RESOURCE_TOOLS_ACCESS_PROFILE_H
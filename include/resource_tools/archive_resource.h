@@ -0,0 +1,233 @@
+#ifndef RESOURCE_TOOLS_ARCHIVE_RESOURCE_H
+#define RESOURCE_TOOLS_ARCHIVE_RESOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// ARCHIVE FORMAT
+// ============================================================================
+
+/**
+ * Resources embedded with ARCHIVE are tar files, plain or compressed with
+ * gzip, bzip2, xz or zstd, re-laid out at build time so members can be
+ * found without extracting:
+ *
+ *   Header  (64 bytes): magic, version, flags, member count, index offset,
+ *                       names offset, names size, data offset, data size
+ *   Index   (32 bytes per member, sorted by name)
+ *     name offset   uint32, into the names
+ *     name length   uint32
+ *     data offset   uint64, into the data
+ *     stored size   uint64
+ *     size          uint64, once decoded
+ *   Names   (NUL-terminated member paths)
+ *   Data    (member contents, each starting on a 16-byte boundary)
+ *
+ * Only regular files are members; directories, links and devices are left
+ * out. Members of a plain tar are stored as they are. Members of a
+ * compressed tar are each stored as a packed container (see
+ * <resource_tools/packed_resource.h>), so one can be decoded without the
+ * others. All integers are little-endian. The archive is produced by the
+ * resource_packer tool.
+ */
+namespace archive {
+
+constexpr uint32_t kMagic = 0x52415452u;  // "RTAR"
+constexpr uint16_t kVersion = 1;
+constexpr uint16_t kCompressed = 1;
+constexpr size_t kHeaderSize = 64;
+constexpr size_t kEntrySize = 32;
+constexpr size_t kDataAlignment = 16;
+
+} // namespace archive
+
+// ============================================================================
+// ARCHIVE VIEW
+// ============================================================================
+
+/**
+ * Read-only view of an embedded ARCHIVE resource
+ *
+ * Construction only checks the header. Members are looked up by path with
+ * a binary search over the index. Members of a plain tar are returned in
+ * place; members of a compressed tar are decoded on first access, each on
+ * its own, and kept for the lifetime of the view. Nothing is written to
+ * the filesystem.
+ *
+ * Example:
+ *   const auto& assets = game::getAssetsTARArchive();
+ *   auto shader = assets.find("shaders/basic.vert");
+ *   if (shader) {
+ *       compile(shader.data, shader.size);
+ *   }
+ */
+class ArchiveResource {
+public:
+    explicit ArchiveResource(const ResourceResult& resource) {
+        if (!resource) {
+            error_ = resource.error;
+            return;
+        }
+        if (!resource.data || resource.size < archive::kHeaderSize ||
+            packed::load_le32(resource.data) != archive::kMagic ||
+            packed::load_le16(resource.data + 4) != archive::kVersion) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        const uint16_t flags = packed::load_le16(resource.data + 6);
+        const uint64_t count = packed::load_le64(resource.data + 8);
+        const uint64_t index_offset = packed::load_le64(resource.data + 16);
+        const uint64_t names_offset = packed::load_le64(resource.data + 24);
+        const uint64_t names_size = packed::load_le64(resource.data + 32);
+        const uint64_t data_offset = packed::load_le64(resource.data + 40);
+        const uint64_t data_size = packed::load_le64(resource.data + 48);
+        if ((flags & ~archive::kCompressed) != 0 || index_offset != archive::kHeaderSize ||
+            count > (resource.size - index_offset) / archive::kEntrySize ||
+            names_offset != index_offset + count * archive::kEntrySize || names_size > resource.size - names_offset ||
+            data_offset < names_offset + names_size || data_offset > resource.size ||
+            data_size > resource.size - data_offset) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        index_ = resource.data + index_offset;
+        names_ = resource.data + names_offset;
+        data_ = resource.data + data_offset;
+        names_size_ = names_size;
+        data_size_ = data_size;
+        count_ = count;
+        compressed_ = (flags & archive::kCompressed) != 0;
+        if (compressed_ && count > 0) {
+            decoded_ = std::make_unique<Decoded[]>(static_cast<size_t>(count));
+        }
+    }
+
+    ArchiveResource(const ArchiveResource&) = delete;
+    auto operator=(const ArchiveResource&) -> ArchiveResource& = delete;
+
+    auto error() const -> ResourceError { return error_; }
+    explicit operator bool() const { return error_ == ResourceError::Success; }
+
+    /**
+     * Number of members
+     */
+    auto size() const -> size_t { return static_cast<size_t>(count_); }
+    auto empty() const -> bool { return count_ == 0; }
+
+    /**
+     * Whether members are decoded on access rather than read in place
+     */
+    auto compressed() const -> bool { return compressed_; }
+
+    /**
+     * Path of member `i`, in sorted order; empty if out of range
+     */
+    auto name(size_t i) const -> std::string_view {
+        if (i >= count_) {
+            return {};
+        }
+        const uint8_t* entry = index_ + i * archive::kEntrySize;
+        const uint64_t offset = packed::load_le32(entry);
+        const uint64_t length = packed::load_le32(entry + 4);
+        if (offset > names_size_ || length > names_size_ - offset) {
+            return {};
+        }
+        return {reinterpret_cast<const char*>(names_ + offset), static_cast<size_t>(length)};
+    }
+
+    /**
+     * Position of the member at `path` in the sorted order, if any
+     */
+    auto index_of(std::string_view path) const -> std::optional<size_t> {
+        size_t low = 0;
+        size_t high = size();
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            const std::string_view candidate = name(mid);
+            if (candidate == path) {
+                return mid;
+            }
+            if (candidate < path) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Contents of member `i`; NotFound if out of range
+     */
+    auto entry(size_t i) const -> ResourceResult {
+        if (error_ != ResourceError::Success) {
+            return {nullptr, 0, error_};
+        }
+        if (i >= count_) {
+            return {nullptr, 0, ResourceError::NotFound};
+        }
+        const uint8_t* entry = index_ + i * archive::kEntrySize;
+        const uint64_t offset = packed::load_le64(entry + 8);
+        const uint64_t stored_size = packed::load_le64(entry + 16);
+        const uint64_t size = packed::load_le64(entry + 24);
+        if (offset > data_size_ || stored_size > data_size_ - offset) {
+            return {nullptr, 0, ResourceError::CorruptData};
+        }
+        const ResourceResult stored{data_ + offset, static_cast<size_t>(stored_size), ResourceError::Success};
+        if (!compressed_) {
+            return stored.size == size ? stored : ResourceResult{nullptr, 0, ResourceError::CorruptData};
+        }
+
+        Decoded& decoded = decoded_[i];
+        std::call_once(decoded.once, [&] { decoded.resource = std::make_unique<PackedResource>(stored); });
+        const ResourceResult result = decoded.resource->get();
+        if (result && result.size != size) {
+            return {nullptr, 0, ResourceError::CorruptData};
+        }
+        return result;
+    }
+
+    /**
+     * Contents of the member at `path`; NotFound if there is none
+     */
+    auto find(std::string_view path) const -> ResourceResult {
+        if (error_ != ResourceError::Success) {
+            return {nullptr, 0, error_};
+        }
+        const auto i = index_of(path);
+        return i ? entry(*i) : ResourceResult{nullptr, 0, ResourceError::NotFound};
+    }
+
+    auto contains(std::string_view path) const -> bool { return index_of(path).has_value(); }
+
+private:
+    struct Decoded {
+        std::once_flag once;
+        std::unique_ptr<PackedResource> resource;
+    };
+
+    const uint8_t* index_ = nullptr;
+    const uint8_t* names_ = nullptr;
+    const uint8_t* data_ = nullptr;
+    uint64_t names_size_ = 0;
+    uint64_t data_size_ = 0;
+    uint64_t count_ = 0;
+    bool compressed_ = false;
+    std::unique_ptr<Decoded[]> decoded_;
+    ResourceError error_ = ResourceError::Success;
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_ARCHIVE_RESOURCE_H
@@ -0,0 +1,306 @@
+#ifndef RESOURCE_TOOLS_BINARY_JSON_H
+#define RESOURCE_TOOLS_BINARY_JSON_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// BINARY JSON FORMAT
+// ============================================================================
+
+/**
+ * Resources embedded with FORMAT json-binary are JSON documents parsed at
+ * build time into records that refer to each other by offset:
+ *
+ *   Header (32 bytes): magic, version, flags, root reference, document size
+ *   Records, each starting on an 8-byte boundary
+ *     integer  int64
+ *     double   IEEE 754 binary64
+ *     string   uint64 length, the UTF-8 bytes, a NUL
+ *     array    uint64 count, count references
+ *     object   uint64 count, count (key reference, value reference) pairs
+ *              in document order, count uint32 pair indices sorted by key
+ *
+ * A value is named by a uint64 reference. Its low 3 bits are a tag, and
+ * null, false, true and small integers are held in the reference itself:
+ *   0    null, false or true, as 0, 1 or 2 in the remaining bits
+ *   1    an integer in [-2^60, 2^60), in the remaining bits
+ *   3-7  an integer, double, string, array or object record, at the offset
+ *        in the remaining bits from the start of the document
+ * Tag 2 is unused. Equal strings, keys included, share one record. All
+ * integers are little-endian. The document is produced by the
+ * resource_packer tool.
+ */
+namespace binary_json {
+
+constexpr uint32_t kMagic = 0x534A5452u;  // "RTJS"
+constexpr uint16_t kVersion = 2;
+constexpr size_t kHeaderSize = 32;
+constexpr uint64_t kTypeMask = 7;
+constexpr uint64_t kConstantTag = 0;
+constexpr uint64_t kInlineIntTag = 1;
+constexpr int64_t kInlineIntMin = -(int64_t{1} << 60);
+constexpr int64_t kInlineIntMax = (int64_t{1} << 60) - 1;
+
+} // namespace binary_json
+
+/**
+ * Type of a JSON value; Missing is what a failed lookup returns
+ */
+enum class JsonType : uint8_t {
+    Null = 0,
+    False = 1,
+    True = 2,
+    Int = 3,
+    Double = 4,
+    String = 5,
+    Array = 6,
+    Object = 7,
+    Missing = 8
+};
+
+// ============================================================================
+// BINARY JSON VIEW
+// ============================================================================
+
+/**
+ * One value of a binary JSON document, read in place
+ *
+ * A value is a few words, cheap to copy, and valid for as long as the
+ * document's bytes are. Lookups that fail (a missing key, an index past
+ * the end, a member of a non-object) return a Missing value rather than
+ * failing, so paths can be chained and the fallback given once at the end.
+ * A damaged reference also reads as Missing.
+ *
+ * Example:
+ *   const auto& config = service::getConfigJSONJson();
+ *   int64_t port = config.root()["server"]["port"].as_int(8080);
+ *   for (size_t i = 0; i < config.root()["hosts"].size(); ++i) {
+ *       connect(config.root()["hosts"][i].as_string());
+ *   }
+ */
+class JsonValue {
+public:
+    JsonValue() = default;
+
+    auto type() const -> JsonType { return type_; }
+
+    /**
+     * False only for Missing; a JSON null exists
+     */
+    explicit operator bool() const { return type_ != JsonType::Missing; }
+
+    auto is_null() const -> bool { return type_ == JsonType::Null; }
+    auto is_bool() const -> bool { return type_ == JsonType::False || type_ == JsonType::True; }
+    auto is_int() const -> bool { return type_ == JsonType::Int; }
+    auto is_number() const -> bool { return type_ == JsonType::Int || type_ == JsonType::Double; }
+    auto is_string() const -> bool { return type_ == JsonType::String; }
+    auto is_array() const -> bool { return type_ == JsonType::Array; }
+    auto is_object() const -> bool { return type_ == JsonType::Object; }
+
+    auto as_bool(bool fallback = false) const -> bool { return is_bool() ? type_ == JsonType::True : fallback; }
+
+    /**
+     * Integers that fit in int64 are stored as such; other numbers are
+     * doubles
+     */
+    auto as_int(int64_t fallback = 0) const -> int64_t {
+        if (!is_int()) {
+            return fallback;
+        }
+        if ((ref_ & binary_json::kTypeMask) == binary_json::kInlineIntTag) {
+            return static_cast<int64_t>(ref_) >> 3;
+        }
+        return static_cast<int64_t>(packed::load_le64(base_ + offset()));
+    }
+
+    auto as_double(double fallback = 0.0) const -> double {
+        if (is_int()) {
+            return static_cast<double>(as_int());
+        }
+        return type_ == JsonType::Double ? std::bit_cast<double>(packed::load_le64(base_ + offset())) : fallback;
+    }
+
+    /**
+     * The string, NUL-terminated in place
+     */
+    auto as_string(std::string_view fallback = {}) const -> std::string_view {
+        if (!is_string()) {
+            return fallback;
+        }
+        const uint64_t length = packed::load_le64(base_ + offset());
+        return {reinterpret_cast<const char*>(base_ + offset() + 8), static_cast<size_t>(length)};
+    }
+
+    /**
+     * Number of elements or members; 0 for other types
+     */
+    auto size() const -> size_t {
+        return is_array() || is_object() ? static_cast<size_t>(packed::load_le64(base_ + offset())) : 0;
+    }
+
+    /**
+     * Element `i` of an array
+     */
+    auto operator[](size_t i) const -> JsonValue {
+        if (!is_array() || i >= size()) {
+            return {};
+        }
+        return make(packed::load_le64(base_ + offset() + 8 + i * 8));
+    }
+
+    /**
+     * Member `key` of an object, found by binary search
+     */
+    auto operator[](std::string_view key) const -> JsonValue {
+        if (!is_object()) {
+            return {};
+        }
+        const uint64_t count = size();
+        const uint8_t* sorted = base_ + offset() + 8 + count * 16;
+        size_t low = 0;
+        size_t high = static_cast<size_t>(count);
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            const uint32_t member = packed::load_le32(sorted + mid * 4);
+            if (member >= count) {
+                return {};
+            }
+            const std::string_view candidate = this->key(member);
+            if (candidate == key) {
+                return value(member);
+            }
+            if (candidate < key) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return {};
+    }
+
+    auto contains(std::string_view key) const -> bool { return static_cast<bool>((*this)[key]); }
+
+    /**
+     * Key of member `i` of an object, in document order
+     */
+    auto key(size_t i) const -> std::string_view {
+        if (!is_object() || i >= size()) {
+            return {};
+        }
+        return make(packed::load_le64(base_ + offset() + 8 + i * 16)).as_string();
+    }
+
+    /**
+     * Value of member `i` of an object, in document order
+     */
+    auto value(size_t i) const -> JsonValue {
+        if (!is_object() || i >= size()) {
+            return {};
+        }
+        return make(packed::load_le64(base_ + offset() + 8 + i * 16 + 8));
+    }
+
+private:
+    friend class JsonDocument;
+
+    JsonValue(const uint8_t* base, uint64_t size, uint64_t reference) : base_(base), size_(size), ref_(reference) {
+        const uint64_t tag = reference & binary_json::kTypeMask;
+        const uint64_t at = reference & ~binary_json::kTypeMask;
+        if (tag == binary_json::kConstantTag) {
+            if ((at >> 3) <= static_cast<uint64_t>(JsonType::True)) {
+                type_ = static_cast<JsonType>(at >> 3);
+            }
+            return;
+        }
+        if (tag == binary_json::kInlineIntTag) {
+            type_ = JsonType::Int;
+            return;
+        }
+        // Record tags are the record's JsonType
+        const auto type = static_cast<JsonType>(tag);
+        if (type < JsonType::Int) {
+            return;
+        }
+        // Every record starts with 8 bytes; strings, arrays and objects
+        // must also hold what their count says
+        if (at < binary_json::kHeaderSize || at > size || size - at < 8) {
+            return;
+        }
+        const uint64_t available = size - at - 8;
+        const uint64_t count = packed::load_le64(base + at);
+        if ((type == JsonType::String && count >= available) || (type == JsonType::Array && count > available / 8) ||
+            (type == JsonType::Object && count > available / 20)) {
+            return;
+        }
+        type_ = type;
+    }
+
+    auto make(uint64_t reference) const -> JsonValue { return {base_, size_, reference}; }
+    auto offset() const -> uint64_t { return ref_ & ~binary_json::kTypeMask; }
+
+    const uint8_t* base_ = nullptr;
+    uint64_t size_ = 0;
+    uint64_t ref_ = 0;
+    JsonType type_ = JsonType::Missing;
+};
+
+/**
+ * Read-only view of an embedded FORMAT json-binary resource
+ *
+ * Construction only checks the header, so a document of any size is ready
+ * immediately; values are decoded as they are visited and nothing is
+ * copied or allocated.
+ */
+class JsonDocument {
+public:
+    explicit JsonDocument(const ResourceResult& resource) {
+        if (!resource) {
+            error_ = resource.error;
+            return;
+        }
+        if (!resource.data || resource.size < binary_json::kHeaderSize ||
+            packed::load_le32(resource.data) != binary_json::kMagic ||
+            packed::load_le16(resource.data + 4) != binary_json::kVersion) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+        const uint64_t size = packed::load_le64(resource.data + 16);
+        if (size < binary_json::kHeaderSize || size > resource.size) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+        root_ = JsonValue(resource.data, size, packed::load_le64(resource.data + 8));
+        if (!root_) {
+            error_ = ResourceError::CorruptData;
+        }
+    }
+
+    auto error() const -> ResourceError { return error_; }
+    explicit operator bool() const { return error_ == ResourceError::Success; }
+
+    /**
+     * The top-level value; Missing if the document is invalid
+     */
+    auto root() const -> JsonValue { return root_; }
+
+    /**
+     * Shorthand for root()[key]
+     */
+    auto operator[](std::string_view key) const -> JsonValue { return root_[key]; }
+
+private:
+    JsonValue root_;
+    ResourceError error_ = ResourceError::Success;
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_BINARY_JSON_H
@@ -0,0 +1,401 @@
+#ifndef RESOURCE_TOOLS_COLUMNAR_H
+#define RESOURCE_TOOLS_COLUMNAR_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// COLUMNAR TABLE FORMAT
+// ============================================================================
+
+/**
+ * Resources embedded with FORMAT columnar are tables converted from CSV at
+ * build time, one typed array per column:
+ *
+ *   Header     (64 bytes): magic, version, flags, row count, column count
+ *   Directory  (48 bytes per column): type, name, value and dictionary offsets
+ *   Names, then each column's values and string dictionary
+ *
+ * Header and directory are little-endian. Column values are stored in the
+ * byte order of the target (flagged in the header) so they can be used in
+ * place, and every array starts on a 64-byte boundary. String columns hold
+ * a uint32 code per row into a sorted dictionary of distinct values: uint64
+ * offsets (one more than the dictionary size) into the dictionary bytes.
+ * Tables are produced by the resource_packer tool.
+ */
+namespace columnar {
+
+constexpr uint32_t kMagic = 0x54435452u;  // "RTCT"
+constexpr uint16_t kVersion = 1;
+constexpr size_t kHeaderSize = 64;
+constexpr size_t kEntrySize = 48;
+constexpr size_t kAlignment = 64;
+constexpr uint16_t kBigEndian = 1;  // Header flag: values are big-endian
+
+} // namespace columnar
+
+/**
+ * Type of a column, as declared in the schema
+ */
+enum class ColumnType : uint16_t {
+    Int8 = 1,
+    Int16 = 2,
+    Int32 = 3,
+    Int64 = 4,
+    UInt8 = 5,
+    UInt16 = 6,
+    UInt32 = 7,
+    UInt64 = 8,
+    Float32 = 9,
+    Float64 = 10,
+    String = 11
+};
+
+namespace detail {
+
+/**
+ * Column type whose values are stored as T
+ */
+template <typename T>
+constexpr auto column_type_of() -> ColumnType {
+    if constexpr (std::is_same_v<T, int8_t>) {
+        return ColumnType::Int8;
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+        return ColumnType::Int16;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        return ColumnType::Int32;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        return ColumnType::Int64;
+    } else if constexpr (std::is_same_v<T, uint8_t>) {
+        return ColumnType::UInt8;
+    } else if constexpr (std::is_same_v<T, uint16_t>) {
+        return ColumnType::UInt16;
+    } else if constexpr (std::is_same_v<T, uint32_t>) {
+        return ColumnType::UInt32;
+    } else if constexpr (std::is_same_v<T, uint64_t>) {
+        return ColumnType::UInt64;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return ColumnType::Float32;
+    } else {
+        static_assert(std::is_same_v<T, double>, "column values are fixed-width integers, float or double");
+        return ColumnType::Float64;
+    }
+}
+
+/**
+ * Bytes per row of a column type (string columns store a uint32 code)
+ */
+inline auto column_width(ColumnType type) -> size_t {
+    switch (type) {
+        case ColumnType::Int8:
+        case ColumnType::UInt8: return 1;
+        case ColumnType::Int16:
+        case ColumnType::UInt16: return 2;
+        case ColumnType::Int32:
+        case ColumnType::UInt32:
+        case ColumnType::Float32:
+        case ColumnType::String: return 4;
+        case ColumnType::Int64:
+        case ColumnType::UInt64:
+        case ColumnType::Float64: return 8;
+    }
+    return 0;
+}
+
+} // namespace detail
+
+/**
+ * Schema name of a column type ("int32", "float64", "string", ...)
+ */
+inline auto to_string(ColumnType type) -> const char* {
+    switch (type) {
+        case ColumnType::Int8: return "int8";
+        case ColumnType::Int16: return "int16";
+        case ColumnType::Int32: return "int32";
+        case ColumnType::Int64: return "int64";
+        case ColumnType::UInt8: return "uint8";
+        case ColumnType::UInt16: return "uint16";
+        case ColumnType::UInt32: return "uint32";
+        case ColumnType::UInt64: return "uint64";
+        case ColumnType::Float32: return "float32";
+        case ColumnType::Float64: return "float64";
+        case ColumnType::String: return "string";
+    }
+    return "unknown";
+}
+
+// ============================================================================
+// COLUMNAR TABLE VIEW
+// ============================================================================
+
+/**
+ * Dictionary-encoded string column
+ *
+ * Each row is a code into a sorted dictionary of the column's distinct
+ * values. Filtering on a value is a scan of the codes for find(value).
+ */
+class StringColumn {
+public:
+    StringColumn() = default;
+    StringColumn(std::span<const uint32_t> codes, std::span<const uint64_t> offsets, const char* bytes,
+                 size_t bytes_size)
+        : codes_(codes), offsets_(offsets), bytes_(bytes), bytes_size_(bytes_size) {}
+
+    auto size() const -> size_t { return codes_.size(); }
+    auto empty() const -> bool { return codes_.empty(); }
+
+    /**
+     * Value of row `row`, which must be below size(); empty if the row's
+     * code is not in the dictionary
+     */
+    auto operator[](size_t row) const -> std::string_view { return dictionary(codes_[row]); }
+
+    /**
+     * Dictionary code of each row, as stored: codes are not checked against
+     * dictionary_size() until looked up
+     */
+    auto codes() const -> std::span<const uint32_t> { return codes_; }
+
+    /**
+     * Number of distinct values
+     */
+    auto dictionary_size() const -> size_t { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+    /**
+     * Value of dictionary code `code`; empty if `code` is not below
+     * dictionary_size() or its entry lies outside the table
+     */
+    auto dictionary(uint32_t code) const -> std::string_view {
+        if (code >= dictionary_size()) {
+            return {};
+        }
+        const uint64_t begin = offsets_[code];
+        const uint64_t end = offsets_[code + 1];
+        if (begin > end || end > bytes_size_) {
+            return {};
+        }
+        return {bytes_ + begin, static_cast<size_t>(end - begin)};
+    }
+
+    /**
+     * Code of `value`, or nothing if no row holds it
+     */
+    auto find(std::string_view value) const -> std::optional<uint32_t> {
+        size_t low = 0;
+        size_t high = dictionary_size();
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            if (dictionary(static_cast<uint32_t>(mid)) < value) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if (low < dictionary_size() && dictionary(static_cast<uint32_t>(low)) == value) {
+            return static_cast<uint32_t>(low);
+        }
+        return std::nullopt;
+    }
+
+private:
+    std::span<const uint32_t> codes_;
+    std::span<const uint64_t> offsets_;
+    const char* bytes_ = nullptr;
+    size_t bytes_size_ = 0;
+};
+
+/**
+ * Read-only view of an embedded columnar table
+ *
+ * Columns are typed arrays used in place: there is no parsing at startup,
+ * and a scan over a column is a loop over contiguous, aligned values. The
+ * header and every column's extent are validated on construction, in time
+ * proportional to the number of columns, so column access cannot read
+ * outside the table; string codes are checked when they are looked up. A
+ * table that is not 8-byte aligned in memory (e.g. served from an
+ * arbitrary offset) is copied once into aligned memory.
+ *
+ * Example:
+ *   resource_tools::ColumnarTable table(data::getCitiesCSV());
+ *   auto population = table.column<uint32_t>("population");
+ *   uint64_t total = std::accumulate(population.begin(), population.end(), uint64_t{0});
+ */
+class ColumnarTable {
+public:
+    explicit ColumnarTable(const ResourceResult& resource) {
+        if (!resource) {
+            error_ = resource.error;
+            return;
+        }
+        if (!resource.data) {
+            error_ = ResourceError::NullPointer;
+            return;
+        }
+        data_ = resource.data;
+        size_ = resource.size;
+        if (reinterpret_cast<uintptr_t>(data_) % alignof(uint64_t) != 0) {
+            // Whole uint64s keep the copy aligned for every column type
+            copy_ = std::unique_ptr<uint64_t[]>(new (std::nothrow) uint64_t[(size_ + 7) / 8]);
+            if (!copy_) {
+                error_ = ResourceError::OutOfMemory;
+                return;
+            }
+            std::memcpy(copy_.get(), data_, size_);
+            data_ = reinterpret_cast<const uint8_t*>(copy_.get());
+        }
+        error_ = validate();
+    }
+
+    auto error() const -> ResourceError { return error_; }
+    explicit operator bool() const { return error_ == ResourceError::Success; }
+
+    auto rows() const -> size_t { return error_ == ResourceError::Success ? rows_ : 0; }
+    auto columns() const -> size_t { return error_ == ResourceError::Success ? columns_ : 0; }
+
+    /**
+     * Name of column `index`, empty if there is no such column
+     */
+    auto column_name(size_t index) const -> std::string_view {
+        return index < columns() ? name_at(entry(index)) : std::string_view{};
+    }
+
+    /**
+     * Type of column `index`, which must be below columns()
+     */
+    auto column_type(size_t index) const -> ColumnType {
+        return static_cast<ColumnType>(packed::load_le16(entry(index)));
+    }
+
+    /**
+     * Index of the column called `name`, or columns() if there is none
+     */
+    auto index_of(std::string_view name) const -> size_t {
+        for (size_t i = 0; i < columns(); ++i) {
+            if (column_name(i) == name) {
+                return i;
+            }
+        }
+        return columns();
+    }
+
+    /**
+     * Values of a numeric column; empty if there is no such column or it
+     * does not hold T
+     */
+    template <typename T>
+    auto column(size_t index) const -> std::span<const T> {
+        if (index >= columns() || column_type(index) != detail::column_type_of<T>()) {
+            return {};
+        }
+        return {reinterpret_cast<const T*>(data_ + packed::load_le64(entry(index) + 16)), rows_};
+    }
+
+    template <typename T>
+    auto column(std::string_view name) const -> std::span<const T> {
+        return column<T>(index_of(name));
+    }
+
+    /**
+     * A string column; empty if there is no such column or it does not hold
+     * strings
+     */
+    auto strings(size_t index) const -> StringColumn {
+        if (index >= columns() || column_type(index) != ColumnType::String) {
+            return {};
+        }
+        const uint8_t* p = entry(index);
+        const auto* codes = reinterpret_cast<const uint32_t*>(data_ + packed::load_le64(p + 16));
+        const auto* offsets = reinterpret_cast<const uint64_t*>(data_ + packed::load_le64(p + 32));
+        const size_t dictionary = static_cast<size_t>(packed::load_le64(p + 24));
+        const uint64_t bytes_at = packed::load_le64(p + 40);
+        return {{codes, rows_}, {offsets, dictionary + 1}, reinterpret_cast<const char*>(data_ + bytes_at),
+                static_cast<size_t>(size_ - bytes_at)};
+    }
+
+    auto strings(std::string_view name) const -> StringColumn { return strings(index_of(name)); }
+
+private:
+    auto entry(size_t index) const -> const uint8_t* {
+        return data_ + columnar::kHeaderSize + index * columnar::kEntrySize;
+    }
+
+    auto name_at(const uint8_t* p) const -> std::string_view {
+        return {reinterpret_cast<const char*>(data_ + packed::load_le64(p + 8)), packed::load_le32(p + 4)};
+    }
+
+    // Whether [offset, offset + count * width) lies in the table and is aligned
+    auto in_bounds(uint64_t offset, uint64_t count, size_t width) const -> bool {
+        return offset % width == 0 && offset <= size_ && count <= (size_ - offset) / width;
+    }
+
+    auto validate() -> ResourceError {
+        if (size_ < columnar::kHeaderSize || packed::load_le32(data_) != columnar::kMagic ||
+            packed::load_le16(data_ + 4) != columnar::kVersion) {
+            return ResourceError::CorruptData;
+        }
+        const bool big_endian = (packed::load_le16(data_ + 6) & columnar::kBigEndian) != 0;
+        if (big_endian != (std::endian::native == std::endian::big)) {
+            // Built for another target
+            return ResourceError::Unsupported;
+        }
+
+        const uint64_t rows = packed::load_le64(data_ + 8);
+        const uint64_t columns = packed::load_le32(data_ + 16);
+        if (columns > (size_ - columnar::kHeaderSize) / columnar::kEntrySize) {
+            return ResourceError::CorruptData;
+        }
+        rows_ = static_cast<size_t>(rows);
+        columns_ = static_cast<size_t>(columns);
+
+        for (size_t i = 0; i < columns_; ++i) {
+            const uint8_t* p = entry(i);
+            const auto type = static_cast<ColumnType>(packed::load_le16(p));
+            const size_t width = detail::column_width(type);
+            const uint64_t name_offset = packed::load_le64(p + 8);
+            const uint64_t name_length = packed::load_le32(p + 4);
+            if (width == 0 || !in_bounds(name_offset, name_length, 1) ||
+                !in_bounds(packed::load_le64(p + 16), rows, width)) {
+                return ResourceError::CorruptData;
+            }
+            if (type != ColumnType::String) {
+                continue;
+            }
+
+            // Only the extents are checked here, so opening a table does not
+            // touch its rows; StringColumn bounds-checks codes and offsets on
+            // lookup
+            const uint64_t dictionary = packed::load_le64(p + 24);
+            const uint64_t offsets_at = packed::load_le64(p + 32);
+            const uint64_t bytes_at = packed::load_le64(p + 40);
+            if (dictionary >= UINT32_MAX || !in_bounds(offsets_at, dictionary + 1, sizeof(uint64_t)) ||
+                bytes_at > size_) {
+                return ResourceError::CorruptData;
+            }
+        }
+        return ResourceError::Success;
+    }
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t rows_ = 0;
+    size_t columns_ = 0;
+    std::unique_ptr<uint64_t[]> copy_;
+    ResourceError error_ = ResourceError::Success;
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_COLUMNAR_H
@@ -0,0 +1,131 @@
+#ifndef RESOURCE_TOOLS_CONTENT_HASH_H
+#define RESOURCE_TOOLS_CONTENT_HASH_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <resource_tools/embedded_resource.h>
+
+namespace resource_tools {
+
+/**
+ * SHA-256 digest of a resource's content
+ */
+using ContentHash = std::array<uint8_t, 32>;
+
+namespace detail {
+
+inline auto sha256_rotr(uint32_t x, int n) -> uint32_t {
+    return (x >> n) | (x << (32 - n));
+}
+
+inline void sha256_block(uint32_t state[8], const uint8_t block[64]) {
+    static constexpr uint32_t k[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) | (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+               (static_cast<uint32_t>(block[i * 4 + 2]) << 8) | static_cast<uint32_t>(block[i * 4 + 3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = sha256_rotr(w[i - 15], 7) ^ sha256_rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = sha256_rotr(w[i - 2], 17) ^ sha256_rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; ++i) {
+        uint32_t s1 = sha256_rotr(e, 6) ^ sha256_rotr(e, 11) ^ sha256_rotr(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + k[i] + w[i];
+        uint32_t s0 = sha256_rotr(a, 2) ^ sha256_rotr(a, 13) ^ sha256_rotr(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+} // namespace detail
+
+/**
+ * Compute the SHA-256 hash of a block of memory
+ *
+ * @param data Pointer to the data (may be nullptr if size is 0)
+ * @param size Number of bytes
+ * @return 32-byte digest
+ */
+inline auto sha256(const uint8_t* data, size_t size) -> ContentHash {
+    uint32_t state[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                         0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+    size_t offset = 0;
+    for (; offset + 64 <= size; offset += 64) {
+        detail::sha256_block(state, data + offset);
+    }
+
+    // Final block(s): remaining bytes, 0x80 terminator, big-endian bit length
+    uint8_t tail[128] = {};
+    const size_t remaining = size - offset;
+    if (remaining > 0) {
+        std::memcpy(tail, data + offset, remaining);
+    }
+    tail[remaining] = 0x80;
+    const size_t tail_size = remaining < 56 ? 64 : 128;
+    const uint64_t bits = static_cast<uint64_t>(size) * 8;
+    for (int i = 0; i < 8; ++i) {
+        tail[tail_size - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+    detail::sha256_block(state, tail);
+    if (tail_size == 128) {
+        detail::sha256_block(state, tail + 64);
+    }
+
+    ContentHash digest;
+    for (int i = 0; i < 8; ++i) {
+        digest[i * 4] = static_cast<uint8_t>(state[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(state[i]);
+    }
+    return digest;
+}
+
+/**
+ * Compute the content hash of a resource
+ */
+inline auto contentHash(const ResourceResult& resource) -> ContentHash {
+    return sha256(resource.data, resource.size);
+}
+
+/**
+ * Lower-case hex form of a content hash (64 characters)
+ */
+inline auto toHex(const ContentHash& hash) -> std::array<char, 65> {
+    static constexpr char digits[] = "0123456789abcdef";
+    std::array<char, 65> hex{};
+    for (size_t i = 0; i < hash.size(); ++i) {
+        hex[i * 2] = digits[hash[i] >> 4];
+        hex[i * 2 + 1] = digits[hash[i] & 0x0f];
+    }
+    hex[64] = '\0';
+    return hex;
+}
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_CONTENT_HASH_H
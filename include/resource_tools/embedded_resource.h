@@ -4,6 +4,10 @@
 #include <cstdint>
 #include <cstddef>
 
+#if __has_include(<string_view>)
+    #include <string_view>
+#endif
+
 // Check for C++23 std::expected support
 #if __cplusplus >= 202302L && __has_include(<expected>)
     #include <expected>
@@ -22,7 +26,12 @@ enum class ResourceError : uint32_t {
     NullPointer = 1,
     InvalidSize = 2,
     IntegerOverflow = 3,
-    NotFound = 4
+    NotFound = 4,
+    CorruptData = 5,
+    OutOfMemory = 6,
+    Unsupported = 7,
+    SystemError = 8,
+    InvalidArgument = 9
 };
 
 /**
@@ -35,6 +44,11 @@ inline auto to_string(ResourceError err) -> const char* {
         case ResourceError::InvalidSize: return "Invalid resource size (end < start)";
         case ResourceError::IntegerOverflow: return "Resource size exceeds uint32_t limit";
         case ResourceError::NotFound: return "Resource not found";
+        case ResourceError::CorruptData: return "Embedded resource data is corrupt";
+        case ResourceError::OutOfMemory: return "Out of memory decoding resource";
+        case ResourceError::Unsupported: return "Operation not supported on this platform";
+        case ResourceError::SystemError: return "Operating system call failed";
+        case ResourceError::InvalidArgument: return "Invalid argument";
     }
     return "Unknown error";
 }
@@ -50,7 +64,6 @@ struct ResourceData {
      * Convert resource data to string view (requires <string_view>)
      */
     #if __has_include(<string_view>)
-    #include <string_view>
     auto as_string_view() const -> std::string_view {
         return std::string_view(reinterpret_cast<const char*>(data), size);
     }
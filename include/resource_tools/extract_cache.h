@@ -0,0 +1,268 @@
+#ifndef RESOURCE_TOOLS_EXTRACT_CACHE_H
+#define RESOURCE_TOOLS_EXTRACT_CACHE_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <resource_tools/content_hash.h>
+#include <resource_tools/embedded_resource.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define RESOURCE_TOOLS_HAS_EXTRACT_CACHE 1
+#else
+    #define RESOURCE_TOOLS_HAS_EXTRACT_CACHE 0
+#endif
+
+namespace resource_tools {
+
+// ============================================================================
+// ON-DISK EXTRACTION CACHE
+// ============================================================================
+
+/**
+ * Path of an extracted resource, or an error
+ */
+struct ExtractResult {
+    std::string path;
+    ResourceError error = ResourceError::Success;
+
+    explicit operator bool() const { return error == ResourceError::Success; }
+};
+
+namespace detail {
+
+#if RESOURCE_TOOLS_HAS_EXTRACT_CACHE
+
+/**
+ * FNV-1a over 256 bytes spread evenly across a resource
+ *
+ * Not a content hash; it only tells a buffer refilled at the same address
+ * from the one hashed before.
+ */
+inline auto sample_fingerprint(const ResourceResult& resource) -> uint64_t {
+    uint64_t hash = 14695981039346656037ull;
+    const size_t step = resource.size / 256 + 1;
+    for (size_t offset = 0; offset < resource.size; offset += step) {
+        hash = (hash ^ resource.data[offset]) * 1099511628211ull;
+    }
+    return resource.size > 0 ? (hash ^ resource.data[resource.size - 1]) * 1099511628211ull : hash;
+}
+
+/**
+ * Hex content hash of a resource, computed once per resource
+ *
+ * Keys are remembered by address and size. A buffer at a remembered
+ * address whose sampled bytes have changed, say freed and reused, is
+ * hashed again.
+ */
+inline auto extraction_key(const ResourceResult& resource) -> std::string {
+    struct Key {
+        uint64_t fingerprint;
+        std::string hex;
+    };
+    static std::mutex mutex;
+    static std::map<std::pair<const uint8_t*, size_t>, Key> keys;
+
+    const uint64_t fingerprint = sample_fingerprint(resource);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = keys.find({resource.data, resource.size});
+        if (it != keys.end() && it->second.fingerprint == fingerprint) {
+            return it->second.hex;
+        }
+    }
+    const auto hex = toHex(contentHash(resource));
+    std::string key(hex.data(), 64);
+    std::lock_guard<std::mutex> lock(mutex);
+    // Programs extracting many short-lived buffers should not grow this
+    // without bound
+    if (keys.size() >= 4096) {
+        keys.clear();
+    }
+    keys.insert_or_assign(std::make_pair(resource.data, resource.size), Key{fingerprint, key});
+    return key;
+}
+
+/**
+ * Whether `path` is a real directory that only the current user can write
+ *
+ * Anyone else able to write there could plant files for us to hand out.
+ */
+inline auto is_private_directory(const std::string& path) -> bool {
+    struct stat st {};
+    return lstat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode) && st.st_uid == geteuid() &&
+           (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+/**
+ * Create `path` and any missing parents, the last one private
+ */
+inline auto make_private_directory(const std::string& path) -> bool {
+    for (size_t slash = path.find('/', 1); slash != std::string::npos; slash = path.find('/', slash + 1)) {
+        const std::string parent = path.substr(0, slash);
+        if (mkdir(parent.c_str(), 0700) != 0 && errno != EEXIST) {
+            return false;
+        }
+    }
+    if (mkdir(path.c_str(), 0700) != 0 && errno != EEXIST) {
+        return false;
+    }
+    return is_private_directory(path);
+}
+
+/**
+ * Whether `path` is a finished extraction of `size` bytes
+ *
+ * The name is the content hash and files are only ever renamed into place
+ * complete and read-only, so a regular file of ours with the right size
+ * and mode 0500 is the resource. A file that was made writable, or
+ * truncated, is written again.
+ */
+inline auto is_extracted(const std::string& path, size_t size) -> bool {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st {};
+    const bool extracted = fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_uid == geteuid() &&
+                           (st.st_mode & 07777) == 0500 && static_cast<uint64_t>(st.st_size) == size;
+    close(fd);
+    return extracted;
+}
+
+/**
+ * Write `resource` to a temporary file next to `path`, then rename it over
+ * `path`
+ */
+inline auto write_extraction(const std::string& path, const ResourceResult& resource) -> bool {
+    static std::atomic<uint64_t> counter{0};
+    const std::string temporary = path + ".tmp." + std::to_string(getpid()) + "." +
+                                  std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+    const int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC | O_NOFOLLOW, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < resource.size) {
+        const ssize_t n = write(fd, resource.data + written, resource.size - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(n);
+    }
+    // Data reaches the disk before the name does, so a crash never leaves
+    // a short file under the final name
+    const bool complete = written == resource.size && fchmod(fd, 0500) == 0 && fsync(fd) == 0;
+    close(fd);
+    if (!complete || rename(temporary.c_str(), path.c_str()) != 0) {
+        unlink(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+#endif // RESOURCE_TOOLS_HAS_EXTRACT_CACHE
+
+} // namespace detail
+
+/**
+ * Per-user directory that extractToCache() writes to
+ *
+ * RESOURCE_TOOLS_EXTRACT_DIR if set, otherwise
+ * $XDG_CACHE_HOME/resource_tools, otherwise ~/.cache/resource_tools. Empty
+ * if none of these variables is set.
+ */
+inline auto extractionDirectory() -> std::string {
+    if (const char* directory = std::getenv("RESOURCE_TOOLS_EXTRACT_DIR"); directory && *directory) {
+        return directory;
+    }
+    if (const char* cache = std::getenv("XDG_CACHE_HOME"); cache && *cache == '/') {
+        return std::string(cache) + "/resource_tools";
+    }
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return std::string(home) + "/.cache/resource_tools";
+    }
+    return {};
+}
+
+/**
+ * Write a resource to a file on disk, once per deployment
+ *
+ * For subprocesses and libraries that need a real path and cannot use
+ * memfdPath(). The file is named after the resource's SHA-256, so it is
+ * found again by later processes, and identical resources embedded in
+ * different binaries share one file. The hash is computed once per
+ * resource, and reuse then costs an open() and fstat() of the file: a
+ * regular file of the current user with the resource's size and mode 0500
+ * is taken as the resource.
+ *
+ * Files are written under a temporary name and renamed into place, so a
+ * reader never sees a partial file; concurrent extractors in any number of
+ * processes each rename identical bytes over the same name. A file of the
+ * wrong size, owner or mode, say left by something else or made writable
+ * and edited, is replaced. Extracted files are read-only and executable
+ * (mode 0500), for helper binaries.
+ *
+ * Example:
+ *   auto helper = resource_tools::extractToCache(tools::getConverterBIN());
+ *   if (helper) {
+ *       spawn(helper.path);
+ *   }
+ *
+ * @param resource Resource to extract
+ * @param extension Appended to the file name (e.g. ".so"), for consumers
+ *        that look at it; must not contain '/'
+ * @param directory Cache directory, created if missing
+ * @return The file's path; the resource's own error, InvalidArgument for
+ *         an extension containing '/', NotFound if there is no cache
+ *         directory, Unsupported on non-POSIX platforms, or SystemError
+ */
+inline auto extractToCache(const ResourceResult& resource, const std::string& extension = {},
+                           const std::string& directory = extractionDirectory()) -> ExtractResult {
+    if (!resource) {
+        return {{}, resource.error};
+    }
+    if (!resource.data && resource.size > 0) {
+        return {{}, ResourceError::NullPointer};
+    }
+    if (extension.find('/') != std::string::npos) {
+        return {{}, ResourceError::InvalidArgument};
+    }
+    if (directory.empty()) {
+        return {{}, ResourceError::NotFound};
+    }
+#if RESOURCE_TOOLS_HAS_EXTRACT_CACHE
+    if (!detail::is_private_directory(directory) && !detail::make_private_directory(directory)) {
+        detail::diagnostic_log("resource_tools: extraction directory cannot be created or is not private");
+        return {{}, ResourceError::SystemError};
+    }
+    std::string path = directory + "/" + detail::extraction_key(resource) + extension;
+    if (detail::is_extracted(path, resource.size)) {
+        return {std::move(path), ResourceError::Success};
+    }
+    if (!detail::write_extraction(path, resource)) {
+        detail::diagnostic_log("resource_tools: failed to extract resource to cache");
+        return {{}, ResourceError::SystemError};
+    }
+    return {std::move(path), ResourceError::Success};
+#else
+    return {{}, ResourceError::Unsupported};
+#endif
+}
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_EXTRACT_CACHE_H
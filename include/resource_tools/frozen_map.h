@@ -0,0 +1,209 @@
+#ifndef RESOURCE_TOOLS_FROZEN_MAP_H
+#define RESOURCE_TOOLS_FROZEN_MAP_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/key_hash.h>
+#include <resource_tools/packed_resource.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// FROZEN MAP FORMAT
+// ============================================================================
+
+/**
+ * Resources embedded with FROZEN_MAP are compiled from key/value files into
+ * an open-addressing hash table that is queried in place:
+ *
+ *   Header  (64 bytes): magic, version, flags, entry count, bucket count,
+ *                       records offset, records size
+ *   Buckets (64 bytes each, one cache line)
+ *     tags     8 bytes: a one-byte fingerprint per slot, 0 if empty; the
+ *                       last byte is unused
+ *     slots    7 x 8 bytes: offset of the slot's record
+ *   Records (key length, value length, key, value), packed
+ *
+ * A key starts at the bucket its hash selects and moves to the next bucket
+ * while the current one is full, so a lookup usually touches one bucket and
+ * one record. Buckets start on a 64-byte boundary when the resource does.
+ * All integers are little-endian. The table is produced by the
+ * resource_packer tool.
+ */
+namespace frozen_map {
+
+constexpr uint32_t kMagic = 0x4D465452u;  // "RTFM"
+constexpr uint16_t kVersion = 1;
+constexpr size_t kHeaderSize = 64;
+constexpr size_t kBucketSize = 64;
+constexpr size_t kSlotsPerBucket = 7;
+constexpr size_t kRecordHeaderSize = 8;
+
+/**
+ * Bucket a key's hash starts at, out of `buckets`
+ */
+inline auto bucket_of(uint64_t hash, uint64_t buckets) -> uint64_t {
+    return (hash >> 8) % buckets;
+}
+
+/**
+ * Non-zero fingerprint of a key's hash
+ */
+inline auto tag_of(uint64_t hash) -> uint8_t {
+    const auto tag = static_cast<uint8_t>(hash);
+    return tag == 0 ? 1 : tag;
+}
+
+/**
+ * Bit 7 of byte i is set where tag i of `tags` equals `byte`. Exact for
+ * the lowest match; a higher byte can be flagged falsely only above a
+ * real match, which the caller's key comparison rejects.
+ */
+inline auto match_tags(uint64_t tags, uint8_t byte) -> uint64_t {
+    constexpr uint64_t kLow = 0x0001010101010101ull;
+    constexpr uint64_t kHigh = 0x0080808080808080ull;
+    const uint64_t x = tags ^ (kLow * byte);
+    return (x - kLow) & ~x & kHigh;
+}
+
+} // namespace frozen_map
+
+// ============================================================================
+// FROZEN MAP VIEW
+// ============================================================================
+
+/**
+ * Read-only view of an embedded FROZEN_MAP resource
+ *
+ * Construction only checks the header, so a map of millions of entries is
+ * ready immediately and uses no memory beyond the resource. A lookup
+ * compares the key's fingerprint against a bucket's tags eight at a time,
+ * then compares the key of each matching slot.
+ *
+ * Example:
+ *   const auto& skus = catalog::getSkusTSVMap();
+ *   if (auto name = skus.find("SKU-10442")) {
+ *       show(*name);
+ *   }
+ */
+class FrozenMap {
+public:
+    explicit FrozenMap(const ResourceResult& resource) {
+        if (!resource) {
+            error_ = resource.error;
+            return;
+        }
+        if (!resource.data || resource.size < frozen_map::kHeaderSize ||
+            packed::load_le32(resource.data) != frozen_map::kMagic ||
+            packed::load_le16(resource.data + 4) != frozen_map::kVersion) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        const uint64_t count = packed::load_le64(resource.data + 8);
+        const uint64_t buckets = packed::load_le64(resource.data + 16);
+        const uint64_t records_offset = packed::load_le64(resource.data + 24);
+        const uint64_t records_size = packed::load_le64(resource.data + 32);
+        const uint64_t max_buckets = (resource.size - frozen_map::kHeaderSize) / frozen_map::kBucketSize;
+        if (buckets == 0 || buckets > max_buckets || count > buckets * frozen_map::kSlotsPerBucket ||
+            records_offset != frozen_map::kHeaderSize + buckets * frozen_map::kBucketSize ||
+            records_size > resource.size - records_offset) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        buckets_ = resource.data + frozen_map::kHeaderSize;
+        records_ = resource.data + records_offset;
+        records_size_ = records_size;
+        bucket_count_ = buckets;
+        count_ = count;
+    }
+
+    auto error() const -> ResourceError { return error_; }
+    explicit operator bool() const { return error_ == ResourceError::Success; }
+
+    /**
+     * Number of entries
+     */
+    auto size() const -> size_t { return static_cast<size_t>(count_); }
+    auto empty() const -> bool { return count_ == 0; }
+
+    /**
+     * Number of 64-byte buckets
+     */
+    auto bucket_count() const -> size_t { return static_cast<size_t>(bucket_count_); }
+
+    /**
+     * Value of `key`, or nullopt if the map has no such key
+     */
+    auto find(std::string_view key) const -> std::optional<std::string_view> {
+        if (bucket_count_ == 0) {
+            return std::nullopt;
+        }
+        const uint64_t hash = keyHash(key);
+        const uint8_t tag = frozen_map::tag_of(hash);
+        uint64_t bucket = frozen_map::bucket_of(hash, bucket_count_);
+        for (uint64_t probed = 0; probed < bucket_count_; ++probed) {
+            const uint8_t* line = buckets_ + bucket * frozen_map::kBucketSize;
+            const uint64_t tags = packed::load_le64(line);
+            for (uint64_t matches = frozen_map::match_tags(tags, tag); matches != 0; matches &= matches - 1) {
+                const size_t slot = static_cast<size_t>(std::countr_zero(matches)) / 8;
+                std::string_view stored_key;
+                std::string_view value;
+                if (record(packed::load_le64(line + 8 + slot * 8), stored_key, value) && stored_key == key) {
+                    return value;
+                }
+            }
+            // Keys only move past a full bucket, so an empty slot ends the probe
+            if (frozen_map::match_tags(tags, 0) != 0) {
+                return std::nullopt;
+            }
+            bucket = bucket + 1 == bucket_count_ ? 0 : bucket + 1;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Value of `key`, or `fallback` if the map has no such key
+     */
+    auto get(std::string_view key, std::string_view fallback = {}) const -> std::string_view {
+        return find(key).value_or(fallback);
+    }
+
+    auto contains(std::string_view key) const -> bool { return find(key).has_value(); }
+
+private:
+    // Bounds-checked so a damaged slot reads as a miss instead of out of the
+    // records
+    auto record(uint64_t offset, std::string_view& key, std::string_view& value) const -> bool {
+        if (offset > records_size_ || records_size_ - offset < frozen_map::kRecordHeaderSize) {
+            return false;
+        }
+        const uint8_t* p = records_ + offset;
+        const uint64_t key_size = packed::load_le32(p);
+        const uint64_t value_size = packed::load_le32(p + 4);
+        if (key_size + value_size > records_size_ - offset - frozen_map::kRecordHeaderSize) {
+            return false;
+        }
+        const auto* text = reinterpret_cast<const char*>(p + frozen_map::kRecordHeaderSize);
+        key = std::string_view(text, static_cast<size_t>(key_size));
+        value = std::string_view(text + key_size, static_cast<size_t>(value_size));
+        return true;
+    }
+
+    const uint8_t* buckets_ = nullptr;
+    const uint8_t* records_ = nullptr;
+    uint64_t records_size_ = 0;
+    uint64_t bucket_count_ = 0;
+    uint64_t count_ = 0;
+    ResourceError error_ = ResourceError::Success;
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_FROZEN_MAP_H
@@ -0,0 +1,299 @@
+#ifndef RESOURCE_TOOLS_FROZEN_SET_H
+#define RESOURCE_TOOLS_FROZEN_SET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/key_hash.h>
+#include <resource_tools/packed_resource.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// FROZEN SET FORMAT
+// ============================================================================
+
+/**
+ * Resources embedded with SET are compiled from word lists into a sorted,
+ * prefix-compressed array with an optional Bloom filter in front of it:
+ *
+ *   Header (64 bytes): magic, version, flags, entry count, restart count,
+ *                      restart interval, filter block count, index offset,
+ *                      data offset, data size
+ *   Filter (32-byte blocks of eight uint32 words; absent if no blocks)
+ *   Index  (data offset of each restart entry, uint64)
+ *   Data   (per entry: varint shared, varint unshared, unshared bytes)
+ *
+ * Entries are sorted bytewise, and each stores only what differs from the
+ * entry before it, except every restart-interval'th entry, which is stored
+ * whole so a binary search can start there. The filter is split-block: a
+ * key selects one block and sets one bit in each of its eight words, so a
+ * probe is eight independent word tests on one cache line. All integers
+ * are little-endian. The set is produced by the resource_packer tool.
+ */
+namespace frozen_set {
+
+constexpr uint32_t kMagic = 0x53535452u;  // "RTSS"
+constexpr uint16_t kVersion = 1;
+constexpr size_t kHeaderSize = 64;
+constexpr size_t kFilterBlockSize = 32;
+constexpr uint32_t kRestartInterval = 16;
+
+/**
+ * Filter block of a key's hash, out of `blocks`
+ */
+inline auto filter_block_of(uint64_t hash, uint64_t blocks) -> uint64_t {
+    return (hash >> 32) % blocks;
+}
+
+/**
+ * Bit of a key's hash in each word of its filter block
+ */
+inline void filter_masks(uint64_t hash, uint32_t masks[8]) {
+    static constexpr uint32_t kSalt[8] = {0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+                                          0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+    const auto key = static_cast<uint32_t>(hash);
+    for (int i = 0; i < 8; ++i) {
+        masks[i] = uint32_t{1} << ((key * kSalt[i]) >> 27);
+    }
+}
+
+/**
+ * Read an LEB128 varint at `p`, at most 5 bytes and not past `end`
+ */
+inline auto read_varint(const uint8_t*& p, const uint8_t* end, uint32_t& value) -> bool {
+    value = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7) {
+        const uint8_t byte = *p++;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace frozen_set
+
+// ============================================================================
+// FROZEN SET VIEW
+// ============================================================================
+
+/**
+ * Read-only view of an embedded SET resource
+ *
+ * Construction only checks the header. contains() asks the Bloom filter
+ * first, so most absent keys are rejected after one cache line, then
+ * binary-searches the restart entries and walks at most one run of
+ * prefix-compressed entries, comparing as it decodes. Nothing is copied or
+ * allocated.
+ *
+ * Example:
+ *   const auto& blocked = policy::getBlocklistTXTSet();
+ *   if (blocked.contains(host)) {
+ *       reject();
+ *   }
+ */
+class FrozenSet {
+public:
+    explicit FrozenSet(const ResourceResult& resource) {
+        if (!resource) {
+            error_ = resource.error;
+            return;
+        }
+        if (!resource.data || resource.size < frozen_set::kHeaderSize ||
+            packed::load_le32(resource.data) != frozen_set::kMagic ||
+            packed::load_le16(resource.data + 4) != frozen_set::kVersion) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        const uint64_t count = packed::load_le64(resource.data + 8);
+        const uint64_t restarts = packed::load_le64(resource.data + 16);
+        const uint32_t interval = packed::load_le32(resource.data + 24);
+        const uint64_t filter_blocks = packed::load_le64(resource.data + 32);
+        const uint64_t index_offset = packed::load_le64(resource.data + 40);
+        const uint64_t data_offset = packed::load_le64(resource.data + 48);
+        const uint64_t data_size = packed::load_le64(resource.data + 56);
+        const uint64_t available = resource.size - frozen_set::kHeaderSize;
+        if (interval == 0 || restarts != (count + interval - 1) / interval ||
+            filter_blocks > available / frozen_set::kFilterBlockSize ||
+            index_offset != frozen_set::kHeaderSize + filter_blocks * frozen_set::kFilterBlockSize ||
+            restarts > (resource.size - index_offset) / 8 || data_offset != index_offset + restarts * 8 ||
+            data_size > resource.size - data_offset) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        filter_ = filter_blocks > 0 ? resource.data + frozen_set::kHeaderSize : nullptr;
+        index_ = resource.data + index_offset;
+        data_ = resource.data + data_offset;
+        data_size_ = data_size;
+        count_ = count;
+        restarts_ = restarts;
+        filter_blocks_ = filter_blocks;
+        interval_ = interval;
+    }
+
+    auto error() const -> ResourceError { return error_; }
+    explicit operator bool() const { return error_ == ResourceError::Success; }
+
+    /**
+     * Number of distinct entries
+     */
+    auto size() const -> size_t { return static_cast<size_t>(count_); }
+    auto empty() const -> bool { return count_ == 0; }
+
+    /**
+     * Whether the set was built with a Bloom filter
+     */
+    auto has_filter() const -> bool { return filter_ != nullptr; }
+
+    /**
+     * False if `key` is certainly not in the set; true if it may be, or if
+     * there is no filter
+     */
+    auto may_contain(std::string_view key) const -> bool {
+        if (!filter_) {
+            return count_ > 0;
+        }
+        const uint64_t hash = keyHash(key);
+        uint32_t masks[8];
+        frozen_set::filter_masks(hash, masks);
+        const uint8_t* block =
+            filter_ + frozen_set::filter_block_of(hash, filter_blocks_) * frozen_set::kFilterBlockSize;
+        uint32_t missing = 0;
+        for (int i = 0; i < 8; ++i) {
+            missing |= masks[i] & ~packed::load_le32(block + i * 4);
+        }
+        return missing == 0;
+    }
+
+    /**
+     * Whether `key` is in the set
+     */
+    auto contains(std::string_view key) const -> bool {
+        if (count_ == 0 || !may_contain(key)) {
+            return false;
+        }
+
+        // Last restart entry not greater than the key
+        uint64_t low = 0;
+        uint64_t high = restarts_;
+        while (high - low > 1) {
+            const uint64_t mid = low + (high - low) / 2;
+            std::string_view restart;
+            if (!restart_key(mid, restart)) {
+                return false;
+            }
+            if (restart <= key) {
+                low = mid;
+            } else {
+                high = mid;
+            }
+        }
+        return scan_block(low, key);
+    }
+
+private:
+    // The whole key of restart entry `index`, and where the entry after it
+    // starts
+    auto restart_key(uint64_t index, std::string_view& key, const uint8_t** next = nullptr) const -> bool {
+        const uint64_t offset = packed::load_le64(index_ + index * 8);
+        if (offset >= data_size_) {
+            return false;
+        }
+        const uint8_t* p = data_ + offset;
+        const uint8_t* end = data_ + data_size_;
+        uint32_t shared = 0;
+        uint32_t unshared = 0;
+        if (!frozen_set::read_varint(p, end, shared) || !frozen_set::read_varint(p, end, unshared) || shared != 0 ||
+            unshared > static_cast<uint64_t>(end - p)) {
+            return false;
+        }
+        key = std::string_view(reinterpret_cast<const char*>(p), unshared);
+        if (next) {
+            *next = p + unshared;
+        }
+        return true;
+    }
+
+    // Walk the run starting at restart `index`, tracking how much of the
+    // key the current entry matches. Every entry visited is below the key
+    // until one equals it or passes it.
+    auto scan_block(uint64_t index, std::string_view key) const -> bool {
+        std::string_view first;
+        const uint8_t* p = nullptr;
+        if (!restart_key(index, first, &p)) {
+            return false;
+        }
+        if (first == key) {
+            return true;
+        }
+        if (first > key) {
+            return false;
+        }
+        size_t matched = common_prefix(first, key);
+
+        const uint8_t* end = data_ + data_size_;
+        const uint64_t run = std::min<uint64_t>(interval_, count_ - index * interval_);
+        for (uint64_t i = 1; i < run; ++i) {
+            uint32_t shared = 0;
+            uint32_t unshared = 0;
+            if (!frozen_set::read_varint(p, end, shared) || !frozen_set::read_varint(p, end, unshared) ||
+                unshared > static_cast<uint64_t>(end - p)) {
+                return false;
+            }
+            const std::string_view suffix(reinterpret_cast<const char*>(p), unshared);
+            p += unshared;
+
+            if (shared < matched) {
+                // This entry's byte at `shared` is above the previous entry's,
+                // which matched the key, so the entry is past the key
+                return false;
+            }
+            if (shared > matched) {
+                // Still differs from the key where the previous entry did
+                continue;
+            }
+            const std::string_view rest = key.substr(matched);
+            const size_t extra = common_prefix(suffix, rest);
+            if (extra == suffix.size() && extra == rest.size()) {
+                return true;
+            }
+            if (extra == rest.size() ||
+                (extra < suffix.size() &&
+                 static_cast<unsigned char>(suffix[extra]) > static_cast<unsigned char>(rest[extra]))) {
+                return false;
+            }
+            matched += extra;
+        }
+        return false;
+    }
+
+    static auto common_prefix(std::string_view a, std::string_view b) -> size_t {
+        const size_t limit = std::min(a.size(), b.size());
+        size_t n = 0;
+        while (n < limit && a[n] == b[n]) {
+            ++n;
+        }
+        return n;
+    }
+
+    const uint8_t* filter_ = nullptr;
+    const uint8_t* index_ = nullptr;
+    const uint8_t* data_ = nullptr;
+    uint64_t data_size_ = 0;
+    uint64_t count_ = 0;
+    uint64_t restarts_ = 0;
+    uint64_t filter_blocks_ = 0;
+    uint32_t interval_ = 0;
+    ResourceError error_ = ResourceError::Success;
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_FROZEN_SET_H
@@ -0,0 +1,333 @@
+#ifndef RESOURCE_TOOLS_HTTP_RESOURCE_H
+#define RESOURCE_TOOLS_HTTP_RESOURCE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// HTTP BUNDLE FORMAT
+// ============================================================================
+
+/**
+ * Resources embedded with HTTP are stored as a bundle holding the identity
+ * body and each precompressed variant, every one preceded by a prebuilt
+ * HTTP/1.1 response header:
+ *
+ *   Header   (32 bytes): magic, version, variant count, content hash, MIME type
+ *   Entries  (32 bytes each): content coding, ETag, response offset and sizes
+ *   Strings and responses (header immediately followed by body)
+ *
+ * All integers are little-endian. The bundle is produced at build time by
+ * the resource_packer tool.
+ */
+namespace http {
+
+constexpr uint32_t kMagic = 0x42485452u;  // "RTHB"
+constexpr uint16_t kVersion = 1;
+constexpr size_t kHeaderSize = 32;
+constexpr size_t kEntrySize = 32;
+
+} // namespace http
+
+/**
+ * HTTP content codings a bundle can hold, in order of preference
+ */
+enum class ContentCoding : uint16_t {
+    Identity = 0,
+    Gzip = 1,
+    Brotli = 2,
+    Zstd = 3
+};
+
+/**
+ * Content-Encoding token for a content coding
+ */
+inline auto to_string(ContentCoding coding) -> const char* {
+    switch (coding) {
+        case ContentCoding::Identity: return "identity";
+        case ContentCoding::Gzip: return "gzip";
+        case ContentCoding::Brotli: return "br";
+        case ContentCoding::Zstd: return "zstd";
+    }
+    return "identity";
+}
+
+/**
+ * One representation of an HTTP resource
+ */
+struct HttpVariant {
+    ContentCoding coding = ContentCoding::Identity;
+    ResourceResult body;       // Encoded body bytes
+    ResourceResult response;   // Status line, headers and body, ready for a single write()
+    std::string_view etag;     // Strong ETag, including quotes
+    ResourceError error = ResourceError::Success;
+
+    explicit operator bool() const { return error == ResourceError::Success; }
+};
+
+namespace detail {
+
+inline auto ascii_lower(char c) -> char {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+inline auto iequals(std::string_view a, std::string_view b) -> bool {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (ascii_lower(a[i]) != ascii_lower(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline auto trim(std::string_view s) -> std::string_view {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+// Parse a qvalue ("1", "0.5", "0.125") into thousandths
+inline auto parse_qvalue(std::string_view q) -> int {
+    if (q.empty() || (q[0] != '0' && q[0] != '1')) {
+        return 0;
+    }
+    int value = (q[0] - '0') * 1000;
+    if (q.size() > 1 && q[1] == '.') {
+        int scale = 100;
+        for (size_t i = 2; i < q.size() && i < 5; ++i) {
+            if (q[i] < '0' || q[i] > '9') {
+                break;
+            }
+            value += (q[i] - '0') * scale;
+            scale /= 10;
+        }
+    }
+    return value > 1000 ? 1000 : value;
+}
+
+/**
+ * Quality (0-1000) the client gives a content coding in an Accept-Encoding
+ * header, or -1 if the coding is not mentioned
+ */
+inline auto coding_quality(std::string_view accept_encoding, ContentCoding coding) -> int {
+    const std::string_view name = to_string(coding);
+    int wildcard = -1;
+    while (!accept_encoding.empty()) {
+        size_t comma = accept_encoding.find(',');
+        std::string_view item = accept_encoding.substr(0, comma);
+        accept_encoding = comma == std::string_view::npos ? std::string_view{} : accept_encoding.substr(comma + 1);
+
+        size_t semicolon = item.find(';');
+        std::string_view token = trim(item.substr(0, semicolon));
+        int quality = 1000;
+        if (semicolon != std::string_view::npos) {
+            std::string_view params = trim(item.substr(semicolon + 1));
+            if (params.size() > 2 && ascii_lower(params[0]) == 'q' && params[1] == '=') {
+                quality = parse_qvalue(trim(params.substr(2)));
+            }
+        }
+
+        if (iequals(token, name) || (coding == ContentCoding::Gzip && iequals(token, "x-gzip"))) {
+            return quality;
+        }
+        if (token == "*") {
+            wildcard = quality;
+        }
+    }
+    return wildcard;
+}
+
+} // namespace detail
+
+// ============================================================================
+// HTTP RESOURCE VIEW
+// ============================================================================
+
+/**
+ * Read-only view of an embedded HTTP bundle
+ *
+ * Everything is precomputed at build time, so serving a request is a table
+ * lookup with no compression, hashing or header formatting.
+ *
+ * Example:
+ *   auto resource = web::getAppJSHttp();
+ *   auto variant = resource.select(request.header("Accept-Encoding"));
+ *   write(fd, variant.response.data, variant.response.size);
+ */
+class HttpResource {
+public:
+    explicit HttpResource(const ResourceResult& bundle) {
+        if (!bundle) {
+            error_ = bundle.error;
+            return;
+        }
+        if (bundle.size < http::kHeaderSize ||
+            packed::load_le32(bundle.data) != http::kMagic ||
+            packed::load_le16(bundle.data + 4) != http::kVersion) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        count_ = packed::load_le16(bundle.data + 6);
+        if (count_ == 0 || count_ > (bundle.size - http::kHeaderSize) / http::kEntrySize) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+        bundle_ = bundle;
+
+        if (!string_at(packed::load_le32(bundle.data + 8), packed::load_le32(bundle.data + 12), hash_) ||
+            !string_at(packed::load_le32(bundle.data + 16), packed::load_le32(bundle.data + 20), mime_type_)) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        // Validate every entry up front so lookups cannot fail later
+        for (size_t i = 0; i < count_; ++i) {
+            if (!entry(i)) {
+                error_ = ResourceError::CorruptData;
+                return;
+            }
+        }
+        if (entry(0).coding != ContentCoding::Identity) {
+            error_ = ResourceError::CorruptData;
+        }
+    }
+
+    auto error() const -> ResourceError { return error_; }
+    explicit operator bool() const { return error_ == ResourceError::Success; }
+
+    /**
+     * MIME type for the Content-Type header
+     */
+    auto mime_type() const -> std::string_view { return mime_type_; }
+
+    /**
+     * Hex SHA-256 of the identity body
+     */
+    auto content_hash() const -> std::string_view { return hash_; }
+
+    /**
+     * Strong ETag of the identity body
+     */
+    auto etag() const -> std::string_view { return identity().etag; }
+
+    /**
+     * Number of stored representations, including identity
+     */
+    auto variant_count() const -> size_t { return error_ == ResourceError::Success ? count_ : 0; }
+
+    /**
+     * The uncompressed representation
+     */
+    auto identity() const -> HttpVariant {
+        return error_ == ResourceError::Success ? entry(0) : failed(ContentCoding::Identity, error_);
+    }
+
+    /**
+     * A specific representation; error is NotFound if it was not built
+     */
+    auto variant(ContentCoding coding) const -> HttpVariant {
+        if (error_ != ResourceError::Success) {
+            return failed(coding, error_);
+        }
+        for (size_t i = 0; i < count_; ++i) {
+            HttpVariant candidate = entry(i);
+            if (candidate.coding == coding) {
+                return candidate;
+            }
+        }
+        return failed(coding, ResourceError::NotFound);
+    }
+
+    /**
+     * Best representation for a request's Accept-Encoding header
+     *
+     * Picks the representation with the highest quality value, preferring
+     * the smaller body on ties. Identity competes like any other coding,
+     * through "identity" or "*"; if the header names neither, identity is
+     * acceptable but ranks below every coding the client asked for. When
+     * the client refuses everything stored, identity is returned anyway.
+     */
+    auto select(std::string_view accept_encoding) const -> HttpVariant {
+        HttpVariant best = identity();
+        if (error_ != ResourceError::Success) {
+            return best;
+        }
+
+        int best_quality = detail::coding_quality(accept_encoding, ContentCoding::Identity);
+        if (best_quality < 0) {
+            best_quality = 1;
+        }
+        for (size_t i = 1; i < count_; ++i) {
+            HttpVariant candidate = entry(i);
+            int quality = detail::coding_quality(accept_encoding, candidate.coding);
+            if (quality <= 0) {
+                continue;
+            }
+            if (quality > best_quality || (quality == best_quality && candidate.body.size < best.body.size)) {
+                best = candidate;
+                best_quality = quality;
+            }
+        }
+        return best;
+    }
+
+private:
+    static auto failed(ContentCoding coding, ResourceError error) -> HttpVariant {
+        return {coding, {nullptr, 0, error}, {nullptr, 0, error}, {}, error};
+    }
+
+    auto string_at(uint64_t offset, uint64_t length, std::string_view& out) const -> bool {
+        if (length > bundle_.size || offset > bundle_.size - length) {
+            return false;
+        }
+        out = std::string_view(reinterpret_cast<const char*>(bundle_.data + offset), static_cast<size_t>(length));
+        return true;
+    }
+
+    auto entry(size_t index) const -> HttpVariant {
+        const uint8_t* p = bundle_.data + http::kHeaderSize + index * http::kEntrySize;
+        HttpVariant variant;
+        variant.coding = static_cast<ContentCoding>(packed::load_le16(p));
+        const uint32_t etag_offset = packed::load_le32(p + 4);
+        const uint32_t etag_length = packed::load_le32(p + 8);
+        const uint64_t offset = packed::load_le64(p + 12);
+        const uint32_t header_size = packed::load_le32(p + 20);
+        const uint64_t body_size = packed::load_le64(p + 24);
+
+        const uint64_t response_size = header_size + body_size;
+        if (response_size < body_size || response_size > bundle_.size || offset > bundle_.size - response_size ||
+            !string_at(etag_offset, etag_length, variant.etag) ||
+            static_cast<uint16_t>(variant.coding) > static_cast<uint16_t>(ContentCoding::Zstd)) {
+            return failed(variant.coding, ResourceError::CorruptData);
+        }
+
+        const uint8_t* response = bundle_.data + offset;
+        variant.response = {response, static_cast<size_t>(response_size), ResourceError::Success};
+        variant.body = {response + header_size, static_cast<size_t>(body_size), ResourceError::Success};
+        return variant;
+    }
+
+    ResourceResult bundle_;
+    size_t count_ = 0;
+    std::string_view hash_;
+    std::string_view mime_type_;
+    ResourceError error_ = ResourceError::Success;
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_HTTP_RESOURCE_H
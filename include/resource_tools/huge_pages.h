@@ -0,0 +1,336 @@
+#ifndef RESOURCE_TOOLS_HUGE_PAGES_H
+#define RESOURCE_TOOLS_HUGE_PAGES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/memory_advice.h>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+namespace resource_tools {
+
+// ============================================================================
+// HUGE PAGES
+// ============================================================================
+
+/**
+ * Memory behind a HugePageResource
+ */
+enum class PageBacking : uint8_t {
+    Source,       // Not copied; the resource's own pages
+    Transparent,  // Anonymous memory advised with MADV_HUGEPAGE
+    HugeTlb       // Reserved huge pages (MAP_HUGETLB)
+};
+
+/**
+ * Which huge pages a HugePageResource may use
+ */
+enum class HugePagePolicy : uint8_t {
+    Auto,         // Reserved huge pages if any are free, else transparent ones
+    Transparent,  // Transparent huge pages only
+    HugeTlb       // Reserved huge pages only
+};
+
+namespace detail {
+
+constexpr size_t kDefaultHugePageSize = size_t{2} * 1024 * 1024;
+
+/**
+ * Size of the default huge page, from /proc/meminfo
+ */
+inline auto huge_page_size() -> size_t {
+#if defined(__linux__)
+    static const size_t size = [] {
+        size_t kb = 0;
+        if (FILE* meminfo = std::fopen("/proc/meminfo", "r")) {
+            char line[128];
+            while (std::fgets(line, sizeof(line), meminfo)) {
+                if (std::sscanf(line, "Hugepagesize: %zu kB", &kb) == 1) {
+                    break;
+                }
+            }
+            std::fclose(meminfo);
+        }
+        return kb != 0 ? kb * 1024 : kDefaultHugePageSize;
+    }();
+    return size;
+#else
+    return kDefaultHugePageSize;
+#endif
+}
+
+/**
+ * Whether MADV_HUGEPAGE can take effect, i.e. THP is not switched off
+ */
+inline auto transparent_huge_pages_enabled() -> bool {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    static const bool enabled = [] {
+        char mode[128] = {};
+        FILE* file = std::fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+        if (!file) {
+            return false;
+        }
+        const bool read = std::fgets(mode, sizeof(mode), file) != nullptr;
+        std::fclose(file);
+        return read && std::strstr(mode, "[never]") == nullptr;
+    }();
+    return enabled;
+#else
+    return false;
+#endif
+}
+
+inline auto round_up(size_t value, size_t multiple) -> size_t {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+#if defined(__linux__)
+
+/**
+ * Map `length` bytes of reserved huge pages, or return nullptr
+ */
+inline auto map_huge_tlb(size_t length) -> void* {
+    #if defined(MAP_HUGETLB)
+    void* memory = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    return memory == MAP_FAILED ? nullptr : memory;
+    #else
+    static_cast<void>(length);
+    return nullptr;
+    #endif
+}
+
+/**
+ * Map `length` bytes of anonymous memory starting on a huge page boundary
+ * and advise it with MADV_HUGEPAGE, or return nullptr
+ *
+ * The kernel only uses a huge page for a fully aligned huge page of the
+ * mapping, so a larger mapping is made and trimmed to an aligned start.
+ */
+inline auto map_transparent(size_t length) -> void* {
+    #if defined(MADV_HUGEPAGE)
+    const size_t huge = huge_page_size();
+    void* reserved = mmap(nullptr, length + huge, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+        return nullptr;
+    }
+    const auto base = reinterpret_cast<uintptr_t>(reserved);
+    const uintptr_t aligned = round_up(base, huge);
+    if (aligned > base) {
+        munmap(reserved, aligned - base);
+    }
+    if (const size_t tail = base + huge - aligned; tail > 0) {
+        munmap(reinterpret_cast<void*>(aligned + length), tail);
+    }
+    void* memory = reinterpret_cast<void*>(aligned);
+    if (madvise(memory, length, MADV_HUGEPAGE) != 0) {
+        munmap(memory, length);
+        return nullptr;
+    }
+    return memory;
+    #else
+    static_cast<void>(length);
+    return nullptr;
+    #endif
+}
+
+/**
+ * Whether every mapping in [start, end) is private and writable, so its
+ * pages can be replaced by an anonymous copy without changing what the
+ * program sees
+ */
+inline auto private_writable(uintptr_t start, uintptr_t end) -> bool {
+    FILE* maps = std::fopen("/proc/self/maps", "r");
+    if (!maps) {
+        return false;
+    }
+    uintptr_t covered = start;
+    char line[512];
+    while (covered < end && std::fgets(line, sizeof(line), maps)) {
+        unsigned long low = 0;
+        unsigned long high = 0;
+        char perms[5] = {};
+        if (std::sscanf(line, "%lx-%lx %4s", &low, &high, perms) != 3 || high <= covered || low >= end) {
+            continue;
+        }
+        if (low > covered || std::strcmp(perms, "rw-p") != 0) {
+            break;
+        }
+        covered = high;
+    }
+    std::fclose(maps);
+    return covered >= end;
+}
+
+#endif // __linux__
+
+} // namespace detail
+
+/**
+ * Copy of a large resource in huge-page backed memory
+ *
+ * Random access over a large resource touches a different 4 KB page almost
+ * every time, and each of them needs its own TLB entry. A copy backed by
+ * 2 MB pages needs 512 times fewer. The copy is made once on construction
+ * and is read-only afterwards.
+ *
+ * Reserved huge pages (MAP_HUGETLB) are only available when the
+ * administrator has set some aside (vm.nr_hugepages). Transparent huge pages
+ * are best effort: the kernel falls back to normal pages when it cannot find
+ * free 2 MB blocks. When neither can be used, or the resource is smaller
+ * than one huge page, get() returns the source itself and backing() is
+ * PageBacking::Source. Linux only; elsewhere the source is always used.
+ *
+ * Example:
+ *   resource_tools::HugePageResource index(my_resources::getSearchIndexBIN());
+ *   auto data = index.get();
+ */
+class HugePageResource {
+public:
+    HugePageResource() = default;
+
+    /**
+     * @param source Resource to copy; get() returns it unchanged when no
+     *        copy is made
+     * @param policy Huge pages to try
+     */
+    explicit HugePageResource(const ResourceResult& source, HugePagePolicy policy = HugePagePolicy::Auto)
+        : result_(source) {
+        if (!source || !source.data || source.size < detail::huge_page_size()) {
+            return;
+        }
+#if defined(__linux__)
+        const size_t length = detail::round_up(source.size, detail::huge_page_size());
+        void* memory = nullptr;
+        if (policy != HugePagePolicy::Transparent) {
+            memory = detail::map_huge_tlb(length);
+            backing_ = PageBacking::HugeTlb;
+        }
+        if (!memory && policy != HugePagePolicy::HugeTlb && detail::transparent_huge_pages_enabled()) {
+            memory = detail::map_transparent(length);
+            backing_ = PageBacking::Transparent;
+        }
+        if (!memory) {
+            backing_ = PageBacking::Source;
+            detail::diagnostic_log("resource_tools: no huge pages available, using the resource in place");
+            return;
+        }
+        std::memcpy(memory, source.data, source.size);
+        mprotect(memory, length, PROT_READ);
+        memory_ = memory;
+        length_ = length;
+        result_.data = static_cast<const uint8_t*>(memory);
+#else
+        static_cast<void>(policy);
+#endif
+    }
+
+    ~HugePageResource() { release(); }
+
+    HugePageResource(const HugePageResource&) = delete;
+    auto operator=(const HugePageResource&) -> HugePageResource& = delete;
+
+    HugePageResource(HugePageResource&& other) noexcept
+        : result_(other.result_),
+          backing_(std::exchange(other.backing_, PageBacking::Source)),
+          memory_(std::exchange(other.memory_, nullptr)),
+          length_(std::exchange(other.length_, 0)) {}
+
+    auto operator=(HugePageResource&& other) noexcept -> HugePageResource& {
+        if (this != &other) {
+            release();
+            result_ = other.result_;
+            backing_ = std::exchange(other.backing_, PageBacking::Source);
+            memory_ = std::exchange(other.memory_, nullptr);
+            length_ = std::exchange(other.length_, 0);
+        }
+        return *this;
+    }
+
+    /**
+     * The copy, or the source if no copy was made (including its error)
+     */
+    auto get() const -> ResourceResult { return result_; }
+
+    auto backing() const -> PageBacking { return backing_; }
+
+private:
+    void release() {
+#if defined(__linux__)
+        if (memory_) {
+            munmap(memory_, length_);
+        }
+#endif
+        memory_ = nullptr;
+        length_ = 0;
+    }
+
+    ResourceResult result_{nullptr, 0, ResourceError::NullPointer};
+    PageBacking backing_ = PageBacking::Source;
+    void* memory_ = nullptr;
+    size_t length_ = 0;
+};
+
+/**
+ * Back a resource with transparent huge pages where it lies, keeping its
+ * address
+ *
+ * Every whole huge page inside the resource is replaced by a huge-page
+ * advised anonymous copy; the partial pages at either end keep their normal
+ * pages. Resources embedded with HUGE_PAGES start on a 2 MB boundary, so
+ * only their tail is left out. Pointers into the resource stay valid and
+ * the bytes never change, so it is safe while other threads read it.
+ *
+ * Only memory that is private and writable can be replaced: data embedded
+ * by embed_resources() on Linux and decoded copies qualify, while shared
+ * cache segments do not. Pin the resource (pin()) after remapping it, not
+ * before, as the new pages are not locked.
+ *
+ * @return Success; the resource's own error; Unsupported if the resource
+ *         holds no whole huge page, its memory cannot be replaced, or
+ *         transparent huge pages are unavailable; SystemError if the copy
+ *         could not be mapped
+ */
+inline auto remapToHugePages(const ResourceResult& resource) -> ResourceError {
+    bool empty = false;
+    ResourceError err = detail::check_resource(resource, empty);
+    if (err != ResourceError::Success) {
+        return err;
+    }
+#if defined(__linux__) && defined(MADV_HUGEPAGE) && defined(MREMAP_FIXED)
+    const size_t huge = detail::huge_page_size();
+    const auto begin = reinterpret_cast<uintptr_t>(resource.data);
+    const uintptr_t start = detail::round_up(begin, huge);
+    const uintptr_t end = (begin + resource.size) / huge * huge;
+    if (empty || start >= end || !detail::transparent_huge_pages_enabled() || !detail::private_writable(start, end)) {
+        return ResourceError::Unsupported;
+    }
+
+    const size_t length = end - start;
+    void* copy = detail::map_transparent(length);
+    if (!copy) {
+        detail::diagnostic_log("resource_tools: failed to map huge pages");
+        return ResourceError::SystemError;
+    }
+    std::memcpy(copy, reinterpret_cast<const void*>(start), length);
+    // Atomically moves the copy over the original pages
+    if (mremap(copy, length, length, MREMAP_MAYMOVE | MREMAP_FIXED, reinterpret_cast<void*>(start)) == MAP_FAILED) {
+        munmap(copy, length);
+        detail::diagnostic_log("resource_tools: failed to remap resource onto huge pages");
+        return ResourceError::SystemError;
+    }
+    return ResourceError::Success;
+#else
+    return ResourceError::Unsupported;
+#endif
+}
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_HUGE_PAGES_H
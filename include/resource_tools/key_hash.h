@@ -0,0 +1,55 @@
+#ifndef RESOURCE_TOOLS_KEY_HASH_H
+#define RESOURCE_TOOLS_KEY_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <resource_tools/packed_resource.h>
+
+namespace resource_tools {
+
+namespace detail {
+
+/**
+ * splitmix64 finalizer: a bijective mix in which every input bit affects
+ * every output bit
+ */
+inline auto mix64(uint64_t x) -> uint64_t {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+} // namespace detail
+
+/**
+ * Hash of a lookup key, as used by the tables built from STRING_TABLE
+ * resources
+ *
+ * The value is part of the embedded format: the build computes it with the
+ * same function, so it must never change for an existing format version.
+ * Not for content identity; see contentHash() for that.
+ */
+inline auto keyHash(std::string_view key, uint64_t seed = 0) -> uint64_t {
+    const auto* p = reinterpret_cast<const uint8_t*>(key.data());
+    size_t remaining = key.size();
+    uint64_t h = seed ^ (static_cast<uint64_t>(key.size()) * 0x9E3779B97F4A7C15ull);
+    while (remaining >= 8) {
+        h = detail::mix64(h ^ packed::load_le64(p));
+        p += 8;
+        remaining -= 8;
+    }
+    uint64_t tail = 0;
+    for (size_t i = 0; i < remaining; ++i) {
+        tail |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return detail::mix64(h ^ tail);
+}
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_KEY_HASH_H
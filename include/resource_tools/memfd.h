@@ -0,0 +1,200 @@
+#ifndef RESOURCE_TOOLS_MEMFD_H
+#define RESOURCE_TOOLS_MEMFD_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <resource_tools/embedded_resource.h>
+
+#if defined(__linux__)
+    #include <dlfcn.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace resource_tools {
+
+// ============================================================================
+// MEMFD EXPORT
+// ============================================================================
+
+/**
+ * File descriptor holding a resource, or an error
+ */
+struct MemfdResult {
+    int fd = -1;
+    ResourceError error = ResourceError::Success;
+
+    explicit operator bool() const { return error == ResourceError::Success; }
+};
+
+namespace detail {
+
+#if defined(__linux__) && defined(MFD_ALLOW_SEALING)
+
+/**
+ * Sealed memfds made so far, keyed by the resource's address and size
+ */
+class MemfdCache {
+public:
+    static auto global() -> MemfdCache& {
+        static MemfdCache cache;
+        return cache;
+    }
+
+    auto get(const ResourceResult& resource, const char* name) -> MemfdResult {
+        const Key key{resource.data, resource.size};
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto it = fds_.find(key); it != fds_.end()) {
+            return {it->second, ResourceError::Success};
+        }
+        const int fd = create(resource, name);
+        if (fd < 0) {
+            return {-1, ResourceError::SystemError};
+        }
+        fds_.emplace(key, fd);
+        return {fd, ResourceError::Success};
+    }
+
+private:
+    using Key = std::pair<const uint8_t*, size_t>;
+
+    static auto create(const ResourceResult& resource, const char* name) -> int {
+        unsigned flags = MFD_CLOEXEC | MFD_ALLOW_SEALING;
+    #if defined(MFD_EXEC)
+        // Keeps the memfd executable where vm.memfd_noexec defaults to
+        // non-executable; kernels before 6.3 reject the flag
+        int fd = memfd_create(name, flags | MFD_EXEC);
+        if (fd < 0) {
+            fd = memfd_create(name, flags);
+        }
+    #else
+        int fd = memfd_create(name, flags);
+    #endif
+        if (fd < 0) {
+            diagnostic_log("resource_tools: memfd_create failed");
+            return -1;
+        }
+        size_t written = 0;
+        while (written < resource.size) {
+            const ssize_t n = write(fd, resource.data + written, resource.size - written);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                break;
+            }
+            written += static_cast<size_t>(n);
+        }
+        // Sealed, the contents can never change, so every user can share it
+        if (written != resource.size ||
+            fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+            diagnostic_log("resource_tools: failed to fill and seal memfd");
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    std::mutex mutex_;
+    std::map<Key, int> fds_;
+};
+
+#endif // __linux__ && MFD_ALLOW_SEALING
+
+} // namespace detail
+
+/**
+ * Expose a resource as a file descriptor, without touching disk
+ *
+ * For APIs that only take a file descriptor or a path, such as font
+ * engines, dlopen() and fexecve(). The resource is copied once into a
+ * memfd that is sealed against any change, and repeated calls for the same
+ * resource return the same descriptor. The descriptor is owned by
+ * resource_tools and stays open until the process exits: do not close it,
+ * and duplicate it (dup()) to hand out an owned descriptor. It is
+ * close-on-exec.
+ *
+ * Resources are recognised by their address, so pass resources that live
+ * for the whole program, as every generated accessor returns.
+ *
+ * @param resource Resource to export
+ * @param name Name shown for the descriptor in /proc/<pid>/fd (debugging only)
+ * @return The descriptor; the resource's own error, Unsupported on
+ *         platforms without memfd_create(), or SystemError
+ */
+inline auto asMemfd(const ResourceResult& resource, const char* name = "resource_tools") -> MemfdResult {
+    if (!resource) {
+        return {-1, resource.error};
+    }
+    if (!resource.data) {
+        return {-1, ResourceError::NullPointer};
+    }
+#if defined(__linux__) && defined(MFD_ALLOW_SEALING)
+    return detail::MemfdCache::global().get(resource, name);
+#else
+    static_cast<void>(name);
+    return {-1, ResourceError::Unsupported};
+#endif
+}
+
+#if defined(__linux__)
+
+/**
+ * Path that opens the memfd of a resource, for APIs that take a path
+ *
+ * @return "/proc/self/fd/<fd>", or an empty string if asMemfd() failed
+ */
+inline auto memfdPath(const ResourceResult& resource) -> std::string {
+    const MemfdResult memfd = asMemfd(resource);
+    return memfd ? "/proc/self/fd/" + std::to_string(memfd.fd) : std::string();
+}
+
+/**
+ * Load an embedded shared library with dlopen(), without touching disk
+ *
+ * Link with ${CMAKE_DL_LIBS} on glibc older than 2.34.
+ *
+ * @param resource The shared library's bytes
+ * @param flags dlopen() flags
+ * @return Handle for dlsym() and dlclose(), or nullptr; dlerror() explains
+ *         a failed load
+ */
+inline auto dlopenResource(const ResourceResult& resource, int flags = RTLD_NOW | RTLD_LOCAL) -> void* {
+    const std::string path = memfdPath(resource);
+    return path.empty() ? nullptr : dlopen(path.c_str(), flags);
+}
+
+/**
+ * Replace the process with an embedded executable, as execve() does
+ *
+ * The executable must be a binary: scripts cannot be run this way, as the
+ * descriptor is closed before their interpreter could open it.
+ *
+ * @param resource The executable's bytes
+ * @param argv Argument list, ending in nullptr
+ * @param envp Environment, ending in nullptr
+ * @return Only on failure: the resource's own error or SystemError
+ */
+inline auto execResource(const ResourceResult& resource, char* const argv[], char* const envp[]) -> ResourceError {
+    const MemfdResult memfd = asMemfd(resource);
+    if (!memfd) {
+        return memfd.error;
+    }
+    fexecve(memfd.fd, argv, envp);
+    detail::diagnostic_log("resource_tools: fexecve failed");
+    return ResourceError::SystemError;
+}
+
+#endif // __linux__
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_MEMFD_H
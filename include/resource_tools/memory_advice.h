@@ -0,0 +1,208 @@
+#ifndef RESOURCE_TOOLS_MEMORY_ADVICE_H
+#define RESOURCE_TOOLS_MEMORY_ADVICE_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#include <resource_tools/embedded_resource.h>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace resource_tools {
+
+// ============================================================================
+// MEMORY ADVICE
+// ============================================================================
+
+/**
+ * How a resource is about to be used
+ */
+enum class Advice : uint8_t {
+    Normal,      // Default paging behaviour
+    WillNeed,    // Read it in now and map it, ahead of the first access
+    Sequential,  // Read ahead aggressively, drop pages soon after use
+    Random,      // Do not read ahead
+    DontNeed     // Not needed for a while; its pages may be reclaimed
+};
+
+namespace detail {
+
+/**
+ * Whole pages covering a resource
+ *
+ * Neighbouring resources can share the first and last page, so advice and
+ * pins reach a little beyond the resource itself.
+ */
+struct PageSpan {
+    void* start = nullptr;
+    size_t length = 0;
+};
+
+inline auto page_size() -> size_t {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwPageSize);
+#elif defined(__unix__) || defined(__APPLE__)
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+inline auto page_span(const ResourceResult& resource) -> PageSpan {
+    const size_t page = page_size();
+    const auto first = reinterpret_cast<uintptr_t>(resource.data) & ~(uintptr_t{page} - 1);
+    const auto last = (reinterpret_cast<uintptr_t>(resource.data) + resource.size + page - 1) & ~(uintptr_t{page} - 1);
+    return {reinterpret_cast<void*>(first), static_cast<size_t>(last - first)};
+}
+
+// Validate a resource before touching its pages; Success means nothing to do
+// only when `empty` is set
+inline auto check_resource(const ResourceResult& resource, bool& empty) -> ResourceError {
+    empty = false;
+    if (!resource) {
+        return resource.error;
+    }
+    if (!resource.data) {
+        return ResourceError::NullPointer;
+    }
+    empty = resource.size == 0;
+    return ResourceError::Success;
+}
+
+} // namespace detail
+
+/**
+ * Tell the kernel how a resource will be used
+ *
+ * Works on any resource: data embedded in the binary, decoded copies and
+ * shared cache segments alike. WillNeed starts reading the pages in and,
+ * where the kernel supports it (MADV_POPULATE_READ), maps them so the first
+ * access takes no page faults. DontNeed never discards data: it asks the
+ * kernel to reclaim the pages (MADV_PAGEOUT), which for decoded copies means
+ * swapping them out rather than dropping them.
+ *
+ * @param resource Resource to advise on
+ * @param advice Expected access pattern
+ * @return Success, the resource's own error, Unsupported on platforms
+ *         without paging advice, or SystemError if the kernel refused
+ */
+inline auto advise(const ResourceResult& resource, Advice advice) -> ResourceError {
+    bool empty = false;
+    ResourceError err = detail::check_resource(resource, empty);
+    if (err != ResourceError::Success || empty) {
+        return err;
+    }
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+    const detail::PageSpan span = detail::page_span(resource);
+    int rc = 0;
+    switch (advice) {
+        case Advice::Normal:
+            rc = posix_madvise(span.start, span.length, POSIX_MADV_NORMAL);
+            break;
+        case Advice::WillNeed:
+            rc = posix_madvise(span.start, span.length, POSIX_MADV_WILLNEED);
+    #if defined(MADV_POPULATE_READ)
+            // Older kernels reject it; the read-ahead above still helps
+            if (rc == 0 && madvise(span.start, span.length, MADV_POPULATE_READ) != 0 && errno != EINVAL) {
+                rc = errno;
+            }
+    #endif
+            break;
+        case Advice::Sequential:
+            rc = posix_madvise(span.start, span.length, POSIX_MADV_SEQUENTIAL);
+            break;
+        case Advice::Random:
+            rc = posix_madvise(span.start, span.length, POSIX_MADV_RANDOM);
+            break;
+        case Advice::DontNeed:
+    #if defined(MADV_PAGEOUT)
+            // Kernels before 5.4 and locked pages reject it with EINVAL
+            if (madvise(span.start, span.length, MADV_PAGEOUT) == 0) {
+                break;
+            }
+            if (errno != EINVAL) {
+                rc = errno;
+                break;
+            }
+    #endif
+            // MADV_DONTNEED would zero private anonymous pages; the POSIX
+            // hint never discards data
+            rc = posix_madvise(span.start, span.length, POSIX_MADV_DONTNEED);
+            break;
+    }
+    if (rc != 0) {
+        detail::diagnostic_log("resource_tools: madvise failed");
+        return ResourceError::SystemError;
+    }
+    return ResourceError::Success;
+#else
+    static_cast<void>(advice);
+    return ResourceError::Unsupported;
+#endif
+}
+
+namespace detail {
+
+inline auto lock_pages(const ResourceResult& resource, bool lock) -> ResourceError {
+    bool empty = false;
+    ResourceError err = check_resource(resource, empty);
+    if (err != ResourceError::Success || empty) {
+        return err;
+    }
+    const PageSpan span = page_span(resource);
+    const char* failure = lock ? "resource_tools: failed to pin resource pages"
+                               : "resource_tools: failed to unpin resource pages";
+#if defined(_WIN32)
+    if ((lock ? VirtualLock(span.start, span.length) : VirtualUnlock(span.start, span.length)) == 0) {
+        diagnostic_log(failure);
+        return ResourceError::SystemError;
+    }
+    return ResourceError::Success;
+#elif defined(__unix__) || defined(__APPLE__)
+    if ((lock ? mlock(span.start, span.length) : munlock(span.start, span.length)) != 0) {
+        diagnostic_log(failure);
+        return ResourceError::SystemError;
+    }
+    return ResourceError::Success;
+#else
+    static_cast<void>(span);
+    static_cast<void>(failure);
+    return ResourceError::Unsupported;
+#endif
+}
+
+} // namespace detail
+
+/**
+ * Lock a resource's pages into memory so they are never paged out
+ *
+ * Locks do not nest: unpinning a resource also unpins any other resource
+ * sharing its first or last page.
+ *
+ * @return Success, the resource's own error, Unsupported, or SystemError if
+ *         the lock limit (RLIMIT_MEMLOCK) or permissions forbid it
+ */
+inline auto pin(const ResourceResult& resource) -> ResourceError {
+    return detail::lock_pages(resource, true);
+}
+
+/**
+ * Undo pin()
+ */
+inline auto unpin(const ResourceResult& resource) -> ResourceError {
+    return detail::lock_pages(resource, false);
+}
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_MEMORY_ADVICE_H
@@ -0,0 +1,294 @@
+#ifndef RESOURCE_TOOLS_MUTABLE_VIEW_H
+#define RESOURCE_TOOLS_MUTABLE_VIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <span>
+#include <string>
+#include <utility>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/memory_advice.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__linux__)
+    #include <sys/sysmacros.h>
+#endif
+
+namespace resource_tools {
+
+// ============================================================================
+// MUTABLE VIEWS
+// ============================================================================
+
+/**
+ * Where the pages of a MutableView come from
+ */
+enum class ViewBacking : uint8_t {
+    None,    // No view (see MutableView::error())
+    File,    // Private mapping of the file the resource is mapped from
+    Memfd,   // Private mapping of an in-memory file holding a copy
+    Copy     // Plain copy
+};
+
+namespace detail {
+
+#if defined(__linux__)
+
+/**
+ * File and offset that a range of the address space is mapped from
+ */
+struct FileRange {
+    std::string path;
+    uint64_t offset = 0;
+    dev_t device = 0;
+    ino_t inode = 0;
+};
+
+/**
+ * Find the file that all of [start, start + length) is mapped from, using
+ * /proc/self/maps; the range must lie in one mapping
+ */
+inline auto find_file_range(uintptr_t start, size_t length, FileRange& range) -> bool {
+    FILE* maps = std::fopen("/proc/self/maps", "r");
+    if (!maps) {
+        return false;
+    }
+    bool found = false;
+    char line[4096];
+    while (!found && std::fgets(line, sizeof(line), maps)) {
+        unsigned long low = 0;
+        unsigned long high = 0;
+        unsigned long long offset = 0;
+        unsigned major = 0;
+        unsigned minor = 0;
+        unsigned long inode = 0;
+        int path_start = 0;
+        if (std::sscanf(line, "%lx-%lx %*4s %llx %x:%x %lu %n", &low, &high, &offset, &major, &minor, &inode,
+                        &path_start) < 6) {
+            continue;
+        }
+        if (start < low || start >= high) {
+            continue;
+        }
+        // Anonymous memory, or a range running into the next mapping
+        if (inode == 0 || line[path_start] != '/' || start + length > high) {
+            break;
+        }
+        std::string path(line + path_start);
+        if (!path.empty() && path.back() == '\n') {
+            path.pop_back();
+        }
+        range.path = std::move(path);
+        range.offset = offset + (start - low);
+        range.device = makedev(major, minor);
+        range.inode = static_cast<ino_t>(inode);
+        found = true;
+    }
+    std::fclose(maps);
+    return found;
+}
+
+/**
+ * Map the pages of `span` privately from the file they are mapped from
+ */
+inline auto map_file_copy_on_write(const PageSpan& span) -> void* {
+    FileRange range;
+    if (!find_file_range(reinterpret_cast<uintptr_t>(span.start), span.length, range)) {
+        return nullptr;
+    }
+    const int fd = open(range.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+    // The path may have been replaced since it was mapped, e.g. by a deploy
+    struct stat info {};
+    void* memory = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_dev == range.device && info.st_ino == range.inode) {
+        memory = mmap(nullptr, span.length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+                      static_cast<off_t>(range.offset));
+    }
+    close(fd);
+    return memory == MAP_FAILED ? nullptr : memory;
+}
+
+/**
+ * Copy `span` into a memfd and map it privately
+ */
+inline auto map_memfd_copy_on_write(const PageSpan& span) -> void* {
+    #if defined(MFD_CLOEXEC)
+    const int fd = memfd_create("resource_tools_view", MFD_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+    void* memory = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(span.length)) == 0) {
+        size_t written = 0;
+        while (written < span.length) {
+            const ssize_t n = pwrite(fd, static_cast<const uint8_t*>(span.start) + written, span.length - written,
+                                     static_cast<off_t>(written));
+            if (n <= 0) {
+                break;
+            }
+            written += static_cast<size_t>(n);
+        }
+        if (written == span.length) {
+            memory = mmap(nullptr, span.length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        }
+    }
+    close(fd);
+    return memory == MAP_FAILED ? nullptr : memory;
+    #else
+    static_cast<void>(span);
+    return nullptr;
+    #endif
+}
+
+#endif // __linux__
+
+} // namespace detail
+
+/**
+ * Private, writable view of a resource
+ *
+ * Writes go to the view only; the resource and other views are unchanged.
+ * Created by mutableView(). The view's pages are released on destruction.
+ */
+class MutableView {
+public:
+    MutableView() = default;
+
+    ~MutableView() { release(); }
+
+    MutableView(const MutableView&) = delete;
+    auto operator=(const MutableView&) -> MutableView& = delete;
+
+    MutableView(MutableView&& other) noexcept
+        : mapping_(std::exchange(other.mapping_, nullptr)),
+          mapping_length_(std::exchange(other.mapping_length_, 0)),
+          data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          backing_(std::exchange(other.backing_, ViewBacking::None)),
+          error_(std::exchange(other.error_, ResourceError::NullPointer)) {}
+
+    auto operator=(MutableView&& other) noexcept -> MutableView& {
+        if (this != &other) {
+            release();
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            mapping_length_ = std::exchange(other.mapping_length_, 0);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            backing_ = std::exchange(other.backing_, ViewBacking::None);
+            error_ = std::exchange(other.error_, ResourceError::NullPointer);
+        }
+        return *this;
+    }
+
+    auto data() -> uint8_t* { return data_; }
+    auto data() const -> const uint8_t* { return data_; }
+    auto size() const -> size_t { return size_; }
+    auto span() -> std::span<uint8_t> { return {data_, size_}; }
+    auto error() const -> ResourceError { return error_; }
+    auto backing() const -> ViewBacking { return backing_; }
+
+    explicit operator bool() const { return error_ == ResourceError::Success; }
+
+private:
+    friend auto mutableView(const ResourceResult& resource) -> MutableView;
+
+    void release() {
+        if (!mapping_) {
+            return;
+        }
+        if (backing_ == ViewBacking::Copy) {
+            ::operator delete(mapping_);
+        }
+#if defined(__unix__) || defined(__APPLE__)
+        else {
+            munmap(mapping_, mapping_length_);
+        }
+#endif
+        mapping_ = nullptr;
+    }
+
+    void* mapping_ = nullptr;
+    size_t mapping_length_ = 0;
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    ViewBacking backing_ = ViewBacking::None;
+    ResourceError error_ = ResourceError::NullPointer;
+};
+
+/**
+ * Make a private copy-on-write view of a resource
+ *
+ * For code that patches embedded defaults in place. Data embedded in the
+ * binary, and shared cache segments, are mapped again privately from the
+ * file they come from: nothing is copied up front, and only the pages that
+ * are written take memory of their own, so views of resources hundreds of
+ * megabytes large are cheap. Other resources, such as decoded copies, are
+ * copied once into a memfd that the view maps privately. Where neither
+ * works (and off Linux) the view is a plain copy.
+ *
+ * Example:
+ *   auto config = resource_tools::mutableView(defaults::getConfigBIN());
+ *   if (config) {
+ *       config.data()[kVersionOffset] = 2;
+ *   }
+ *
+ * @param resource Resource to view
+ * @return The view; its error() is the resource's own error, or
+ *         OutOfMemory if no view could be made
+ */
+inline auto mutableView(const ResourceResult& resource) -> MutableView {
+    MutableView view;
+    bool empty = false;
+    view.error_ = detail::check_resource(resource, empty);
+    if (view.error_ != ResourceError::Success || empty) {
+        return view;
+    }
+
+#if defined(__linux__)
+    const detail::PageSpan span = detail::page_span(resource);
+    const size_t skip = static_cast<size_t>(resource.data - static_cast<const uint8_t*>(span.start));
+    void* memory = detail::map_file_copy_on_write(span);
+    view.backing_ = ViewBacking::File;
+    if (!memory) {
+        memory = detail::map_memfd_copy_on_write(span);
+        view.backing_ = ViewBacking::Memfd;
+    }
+    if (memory) {
+        view.mapping_ = memory;
+        view.mapping_length_ = span.length;
+        view.data_ = static_cast<uint8_t*>(memory) + skip;
+        view.size_ = resource.size;
+        return view;
+    }
+#endif
+
+    void* copy = ::operator new(resource.size, std::nothrow);
+    if (!copy) {
+        view.backing_ = ViewBacking::None;
+        view.error_ = ResourceError::OutOfMemory;
+        return view;
+    }
+    std::memcpy(copy, resource.data, resource.size);
+    view.mapping_ = copy;
+    view.data_ = static_cast<uint8_t*>(copy);
+    view.size_ = resource.size;
+    view.backing_ = ViewBacking::Copy;
+    return view;
+}
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_MUTABLE_VIEW_H
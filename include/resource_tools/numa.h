@@ -0,0 +1,231 @@
+#ifndef RESOURCE_TOOLS_NUMA_H
+#define RESOURCE_TOOLS_NUMA_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#include <resource_tools/embedded_resource.h>
+
+#if defined(__linux__)
+    #include <linux/mempolicy.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace resource_tools {
+
+// ============================================================================
+// NUMA REPLICATION
+// ============================================================================
+
+/**
+ * NUMA nodes a ReplicatedResource spreads over
+ *
+ * systemNumaTopology() describes the machine. Tests and simulations can pass
+ * their own: a fake topology with several nodes works on any machine, as
+ * long as `bind_memory` is false so replicas are not bound to nodes that do
+ * not exist.
+ */
+struct NumaTopology {
+    size_t node_count = 1;                    // Node ids are 0 .. node_count - 1
+    unsigned (*current_node)() = nullptr;     // Node of the calling thread
+    bool bind_memory = false;                 // Place each replica on its node with mbind()
+};
+
+namespace detail {
+
+constexpr size_t kMaxNumaNodes = 1024;
+
+#if defined(__linux__)
+
+inline auto current_numa_node() -> unsigned {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return 0;
+    }
+    return node;
+}
+
+/**
+ * Highest online node id plus one, from a list such as "0-1,4"
+ */
+inline auto online_numa_nodes() -> size_t {
+    FILE* file = std::fopen("/sys/devices/system/node/online", "r");
+    if (!file) {
+        return 1;
+    }
+    char list[256] = {};
+    const bool read = std::fgets(list, sizeof(list), file) != nullptr;
+    std::fclose(file);
+    size_t count = 1;
+    for (const char* p = list; read && *p;) {
+        char* next = nullptr;
+        const unsigned long id = std::strtoul(p, &next, 10);
+        if (next == p) {
+            ++p;
+            continue;
+        }
+        count = std::max<size_t>(count, id + 1);
+        p = next;
+    }
+    return std::min(count, kMaxNumaNodes);
+}
+
+/**
+ * Prefer `node` for pages not yet touched in [memory, memory + length)
+ *
+ * MPOL_PREFERRED rather than MPOL_BIND, so a full node spills over to
+ * another instead of failing the copy.
+ */
+inline auto prefer_numa_node(void* memory, size_t length, unsigned node) -> bool {
+    constexpr size_t bits = sizeof(unsigned long) * 8;
+    unsigned long mask[kMaxNumaNodes / bits] = {};
+    if (node >= kMaxNumaNodes) {
+        return false;
+    }
+    mask[node / bits] = 1UL << (node % bits);
+    return syscall(SYS_mbind, memory, length, MPOL_PREFERRED, mask, kMaxNumaNodes + 1, 0) == 0;
+}
+
+#endif // __linux__
+
+} // namespace detail
+
+/**
+ * The machine's NUMA nodes; a single node where NUMA is not supported
+ */
+inline auto systemNumaTopology() -> NumaTopology {
+#if defined(__linux__)
+    static const size_t nodes = detail::online_numa_nodes();
+    return {nodes, &detail::current_numa_node, true};
+#else
+    return {1, nullptr, false};
+#endif
+}
+
+/**
+ * Resource copied once per NUMA node, read from the caller's node
+ *
+ * For hot, read-mostly resources on multi-socket machines, where every
+ * thread otherwise reads the one copy on the node that first touched it.
+ * A node's replica is made the first time a thread on that node calls
+ * get(), on memory placed on that node. On a single-node machine no copies
+ * are made and get() returns the source.
+ *
+ * If a replica cannot be allocated, that node keeps reading the source.
+ *
+ * Example:
+ *   static const resource_tools::ReplicatedResource table(assets::getLookupBIN());
+ *   auto local = table.get();
+ */
+class ReplicatedResource {
+public:
+    /**
+     * @param source Resource to replicate; must stay valid while this
+     *        object is used (embedded resources always do)
+     * @param topology Nodes to replicate over
+     */
+    explicit ReplicatedResource(const ResourceResult& source, NumaTopology topology = systemNumaTopology())
+        : source_(source),
+          topology_(topology),
+          replicas_(topology.node_count > 1 ? std::make_unique<Replica[]>(topology.node_count) : nullptr) {}
+
+    ~ReplicatedResource() {
+#if defined(__linux__)
+        for (size_t node = 0; replicas_ && node < topology_.node_count; ++node) {
+            if (void* memory = const_cast<uint8_t*>(replicas_[node].data.load(std::memory_order_relaxed))) {
+                munmap(memory, replicas_[node].length);
+            }
+        }
+#endif
+    }
+
+    ReplicatedResource(const ReplicatedResource&) = delete;
+    auto operator=(const ReplicatedResource&) -> ReplicatedResource& = delete;
+
+    /**
+     * The replica on the calling thread's node
+     */
+    auto get() const -> ResourceResult {
+        if (!replicas_ || !topology_.current_node) {
+            return source_;
+        }
+        return get(topology_.current_node());
+    }
+
+    /**
+     * The replica on `node`, made on first use; the source for node ids
+     * outside the topology
+     */
+    auto get(unsigned node) const -> ResourceResult {
+        if (!replicas_ || node >= topology_.node_count || !source_ || !source_.data || source_.size == 0) {
+            return source_;
+        }
+        Replica& replica = replicas_[node];
+        const uint8_t* data = replica.data.load(std::memory_order_acquire);
+        if (!data) {
+            std::call_once(replica.once, [&] { make_replica(node, replica); });
+            data = replica.data.load(std::memory_order_acquire);
+        }
+        return data ? ResourceResult{data, source_.size, ResourceError::Success} : source_;
+    }
+
+    /**
+     * Number of replicas made so far
+     */
+    auto replica_count() const -> size_t {
+        size_t count = 0;
+        for (size_t node = 0; replicas_ && node < topology_.node_count; ++node) {
+            count += replicas_[node].data.load(std::memory_order_relaxed) != nullptr ? 1 : 0;
+        }
+        return count;
+    }
+
+    auto topology() const -> const NumaTopology& { return topology_; }
+
+private:
+    struct Replica {
+        std::once_flag once;
+        std::atomic<const uint8_t*> data{nullptr};
+        size_t length = 0;
+    };
+
+    void make_replica(unsigned node, Replica& replica) const {
+#if defined(__linux__)
+        const size_t length = source_.size;
+        void* memory = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            detail::diagnostic_log("resource_tools: failed to allocate a NUMA replica, reading the source");
+            return;
+        }
+        // Policy only applies to pages touched afterwards, so bind before copying
+        if (topology_.bind_memory && !detail::prefer_numa_node(memory, length, node)) {
+            detail::diagnostic_log("resource_tools: mbind failed, NUMA replica placed by first touch");
+        }
+        std::memcpy(memory, source_.data, length);
+        mprotect(memory, length, PROT_READ);
+        replica.length = length;
+        replica.data.store(static_cast<const uint8_t*>(memory), std::memory_order_release);
+#else
+        static_cast<void>(node);
+        static_cast<void>(replica);
+#endif
+    }
+
+    ResourceResult source_;
+    NumaTopology topology_;
+    std::unique_ptr<Replica[]> replicas_;
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_NUMA_H
@@ -0,0 +1,755 @@
+#ifndef RESOURCE_TOOLS_PACKED_RESOURCE_H
+#define RESOURCE_TOOLS_PACKED_RESOURCE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+
+#include <resource_tools/embedded_resource.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// PACKED CONTAINER FORMAT
+// ============================================================================
+
+/**
+ * Build-time encoded resources are embedded as a small container:
+ *
+ *   Header (32 bytes, little-endian) followed by an encoding-specific payload.
+ *
+ * The container is produced by the resource_packer tool that embed_resources()
+ * runs at build time, and decoded lazily by the generated accessors.
+ */
+namespace packed {
+
+constexpr uint32_t kMagic = 0x4B505452u;  // "RTPK"
+constexpr uint16_t kVersion = 1;
+constexpr size_t kHeaderSize = 32;
+
+/**
+ * Payload encodings
+ */
+enum class Encoding : uint16_t {
+    Stored = 0,  // Payload is the resource itself
+    Sparse = 1,  // Payload lists the non-zero segments; everything else is zero
+    Chunked = 2, // Payload lists chunks held in a shared chunk store
+    Delta = 3,   // Payload is a list of copy/insert operations against a base resource
+    Lz = 4       // Payload is an LZ77 byte stream
+};
+
+/**
+ * Decoded container header
+ */
+struct Header {
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    Encoding encoding = Encoding::Stored;
+    uint64_t size = 0;          // Size of the decoded resource
+    uint64_t payload_size = 0;  // Bytes following the header
+    uint64_t key = 0;           // First 8 bytes of the decoded resource's SHA-256; 0 if not recorded
+};
+
+/**
+ * Sparse payload: uint64 segment count, then (offset, length) pairs,
+ * then the bytes of each segment in order
+ */
+struct SparseSegment {
+    uint64_t offset = 0;
+    uint64_t length = 0;
+};
+
+/**
+ * Chunked payload: uint64 chunk count, then (offset, length) pairs locating
+ * each chunk inside the payload of the chunk store container
+ */
+struct ChunkRef {
+    uint64_t offset = 0;
+    uint64_t length = 0;
+};
+
+/**
+ * Delta payload: uint64 operation count, then each operation as a one-byte
+ * opcode followed by its operands
+ */
+enum class DeltaOp : uint8_t {
+    Copy = 0,   // uint64 base offset, uint64 length
+    Insert = 1  // uint64 length, then the literal bytes
+};
+
+/**
+ * LZ payload: a sequence of (literals, match) pairs. Each starts with a token
+ * byte holding the literal count in the high nibble and the match length
+ * minus kLzMinMatch in the low nibble; a nibble of 15 is followed by extension
+ * bytes that are added to it until one is below 255. The literals follow,
+ * then a uint16 match offset back into the output and the match. The last
+ * pair ends after its literals, once the output is complete.
+ */
+constexpr size_t kLzMinMatch = 4;
+constexpr size_t kLzWindow = 65535;
+
+inline auto load_le16(const uint8_t* p) -> uint16_t {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline auto load_le32(const uint8_t* p) -> uint32_t {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline auto load_le64(const uint8_t* p) -> uint64_t {
+    return static_cast<uint64_t>(load_le32(p)) | (static_cast<uint64_t>(load_le32(p + 4)) << 32);
+}
+
+inline void store_le16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline void store_le32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+
+inline void store_le64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+
+/**
+ * Parse and validate a container header
+ *
+ * @param blob Embedded container bytes
+ * @param header Receives the parsed header
+ * @return ResourceError::Success, or CorruptData if the container is malformed
+ */
+inline auto readHeader(const ResourceResult& blob, Header& header) -> ResourceError {
+    if (!blob) {
+        return blob.error;
+    }
+    if (blob.size < kHeaderSize) {
+        return ResourceError::CorruptData;
+    }
+
+    header.magic = load_le32(blob.data);
+    header.version = load_le16(blob.data + 4);
+    header.encoding = static_cast<Encoding>(load_le16(blob.data + 6));
+    header.size = load_le64(blob.data + 8);
+    header.payload_size = load_le64(blob.data + 16);
+    header.key = load_le64(blob.data + 24);
+
+    if (header.magic != kMagic || header.version != kVersion) {
+        return ResourceError::CorruptData;
+    }
+    if (header.payload_size != blob.size - kHeaderSize) {
+        return ResourceError::CorruptData;
+    }
+    if (header.size > SIZE_MAX) {
+        return ResourceError::IntegerOverflow;
+    }
+    return ResourceError::Success;
+}
+
+/**
+ * Serialise a container header (used by the build-time packer)
+ */
+inline void writeHeader(uint8_t* out, const Header& header) {
+    store_le32(out, kMagic);
+    store_le16(out + 4, kVersion);
+    store_le16(out + 6, static_cast<uint16_t>(header.encoding));
+    store_le64(out + 8, header.size);
+    store_le64(out + 16, header.payload_size);
+    store_le64(out + 24, header.key);
+}
+
+/**
+ * Get the payload of a Stored container, such as a chunk store
+ *
+ * @param blob Embedded container bytes
+ * @return The payload in place, or the reason the container is unusable
+ */
+inline auto storedPayload(const ResourceResult& blob) -> ResourceResult {
+    Header header;
+    ResourceError err = readHeader(blob, header);
+    if (err != ResourceError::Success) {
+        return {nullptr, 0, err};
+    }
+    if (header.encoding != Encoding::Stored || header.payload_size != header.size) {
+        return {nullptr, 0, ResourceError::CorruptData};
+    }
+    return {blob.data + kHeaderSize, static_cast<size_t>(header.size), ResourceError::Success};
+}
+
+/**
+ * Validate a chunk table against its chunk store
+ *
+ * @param header Header of the chunked container
+ * @param payload Payload of the chunked container
+ * @param store Payload of the chunk store
+ * @param count Receives the number of chunks
+ */
+inline auto validateChunks(const Header& header, const uint8_t* payload,
+                           const ResourceResult& store, uint64_t& count) -> ResourceError {
+    if (header.payload_size < 8) {
+        return ResourceError::CorruptData;
+    }
+    count = load_le64(payload);
+    if (count != (header.payload_size - 8) / 16 || (header.payload_size - 8) % 16 != 0) {
+        return ResourceError::CorruptData;
+    }
+
+    uint64_t total = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        const uint64_t offset = load_le64(payload + 8 + i * 16);
+        const uint64_t length = load_le64(payload + 16 + i * 16);
+        if (length > store.size || offset > store.size - length || length > header.size - total) {
+            return ResourceError::CorruptData;
+        }
+        total += length;
+    }
+    return total == header.size ? ResourceError::Success : ResourceError::CorruptData;
+}
+
+} // namespace packed
+
+// ============================================================================
+// DECODING
+// ============================================================================
+
+namespace detail {
+
+inline auto decode_chunked(const packed::Header& header, const uint8_t* payload,
+                           const ResourceResult& reference, uint8_t* out) -> ResourceError {
+    ResourceResult store = packed::storedPayload(reference);
+    if (!store) {
+        return store.error == ResourceError::NullPointer ? ResourceError::CorruptData : store.error;
+    }
+
+    uint64_t count = 0;
+    ResourceError err = packed::validateChunks(header, payload, store, count);
+    if (err != ResourceError::Success) {
+        return err;
+    }
+
+    for (uint64_t i = 0; i < count; ++i) {
+        const uint64_t offset = packed::load_le64(payload + 8 + i * 16);
+        const uint64_t length = packed::load_le64(payload + 16 + i * 16);
+        std::memcpy(out, store.data + offset, static_cast<size_t>(length));
+        out += length;
+    }
+    return ResourceError::Success;
+}
+
+inline auto decode_sparse(const packed::Header& header, const uint8_t* payload,
+                          uint8_t* out, bool out_is_zeroed) -> ResourceError {
+    const uint64_t payload_size = header.payload_size;
+    if (payload_size < 8) {
+        return ResourceError::CorruptData;
+    }
+
+    const uint64_t count = packed::load_le64(payload);
+    if (count > (payload_size - 8) / 16) {
+        return ResourceError::CorruptData;
+    }
+
+    const uint8_t* table = payload + 8;
+    const uint8_t* bytes = table + count * 16;
+    const uint8_t* payload_end = payload + payload_size;
+    uint64_t cursor = 0;
+
+    for (uint64_t i = 0; i < count; ++i) {
+        const uint64_t offset = packed::load_le64(table + i * 16);
+        const uint64_t length = packed::load_le64(table + i * 16 + 8);
+
+        // Segments must be ordered, non-overlapping and inside the resource
+        if (offset < cursor || length > header.size || offset > header.size - length) {
+            return ResourceError::CorruptData;
+        }
+        if (length > static_cast<uint64_t>(payload_end - bytes)) {
+            return ResourceError::CorruptData;
+        }
+
+        if (!out_is_zeroed) {
+            std::memset(out + cursor, 0, static_cast<size_t>(offset - cursor));
+        }
+        std::memcpy(out + offset, bytes, static_cast<size_t>(length));
+        bytes += length;
+        cursor = offset + length;
+    }
+
+    if (bytes != payload_end) {
+        return ResourceError::CorruptData;
+    }
+    if (!out_is_zeroed) {
+        std::memset(out + cursor, 0, static_cast<size_t>(header.size - cursor));
+    }
+    return ResourceError::Success;
+}
+
+inline auto decode_delta(const packed::Header& header, const uint8_t* payload,
+                         const ResourceResult& reference, uint8_t* out) -> ResourceError {
+    ResourceResult base = packed::storedPayload(reference);
+    if (!base) {
+        return base.error == ResourceError::NullPointer ? ResourceError::CorruptData : base.error;
+    }
+    if (header.payload_size < 8) {
+        return ResourceError::CorruptData;
+    }
+
+    const uint8_t* cursor = payload + 8;
+    const uint8_t* payload_end = payload + header.payload_size;
+    const uint64_t count = packed::load_le64(payload);
+    uint64_t written = 0;
+
+    for (uint64_t i = 0; i < count; ++i) {
+        if (payload_end - cursor < 9) {
+            return ResourceError::CorruptData;
+        }
+        const auto op = static_cast<packed::DeltaOp>(cursor[0]);
+
+        if (op == packed::DeltaOp::Copy) {
+            if (payload_end - cursor < 17) {
+                return ResourceError::CorruptData;
+            }
+            const uint64_t offset = packed::load_le64(cursor + 1);
+            const uint64_t length = packed::load_le64(cursor + 9);
+            if (length > base.size || offset > base.size - length || length > header.size - written) {
+                return ResourceError::CorruptData;
+            }
+            std::memcpy(out + written, base.data + offset, static_cast<size_t>(length));
+            written += length;
+            cursor += 17;
+        } else if (op == packed::DeltaOp::Insert) {
+            const uint64_t length = packed::load_le64(cursor + 1);
+            cursor += 9;
+            if (length > static_cast<uint64_t>(payload_end - cursor) || length > header.size - written) {
+                return ResourceError::CorruptData;
+            }
+            std::memcpy(out + written, cursor, static_cast<size_t>(length));
+            written += length;
+            cursor += length;
+        } else {
+            return ResourceError::CorruptData;
+        }
+    }
+
+    if (cursor != payload_end || written != header.size) {
+        return ResourceError::CorruptData;
+    }
+    return ResourceError::Success;
+}
+
+// Read an LZ length nibble and its extension bytes
+inline auto lz_length(size_t nibble, const uint8_t*& cursor, const uint8_t* end, size_t& length) -> bool {
+    length = nibble;
+    if (nibble != 15) {
+        return true;
+    }
+    uint8_t extra = 255;
+    while (extra == 255) {
+        if (cursor == end) {
+            return false;
+        }
+        extra = *cursor++;
+        length += extra;
+    }
+    return true;
+}
+
+inline auto decode_lz(const packed::Header& header, const uint8_t* payload, uint8_t* out) -> ResourceError {
+    const uint8_t* cursor = payload;
+    const uint8_t* payload_end = payload + header.payload_size;
+    const size_t size = static_cast<size_t>(header.size);
+    size_t written = 0;
+
+    while (written < size) {
+        if (cursor == payload_end) {
+            return ResourceError::CorruptData;
+        }
+        const uint8_t token = *cursor++;
+
+        size_t literals = 0;
+        if (!lz_length(token >> 4, cursor, payload_end, literals) ||
+            literals > static_cast<size_t>(payload_end - cursor) || literals > size - written) {
+            return ResourceError::CorruptData;
+        }
+        std::memcpy(out + written, cursor, literals);
+        cursor += literals;
+        written += literals;
+        if (written == size) {
+            break;
+        }
+
+        if (payload_end - cursor < 2) {
+            return ResourceError::CorruptData;
+        }
+        const size_t offset = packed::load_le16(cursor);
+        cursor += 2;
+        size_t match = 0;
+        if (!lz_length(token & 0x0f, cursor, payload_end, match)) {
+            return ResourceError::CorruptData;
+        }
+        match += packed::kLzMinMatch;
+        if (offset == 0 || offset > written || match > size - written) {
+            return ResourceError::CorruptData;
+        }
+
+        // Matches may overlap the bytes they produce, so copy forwards
+        const uint8_t* source = out + written - offset;
+        for (size_t i = 0; i < match; ++i) {
+            out[written + i] = source[i];
+        }
+        written += match;
+    }
+
+    if (cursor != payload_end) {
+        return ResourceError::CorruptData;
+    }
+    return ResourceError::Success;
+}
+
+} // namespace detail
+
+/**
+ * Decode a packed container into a caller-provided buffer
+ *
+ * @param blob Embedded container bytes
+ * @param out Destination buffer of at least the decoded size
+ * @param out_size Size of the destination buffer
+ * @param reference Container the encoding refers to (the chunk store for
+ *        chunked resources, the base for delta resources); unused by
+ *        other encodings
+ * @param out_is_zeroed True if the buffer is already zero-filled, which lets
+ *        sparse resources skip writing their zero runs
+ * @return ResourceError::Success or the reason decoding failed
+ */
+inline auto decodePacked(const ResourceResult& blob, uint8_t* out, size_t out_size,
+                         const ResourceResult& reference = {},
+                         bool out_is_zeroed = false) -> ResourceError {
+    packed::Header header;
+    ResourceError err = packed::readHeader(blob, header);
+    if (err != ResourceError::Success) {
+        return err;
+    }
+    if (out_size < header.size) {
+        return ResourceError::InvalidSize;
+    }
+    if (header.size > 0 && !out) {
+        return ResourceError::NullPointer;
+    }
+
+    const uint8_t* payload = blob.data + packed::kHeaderSize;
+    switch (header.encoding) {
+        case packed::Encoding::Stored:
+            if (header.payload_size != header.size) {
+                return ResourceError::CorruptData;
+            }
+            std::memcpy(out, payload, static_cast<size_t>(header.size));
+            return ResourceError::Success;
+        case packed::Encoding::Sparse:
+            return detail::decode_sparse(header, payload, out, out_is_zeroed);
+        case packed::Encoding::Chunked:
+            return detail::decode_chunked(header, payload, reference, out);
+        case packed::Encoding::Delta:
+            return detail::decode_delta(header, payload, reference, out);
+        case packed::Encoding::Lz:
+            return detail::decode_lz(header, payload, out);
+    }
+    return ResourceError::CorruptData;
+}
+
+// ============================================================================
+// MEMORY RESOURCES
+// ============================================================================
+
+namespace detail {
+
+/**
+ * calloc-backed memory resource; see zeroedMemoryResource()
+ */
+class ZeroedMemoryResource final : public std::pmr::memory_resource {
+private:
+    // Over-aligned blocks keep the address calloc returned just before the block
+    static auto over_aligned_size(size_t bytes, size_t alignment) -> size_t {
+        return bytes + alignment + sizeof(void*);
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* block = nullptr;
+        if (alignment <= alignof(std::max_align_t)) {
+            // calloc(0) may return nullptr; always allocate at least one byte
+            block = std::calloc(bytes > 0 ? bytes : 1, 1);
+        } else if (void* raw = std::calloc(over_aligned_size(bytes, alignment), 1)) {
+            auto address = reinterpret_cast<uintptr_t>(raw) + sizeof(void*);
+            address = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+            block = reinterpret_cast<void*>(address);
+            std::memcpy(static_cast<uint8_t*>(block) - sizeof(void*), &raw, sizeof(void*));
+        }
+        if (!block) {
+#if defined(__cpp_exceptions)
+            throw std::bad_alloc();
+#else
+            std::abort();
+#endif
+        }
+        return block;
+    }
+
+    void do_deallocate(void* block, size_t, size_t alignment) override {
+        if (alignment <= alignof(std::max_align_t)) {
+            std::free(block);
+            return;
+        }
+        void* raw = nullptr;
+        std::memcpy(&raw, static_cast<uint8_t*>(block) - sizeof(void*), sizeof(void*));
+        std::free(raw);
+    }
+
+    auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override {
+        return this == &other;
+    }
+};
+
+// Decoded copies start on the same 64-byte boundary the formats are
+// embedded at, so a columnar table or typed array is still read in place
+constexpr size_t kDecodeAlignment = 64;
+
+/**
+ * Allocate a decode buffer, reporting failure as nullptr instead of throwing
+ */
+inline auto allocate_buffer(std::pmr::memory_resource* memory, size_t size) -> uint8_t* {
+#if defined(__cpp_exceptions)
+    try {
+        return static_cast<uint8_t*>(memory->allocate(size > 0 ? size : 1, kDecodeAlignment));
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+#else
+    return static_cast<uint8_t*>(memory->allocate(size > 0 ? size : 1, kDecodeAlignment));
+#endif
+}
+
+inline void deallocate_buffer(std::pmr::memory_resource* memory, uint8_t* buffer, size_t size) {
+    memory->deallocate(buffer, size > 0 ? size : 1, kDecodeAlignment);
+}
+
+} // namespace detail
+
+/**
+ * Default memory resource for decoded resources
+ *
+ * Hands out zero-filled memory from calloc. Decoders recognise it and skip
+ * writing zero runs, so pages that only hold zeros are never touched. Any
+ * other std::pmr::memory_resource can be passed to the materialising APIs
+ * instead, e.g. a per-request std::pmr::monotonic_buffer_resource; buffers
+ * from those are zeroed by the decoder where needed.
+ */
+inline auto zeroedMemoryResource() -> std::pmr::memory_resource* {
+    static detail::ZeroedMemoryResource resource;
+    return &resource;
+}
+
+/**
+ * Lazily decoded view of a packed resource
+ *
+ * Generated accessors hold one of these in a function-local static, so the
+ * resource is decoded once on first access and kept for the process lifetime.
+ * Stored resources are returned in place without copying. By default decoded
+ * buffers come from zeroedMemoryResource(), so pages that only hold zero runs
+ * are never touched and cost no file size or resident memory.
+ *
+ * @param blob Embedded container bytes
+ * @param reference Container the encoding refers to, as for decodePacked()
+ * @param memory Memory resource the decoded buffer is allocated from
+ */
+class PackedResource {
+public:
+    explicit PackedResource(const ResourceResult& blob, const ResourceResult& reference = {},
+                            std::pmr::memory_resource* memory = zeroedMemoryResource())
+        : memory_(memory) {
+        packed::Header header;
+        ResourceError err = packed::readHeader(blob, header);
+        if (err != ResourceError::Success) {
+            detail::diagnostic_log("resource_tools: invalid packed resource header");
+            result_ = {nullptr, 0, err};
+            return;
+        }
+
+        const size_t size = static_cast<size_t>(header.size);
+        if (header.encoding == packed::Encoding::Stored) {
+            if (header.payload_size != header.size) {
+                result_ = {nullptr, 0, ResourceError::CorruptData};
+                return;
+            }
+            result_ = {blob.data + packed::kHeaderSize, size, ResourceError::Success};
+            return;
+        }
+
+        buffer_ = detail::allocate_buffer(memory_, size);
+        if (!buffer_) {
+            detail::diagnostic_log("resource_tools: out of memory decoding packed resource");
+            result_ = {nullptr, 0, ResourceError::OutOfMemory};
+            return;
+        }
+        size_ = size;
+
+        err = decodePacked(blob, buffer_, size, reference, memory_ == zeroedMemoryResource());
+        if (err != ResourceError::Success) {
+            detail::diagnostic_log("resource_tools: failed to decode packed resource");
+            release();
+            result_ = {nullptr, 0, err};
+            return;
+        }
+        result_ = {buffer_, size, ResourceError::Success};
+    }
+
+    ~PackedResource() { release(); }
+
+    PackedResource(const PackedResource&) = delete;
+    auto operator=(const PackedResource&) -> PackedResource& = delete;
+
+    PackedResource(PackedResource&& other) noexcept
+        : result_(other.result_), buffer_(other.buffer_), size_(other.size_), memory_(other.memory_) {
+        other.buffer_ = nullptr;
+        other.result_ = {nullptr, 0, ResourceError::NullPointer};
+    }
+
+    auto operator=(PackedResource&& other) noexcept -> PackedResource& {
+        if (this != &other) {
+            release();
+            result_ = other.result_;
+            buffer_ = other.buffer_;
+            size_ = other.size_;
+            memory_ = other.memory_;
+            other.buffer_ = nullptr;
+            other.result_ = {nullptr, 0, ResourceError::NullPointer};
+        }
+        return *this;
+    }
+
+    /**
+     * Get the decoded resource
+     */
+    auto get() const -> ResourceResult { return result_; }
+
+private:
+    void release() {
+        if (buffer_) {
+            detail::deallocate_buffer(memory_, buffer_, size_);
+            buffer_ = nullptr;
+        }
+    }
+
+    ResourceResult result_;
+    uint8_t* buffer_ = nullptr;
+    size_t size_ = 0;
+    std::pmr::memory_resource* memory_;
+};
+
+// ============================================================================
+// CHUNK ITERATION
+// ============================================================================
+
+/**
+ * Zero-copy view of a chunked resource as a sequence of chunks
+ *
+ * Each chunk is returned as a ResourceResult pointing into the shared chunk
+ * store, so a resource can be streamed without reconstructing it.
+ *
+ * Example:
+ *   for (auto chunk : my_resources::getStringsJSONChunks()) {
+ *       write(fd, chunk.data, chunk.size);
+ *   }
+ */
+class ChunkRange {
+public:
+    class iterator {
+    public:
+        iterator() = default;
+        iterator(const uint8_t* entry, const uint8_t* store) : entry_(entry), store_(store) {}
+
+        auto operator*() const -> ResourceResult {
+            const uint64_t offset = packed::load_le64(entry_);
+            const uint64_t length = packed::load_le64(entry_ + 8);
+            return {store_ + offset, static_cast<size_t>(length), ResourceError::Success};
+        }
+
+        auto operator++() -> iterator& {
+            entry_ += 16;
+            return *this;
+        }
+
+        auto operator==(const iterator& other) const -> bool { return entry_ == other.entry_; }
+        auto operator!=(const iterator& other) const -> bool { return entry_ != other.entry_; }
+
+    private:
+        const uint8_t* entry_ = nullptr;
+        const uint8_t* store_ = nullptr;
+    };
+
+    /**
+     * @param blob Chunked container
+     * @param reference Chunk store container
+     */
+    ChunkRange(const ResourceResult& blob, const ResourceResult& reference) {
+        packed::Header header;
+        error_ = packed::readHeader(blob, header);
+        if (error_ != ResourceError::Success) {
+            return;
+        }
+        if (header.encoding != packed::Encoding::Chunked) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        ResourceResult store = packed::storedPayload(reference);
+        if (!store) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        const uint8_t* payload = blob.data + packed::kHeaderSize;
+        uint64_t count = 0;
+        error_ = packed::validateChunks(header, payload, store, count);
+        if (error_ != ResourceError::Success) {
+            return;
+        }
+
+        first_ = payload + 8;
+        count_ = static_cast<size_t>(count);
+        size_ = static_cast<size_t>(header.size);
+        store_ = store.data;
+    }
+
+    auto begin() const -> iterator { return {first_, store_}; }
+    auto end() const -> iterator { return {first_ + count_ * 16, store_}; }
+
+    /**
+     * Number of chunks
+     */
+    auto count() const -> size_t { return count_; }
+
+    /**
+     * Total size of the resource in bytes
+     */
+    auto size() const -> size_t { return size_; }
+
+    auto error() const -> ResourceError { return error_; }
+    explicit operator bool() const { return error_ == ResourceError::Success; }
+
+private:
+    const uint8_t* first_ = nullptr;
+    const uint8_t* store_ = nullptr;
+    size_t count_ = 0;
+    size_t size_ = 0;
+    ResourceError error_ = ResourceError::Success;
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_PACKED_RESOURCE_H
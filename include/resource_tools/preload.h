@@ -0,0 +1,324 @@
+#ifndef RESOURCE_TOOLS_PRELOAD_H
+#define RESOURCE_TOOLS_PRELOAD_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/resource_registry.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// PRELOADING
+// ============================================================================
+
+/**
+ * Order in which queued preloads run; all High work is started before any
+ * Normal work, and all Normal work before any Low work
+ */
+enum class PreloadPriority : uint8_t {
+    High = 0,
+    Normal = 1,
+    Low = 2
+};
+
+namespace detail {
+
+constexpr size_t kPreloadPriorities = 3;
+constexpr size_t kPreloadPageStride = 4096;
+
+/**
+ * Progress of one preload() call, shared by its tasks and handles
+ */
+struct PreloadBatch {
+    std::vector<ResourceEntry> entries;
+    std::atomic<size_t> remaining{0};
+    std::atomic<size_t> loaded{0};
+    std::atomic<size_t> failed{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    void complete(bool ok) {
+        (ok ? loaded : failed).fetch_add(1, std::memory_order_relaxed);
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.notify_all();
+        }
+    }
+};
+
+struct PreloadTask {
+    std::shared_ptr<PreloadBatch> batch;
+    size_t index = 0;
+};
+
+/**
+ * Decode a resource and fault in every page of it, reporting the time taken
+ */
+inline auto warm_up(const ResourceEntry& entry) -> bool {
+    const auto start = std::chrono::steady_clock::now();
+    const ResourceResult result = entry.get ? entry.get() : ResourceResult{nullptr, 0, ResourceError::NullPointer};
+    if (result) {
+        uint8_t sum = 0;
+        for (size_t offset = 0; offset < result.size; offset += kPreloadPageStride) {
+            sum ^= static_cast<const volatile uint8_t*>(result.data)[offset];
+        }
+        static_cast<void>(sum);
+    }
+    const auto micros =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    if (g_diagnostic_callback) {
+        char message[512];
+        if (result) {
+            std::snprintf(message, sizeof(message), "resource_tools: preloaded %s/%s (%zu bytes) in %lld us",
+                          entry.ns, entry.name, result.size, static_cast<long long>(micros));
+        } else {
+            std::snprintf(message, sizeof(message), "resource_tools: failed to preload %s/%s", entry.ns, entry.name);
+        }
+        diagnostic_log(message);
+    }
+    return static_cast<bool>(result);
+}
+
+} // namespace detail
+
+/**
+ * Waitable handle to the resources scheduled by one preload() call
+ *
+ * Copies share the same progress. A default-constructed handle is already
+ * done.
+ */
+class PreloadHandle {
+public:
+    PreloadHandle() = default;
+
+    /**
+     * Block until every resource has been loaded or has failed
+     */
+    void wait() const {
+        if (!batch_) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(batch_->mutex);
+        batch_->finished.wait(lock, [this] { return done(); });
+    }
+
+    /**
+     * Block for at most `timeout`
+     *
+     * @return true if every resource finished in time
+     */
+    template <typename Rep, typename Period>
+    auto wait_for(std::chrono::duration<Rep, Period> timeout) const -> bool {
+        if (!batch_) {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(batch_->mutex);
+        return batch_->finished.wait_for(lock, timeout, [this] { return done(); });
+    }
+
+    auto done() const -> bool { return !batch_ || batch_->remaining.load(std::memory_order_acquire) == 0; }
+    auto total() const -> size_t { return batch_ ? batch_->entries.size() : 0; }
+    auto loaded() const -> size_t { return batch_ ? batch_->loaded.load(std::memory_order_relaxed) : 0; }
+    auto failed() const -> size_t { return batch_ ? batch_->failed.load(std::memory_order_relaxed) : 0; }
+
+private:
+    friend class PreloadPool;
+
+    explicit PreloadHandle(std::shared_ptr<detail::PreloadBatch> batch) : batch_(std::move(batch)) {}
+
+    std::shared_ptr<detail::PreloadBatch> batch_;
+};
+
+/**
+ * Small work-stealing thread pool that decodes and faults in resources
+ *
+ * Submitted resources are dealt round-robin onto per-worker queues, one
+ * queue per priority. A worker takes the newest task from its own queues
+ * and, when they are empty, steals the oldest task from another worker's,
+ * always looking at every queue of a higher priority first.
+ *
+ * The time each resource took is reported through the diagnostic callback
+ * (see setDiagnosticCallback()), which is then called from the worker
+ * threads. Destroying the pool finishes the queued work and joins the
+ * workers.
+ */
+class PreloadPool {
+public:
+    /**
+     * @param thread_count Number of worker threads (at least one)
+     */
+    explicit PreloadPool(size_t thread_count = defaultThreadCount())
+        : queues_(std::max<size_t>(thread_count, 1)) {
+        workers_.reserve(queues_.size());
+        for (size_t i = 0; i < queues_.size(); ++i) {
+            workers_.emplace_back([this, i] { run(i); });
+        }
+    }
+
+    PreloadPool(const PreloadPool&) = delete;
+    auto operator=(const PreloadPool&) -> PreloadPool& = delete;
+
+    ~PreloadPool() {
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            stopping_ = true;
+        }
+        idle_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /**
+     * Pool used by preload(); its threads live until the process exits
+     */
+    static auto global() -> PreloadPool& {
+        static PreloadPool pool;
+        return pool;
+    }
+
+    static auto defaultThreadCount() -> size_t {
+        return std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 4);
+    }
+
+    auto thread_count() const -> size_t { return workers_.size(); }
+
+    /**
+     * Schedule resources for preloading
+     *
+     * @param resources Resources to load; the entries are copied
+     * @param priority Queue to put them on
+     * @return Handle to wait on
+     */
+    auto submit(std::span<const ResourceEntry> resources, PreloadPriority priority = PreloadPriority::Normal)
+        -> PreloadHandle {
+        auto batch = std::make_shared<detail::PreloadBatch>();
+        batch->entries.assign(resources.begin(), resources.end());
+        batch->remaining.store(batch->entries.size(), std::memory_order_relaxed);
+        if (batch->entries.empty()) {
+            return PreloadHandle(std::move(batch));
+        }
+
+        const auto level = static_cast<size_t>(priority);
+        for (size_t i = 0; i < batch->entries.size(); ++i) {
+            WorkerQueue& queue = queues_[next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks[level].push_back({batch, i});
+        }
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            pending_ += batch->entries.size();
+        }
+        idle_.notify_all();
+        return PreloadHandle(std::move(batch));
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::array<std::deque<detail::PreloadTask>, detail::kPreloadPriorities> tasks;
+    };
+
+    auto take(size_t self, detail::PreloadTask& task) -> bool {
+        for (size_t level = 0; level < detail::kPreloadPriorities; ++level) {
+            for (size_t n = 0; n < queues_.size(); ++n) {
+                WorkerQueue& queue = queues_[(self + n) % queues_.size()];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                auto& tasks = queue.tasks[level];
+                if (tasks.empty()) {
+                    continue;
+                }
+                if (n == 0) {
+                    task = std::move(tasks.back());
+                    tasks.pop_back();
+                } else {
+                    task = std::move(tasks.front());
+                    tasks.pop_front();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(size_t self) {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(idle_mutex_);
+                idle_.wait(lock, [this] { return pending_ > 0 || stopping_; });
+                if (pending_ == 0) {
+                    return;
+                }
+                --pending_;
+            }
+            // pending_ counted this task, so some queue holds it
+            detail::PreloadTask task;
+            while (!take(self, task)) {
+                std::this_thread::yield();
+            }
+            const bool ok = detail::warm_up(task.batch->entries[task.index]);
+            task.batch->complete(ok);
+        }
+    }
+
+    std::vector<WorkerQueue> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> next_queue_{0};
+    std::mutex idle_mutex_;
+    std::condition_variable idle_;
+    size_t pending_ = 0;
+    bool stopping_ = false;
+};
+
+/**
+ * Decode and fault in resources in the background
+ *
+ * Example:
+ *   auto handle = resource_tools::preload(ui_resources::allResources(),
+ *                                         resource_tools::PreloadPriority::High);
+ *   ...
+ *   handle.wait();
+ */
+inline auto preload(std::span<const ResourceEntry> resources, PreloadPriority priority = PreloadPriority::Normal)
+    -> PreloadHandle {
+    return PreloadPool::global().submit(resources, priority);
+}
+
+/**
+ * Load every registered resource and wait for them, for pre-fork servers
+ *
+ * Runs on a pool of its own that is joined before returning, so no preload
+ * threads are left running when the caller forks. Children then share the
+ * decoded copies copy-on-write.
+ *
+ * @return Handle reporting how many resources loaded or failed
+ */
+inline auto preloadAllAndWait(size_t thread_count = PreloadPool::defaultThreadCount()) -> PreloadHandle {
+    const std::vector<ResourceEntry> resources = registeredResources();
+    PreloadHandle handle;
+    {
+        PreloadPool pool(thread_count);
+        handle = pool.submit(resources, PreloadPriority::High);
+        handle.wait();
+    }
+    return handle;
+}
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_PRELOAD_H
@@ -0,0 +1,170 @@
+#ifndef RESOURCE_TOOLS_RESIDENCY_H
+#define RESOURCE_TOOLS_RESIDENCY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/memory_advice.h>
+#include <resource_tools/resource_registry.h>
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+    #include <sys/mman.h>
+#endif
+
+namespace resource_tools {
+
+// ============================================================================
+// PAGE RESIDENCY
+// ============================================================================
+
+/**
+ * How much of a resource is in physical memory
+ */
+struct Residency {
+    size_t resident_bytes = 0;  // Bytes of the resource on resident pages
+    size_t size = 0;            // Size of the resource
+    ResourceError error = ResourceError::Success;
+
+    explicit operator bool() const { return error == ResourceError::Success; }
+
+    /**
+     * Resident share of the resource, from 0 to 1 (1 for an empty resource)
+     */
+    auto fraction() const -> double {
+        return size == 0 ? 1.0 : static_cast<double>(resident_bytes) / static_cast<double>(size);
+    }
+};
+
+/**
+ * Measure how much of a resource is resident, using mincore()
+ *
+ * Works on anything mapped into the process: data embedded in the binary,
+ * decoded copies and shared cache segments. Residency is per page, so a
+ * resident page shared with a neighbouring resource counts as resident for
+ * both. Pages of a mapped file can be resident because another process, or
+ * the page cache, holds them, without this process ever touching them.
+ *
+ * @param resource Resource to measure
+ * @return Resident bytes; the resource's own error, Unsupported on platforms
+ *         without mincore(), or SystemError if part of it is not mapped
+ */
+inline auto residency(const ResourceResult& resource) -> Residency {
+    bool empty = false;
+    ResourceError err = detail::check_resource(resource, empty);
+    if (err != ResourceError::Success || empty) {
+        return {0, resource.size, err};
+    }
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+    const size_t page = detail::page_size();
+    const detail::PageSpan span = detail::page_span(resource);
+    std::vector<unsigned char> pages(span.length / page);
+    #if defined(__APPLE__)
+    auto* vector = reinterpret_cast<char*>(pages.data());
+    #else
+    auto* vector = pages.data();
+    #endif
+    if (mincore(span.start, span.length, vector) != 0) {
+        detail::diagnostic_log("resource_tools: mincore failed");
+        return {0, resource.size, ResourceError::SystemError};
+    }
+
+    // Count only the part of the first and last page the resource covers
+    const auto begin = reinterpret_cast<uintptr_t>(resource.data);
+    const uintptr_t end = begin + resource.size;
+    const auto first = reinterpret_cast<uintptr_t>(span.start);
+    size_t resident = 0;
+    for (size_t i = 0; i < pages.size(); ++i) {
+        if ((pages[i] & 1) == 0) {
+            continue;
+        }
+        const uintptr_t low = std::max(begin, first + i * page);
+        const uintptr_t high = std::min(end, first + (i + 1) * page);
+        resident += high - low;
+    }
+    return {resident, resource.size, ResourceError::Success};
+#else
+    return {0, resource.size, ResourceError::Unsupported};
+#endif
+}
+
+/**
+ * Residency of one registered resource
+ */
+struct ResourceResidency {
+    ResourceEntry entry;
+    Residency residency;
+};
+
+/**
+ * Residency of every registered resource, largest resident first
+ */
+struct ResidencyReport {
+    std::vector<ResourceResidency> resources;
+    size_t resident_bytes = 0;
+    size_t size = 0;
+};
+
+/**
+ * Measure every resource of every registered namespace
+ *
+ * Reports the bytes embedded in the binary, so packed resources are never
+ * decoded by the report itself; pass decoded copies to residency() to
+ * measure them. Resources whose residency cannot be measured are listed
+ * with their error and left out of the totals.
+ */
+inline auto residencyReport() -> ResidencyReport {
+    ResidencyReport report;
+    for (const ResourceEntry& entry : registeredResources()) {
+        const ResourceResult embedded =
+            entry.embedded ? entry.embedded() : ResourceResult{nullptr, 0, ResourceError::NullPointer};
+        const Residency measured = residency(embedded);
+        if (measured) {
+            report.resident_bytes += measured.resident_bytes;
+            report.size += measured.size;
+        }
+        report.resources.push_back({entry, measured});
+    }
+    std::stable_sort(report.resources.begin(), report.resources.end(),
+                     [](const ResourceResidency& a, const ResourceResidency& b) {
+                         return a.residency.resident_bytes > b.residency.resident_bytes;
+                     });
+    return report;
+}
+
+/**
+ * Render a report as a table, one resource per line
+ *
+ * Example:
+ *   std::fputs(resource_tools::formatResidencyReport(resource_tools::residencyReport()).c_str(), stderr);
+ */
+inline auto formatResidencyReport(const ResidencyReport& report) -> std::string {
+    std::string text;
+    char line[512];
+    for (const ResourceResidency& item : report.resources) {
+        if (item.residency) {
+            std::snprintf(line, sizeof(line), "%12zu / %12zu bytes %5.1f%%  %s/%s\n", item.residency.resident_bytes,
+                          item.residency.size, item.residency.fraction() * 100.0, item.entry.ns, item.entry.name);
+        } else {
+            std::snprintf(line, sizeof(line), "%12s / %12zu bytes %6s  %s/%s (%s)\n", "-", item.residency.size, "-",
+                          item.entry.ns, item.entry.name, to_string(item.residency.error));
+        }
+        text += line;
+    }
+    const double percent = report.size == 0 ? 100.0
+                                            : 100.0 * static_cast<double>(report.resident_bytes) /
+                                                  static_cast<double>(report.size);
+    std::snprintf(line, sizeof(line), "%12zu / %12zu bytes %5.1f%%  total (%zu resources)\n", report.resident_bytes,
+                  report.size, percent, report.resources.size());
+    text += line;
+    return text;
+}
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_RESIDENCY_H
@@ -0,0 +1,365 @@
+#ifndef RESOURCE_TOOLS_RESOURCE_CACHE_H
+#define RESOURCE_TOOLS_RESOURCE_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// DECODED RESOURCE CACHE
+// ============================================================================
+
+namespace detail {
+
+/**
+ * One decoded resource; the buffer is freed when the last handle goes away
+ */
+struct CacheEntry {
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    std::pmr::memory_resource* memory = nullptr;
+
+    explicit CacheEntry(std::pmr::memory_resource* resource) : memory(resource) {}
+    CacheEntry(const CacheEntry&) = delete;
+    auto operator=(const CacheEntry&) -> CacheEntry& = delete;
+    ~CacheEntry() {
+        if (data) {
+            deallocate_buffer(memory, data, size);
+        }
+    }
+};
+
+/**
+ * A decode in progress; threads that miss on the same resource together
+ * wait on it instead of each decoding their own copy
+ */
+struct PendingDecode {
+    std::once_flag once;
+    std::shared_ptr<CacheEntry> entry;
+    ResourceError error = ResourceError::Success;
+};
+
+} // namespace detail
+
+/**
+ * Reference-counted handle to a resource obtained from a ResourceCache or
+ * SharedCache
+ *
+ * The data stays valid for as long as the handle (or a copy of it) exists,
+ * even if the cache evicts the entry in the meantime. Stored resources are
+ * returned in place and need no reference.
+ */
+class ResourceHandle {
+public:
+    ResourceHandle() = default;
+
+    /**
+     * Get the decoded resource
+     */
+    auto get() const -> ResourceResult { return result_; }
+
+    auto error() const -> ResourceError { return result_.error; }
+    explicit operator bool() const { return result_.error == ResourceError::Success; }
+
+private:
+    friend class ResourceCache;
+    friend class SharedCache;
+
+    explicit ResourceHandle(ResourceResult result) : result_(result) {}
+    explicit ResourceHandle(std::shared_ptr<const detail::CacheEntry> entry)
+        : result_{entry->data, entry->size, ResourceError::Success}, owner_(std::move(entry)) {}
+    ResourceHandle(std::shared_ptr<const void> owner, ResourceResult result)
+        : result_(result), owner_(std::move(owner)) {}
+
+    ResourceResult result_{nullptr, 0, ResourceError::NullPointer};
+    std::shared_ptr<const void> owner_;  // Keeps the data alive
+};
+
+/**
+ * Cache statistics
+ */
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;  // Decodes; threads that wait on another's decode count as hits
+    uint64_t evictions = 0;
+    size_t bytes = 0;     // Decoded bytes currently held by the cache
+    size_t entries = 0;
+};
+
+/**
+ * Bounded cache of decoded packed resources
+ *
+ * Keeps decoded copies of packed resources up to a byte budget, evicting the
+ * least recently used ones first. Keys are hashed over independently locked
+ * shards so concurrent readers of different resources rarely contend.
+ * Recency is tracked per shard; when an insert pushes the cache over budget,
+ * the other shards are trimmed first and the inserting shard last.
+ *
+ * Resources are decoded outside the shard lock, once however many threads
+ * miss on them at the same time. Stored resources are returned in place
+ * and never occupy the cache, and resources larger than the whole budget
+ * are decoded for the caller without being cached.
+ *
+ * Decoded buffers, entries and the cache's own bookkeeping are all allocated
+ * from the memory resource passed at construction.
+ *
+ * Example:
+ *   resource_tools::ResourceCache::global().set_budget(16 * 1024 * 1024);
+ *   auto handle = my_resources::getStringsJSONCached();
+ *   if (handle) {
+ *       use(handle.get().data, handle.get().size);
+ *   }
+ */
+class ResourceCache {
+public:
+    static constexpr size_t kDefaultShards = 32;
+    static constexpr size_t kDefaultGlobalBudget = size_t{64} * 1024 * 1024;
+
+    /**
+     * @param budget_bytes Decoded bytes the cache may hold
+     * @param shard_count Number of independently locked shards
+     * @param memory Memory resource for decoded buffers and bookkeeping
+     */
+    explicit ResourceCache(size_t budget_bytes, size_t shard_count = kDefaultShards,
+                           std::pmr::memory_resource* memory = zeroedMemoryResource())
+        : budget_(budget_bytes), memory_(memory), shards_(shard_count > 0 ? shard_count : 1, memory) {}
+
+    ResourceCache(const ResourceCache&) = delete;
+    auto operator=(const ResourceCache&) -> ResourceCache& = delete;
+
+    /**
+     * Process-wide cache used by the generated get<Name>Cached() accessors
+     */
+    static auto global() -> ResourceCache& {
+        static ResourceCache cache(kDefaultGlobalBudget);
+        return cache;
+    }
+
+    /**
+     * Get a decoded resource, decoding it on a miss
+     *
+     * @param blob Embedded container bytes; its address is the cache key
+     * @param reference Container the encoding refers to, as for decodePacked()
+     * @return Handle to the resource, or to the reason decoding failed
+     */
+    auto get(const ResourceResult& blob, const ResourceResult& reference = {}) -> ResourceHandle {
+        packed::Header header;
+        ResourceError err = packed::readHeader(blob, header);
+        if (err != ResourceError::Success) {
+            return ResourceHandle(ResourceResult{nullptr, 0, err});
+        }
+        if (header.encoding == packed::Encoding::Stored) {
+            return ResourceHandle(packed::storedPayload(blob));
+        }
+
+        const size_t index = shard_index(blob.data);
+        Shard& shard = shards_[index];
+        std::shared_ptr<detail::PendingDecode> pending;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.index.find(blob.data);
+            if (it != shard.index.end()) {
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return ResourceHandle(it->second->entry);
+            }
+            auto in_flight = shard.pending.find(blob.data);
+            if (in_flight != shard.pending.end()) {
+                pending = in_flight->second;
+            } else {
+                pending = std::allocate_shared<detail::PendingDecode>(
+                    std::pmr::polymorphic_allocator<detail::PendingDecode>(memory_));
+                shard.pending.emplace(blob.data, pending);
+            }
+        }
+
+        bool decoded_here = false;
+        std::call_once(pending->once, [&] {
+            decoded_here = true;
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            pending->entry = make_entry(static_cast<size_t>(header.size));
+            if (!pending->entry) {
+                detail::diagnostic_log("resource_tools: out of memory decoding cached resource");
+                pending->error = ResourceError::OutOfMemory;
+                return;
+            }
+            pending->error = decodePacked(blob, pending->entry->data, pending->entry->size, reference,
+                                          memory_ == zeroedMemoryResource());
+            if (pending->error != ResourceError::Success) {
+                detail::diagnostic_log("resource_tools: failed to decode cached resource");
+                pending->entry.reset();
+            }
+        });
+        if (!decoded_here) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return handle_of(*pending);
+        }
+
+        // Only the decoding thread publishes the entry, so it cannot be in
+        // the index already
+        const bool cached = pending->entry && pending->entry->size <= budget_.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.pending.erase(blob.data);
+            if (cached) {
+                shard.lru.push_front({blob.data, pending->entry});
+                shard.index.emplace(blob.data, shard.lru.begin());
+                shard.bytes += pending->entry->size;
+                bytes_.fetch_add(pending->entry->size, std::memory_order_relaxed);
+            }
+        }
+
+        if (cached) {
+            evict_to_budget(index);
+        }
+        return handle_of(*pending);
+    }
+
+    /**
+     * Change the byte budget, evicting entries if it shrank
+     */
+    void set_budget(size_t budget_bytes) {
+        budget_.store(budget_bytes, std::memory_order_relaxed);
+        evict_to_budget(0);
+    }
+
+    auto budget() const -> size_t { return budget_.load(std::memory_order_relaxed); }
+
+    /**
+     * Drop every entry; outstanding handles stay valid
+     *
+     * Each shard is emptied under its own lock, so gets running at the same
+     * time either land before the clear and are dropped, or after it and
+     * stay cached.
+     */
+    void clear() {
+        for (auto& shard : shards_) {
+            // Declared before the lock so buffers are freed after it is released
+            std::pmr::list<Node> dropped(memory_);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            evictions_.fetch_add(shard.lru.size(), std::memory_order_relaxed);
+            bytes_.fetch_sub(shard.bytes, std::memory_order_relaxed);
+            shard.bytes = 0;
+            shard.index.clear();
+            dropped.splice(dropped.end(), shard.lru);
+        }
+    }
+
+    auto stats() const -> CacheStats {
+        CacheStats stats;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        stats.evictions = evictions_.load(std::memory_order_relaxed);
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            stats.bytes += shard.bytes;
+            stats.entries += shard.lru.size();
+        }
+        return stats;
+    }
+
+private:
+    struct Node {
+        const uint8_t* key;
+        std::shared_ptr<const detail::CacheEntry> entry;
+    };
+
+    // Padded to a cache line so neighbouring shard locks do not false-share
+    struct alignas(64) Shard {
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        explicit Shard(const allocator_type& alloc) : lru(alloc), index(alloc), pending(alloc) {}
+
+        mutable std::mutex mutex;
+        std::pmr::list<Node> lru;  // Most recently used first
+        std::pmr::unordered_map<const uint8_t*, std::pmr::list<Node>::iterator> index;
+        std::pmr::unordered_map<const uint8_t*, std::shared_ptr<detail::PendingDecode>> pending;
+        size_t bytes = 0;
+    };
+
+    static auto handle_of(const detail::PendingDecode& pending) -> ResourceHandle {
+        if (!pending.entry) {
+            return ResourceHandle(ResourceResult{nullptr, 0, pending.error});
+        }
+        return ResourceHandle(std::shared_ptr<const detail::CacheEntry>(pending.entry));
+    }
+
+    // Entry and its buffer both come from the cache's memory resource
+    auto make_entry(size_t size) -> std::shared_ptr<detail::CacheEntry> {
+        uint8_t* buffer = detail::allocate_buffer(memory_, size);
+        if (!buffer) {
+            return nullptr;
+        }
+#if defined(__cpp_exceptions)
+        try {
+#endif
+            auto entry = std::allocate_shared<detail::CacheEntry>(
+                std::pmr::polymorphic_allocator<detail::CacheEntry>(memory_), memory_);
+            entry->data = buffer;
+            entry->size = size;
+            return entry;
+#if defined(__cpp_exceptions)
+        } catch (const std::bad_alloc&) {
+            detail::deallocate_buffer(memory_, buffer, size);
+            return nullptr;
+        }
+#endif
+    }
+
+    auto shard_index(const uint8_t* key) const -> size_t {
+        // Resources are laid out next to each other, so mix the address bits
+        uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h % shards_.size());
+    }
+
+    void evict_to_budget(size_t inserted_shard) {
+        for (size_t n = 1; n <= shards_.size(); ++n) {
+            if (bytes_.load(std::memory_order_relaxed) <= budget_.load(std::memory_order_relaxed)) {
+                return;
+            }
+            Shard& shard = shards_[(inserted_shard + n) % shards_.size()];
+
+            // Declared before the lock so buffers are freed after it is released
+            std::pmr::vector<std::shared_ptr<const detail::CacheEntry>> evicted(memory_);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            while (!shard.lru.empty() &&
+                   bytes_.load(std::memory_order_relaxed) > budget_.load(std::memory_order_relaxed)) {
+                Node& victim = shard.lru.back();
+                shard.bytes -= victim.entry->size;
+                bytes_.fetch_sub(victim.entry->size, std::memory_order_relaxed);
+                evicted.push_back(std::move(victim.entry));
+                shard.index.erase(victim.key);
+                shard.lru.pop_back();
+                evictions_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::atomic<size_t> budget_;
+    std::atomic<size_t> bytes_{0};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::pmr::memory_resource* memory_;
+    std::pmr::vector<Shard> shards_;
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_RESOURCE_CACHE_H
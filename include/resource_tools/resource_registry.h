@@ -0,0 +1,99 @@
+#ifndef RESOURCE_TOOLS_RESOURCE_REGISTRY_H
+#define RESOURCE_TOOLS_RESOURCE_REGISTRY_H
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <resource_tools/embedded_resource.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// RESOURCE REGISTRY
+// ============================================================================
+
+/**
+ * One embedded resource and the accessors that return it
+ *
+ * Every generated header lists its resources in <namespace>::allResources().
+ * `embedded` returns the bytes stored in the binary without decoding them:
+ * get<Name>Packed() for packed resources, the same accessor as `get` for
+ * raw ones.
+ */
+struct ResourceEntry {
+    const char* ns = nullptr;
+    const char* name = nullptr;
+    ResourceResult (*get)() = nullptr;
+    ResourceResult (*embedded)() = nullptr;
+};
+
+/**
+ * Resources of one generated namespace, registered for the whole program
+ *
+ * Each generated header defines one group, so every namespace whose header
+ * is included somewhere in the program can be found through
+ * registeredResources() without being named. Groups are linked into a
+ * lock-free list on construction and never removed.
+ */
+class ResourceGroup {
+public:
+    explicit ResourceGroup(std::span<const ResourceEntry> entries) : entries_(entries) {
+        next_ = head().load(std::memory_order_relaxed);
+        while (!head().compare_exchange_weak(next_, this, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    ResourceGroup(const ResourceGroup&) = delete;
+    auto operator=(const ResourceGroup&) -> ResourceGroup& = delete;
+
+    auto entries() const -> std::span<const ResourceEntry> { return entries_; }
+    auto next() const -> const ResourceGroup* { return next_; }
+
+    /**
+     * Most recently registered group, or nullptr if there are none
+     */
+    static auto first() -> const ResourceGroup* { return head().load(std::memory_order_acquire); }
+
+private:
+    static auto head() -> std::atomic<const ResourceGroup*>& {
+        static std::atomic<const ResourceGroup*> groups{nullptr};
+        return groups;
+    }
+
+    std::span<const ResourceEntry> entries_;
+    const ResourceGroup* next_ = nullptr;
+};
+
+/**
+ * Every resource of every registered namespace
+ */
+inline auto registeredResources() -> std::vector<ResourceEntry> {
+    std::vector<ResourceEntry> entries;
+    for (const ResourceGroup* group = ResourceGroup::first(); group; group = group->next()) {
+        entries.insert(entries.end(), group->entries().begin(), group->entries().end());
+    }
+    return entries;
+}
+
+/**
+ * Look up a registered resource by namespace and file name
+ *
+ * @return The entry, or nullptr if no registered namespace embeds it
+ */
+inline auto findResource(std::string_view ns, std::string_view name) -> const ResourceEntry* {
+    for (const ResourceGroup* group = ResourceGroup::first(); group; group = group->next()) {
+        for (const ResourceEntry& entry : group->entries()) {
+            if (entry.ns == ns && entry.name == name) {
+                return &entry;
+            }
+        }
+    }
+    return nullptr;
+}
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_RESOURCE_REGISTRY_H
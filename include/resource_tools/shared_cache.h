@@ -0,0 +1,396 @@
+#ifndef RESOURCE_TOOLS_SHARED_CACHE_H
+#define RESOURCE_TOOLS_SHARED_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+#include <resource_tools/resource_cache.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/file.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define RESOURCE_TOOLS_HAS_SHARED_CACHE 1
+#else
+    #define RESOURCE_TOOLS_HAS_SHARED_CACHE 0
+#endif
+
+namespace resource_tools {
+
+// ============================================================================
+// CROSS-PROCESS SHARED CACHE
+// ============================================================================
+
+/**
+ * Shared cache statistics for this process
+ */
+struct SharedCacheStats {
+    uint64_t hits = 0;       // Served from a segment this process already maps
+    uint64_t created = 0;    // Decoded by this process into a new segment
+    uint64_t attached = 0;   // Mapped from a segment another process decoded
+    uint64_t fallbacks = 0;  // Decoded privately because no segment was usable
+};
+
+namespace detail {
+
+// Trailer written after the decoded bytes once a segment is complete
+constexpr uint64_t kSegmentMagic = 0x3147455348535452ULL;  // "RTSHSEG1"
+constexpr size_t kSegmentTrailerSize = 16;
+constexpr char kSegmentPrefix[] = "resource_tools-";
+
+/**
+ * Read-only mapping of one shared segment, unmapped with the last handle
+ */
+struct SharedSegment {
+    void* address = nullptr;
+    size_t length = 0;
+
+    SharedSegment(void* mapped, size_t mapped_length) : address(mapped), length(mapped_length) {}
+    SharedSegment(const SharedSegment&) = delete;
+    auto operator=(const SharedSegment&) -> SharedSegment& = delete;
+    ~SharedSegment() {
+#if RESOURCE_TOOLS_HAS_SHARED_CACHE
+        munmap(address, length);
+#endif
+    }
+};
+
+/**
+ * This process's view of one resource, set up once however many threads
+ * ask for it together
+ */
+struct SharedEntry {
+    std::once_flag once;
+    std::shared_ptr<const SharedSegment> segment;  // Null when decoded privately
+    ResourceError error = ResourceError::Success;
+};
+
+} // namespace detail
+
+/**
+ * Cache of decoded packed resources shared by every process on a host
+ *
+ * Each decoded resource lives in a file in a shared memory directory,
+ * /dev/shm by default, named after the content key and size the packer
+ * recorded in its container header. The first process to ask for a
+ * resource decodes it into the file; every later process, including ones
+ * started long afterwards, maps the same pages read-only, so N workers hold
+ * one copy of the data instead of N.
+ *
+ * Writers hold an exclusive flock() on the segment while decoding and
+ * readers take a shared one before checking it is complete, so a reader
+ * never maps a half-written segment. A segment is only complete once its
+ * trailer is written; if the writer dies first the kernel drops its lock and
+ * the next process decodes the resource again. Complete segments are made
+ * read-only (mode 0400), and segments not owned by the current user are
+ * never trusted.
+ *
+ * When no segment can be used (the directory is missing, permissions,
+ * non-POSIX platforms, containers without a key) the resource is decoded
+ * privately through ResourceCache::global() instead, so callers always get
+ * the data.
+ *
+ * Segments outlive the processes that create them: they stay in the
+ * directory until they are removed or the host reboots, and a new build of
+ * a resource gets a new segment rather than replacing the old one. Call
+ * purge() when deploying new binaries (or point
+ * RESOURCE_TOOLS_SHARED_CACHE_DIR at a per-deployment directory and remove
+ * it afterwards). Removing a segment never disturbs processes that already
+ * map it; they keep their pages until they exit.
+ *
+ * Example:
+ *   auto handle = my_resources::getLevelsBINShared();
+ *   if (handle) {
+ *       use(handle.get().data, handle.get().size);
+ *   }
+ */
+class SharedCache {
+public:
+    /**
+     * @param directory Directory holding the segments; empty disables sharing
+     */
+    explicit SharedCache(std::string directory = defaultDirectory()) : directory_(std::move(directory)) {}
+
+    SharedCache(const SharedCache&) = delete;
+    auto operator=(const SharedCache&) -> SharedCache& = delete;
+
+    /**
+     * Process-wide cache used by the generated get<Name>Shared() accessors
+     */
+    static auto global() -> SharedCache& {
+        static SharedCache cache;
+        return cache;
+    }
+
+    /**
+     * Segment directory from RESOURCE_TOOLS_SHARED_CACHE_DIR, /dev/shm by default
+     */
+    static auto defaultDirectory() -> std::string {
+        const char* directory = std::getenv("RESOURCE_TOOLS_SHARED_CACHE_DIR");
+        return directory ? directory : "/dev/shm";
+    }
+
+    auto directory() const -> const std::string& { return directory_; }
+
+    /**
+     * Get a decoded resource, decoding it into a shared segment if no
+     * process has done so yet
+     *
+     * @param blob Embedded container bytes
+     * @param reference Container the encoding refers to, as for decodePacked()
+     * @return Handle to the resource, or to the reason decoding failed
+     */
+    auto get(const ResourceResult& blob, const ResourceResult& reference = {}) -> ResourceHandle {
+        packed::Header header;
+        ResourceError err = packed::readHeader(blob, header);
+        if (err != ResourceError::Success) {
+            return ResourceHandle(ResourceResult{nullptr, 0, err});
+        }
+        if (header.encoding == packed::Encoding::Stored) {
+            return ResourceHandle(packed::storedPayload(blob));
+        }
+
+        std::shared_ptr<detail::SharedEntry> entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto& slot = segments_[blob.data];
+            if (!slot) {
+                slot = std::make_shared<detail::SharedEntry>();
+            }
+            entry = slot;
+        }
+
+        // Decoding happens outside mutex_, so other resources are not held up
+        bool first = false;
+        std::call_once(entry->once, [&] {
+            first = true;
+#if RESOURCE_TOOLS_HAS_SHARED_CACHE
+            const std::string path = segment_path(blob);
+            if (!path.empty() && header.size > 0) {
+                bool created = false;
+                entry->segment = map_segment(path, blob, reference, static_cast<size_t>(header.size), created,
+                                             entry->error);
+                if (entry->segment) {
+                    (created ? created_ : attached_).fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+#endif
+        });
+
+        if (entry->segment) {
+            if (!first) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return handle_for(entry->segment);
+        }
+        if (entry->error != ResourceError::Success) {
+            return ResourceHandle(ResourceResult{nullptr, 0, entry->error});
+        }
+        fallbacks_.fetch_add(1, std::memory_order_relaxed);
+        return ResourceCache::global().get(blob, reference);
+    }
+
+    /**
+     * Path of the segment holding a resource
+     *
+     * The name is the content key the packer stored in the container header
+     * followed by the decoded size, so identical resources embedded in
+     * different binaries share one segment.
+     *
+     * @return The path, or an empty string if sharing is disabled or the
+     *         container records no key
+     */
+    auto segment_path(const ResourceResult& blob) const -> std::string {
+        packed::Header header;
+        if (directory_.empty() || packed::readHeader(blob, header) != ResourceError::Success || header.key == 0) {
+            return {};
+        }
+        static constexpr char digits[] = "0123456789abcdef";
+        std::string name = directory_ + "/" + detail::kSegmentPrefix;
+        for (int shift = 60; shift >= 0; shift -= 4) {
+            name += digits[(header.key >> shift) & 0xF];
+        }
+        return name + "-" + std::to_string(header.size);
+    }
+
+    /**
+     * Remove the segment of one resource from the directory
+     *
+     * @return true if a segment was removed
+     */
+    auto remove(const ResourceResult& blob) const -> bool {
+        const std::string path = segment_path(blob);
+#if RESOURCE_TOOLS_HAS_SHARED_CACHE
+        return !path.empty() && unlink(path.c_str()) == 0;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Remove every segment the current user owns from the directory
+     *
+     * Meant for deployment and test teardown. Processes that still need a
+     * removed resource decode it into a new segment.
+     *
+     * @return Number of segments removed
+     */
+    auto purge() const -> size_t {
+        size_t removed = 0;
+#if RESOURCE_TOOLS_HAS_SHARED_CACHE
+        DIR* dir = directory_.empty() ? nullptr : opendir(directory_.c_str());
+        if (!dir) {
+            return 0;
+        }
+        const size_t prefix_length = sizeof(detail::kSegmentPrefix) - 1;
+        while (const dirent* item = readdir(dir)) {
+            if (std::strncmp(item->d_name, detail::kSegmentPrefix, prefix_length) != 0) {
+                continue;
+            }
+            struct stat st {};
+            if (fstatat(dirfd(dir), item->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISREG(st.st_mode) &&
+                st.st_uid == geteuid() && unlinkat(dirfd(dir), item->d_name, 0) == 0) {
+                ++removed;
+            }
+        }
+        closedir(dir);
+#endif
+        return removed;
+    }
+
+    auto stats() const -> SharedCacheStats {
+        SharedCacheStats stats;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.created = created_.load(std::memory_order_relaxed);
+        stats.attached = attached_.load(std::memory_order_relaxed);
+        stats.fallbacks = fallbacks_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    static auto handle_for(const std::shared_ptr<const detail::SharedSegment>& segment) -> ResourceHandle {
+        return ResourceHandle(segment, ResourceResult{static_cast<const uint8_t*>(segment->address),
+                                                      segment->length - detail::kSegmentTrailerSize,
+                                                      ResourceError::Success});
+    }
+
+#if RESOURCE_TOOLS_HAS_SHARED_CACHE
+    // Mappings keep the open file alive, so the lock is dropped explicitly
+    struct FileDescriptor {
+        int fd = -1;
+        ~FileDescriptor() {
+            if (fd >= 0) {
+                flock(fd, LOCK_UN);
+                close(fd);
+            }
+        }
+    };
+
+    static auto owned_by_us(int fd, struct stat& st) -> bool {
+        return fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_uid == geteuid();
+    }
+
+    static auto is_complete(int fd, const struct stat& st, size_t size) -> bool {
+        if (static_cast<uint64_t>(st.st_size) != size + detail::kSegmentTrailerSize) {
+            return false;
+        }
+        uint8_t trailer[detail::kSegmentTrailerSize];
+        if (pread(fd, trailer, sizeof(trailer), static_cast<off_t>(size)) != static_cast<ssize_t>(sizeof(trailer))) {
+            return false;
+        }
+        return packed::load_le64(trailer) == detail::kSegmentMagic && packed::load_le64(trailer + 8) == size;
+    }
+
+    static auto map_read_only(int fd, size_t size) -> std::shared_ptr<const detail::SharedSegment> {
+        const size_t length = size + detail::kSegmentTrailerSize;
+        void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            return nullptr;
+        }
+        return std::make_shared<const detail::SharedSegment>(address, length);
+    }
+
+    /**
+     * Map the segment at `path`, decoding into it first if it is not complete
+     *
+     * Returns nullptr with err == Success when the caller should fall back to
+     * a private copy, and nullptr with an error when decoding itself failed.
+     */
+    static auto map_segment(const std::string& path, const ResourceResult& blob, const ResourceResult& reference,
+                            size_t size, bool& created, ResourceError& err)
+        -> std::shared_ptr<const detail::SharedSegment> {
+        err = ResourceError::Success;
+        struct stat st {};
+
+        // Fast path: someone already finished this segment
+        {
+            FileDescriptor file{open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW)};
+            if (file.fd >= 0 && flock(file.fd, LOCK_SH) == 0 && owned_by_us(file.fd, st) &&
+                is_complete(file.fd, st, size)) {
+                return map_read_only(file.fd, size);
+            }
+        }
+
+        FileDescriptor file{open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | O_NOFOLLOW, 0600)};
+        if (file.fd < 0 || flock(file.fd, LOCK_EX) != 0 || !owned_by_us(file.fd, st)) {
+            detail::diagnostic_log("resource_tools: shared cache segment unavailable, decoding privately");
+            return nullptr;
+        }
+        if (is_complete(file.fd, st, size)) {
+            // Another process finished it while we waited for the lock
+            return map_read_only(file.fd, size);
+        }
+
+        // Empty or left behind by a writer that died; start again from zeroes
+        const size_t length = size + detail::kSegmentTrailerSize;
+        if (ftruncate(file.fd, 0) != 0 || ftruncate(file.fd, static_cast<off_t>(length)) != 0) {
+            detail::diagnostic_log("resource_tools: cannot size shared cache segment, decoding privately");
+            return nullptr;
+        }
+        void* address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+        if (address == MAP_FAILED) {
+            detail::diagnostic_log("resource_tools: cannot map shared cache segment, decoding privately");
+            return nullptr;
+        }
+        auto* data = static_cast<uint8_t*>(address);
+        err = decodePacked(blob, data, size, reference, true);
+        if (err != ResourceError::Success) {
+            munmap(address, length);
+            detail::diagnostic_log("resource_tools: failed to decode shared resource");
+            return nullptr;
+        }
+        packed::store_le64(data + size, detail::kSegmentMagic);
+        packed::store_le64(data + size + 8, size);
+        munmap(address, length);
+        fchmod(file.fd, 0400);
+
+        created = true;
+        return map_read_only(file.fd, size);
+    }
+#endif
+
+    std::string directory_;
+    std::mutex mutex_;  // Guards segments_ only, never held while decoding
+    std::unordered_map<const uint8_t*, std::shared_ptr<detail::SharedEntry>> segments_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> created_{0};
+    std::atomic<uint64_t> attached_{0};
+    std::atomic<uint64_t> fallbacks_{0};
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_SHARED_CACHE_H
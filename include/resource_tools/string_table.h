@@ -0,0 +1,177 @@
+#ifndef RESOURCE_TOOLS_STRING_TABLE_H
+#define RESOURCE_TOOLS_STRING_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/key_hash.h>
+#include <resource_tools/packed_resource.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// STRING TABLE FORMAT
+// ============================================================================
+
+/**
+ * Resources embedded with STRING_TABLE are compiled from key/value catalogs
+ * into a table that is looked up in place:
+ *
+ *   Header (32 bytes): magic, version, flags, entry count, bucket count,
+ *                      pool offset, pool size
+ *   Displacements (one uint32 per bucket)
+ *   Entries       (key offset, key length, value offset, value length;
+ *                  one uint32 each, in slot order)
+ *   Pool          (every key and value once, each followed by a NUL)
+ *
+ * The key index is a minimal perfect hash (hash and displace): a key's
+ * bucket gives the displacement that sends it to its slot, and the key
+ * stored there is compared to reject keys that are not in the table. All
+ * integers are little-endian. The table is produced by the resource_packer
+ * tool.
+ */
+namespace string_table {
+
+constexpr uint32_t kMagic = 0x54535452u;  // "RTST"
+constexpr uint16_t kVersion = 1;
+constexpr size_t kHeaderSize = 32;
+constexpr size_t kEntrySize = 16;
+
+/**
+ * Bucket of a key's hash, out of `buckets`
+ */
+inline auto bucket_of(uint64_t hash, uint32_t buckets) -> uint32_t {
+    return static_cast<uint32_t>((hash >> 32) % buckets);
+}
+
+/**
+ * Slot of a key's hash under a bucket's displacement, out of `slots`
+ */
+inline auto slot_of(uint64_t hash, uint32_t displacement, uint32_t slots) -> uint32_t {
+    return static_cast<uint32_t>(detail::mix64(hash + displacement * 0x9E3779B97F4A7C15ull) % slots);
+}
+
+} // namespace string_table
+
+// ============================================================================
+// STRING TABLE VIEW
+// ============================================================================
+
+/**
+ * Read-only view of an embedded STRING_TABLE resource
+ *
+ * Construction only checks the header, and lookups hash the key once, read
+ * one displacement and one entry, and compare one key, so there is no
+ * startup work and nothing is allocated. Strings are views into the
+ * embedded pool and stay valid for the life of the program; each is
+ * followed by a NUL, so data() can be passed to C APIs.
+ *
+ * Example:
+ *   const auto& messages = ui::stringTable("fr");
+ *   label.set_text(messages.get("menu.open", "Open"));
+ */
+class StringTable {
+public:
+    explicit StringTable(const ResourceResult& resource) {
+        if (!resource) {
+            error_ = resource.error;
+            return;
+        }
+        if (!resource.data || resource.size < string_table::kHeaderSize ||
+            packed::load_le32(resource.data) != string_table::kMagic ||
+            packed::load_le16(resource.data + 4) != string_table::kVersion) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        const uint32_t count = packed::load_le32(resource.data + 8);
+        const uint32_t buckets = packed::load_le32(resource.data + 12);
+        const uint64_t pool_offset = packed::load_le64(resource.data + 16);
+        const uint64_t pool_size = packed::load_le64(resource.data + 24);
+        const uint64_t index_size = uint64_t{buckets} * 4 + uint64_t{count} * string_table::kEntrySize;
+        if ((count > 0 && buckets == 0) || pool_offset != string_table::kHeaderSize + index_size ||
+            pool_offset > resource.size || pool_size > resource.size - pool_offset) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        displacements_ = resource.data + string_table::kHeaderSize;
+        entries_ = displacements_ + uint64_t{buckets} * 4;
+        pool_ = std::string_view(reinterpret_cast<const char*>(resource.data + pool_offset),
+                                 static_cast<size_t>(pool_size));
+        count_ = count;
+        buckets_ = buckets;
+    }
+
+    auto error() const -> ResourceError { return error_; }
+    explicit operator bool() const { return error_ == ResourceError::Success; }
+
+    /**
+     * Number of entries
+     */
+    auto size() const -> size_t { return count_; }
+    auto empty() const -> bool { return count_ == 0; }
+
+    /**
+     * Value of `key`, or nullopt if the table has no such key
+     */
+    auto find(std::string_view key) const -> std::optional<std::string_view> {
+        if (count_ == 0) {
+            return std::nullopt;
+        }
+        const uint64_t hash = keyHash(key);
+        const uint32_t displacement =
+            packed::load_le32(displacements_ + size_t{string_table::bucket_of(hash, buckets_)} * 4);
+        const uint32_t slot = string_table::slot_of(hash, displacement, count_);
+        if (this->key(slot) != key) {
+            return std::nullopt;
+        }
+        return value(slot);
+    }
+
+    /**
+     * Value of `key`, or `fallback` if the table has no such key
+     */
+    auto get(std::string_view key, std::string_view fallback = {}) const -> std::string_view {
+        return find(key).value_or(fallback);
+    }
+
+    auto contains(std::string_view key) const -> bool { return find(key).has_value(); }
+
+    /**
+     * Key and value of entry `index`, in slot order; empty if out of range
+     */
+    auto key(size_t index) const -> std::string_view { return string_at(index, 0); }
+    auto value(size_t index) const -> std::string_view { return string_at(index, 8); }
+
+private:
+    // Bounds-checked so a damaged entry reads as empty instead of out of
+    // the pool
+    auto string_at(size_t index, size_t field) const -> std::string_view {
+        if (index >= count_) {
+            return {};
+        }
+        const uint8_t* entry = entries_ + index * string_table::kEntrySize + field;
+        const uint32_t offset = packed::load_le32(entry);
+        const uint32_t length = packed::load_le32(entry + 4);
+        if (offset > pool_.size() || length > pool_.size() - offset) {
+            return {};
+        }
+        return pool_.substr(offset, length);
+    }
+
+    const uint8_t* displacements_ = nullptr;
+    const uint8_t* entries_ = nullptr;
+    std::string_view pool_;
+    uint32_t count_ = 0;
+    uint32_t buckets_ = 0;
+    ResourceError error_ = ResourceError::Success;
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_STRING_TABLE_H
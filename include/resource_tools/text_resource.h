@@ -0,0 +1,180 @@
+#ifndef RESOURCE_TOOLS_TEXT_RESOURCE_H
+#define RESOURCE_TOOLS_TEXT_RESOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// TEXT RESOURCE FORMAT
+// ============================================================================
+
+/**
+ * Resources embedded with TEXT are validated as UTF-8 at build time and
+ * stored with an index of where each line starts:
+ *
+ *   Header (32 bytes): magic, version, flags, text size, line count,
+ *                      index offset
+ *   Text
+ *   Index  (line count + 1 offsets, 4 bytes each, or 8 with kWideIndex)
+ *
+ * Offset i is where line i starts; the last one is one past the end of the
+ * text as if it ended in a newline, so line i always ends one byte before
+ * the next offset. All integers are little-endian. The container is produced
+ * by the resource_packer tool.
+ */
+namespace text {
+
+constexpr uint32_t kMagic = 0x58545452u;  // "RTTX"
+constexpr uint16_t kVersion = 1;
+constexpr size_t kHeaderSize = 32;
+constexpr uint16_t kNormalized = 1;  // Flag: line endings were converted to "\n"
+constexpr uint16_t kWideIndex = 2;   // Flag: index offsets are 8 bytes
+
+} // namespace text
+
+// ============================================================================
+// TEXT RESOURCE VIEW
+// ============================================================================
+
+/**
+ * Read-only view of an embedded TEXT resource
+ *
+ * The text is known to be valid UTF-8, so it can be used without checking
+ * again, and line(i) is a lookup in the build-time index. Lines do not
+ * include their "\n", or the "\r" of a "\r\n". Construction only checks the
+ * header; each line is bounds-checked when it is read.
+ *
+ * Example:
+ *   const auto& text = docs::getLicenseTXTText();
+ *   for (std::string_view line : text) {
+ *       print(line);
+ *   }
+ */
+class TextResource {
+public:
+    explicit TextResource(const ResourceResult& resource) {
+        if (!resource) {
+            error_ = resource.error;
+            return;
+        }
+        if (!resource.data || resource.size < text::kHeaderSize || packed::load_le32(resource.data) != text::kMagic ||
+            packed::load_le16(resource.data + 4) != text::kVersion) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        flags_ = packed::load_le16(resource.data + 6);
+        const uint64_t text_size = packed::load_le64(resource.data + 8);
+        const uint64_t lines = packed::load_le64(resource.data + 16);
+        const uint64_t index_offset = packed::load_le64(resource.data + 24);
+        const size_t width = (flags_ & text::kWideIndex) ? 8 : 4;
+        if (text_size > resource.size - text::kHeaderSize || index_offset < text::kHeaderSize + text_size ||
+            index_offset > resource.size || lines >= (resource.size - index_offset) / width) {
+            error_ = ResourceError::CorruptData;
+            return;
+        }
+
+        text_ = std::string_view(reinterpret_cast<const char*>(resource.data + text::kHeaderSize),
+                                 static_cast<size_t>(text_size));
+        index_ = resource.data + index_offset;
+        lines_ = static_cast<size_t>(lines);
+    }
+
+    auto error() const -> ResourceError { return error_; }
+    explicit operator bool() const { return error_ == ResourceError::Success; }
+
+    /**
+     * The whole text, valid UTF-8
+     */
+    auto text() const -> std::string_view { return text_; }
+
+    /**
+     * Whether line endings were normalized to "\n" at build time
+     */
+    auto normalized() const -> bool { return (flags_ & text::kNormalized) != 0; }
+
+    /**
+     * Number of lines; a final line without a newline counts
+     */
+    auto line_count() const -> size_t { return lines_; }
+
+    /**
+     * Line `index` without its line ending; empty if there is no such line
+     */
+    auto line(size_t index) const -> std::string_view {
+        if (index >= lines_) {
+            return {};
+        }
+        const uint64_t start = offset(index);
+        uint64_t end = offset(index + 1);
+        if (end == 0 || start > --end || end > text_.size()) {
+            return {};
+        }
+        if (end > start && text_[static_cast<size_t>(end - 1)] == '\r') {
+            --end;
+        }
+        return text_.substr(static_cast<size_t>(start), static_cast<size_t>(end - start));
+    }
+
+    /**
+     * Iterator over the lines, as returned by line()
+     */
+    class LineIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        LineIterator() = default;
+        LineIterator(const TextResource* text, size_t index) : text_(text), index_(index) {}
+
+        auto operator*() const -> std::string_view { return text_->line(index_); }
+        auto operator++() -> LineIterator& {
+            ++index_;
+            return *this;
+        }
+        auto operator++(int) -> LineIterator {
+            LineIterator previous = *this;
+            ++index_;
+            return previous;
+        }
+        auto operator==(const LineIterator& other) const -> bool { return index_ == other.index_; }
+
+        /**
+         * Number of the line the iterator is at, from 0
+         */
+        auto index() const -> size_t { return index_; }
+
+    private:
+        const TextResource* text_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    auto begin() const -> LineIterator { return {this, 0}; }
+    auto end() const -> LineIterator { return {this, lines_}; }
+
+private:
+    auto offset(size_t index) const -> uint64_t {
+        return (flags_ & text::kWideIndex) ? packed::load_le64(index_ + index * 8)
+                                           : packed::load_le32(index_ + index * 4);
+    }
+
+    std::string_view text_;
+    const uint8_t* index_ = nullptr;
+    size_t lines_ = 0;
+    uint16_t flags_ = 0;
+    ResourceError error_ = ResourceError::Success;
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_TEXT_RESOURCE_H
@@ -0,0 +1,88 @@
+#ifndef RESOURCE_TOOLS_TYPED_ARRAY_H
+#define RESOURCE_TOOLS_TYPED_ARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+
+#include <resource_tools/embedded_resource.h>
+
+namespace resource_tools {
+
+// ============================================================================
+// TYPED ARRAYS
+// ============================================================================
+
+/**
+ * Read-only array of numbers embedded with ELEMENT_TYPE
+ *
+ * The build checks that the resource is a whole number of elements and
+ * stores them in the target's byte order, so the array is the resource
+ * itself: no parsing, swapping or copying. Embedded arrays start on a
+ * 64-byte boundary; a resource that is not aligned for T (e.g. one read
+ * through the Windows resource API) is copied once into aligned memory.
+ *
+ * Example:
+ *   resource_tools::TypedArray<float> weights(model::getWeightsF32());
+ *   kernel(weights.span().data(), weights.size());
+ */
+template <typename T>
+class TypedArray {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "elements are integers or floating point");
+
+public:
+    explicit TypedArray(const ResourceResult& resource) {
+        if (!resource) {
+            error_ = resource.error;
+            return;
+        }
+        if (!resource.data && resource.size > 0) {
+            error_ = ResourceError::NullPointer;
+            return;
+        }
+        if (resource.size % sizeof(T) != 0) {
+            detail::diagnostic_log("resource_tools: typed array size is not a whole number of elements");
+            error_ = ResourceError::InvalidSize;
+            return;
+        }
+        const size_t count = resource.size / sizeof(T);
+        if (reinterpret_cast<uintptr_t>(resource.data) % alignof(T) == 0) {
+            elements_ = {reinterpret_cast<const T*>(resource.data), count};
+            return;
+        }
+        copy_ = std::unique_ptr<T[]>(new (std::nothrow) T[count]);
+        if (!copy_) {
+            error_ = ResourceError::OutOfMemory;
+            return;
+        }
+        std::memcpy(copy_.get(), resource.data, resource.size);
+        elements_ = {copy_.get(), count};
+    }
+
+    auto error() const -> ResourceError { return error_; }
+    explicit operator bool() const { return error_ == ResourceError::Success; }
+
+    /**
+     * The elements; empty if the array failed to load
+     */
+    auto span() const -> std::span<const T> { return elements_; }
+    auto size() const -> size_t { return elements_.size(); }
+
+    /**
+     * Whether the elements had to be copied to align them
+     */
+    auto copied() const -> bool { return copy_ != nullptr; }
+
+private:
+    std::span<const T> elements_;
+    std::unique_ptr<T[]> copy_;
+    ResourceError error_ = ResourceError::Success;
+};
+
+} // namespace resource_tools
+
+#endif // RESOURCE_TOOLS_TYPED_ARRAY_H
@@ -0,0 +1,382 @@
+#include <gtest/gtest.h>
+#include <resource_tools/archive_resource.h>
+#include <resource_tools/embedded_resource.h>
+#include <archive_resources/embedded_data.h>
+#include "build_step_test.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using resource_tools::ArchiveResource;
+using resource_tools::ResourceError;
+
+class ArchiveResourceTest : public BuildStepTest {
+protected:
+    // Index an archive the way the build does, decompressing it with CMake
+    // first if need be
+    static auto pack(const fs::path& input, const fs::path& output) -> int {
+        const std::string line = std::string("\"") + RESOURCE_TOOLS_CMAKE_COMMAND + "\" -DPACKER=\"" +
+                                 RESOURCE_TOOLS_TEST_PACKER + "\" -DINPUT=\"" + input.string() + "\" -DOUTPUT=\"" +
+                                 output.string() + "\" -P \"" + RESOURCE_TOOLS_ARCHIVE_SCRIPT + "\"";
+        return std::system(line.c_str());
+    }
+
+    // Run the packer on its own, which takes only plain tar files
+    static auto packTar(const fs::path& input, const fs::path& output) -> int {
+        const std::string line = std::string("\"") + RESOURCE_TOOLS_TEST_PACKER + "\" archive \"" + input.string() +
+                                 "\" \"" + output.string() + "\"";
+        return std::system(line.c_str());
+    }
+
+    // Compress `input` into a gzip stream, as gzip(1) would
+    static auto gzip(const fs::path& input, const fs::path& output) -> int {
+        const std::string line = std::string("\"") + RESOURCE_TOOLS_CMAKE_COMMAND + "\" -DINPUT=\"" +
+                                 input.string() + "\" -DOUTPUT=\"" + output.string() + "\" -DCODING=gzip -P \"" +
+                                 RESOURCE_TOOLS_COMPRESS_SCRIPT + "\"";
+        return std::system(line.c_str());
+    }
+
+    // Append one ustar entry, for archives no tool would write
+    static void appendTarEntry(std::vector<uint8_t>& tar, const std::string& name, char type,
+                               const std::string& contents = {}, const std::string& link = {}) {
+        char header[512] = {};
+        std::memcpy(header, name.data(), std::min<size_t>(name.size(), 100));
+        std::snprintf(header + 100, 8, "%07o", 0644u);
+        std::snprintf(header + 108, 8, "%07o", 0u);
+        std::snprintf(header + 116, 8, "%07o", 0u);
+        std::snprintf(header + 124, 12, "%011o", static_cast<unsigned>(contents.size()));
+        std::snprintf(header + 136, 12, "%011o", 0u);
+        header[156] = type;
+        std::memcpy(header + 157, link.data(), std::min<size_t>(link.size(), 100));
+        std::memcpy(header + 257, "ustar", 6);
+        std::memcpy(header + 263, "00", 2);
+        std::memset(header + 148, ' ', 8);
+        unsigned sum = 0;
+        for (const char c : header) {
+            sum += static_cast<uint8_t>(c);
+        }
+        std::snprintf(header + 148, 8, "%06o", sum);
+        tar.insert(tar.end(), header, header + sizeof(header));
+        tar.insert(tar.end(), contents.begin(), contents.end());
+        tar.resize((tar.size() + 511) / 512 * 512, 0);
+    }
+
+    // Archive the contents of `dir` with CMake's own tar
+    static auto makeTar(const fs::path& dir, const fs::path& output, const std::string& mode) -> int {
+        const std::string line = "cd \"" + dir.string() + "\" && \"" + RESOURCE_TOOLS_CMAKE_COMMAND + "\" -E tar " +
+                                 mode + " \"" + output.string() + "\" --format=pax .";
+        return std::system(line.c_str());
+    }
+
+    static constexpr std::string_view kLongPath =
+        "assets/deeply/nested/deeply/nested/deeply/nested/deeply/nested/deeply/nested/deeply/nested/deeply/nested/"
+        "deeply/nested/leaf.txt";
+};
+
+// ============================================================================
+// EMBEDDED ARCHIVES
+// ============================================================================
+
+TEST_F(ArchiveResourceTest, ListsRegularFilesInOrder) {
+    const ArchiveResource& assets = archive_resources::getAssetsTARArchive();
+    ASSERT_TRUE(assets);
+    EXPECT_FALSE(assets.compressed());
+    const std::vector<std::string_view> names = {kLongPath, "assets/empty.dat", "assets/levels/level1.map",
+                                                 "assets/readme.txt", "assets/shaders/basic.vert"};
+    ASSERT_EQ(assets.size(), names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        EXPECT_EQ(assets.name(i), names[i]);
+        EXPECT_EQ(assets.index_of(names[i]), i);
+    }
+
+    // Directories and links are not members
+    EXPECT_FALSE(assets.contains("assets/"));
+    EXPECT_FALSE(assets.contains("assets/shaders"));
+    EXPECT_FALSE(assets.contains("assets/link.txt"));
+}
+
+TEST_F(ArchiveResourceTest, PlainMembersAreReadInPlace) {
+    const auto blob = archive_resources::getAssetsTAR();
+    const ArchiveResource& assets = archive_resources::getAssetsTARArchive();
+    const auto readme = assets.find("assets/readme.txt");
+    ASSERT_TRUE(readme);
+    EXPECT_EQ(text(readme), "Embedded archive members are read in place.\n");
+    EXPECT_GE(readme.data, blob.data);
+    EXPECT_LE(readme.data + readme.size, blob.data + blob.size);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(readme.data) % resource_tools::archive::kDataAlignment, 0u);
+}
+
+TEST_F(ArchiveResourceTest, LongNamesAndEmptyMembers) {
+    for (const ArchiveResource* assets :
+         {&archive_resources::getAssetsTARArchive(), &archive_resources::getAssetsPaxTARGZArchive()}) {
+        // GNU long name records in the plain tar, pax headers in the other
+        EXPECT_EQ(text(assets->find(kLongPath)), "A path longer than the 100 bytes of a tar name field\n");
+        const auto empty = assets->find("assets/empty.dat");
+        EXPECT_EQ(empty.error, ResourceError::Success);
+        EXPECT_EQ(empty.size, 0u);
+    }
+}
+
+TEST_F(ArchiveResourceTest, MissingMembers) {
+    const ArchiveResource& assets = archive_resources::getAssetsTARArchive();
+    EXPECT_EQ(assets.find("assets/missing.txt").error, ResourceError::NotFound);
+    EXPECT_EQ(assets.find("readme.txt").error, ResourceError::NotFound);
+    EXPECT_EQ(assets.find("").error, ResourceError::NotFound);
+    EXPECT_EQ(assets.entry(assets.size()).error, ResourceError::NotFound);
+    EXPECT_EQ(assets.name(assets.size()), "");
+}
+
+TEST_F(ArchiveResourceTest, CompressedMembersDecodeOnDemand) {
+    const ArchiveResource& plain = archive_resources::getAssetsTARArchive();
+    const ArchiveResource& compressed = archive_resources::getAssetsPaxTARGZArchive();
+    ASSERT_TRUE(compressed);
+    EXPECT_TRUE(compressed.compressed());
+    EXPECT_LT(archive_resources::getAssetsPaxTARGZ().size, archive_resources::getAssetsTAR().size / 4);
+
+    ASSERT_EQ(compressed.size(), plain.size());
+    for (size_t i = 0; i < plain.size(); ++i) {
+        EXPECT_EQ(compressed.name(i), plain.name(i));
+        EXPECT_EQ(text(compressed.entry(i)), text(plain.entry(i))) << plain.name(i);
+    }
+
+    // Decoded once and kept
+    const auto first = compressed.find("assets/levels/level1.map");
+    const auto second = compressed.find("assets/levels/level1.map");
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first.data, second.data);
+    EXPECT_EQ(first.size, 4140u);
+}
+
+// ============================================================================
+// BUILD STEP
+// ============================================================================
+
+TEST_F(ArchiveResourceTest, ArchivesMadeByCMake) {
+    const fs::path tree = work_ / "tree";
+    fs::create_directories(tree / "config" / std::string(120, 'd'));
+    std::ofstream(tree / "config" / "app.ini") << "[window]\nwidth = 1280\n";
+    std::ofstream(tree / "config" / std::string(120, 'd') / "deep.txt") << "deep";
+    std::ofstream(tree / "notes.txt") << std::string(10000, 'n');
+
+    for (const std::string mode : {"cf", "czf", "cjf", "cJf"}) {
+        const fs::path tar = work_ / ("tree." + mode);
+        const fs::path output = work_ / ("tree_" + mode + ".bin");
+        ASSERT_EQ(makeTar(tree, tar, mode), 0);
+        ASSERT_EQ(pack(tar, output), 0) << mode;
+        const auto bytes = readFile(output);
+        ArchiveResource archive(view(bytes));
+        ASSERT_TRUE(archive) << mode;
+        EXPECT_EQ(archive.compressed(), mode != "cf");
+        // The leading "./" is dropped
+        EXPECT_EQ(archive.size(), 3u);
+        EXPECT_EQ(text(archive.find("config/app.ini")), "[window]\nwidth = 1280\n");
+        EXPECT_EQ(text(archive.find("config/" + std::string(120, 'd') + "/deep.txt")), "deep");
+        EXPECT_EQ(archive.find("notes.txt").size, 10000u);
+    }
+}
+
+TEST_F(ArchiveResourceTest, EmptyArchive) {
+    const fs::path input = work_ / "empty.tar";
+    writeFile(input, std::vector<uint8_t>(1024, 0));
+    const fs::path output = work_ / "empty.bin";
+    ASSERT_EQ(pack(input, output), 0);
+    const auto bytes = readFile(output);
+    ArchiveResource archive(view(bytes));
+    ASSERT_TRUE(archive);
+    EXPECT_TRUE(archive.empty());
+    EXPECT_EQ(archive.find("anything").error, ResourceError::NotFound);
+}
+
+TEST_F(ArchiveResourceTest, DamagedArchivesFailTheBuild) {
+    const fs::path data = fs::path(RESOURCE_TOOLS_TEST_DATA_DIR) / "archives";
+    const auto tar = readFile(data / "assets.tar");
+    const auto gz = readFile(data / "assets_pax.tar.gz");
+
+    auto bad_checksum = tar;
+    bad_checksum[10] ^= 0x01;
+    auto truncated = tar;
+    truncated.resize(700);
+    auto bad_stream = gz;
+    bad_stream[bad_stream.size() / 2] ^= 0xFF;
+    auto cut_stream = gz;
+    cut_stream.resize(gz.size() / 2);
+    std::vector<uint8_t> zstd = {0x28, 0xB5, 0x2F, 0xFD, 0, 0, 0, 0};
+
+    for (const std::vector<uint8_t>* input : {&bad_checksum, &truncated, &bad_stream, &cut_stream, &zstd}) {
+        writeFile(work_ / "input", *input);
+        const fs::path output = work_ / "out.bin";
+        EXPECT_NE(pack(work_ / "input", output), 0);
+        EXPECT_FALSE(fs::exists(output));
+    }
+}
+
+TEST_F(ArchiveResourceTest, PackerTakesOnlyPlainTar) {
+    const fs::path data = fs::path(RESOURCE_TOOLS_TEST_DATA_DIR) / "archives";
+
+    EXPECT_EQ(packTar(data / "assets.tar", work_ / "plain.bin"), 0);
+    EXPECT_NE(packTar(data / "assets_pax.tar.gz", work_ / "compressed.bin"), 0);
+    EXPECT_FALSE(fs::exists(work_ / "compressed.bin"));
+}
+
+TEST_F(ArchiveResourceTest, LinksAreNotExtracted) {
+    // A member below a symlink would be written wherever the link points
+    const fs::path outside = work_ / "outside";
+    fs::create_directories(outside);
+    std::vector<uint8_t> tar;
+    appendTarEntry(tar, "link", '2', {}, outside.string());
+    appendTarEntry(tar, "link/file.txt", '0', "contents");
+    appendTarEntry(tar, "hard", '1', {}, "link/file.txt");
+    tar.resize(tar.size() + 1024, 0);
+    writeFile(work_ / "links.tar", tar);
+    ASSERT_EQ(gzip(work_ / "links.tar", work_ / "links.tar.gz"), 0);
+
+    const fs::path output = work_ / "links.bin";
+    ASSERT_EQ(pack(work_ / "links.tar.gz", output), 0);
+    const auto bytes = readFile(output);
+    ArchiveResource archive(view(bytes));
+
+    ASSERT_TRUE(archive);
+    EXPECT_EQ(archive.size(), 1u);
+    EXPECT_EQ(text(archive.find("link/file.txt")), "contents");
+    EXPECT_TRUE(fs::is_empty(outside));
+}
+
+TEST_F(ArchiveResourceTest, CompressedArchivesKeepUnusualNames) {
+    const std::vector<std::string> names = {"with space.txt", "arrow -> target.txt", "star*.txt", "what?.txt",
+                                            "back\\slash.txt", "dir/x -> y/leaf.txt"};
+    std::vector<uint8_t> tar;
+    for (const auto& name : names) {
+        appendTarEntry(tar, name, '0', "contents of " + name);
+    }
+    // Not a member, though "star*.txt" read as a glob would match it
+    appendTarEntry(tar, "starry.txt", '2', {}, "/nowhere");
+    tar.resize(tar.size() + 1024, 0);
+    writeFile(work_ / "names.tar", tar);
+    ASSERT_EQ(gzip(work_ / "names.tar", work_ / "names.tar.gz"), 0);
+
+    const fs::path output = work_ / "names.bin";
+    ASSERT_EQ(pack(work_ / "names.tar.gz", output), 0);
+    const auto bytes = readFile(output);
+    ArchiveResource archive(view(bytes));
+
+    ASSERT_TRUE(archive);
+    EXPECT_EQ(archive.size(), names.size());
+    for (const auto& name : names) {
+        EXPECT_EQ(text(archive.find(name)), "contents of " + name) << name;
+    }
+}
+
+TEST_F(ArchiveResourceTest, NamesCMakeCannotListFailTheBuild) {
+    for (const std::string name : {"semi;colon.txt", "[bracket].txt"}) {
+        std::vector<uint8_t> tar;
+        appendTarEntry(tar, name, '0', "contents");
+        tar.resize(tar.size() + 1024, 0);
+        writeFile(work_ / "names.tar", tar);
+        ASSERT_EQ(gzip(work_ / "names.tar", work_ / "names.tar.gz"), 0);
+
+        EXPECT_NE(pack(work_ / "names.tar.gz", work_ / "names.bin"), 0) << name;
+        EXPECT_FALSE(fs::exists(work_ / "names.bin"));
+        // The same names are fine in a plain tar
+        EXPECT_EQ(pack(work_ / "names.tar", work_ / "plain.bin"), 0) << name;
+    }
+}
+
+TEST_F(ArchiveResourceTest, MembersOutsideTheArchiveFailTheBuild) {
+    for (const std::string name : {"../escaped.txt", "nested/../../escaped.txt", "/tmp/escaped.txt"}) {
+        std::vector<uint8_t> tar;
+        appendTarEntry(tar, "kept.txt", '0', "kept");
+        appendTarEntry(tar, name, '0', "escaped");
+        tar.resize(tar.size() + 1024, 0);
+        writeFile(work_ / "escape.tar", tar);
+        ASSERT_EQ(gzip(work_ / "escape.tar", work_ / "escape.tar.gz"), 0);
+
+        const fs::path output = work_ / "escape.bin";
+        EXPECT_NE(pack(work_ / "escape.tar.gz", output), 0) << name;
+        EXPECT_FALSE(fs::exists(output));
+    }
+}
+
+TEST_F(ArchiveResourceTest, CorruptArchiveIsRejected) {
+    const fs::path output = work_ / "assets.bin";
+    ASSERT_EQ(pack(fs::path(RESOURCE_TOOLS_TEST_DATA_DIR) / "archives" / "assets_pax.tar.gz", output), 0);
+    auto bytes = readFile(output);
+    ASSERT_TRUE(ArchiveResource(view(bytes)));
+
+    auto bad_magic = bytes;
+    bad_magic[0] ^= 0xFF;
+    EXPECT_EQ(ArchiveResource(view(bad_magic)).error(), ResourceError::CorruptData);
+
+    // A count that does not match where the names start
+    auto bad_count = bytes;
+    bad_count[8] = 9;
+    EXPECT_EQ(ArchiveResource(view(bad_count)).error(), ResourceError::CorruptData);
+
+    // A member running past the data reads as corrupt, the others still read
+    auto bad_member = bytes;
+    bad_member[resource_tools::archive::kHeaderSize + 8 + 7] = 0x7F;
+    ArchiveResource damaged(view(bad_member));
+    ASSERT_TRUE(damaged);
+    EXPECT_EQ(damaged.entry(0).error, ResourceError::CorruptData);
+    EXPECT_TRUE(damaged.find("assets/readme.txt"));
+
+    bytes.resize(bytes.size() / 2);
+    EXPECT_EQ(ArchiveResource(view(bytes)).error(), ResourceError::CorruptData);
+}
+
+TEST_F(ArchiveResourceTest, ConcurrentFirstAccessDecodesOnce) {
+    const fs::path output = work_ / "assets.bin";
+    ASSERT_EQ(pack(fs::path(RESOURCE_TOOLS_TEST_DATA_DIR) / "archives" / "assets_pax.tar.gz", output), 0);
+    const auto bytes = readFile(output);
+    ArchiveResource archive(view(bytes));
+    ASSERT_TRUE(archive);
+
+    std::vector<const uint8_t*> seen(8, nullptr);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&, t] { seen[t] = archive.find("assets/levels/level1.map").data; });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_NE(seen[0], nullptr);
+    for (const auto* data : seen) {
+        EXPECT_EQ(data, seen[0]);
+    }
+}
+
+// ============================================================================
+// AGAINST EXTRACTION
+// ============================================================================
+
+TEST_F(ArchiveResourceTest, IndexedLookupsMatchTheFiles) {
+    constexpr size_t kFiles = 50;
+    const fs::path tree = work_ / "tree";
+    fs::create_directories(tree);
+    for (size_t i = 0; i < kFiles; ++i) {
+        std::ofstream(tree / ("file" + std::to_string(i) + ".json"))
+            << "{\"id\": " << i << ", \"payload\": \"" << std::string(i * 40, static_cast<char>('a' + i % 26))
+            << "\"}\n";
+    }
+    const fs::path tar = work_ / "tree.tar";
+    ASSERT_EQ(makeTar(tree, tar, "cf"), 0);
+    const fs::path output = work_ / "tree.bin";
+    ASSERT_EQ(pack(tar, output), 0);
+    const auto bytes = readFile(output);
+
+    ArchiveResource archive(view(bytes));
+    for (size_t i = 0; i < kFiles; ++i) {
+        const std::string name = "file" + std::to_string(i) + ".json";
+        const auto file = readFile(tree / name);
+        ASSERT_EQ(text(archive.find(name)), std::string_view(reinterpret_cast<const char*>(file.data()), file.size()))
+            << name;
+    }
+}
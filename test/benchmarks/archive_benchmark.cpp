@@ -0,0 +1,58 @@
+#include "benchmark.h"
+
+#include <resource_tools/archive_resource.h>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+class ArchiveBenchmark : public BenchmarkTest {};
+
+TEST_F(ArchiveBenchmark, IndexedLookupsAgainstExtraction) {
+    constexpr size_t kFiles = 500;
+    const auto tree = work_ / "tree";
+    std::filesystem::create_directories(tree);
+    for (size_t i = 0; i < kFiles; ++i) {
+        std::ofstream(tree / ("file" + std::to_string(i) + ".json"))
+            << "{\"id\": " << i << ", \"payload\": \"" << std::string(2000, static_cast<char>('a' + i % 26))
+            << "\"}\n";
+    }
+    const auto tar = work_ / "tree.tar";
+    const std::string line = "cd \"" + tree.string() + "\" && \"" + RESOURCE_TOOLS_CMAKE_COMMAND + "\" -E tar cf \"" +
+                             tar.string() + "\" --format=pax .";
+    ASSERT_EQ(std::system(line.c_str()), 0);
+    const auto output = work_ / "tree.bin";
+    ASSERT_EQ(packFile("archive", tar, output), 0);
+    const auto tar_bytes = readFile(tar);
+    const auto bytes = readFile(output);
+
+    // What every startup did before: write the members out, then read them
+    auto start = std::chrono::steady_clock::now();
+    const auto extracted = work_ / "extracted";
+    std::filesystem::create_directories(extracted);
+    size_t extracted_total = 0;
+    for (size_t pos = 0; pos + 512 <= tar_bytes.size() && tar_bytes[pos] != 0;) {
+        const std::string name(reinterpret_cast<const char*>(tar_bytes.data() + pos));
+        const size_t size = std::strtoull(reinterpret_cast<const char*>(tar_bytes.data() + pos + 124), nullptr, 8);
+        if (tar_bytes[pos + 156] == '0' && name.find('/') == name.rfind('/')) {
+            std::ofstream(extracted / std::filesystem::path(name).filename(), std::ios::binary)
+                .write(reinterpret_cast<const char*>(tar_bytes.data() + pos + 512), static_cast<std::streamsize>(size));
+        }
+        pos += 512 + (size + 511) / 512 * 512;
+    }
+    for (size_t i = 0; i < kFiles; ++i) {
+        extracted_total += readFile(extracted / ("file" + std::to_string(i) + ".json")).size();
+    }
+    const auto extract_us = microsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    resource_tools::ArchiveResource archive(view(bytes));
+    size_t archive_total = 0;
+    for (size_t i = 0; i < kFiles; ++i) {
+        archive_total += archive.find("file" + std::to_string(i) + ".json").size;
+    }
+    const auto archive_us = microsSince(start);
+
+    EXPECT_EQ(archive_total, extracted_total);
+    std::cout << "[ BENCH    ] " << kFiles << " members: extract and read " << extract_us << " us, indexed lookups "
+              << archive_us << " us\n";
+}
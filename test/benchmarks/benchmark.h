@@ -0,0 +1,17 @@
+#ifndef RESOURCE_TOOLS_BENCHMARK_H
+#define RESOURCE_TOOLS_BENCHMARK_H
+
+#include "../build_step_test.h"
+#include <chrono>
+
+// Fixture shared by the benchmarks; the scratch directory and packer come
+// from BuildStepTest
+class BenchmarkTest : public BuildStepTest {
+protected:
+    static auto microsSince(std::chrono::steady_clock::time_point start) -> long long {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+};
+
+#endif // RESOURCE_TOOLS_BENCHMARK_H
@@ -0,0 +1,58 @@
+#include "benchmark.h"
+
+#include <resource_tools/binary_json.h>
+#include <iostream>
+#include <string>
+
+class BinaryJsonBenchmark : public BenchmarkTest {};
+
+TEST_F(BinaryJsonBenchmark, OpenAgainstScanningText) {
+    constexpr int kRecords = 100000;
+    std::string json = "{\"records\": [";
+    for (int i = 0; i < kRecords; ++i) {
+        json += (i > 0 ? ",\n" : "") + std::string("{\"id\": ") + std::to_string(i) + ", \"name\": \"record-" +
+                std::to_string(i) + "\"}";
+    }
+    json += "], \"version\": 7}";
+    const auto output = work_ / "bench.bin";
+    ASSERT_EQ(pack("json", json, output), 0);
+    const auto bytes = readFile(output);
+
+    // One pass over the text that only tracks strings and nesting, a lower
+    // bound on what parsing it at startup costs
+    auto start = std::chrono::steady_clock::now();
+    size_t depth = 0;
+    size_t values = 0;
+    bool in_string = false;
+    for (size_t i = 0; i < json.size(); ++i) {
+        const char c = json[i];
+        if (in_string) {
+            i += c == '\\' ? 1 : 0;
+            in_string = c != '"';
+        } else if (c == '"') {
+            in_string = true;
+        } else if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            --depth;
+        } else if (c == ',') {
+            ++values;
+        }
+    }
+    const auto scan_us = microsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    resource_tools::JsonDocument document(view(bytes));
+    const int64_t version = document["version"].as_int();
+    const auto last = document["records"][kRecords - 1]["name"].as_string();
+    const auto open_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(depth, 0u);
+    EXPECT_GT(values, static_cast<size_t>(kRecords));
+    EXPECT_EQ(version, 7);
+    EXPECT_EQ(last, "record-" + std::to_string(kRecords - 1));
+    std::cout << "[ BENCH    ] " << json.size() / 1024 << " KB of JSON: scanning the text " << scan_us
+              << " us, opening the binary document and two lookups " << open_ns << " ns (" << bytes.size() / 1024
+              << " KB)\n";
+}
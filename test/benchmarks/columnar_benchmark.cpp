@@ -0,0 +1,62 @@
+#include "benchmark.h"
+
+#include <resource_tools/columnar.h>
+#include <charconv>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class ColumnarBenchmark : public BenchmarkTest {};
+
+TEST_F(ColumnarBenchmark, ColumnarScanSkipsParsing) {
+    constexpr size_t kRows = 200000;
+    std::string csv = "id,price,quantity,region\n";
+    for (size_t i = 0; i < kRows; ++i) {
+        csv += std::to_string(i) + "," + std::to_string((i % 1000) * 0.25) + "," + std::to_string(i % 97) +
+               ",region" + std::to_string(i % 16) + "\n";
+    }
+    const auto output = work_ / "table.bin";
+    ASSERT_EQ(pack("columnar --schema id:uint32,price:float64,quantity:int32,region:string", csv, output), 0);
+    const auto bytes = readFile(output);
+
+    // What every startup did before: parse the text into vectors, then scan
+    auto start = std::chrono::steady_clock::now();
+    std::vector<double> prices;
+    std::vector<int32_t> quantities;
+    prices.reserve(kRows);
+    quantities.reserve(kRows);
+    const char* p = csv.data() + csv.find('\n') + 1;
+    const char* end = csv.data() + csv.size();
+    while (p < end) {
+        uint32_t id = 0;
+        double price = 0;
+        int32_t quantity = 0;
+        p = std::from_chars(p, end, id).ptr + 1;
+        p = std::from_chars(p, end, price).ptr + 1;
+        p = std::from_chars(p, end, quantity).ptr + 1;
+        while (p < end && *p++ != '\n') {
+        }
+        prices.push_back(price);
+        quantities.push_back(quantity);
+    }
+    double parsed_total = 0;
+    for (size_t i = 0; i < prices.size(); ++i) {
+        parsed_total += prices[i] * quantities[i];
+    }
+    const auto parse_us = microsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    resource_tools::ColumnarTable table(view(bytes));
+    auto price = table.column<double>("price");
+    auto quantity = table.column<int32_t>("quantity");
+    double columnar_total = 0;
+    for (size_t i = 0; i < price.size(); ++i) {
+        columnar_total += price[i] * quantity[i];
+    }
+    const auto columnar_us = microsSince(start);
+
+    ASSERT_EQ(price.size(), kRows);
+    EXPECT_DOUBLE_EQ(columnar_total, parsed_total);
+    std::cout << "[ BENCH    ] " << kRows << " rows: parse and scan " << parse_us << " us, columnar scan "
+              << columnar_us << " us\n";
+}
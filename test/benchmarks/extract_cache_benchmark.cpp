@@ -0,0 +1,28 @@
+#include "benchmark.h"
+
+#include <resource_tools/extract_cache.h>
+#include <iostream>
+#include <vector>
+
+class ExtractCacheBenchmark : public BenchmarkTest {};
+
+TEST_F(ExtractCacheBenchmark, ColdAndWarmStart) {
+    const auto cache = (work_ / "cache").string();
+    std::vector<uint8_t> bytes(size_t{32} * 1024 * 1024);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 131);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto cold = resource_tools::extractToCache(view(bytes), "", cache);
+    const auto cold_us = microsSince(start);
+    ASSERT_TRUE(cold);
+
+    start = std::chrono::steady_clock::now();
+    auto warm = resource_tools::extractToCache(view(bytes), "", cache);
+    const auto warm_us = microsSince(start);
+    ASSERT_TRUE(warm);
+
+    EXPECT_EQ(warm.path, cold.path);
+    std::cout << "[ BENCH    ] extracting 32 MB: cold " << cold_us << " us, warm " << warm_us << " us\n";
+}
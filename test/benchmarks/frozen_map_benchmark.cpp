@@ -0,0 +1,60 @@
+#include "benchmark.h"
+
+#include <resource_tools/frozen_map.h>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class FrozenMapBenchmark : public BenchmarkTest {};
+
+TEST_F(FrozenMapBenchmark, AgainstUnorderedMap) {
+    constexpr size_t kKeys = 100000;
+    constexpr size_t kLookups = 100000;
+    std::string tsv;
+    for (size_t i = 0; i < kKeys; ++i) {
+        tsv += "SKU-" + std::to_string(1000000 + i) + "\tProduct " + std::to_string(i) + "\n";
+    }
+    const auto output = work_ / "bench.bin";
+    ASSERT_EQ(pack("frozen-map", tsv, output), 0);
+    const auto bytes = readFile(output);
+
+    std::mt19937 rng(47);
+    std::vector<std::string> lookups;
+    lookups.reserve(kLookups);
+    for (size_t i = 0; i < kLookups; ++i) {
+        lookups.push_back("SKU-" + std::to_string(1000000 + rng() % (kKeys + kKeys / 4)));
+    }
+
+    // What every startup did before: parse the file into a map
+    auto start = std::chrono::steady_clock::now();
+    std::unordered_map<std::string, std::string> map;
+    map.reserve(kKeys);
+    for (size_t pos = 0; pos < tsv.size();) {
+        const size_t tab = tsv.find('\t', pos);
+        const size_t end = tsv.find('\n', tab);
+        map.emplace(tsv.substr(pos, tab - pos), tsv.substr(tab + 1, end - tab - 1));
+        pos = end + 1;
+    }
+    const auto build_us = microsSince(start);
+    start = std::chrono::steady_clock::now();
+    size_t map_hits = 0;
+    for (const auto& key : lookups) {
+        map_hits += map.count(key);
+    }
+    const auto map_us = microsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    resource_tools::FrozenMap frozen(view(bytes));
+    size_t frozen_hits = 0;
+    for (const auto& key : lookups) {
+        frozen_hits += frozen.contains(key) ? 1 : 0;
+    }
+    const auto frozen_us = microsSince(start);
+
+    EXPECT_EQ(frozen_hits, map_hits);
+    std::cout << "[ BENCH    ] " << kKeys << " keys, " << kLookups << " lookups: unordered_map build " << build_us
+              << " us + lookups " << map_us << " us, frozen map lookups " << frozen_us << " us ("
+              << bytes.size() / 1024 << " KB, " << frozen.bucket_count() << " buckets)\n";
+}
@@ -0,0 +1,60 @@
+#include "benchmark.h"
+
+#include <resource_tools/frozen_set.h>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class FrozenSetBenchmark : public BenchmarkTest {};
+
+TEST_F(FrozenSetBenchmark, AgainstUnorderedSet) {
+    constexpr size_t kWords = 100000;
+    constexpr size_t kLookups = 100000;
+    std::string words;
+    for (size_t i = 0; i < kWords; ++i) {
+        words += "host" + std::to_string(i * 7) + ".example.com\n";
+    }
+    const auto output = work_ / "bench.bin";
+    ASSERT_EQ(pack("set --bloom-bits 10", words, output), 0);
+    const auto bytes = readFile(output);
+
+    // Mostly misses, as for a blocklist
+    std::mt19937 rng(48);
+    std::vector<std::string> lookups;
+    lookups.reserve(kLookups);
+    for (size_t i = 0; i < kLookups; ++i) {
+        lookups.push_back("host" + std::to_string(rng() % (kWords * 70)) + ".example.com");
+    }
+
+    // What every startup did before: load the list into a hash set
+    auto start = std::chrono::steady_clock::now();
+    std::unordered_set<std::string> parsed;
+    parsed.reserve(kWords);
+    for (size_t pos = 0; pos < words.size();) {
+        const size_t end = words.find('\n', pos);
+        parsed.insert(words.substr(pos, end - pos));
+        pos = end + 1;
+    }
+    const auto build_us = microsSince(start);
+    start = std::chrono::steady_clock::now();
+    size_t parsed_hits = 0;
+    for (const auto& key : lookups) {
+        parsed_hits += parsed.count(key);
+    }
+    const auto parsed_us = microsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    resource_tools::FrozenSet set(view(bytes));
+    size_t set_hits = 0;
+    for (const auto& key : lookups) {
+        set_hits += set.contains(key) ? 1 : 0;
+    }
+    const auto set_us = microsSince(start);
+
+    EXPECT_EQ(set_hits, parsed_hits);
+    std::cout << "[ BENCH    ] " << kWords << " entries, " << kLookups << " lookups: unordered_set build "
+              << build_us << " us + lookups " << parsed_us << " us, frozen set lookups " << set_us << " us ("
+              << bytes.size() / 1024 << " KB vs " << words.size() / 1024 << " KB of text)\n";
+}
@@ -0,0 +1,113 @@
+#include "benchmark.h"
+
+#include <resource_tools/huge_pages.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using resource_tools::HugePageResource;
+using resource_tools::PageBacking;
+using resource_tools::ResourceError;
+
+class HugePagesBenchmark : public BenchmarkTest {
+protected:
+    static auto reservedHugePages() -> long {
+        long pages = 0;
+        if (FILE* file = std::fopen("/proc/sys/vm/nr_hugepages", "r")) {
+            if (std::fscanf(file, "%ld", &pages) != 1) {
+                pages = 0;
+            }
+            std::fclose(file);
+        }
+        return pages;
+    }
+
+    // Open a user-space dTLB read miss counter, or return -1
+    static auto openTlbMissCounter() -> int {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    struct RandomReads {
+        long long tlb_misses = -1;
+        double millis = 0;
+    };
+
+    // Read one byte at each of `count` pseudo-random offsets
+    static auto randomReads(const resource_tools::ResourceResult& resource, size_t count) -> RandomReads {
+        const int counter = openTlbMissCounter();
+        if (counter >= 0) {
+            ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+            ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+        }
+        const auto start = std::chrono::steady_clock::now();
+        uint64_t state = 88172645463325252ULL;
+        uint8_t sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            sum ^= static_cast<const volatile uint8_t*>(resource.data)[state % resource.size];
+        }
+        RandomReads reads;
+        reads.millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (counter >= 0) {
+            ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+            long long misses = 0;
+            if (read(counter, &misses, sizeof(misses)) == static_cast<ssize_t>(sizeof(misses))) {
+                reads.tlb_misses = misses;
+            }
+            close(counter);
+        }
+        static_cast<void>(sum);
+        return reads;
+    }
+};
+
+TEST_F(HugePagesBenchmark, RandomAccess) {
+    if (!resource_tools::detail::transparent_huge_pages_enabled() && reservedHugePages() == 0) {
+        GTEST_SKIP() << "No huge pages on this system";
+    }
+    // 64 MB of normal pages, much more than the TLB covers
+    constexpr size_t size = size_t{64} * 1024 * 1024;
+    constexpr size_t reads = size_t{4} * 1024 * 1024;
+    void* small_pages = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(small_pages, MAP_FAILED);
+    madvise(small_pages, size, MADV_NOHUGEPAGE);
+    std::memset(small_pages, 0x5a, size);
+    resource_tools::ResourceResult source{static_cast<const uint8_t*>(small_pages), size, ResourceError::Success};
+
+    HugePageResource copy(source);
+    ASSERT_NE(copy.backing(), PageBacking::Source);
+
+    randomReads(source, reads);
+    const RandomReads normal = randomReads(source, reads);
+    randomReads(copy.get(), reads);
+    const RandomReads huge = randomReads(copy.get(), reads);
+    munmap(small_pages, size);
+
+    std::cout << "[ BENCH    ] " << reads << " random reads over " << size / (1024 * 1024) << " MB: " << normal.millis
+              << " ms on 4 KB pages, " << huge.millis << " ms on huge pages\n";
+    if (normal.tlb_misses >= 0 && huge.tlb_misses >= 0) {
+        std::cout << "[ BENCH    ] dTLB read misses: " << normal.tlb_misses << " on 4 KB pages, " << huge.tlb_misses
+                  << " on huge pages\n";
+    } else {
+        std::cout << "[ BENCH    ] dTLB miss counter unavailable (perf_event_open), timing only\n";
+    }
+}
+
+#endif // __linux__
@@ -0,0 +1,70 @@
+#include "benchmark.h"
+
+#include <resource_tools/memory_advice.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using resource_tools::Advice;
+using resource_tools::ResourceError;
+
+class MemoryAdviceBenchmark : public BenchmarkTest {
+protected:
+    static auto minorFaults() -> long {
+        struct rusage usage {};
+        getrusage(RUSAGE_THREAD, &usage);
+        return usage.ru_minflt;
+    }
+
+    static auto touchPages(const resource_tools::ResourceResult& resource) -> uint8_t {
+        uint8_t sum = 0;
+        for (size_t offset = 0; offset < resource.size; offset += 4096) {
+            sum ^= static_cast<const volatile uint8_t*>(resource.data)[offset];
+        }
+        return sum;
+    }
+};
+
+TEST_F(MemoryAdviceBenchmark, FirstTouchFaults) {
+    // A file-backed read-only mapping behaves like data embedded in .rodata
+    constexpr size_t size = size_t{16} * 1024 * 1024;
+    const auto path = work_ / "advice.bin";
+    {
+        std::vector<char> data(size, 'x');
+        std::ofstream out(path, std::ios::binary);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    int fd = open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    void* cold_map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    void* warm_map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    ASSERT_NE(cold_map, MAP_FAILED);
+    ASSERT_NE(warm_map, MAP_FAILED);
+    resource_tools::ResourceResult cold{static_cast<const uint8_t*>(cold_map), size, ResourceError::Success};
+    resource_tools::ResourceResult warm{static_cast<const uint8_t*>(warm_map), size, ResourceError::Success};
+
+    long start = minorFaults();
+    touchPages(cold);
+    const long cold_faults = minorFaults() - start;
+
+    ASSERT_EQ(resource_tools::advise(warm, Advice::WillNeed), ResourceError::Success);
+    start = minorFaults();
+    touchPages(warm);
+    const long warm_faults = minorFaults() - start;
+
+    munmap(cold_map, size);
+    munmap(warm_map, size);
+
+    EXPECT_LE(warm_faults, cold_faults);
+    std::cout << "[ BENCH    ] first touch of " << size / (1024 * 1024) << " MB: " << cold_faults
+              << " minor faults cold, " << warm_faults << " after advise(WillNeed)\n";
+}
+
+#endif // __linux__
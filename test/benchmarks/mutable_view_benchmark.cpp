@@ -0,0 +1,50 @@
+#include "benchmark.h"
+
+#include <resource_tools/mutable_view.h>
+#include <iostream>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using resource_tools::ResourceError;
+using resource_tools::ViewBacking;
+
+class MutableViewBenchmark : public BenchmarkTest {};
+
+TEST_F(MutableViewBenchmark, LargeView) {
+    // A read-only file mapping stands in for a large resource in the binary
+    constexpr size_t size = size_t{256} * 1024 * 1024;
+    const auto path = work_ / "view.bin";
+    {
+        std::vector<char> block(size_t{1} << 20, 'v');
+        std::ofstream out(path, std::ios::binary);
+        for (size_t written = 0; written < size; written += block.size()) {
+            out.write(block.data(), static_cast<std::streamsize>(block.size()));
+        }
+    }
+    const int fd = open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    ASSERT_NE(mapped, MAP_FAILED);
+
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto view = resource_tools::mutableView({static_cast<const uint8_t*>(mapped), size, ResourceError::Success});
+        const auto micros = microsSince(start);
+        ASSERT_TRUE(view);
+        EXPECT_EQ(view.backing(), ViewBacking::File);
+        for (size_t i = 0; i < 16; ++i) {
+            view.data()[i * (size / 16)] = 0xab;
+        }
+
+        std::cout << "[ BENCH    ] mutable view of " << size / (1024 * 1024) << " MB in " << micros
+                  << " us, 16 pages written\n";
+    }
+    munmap(mapped, size);
+}
+
+#endif // __linux__
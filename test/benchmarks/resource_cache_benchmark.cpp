@@ -0,0 +1,74 @@
+#include "benchmark.h"
+
+#include <resource_tools/packed_resource.h>
+#include <resource_tools/resource_cache.h>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using resource_tools::ResourceCache;
+using resource_tools::ResourceResult;
+
+class ResourceCacheBenchmark : public BenchmarkTest {
+protected:
+    // Sparse container of `size` bytes whose first 16 bytes are `fill`
+    static auto makeResource(size_t size, uint8_t fill) -> std::vector<uint8_t> {
+        std::vector<uint8_t> payload(8 + 16 + 16, fill);
+        resource_tools::packed::store_le64(payload.data(), 1);
+        resource_tools::packed::store_le64(payload.data() + 8, 0);
+        resource_tools::packed::store_le64(payload.data() + 16, 16);
+
+        std::vector<uint8_t> out(resource_tools::packed::kHeaderSize);
+        resource_tools::packed::Header header;
+        header.encoding = resource_tools::packed::Encoding::Sparse;
+        header.size = size;
+        header.payload_size = payload.size();
+        resource_tools::packed::writeHeader(out.data(), header);
+        out.insert(out.end(), payload.begin(), payload.end());
+        return out;
+    }
+};
+
+TEST_F(ResourceCacheBenchmark, ConcurrentReadsDifferentResources) {
+    constexpr int num_threads = 64;
+    constexpr int num_resources = 256;
+    constexpr int reads_per_thread = 2000;
+    constexpr size_t resource_size = 16 * 1024;
+
+    // Room for a quarter of the working set, so threads evict each other
+    ResourceCache cache(resource_size * num_resources / 4);
+    std::vector<std::vector<uint8_t>> resources;
+    for (int i = 0; i < num_resources; ++i) {
+        resources.push_back(makeResource(resource_size, static_cast<uint8_t>(i)));
+    }
+
+    std::atomic<int> total_success{0};
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            uint32_t state = static_cast<uint32_t>(t) * 2654435761u + 1;
+            for (int j = 0; j < reads_per_thread; ++j) {
+                state = state * 1664525u + 1013904223u;
+                // Skewed access: most reads hit a small hot set
+                const int index = (state >> 24) < 200 ? static_cast<int>((state >> 8) % 32)
+                                                      : static_cast<int>((state >> 8) % num_resources);
+                if (cache.get(view(resources[index]))) {
+                    total_success++;
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(total_success, num_threads * reads_per_thread);
+    auto stats = cache.stats();
+    std::cout << "[ BENCH    ] " << num_threads << " threads, " << (num_threads * reads_per_thread) / elapsed
+              << " reads/s, hit rate " << (100.0 * stats.hits / (stats.hits + stats.misses)) << "%\n";
+}
@@ -0,0 +1,50 @@
+#include "benchmark.h"
+
+#include <resource_tools/string_table.h>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class StringTableBenchmark : public BenchmarkTest {};
+
+TEST_F(StringTableBenchmark, StartupAndLookup) {
+    constexpr size_t kKeys = 20000;
+    std::string catalog;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < kKeys; ++i) {
+        keys.push_back("ui.panel" + std::to_string(i % 97) + ".label" + std::to_string(i));
+        catalog += keys.back() + " = Label " + std::to_string(i) + "\n";
+    }
+    const auto output = work_ / "bench.bin";
+    ASSERT_EQ(pack("string-table", catalog, output), 0);
+    const auto bytes = readFile(output);
+
+    // What every startup did before: build a map from the catalog text
+    auto start = std::chrono::steady_clock::now();
+    std::unordered_map<std::string, std::string> map;
+    size_t pos = 0;
+    while (pos < catalog.size()) {
+        const size_t equals = catalog.find(" = ", pos);
+        const size_t end = catalog.find('\n', equals);
+        map.emplace(catalog.substr(pos, equals - pos), catalog.substr(equals + 3, end - equals - 3));
+        pos = end + 1;
+    }
+    size_t map_total = 0;
+    for (const auto& key : keys) {
+        map_total += map.find(key)->second.size();
+    }
+    const auto map_us = microsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    resource_tools::StringTable table(view(bytes));
+    size_t table_total = 0;
+    for (const auto& key : keys) {
+        table_total += table.get(key).size();
+    }
+    const auto table_us = microsSince(start);
+
+    EXPECT_EQ(table_total, map_total);
+    std::cout << "[ BENCH    ] " << kKeys << " keys: unordered_map build and lookups " << map_us
+              << " us, string table lookups " << table_us << " us\n";
+}
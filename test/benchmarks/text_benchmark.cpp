@@ -0,0 +1,51 @@
+#include "benchmark.h"
+
+#include <resource_tools/text_resource.h>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+class TextBenchmark : public BenchmarkTest {};
+
+TEST_F(TextBenchmark, RandomLineAccess) {
+    constexpr size_t kLines = 100000;
+    constexpr size_t kLookups = 1000;
+    std::string text;
+    for (size_t i = 0; i < kLines; ++i) {
+        text += "line " + std::to_string(i) + "\n";
+    }
+    const auto output = work_ / "bench.bin";
+    ASSERT_EQ(pack("text", text, output), 0);
+    const auto bytes = readFile(output);
+
+    std::mt19937 rng(7);
+    std::vector<size_t> lookups(kLookups);
+    for (auto& lookup : lookups) {
+        lookup = rng() % kLines;
+    }
+
+    // Finding a line by counting newlines from the start
+    auto start = std::chrono::steady_clock::now();
+    size_t scanned = 0;
+    for (const size_t lookup : lookups) {
+        size_t pos = 0;
+        for (size_t line = 0; line < lookup; ++line) {
+            pos = text.find('\n', pos) + 1;
+        }
+        scanned += text.find('\n', pos) - pos;
+    }
+    const auto scan_us = microsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    resource_tools::TextResource indexed(view(bytes));
+    size_t looked_up = 0;
+    for (const size_t lookup : lookups) {
+        looked_up += indexed.line(lookup).size();
+    }
+    const auto index_us = microsSince(start);
+
+    EXPECT_EQ(looked_up, scanned);
+    std::cout << "[ BENCH    ] " << kLookups << " lines of " << kLines << ": scan " << scan_us << " us, index "
+              << index_us << " us\n";
+}
@@ -0,0 +1,340 @@
+#include <gtest/gtest.h>
+#include <resource_tools/binary_json.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+#include <json_resources/embedded_data.h>
+#include <json_sparse_resources/embedded_data.h>
+#include "build_step_test.h"
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+using resource_tools::JsonDocument;
+using resource_tools::JsonType;
+using resource_tools::ResourceError;
+
+class BinaryJsonTest : public BuildStepTest {
+protected:
+    // Convert a document the way the build does
+    auto pack(const std::string& json, const fs::path& output) const -> int {
+        return BuildStepTest::pack("json", json, output, "input.json");
+    }
+};
+
+// ============================================================================
+// EMBEDDED DOCUMENTS
+// ============================================================================
+
+TEST_F(BinaryJsonTest, ReadsScalars) {
+    const JsonDocument& service = json_resources::getServiceJSONJson();
+    ASSERT_TRUE(service);
+    ASSERT_TRUE(service.root().is_object());
+
+    EXPECT_EQ(service["name"].as_string(), "resource_tools");
+    EXPECT_EQ(service["version"].type(), JsonType::Int);
+    EXPECT_EQ(service["version"].as_int(), 3);
+    EXPECT_EQ(service["timeout_ms"].as_int(), -2500);
+    EXPECT_EQ(service["debug"].type(), JsonType::False);
+    EXPECT_FALSE(service["debug"].as_bool(true));
+    EXPECT_TRUE(service["verbose"].as_bool());
+    EXPECT_TRUE(service["proxy"].is_null());
+    EXPECT_TRUE(service["proxy"]);
+    EXPECT_EQ(service["ratio"].type(), JsonType::Double);
+    EXPECT_DOUBLE_EQ(service["ratio"].as_double(), 0.75);
+    EXPECT_DOUBLE_EQ(service["version"].as_double(), 3.0);
+}
+
+TEST_F(BinaryJsonTest, IntegersOutsideInt64AreDoubles) {
+    const auto limits = json_resources::getServiceJSONJson()["limits"];
+    EXPECT_EQ(limits["max_connections"].as_int(), std::numeric_limits<int64_t>::max());
+    EXPECT_EQ(limits["tiny"].type(), JsonType::Double);
+    EXPECT_DOUBLE_EQ(limits["tiny"].as_double(), 18446744073709551616.0);
+}
+
+TEST_F(BinaryJsonTest, NavigatesNestedValues) {
+    const JsonDocument& service = json_resources::getServiceJSONJson();
+    EXPECT_EQ(service["server"]["port"].as_int(), 8080);
+    EXPECT_TRUE(service["server"]["tls"]["enabled"].as_bool());
+    EXPECT_EQ(service["server"]["tls"]["ciphers"][1].as_string(), "TLS_CHACHA20_POLY1305_SHA256");
+
+    const auto hosts = service["hosts"];
+    ASSERT_TRUE(hosts.is_array());
+    ASSERT_EQ(hosts.size(), 3u);
+    EXPECT_EQ(hosts[0].as_string(), "alpha.example.com");
+    EXPECT_EQ(hosts[2].as_string(), "gamma.example.com");
+
+    const auto mixed = service["mixed"];
+    ASSERT_EQ(mixed.size(), 7u);
+    EXPECT_EQ(mixed[0].type(), JsonType::Int);
+    EXPECT_EQ(mixed[1].type(), JsonType::Double);
+    EXPECT_EQ(mixed[2].as_string(), "three");
+    EXPECT_TRUE(mixed[3].is_null());
+    EXPECT_TRUE(mixed[4].as_bool());
+    EXPECT_EQ(mixed[5][0].as_int(), 4);
+    EXPECT_EQ(mixed[6]["five"].as_int(), 5);
+
+    EXPECT_TRUE(service["empty_object"].is_object());
+    EXPECT_EQ(service["empty_object"].size(), 0u);
+    EXPECT_TRUE(service["empty_array"].is_array());
+    EXPECT_EQ(service["empty_array"].size(), 0u);
+}
+
+TEST_F(BinaryJsonTest, StringsAreDecoded) {
+    const JsonDocument& service = json_resources::getServiceJSONJson();
+    EXPECT_EQ(service["greeting"].as_string(), "Grüße, café 😀 \"quoted\"\n\ttabbed \\ slash/");
+    EXPECT_EQ(service["escaped"].as_string(), "café 😀 A");
+    EXPECT_EQ(service["motto"].as_string(), "naïve résumé");
+
+    // NUL-terminated in place, for C APIs
+    const std::string_view host = service["server"]["host"].as_string();
+    EXPECT_EQ(host.data()[host.size()], '\0');
+}
+
+TEST_F(BinaryJsonTest, MembersKeepDocumentOrder) {
+    const auto root = json_resources::getServiceJSONJson().root();
+    ASSERT_EQ(root.size(), 18u);
+    EXPECT_EQ(root.key(0), "name");
+    EXPECT_EQ(root.value(0).as_string(), "resource_tools");
+    EXPECT_EQ(root.key(16), "zebra");
+    EXPECT_EQ(root.key(17), "Apple");
+    for (size_t i = 0; i < root.size(); ++i) {
+        EXPECT_TRUE(root.contains(root.key(i))) << root.key(i);
+    }
+    EXPECT_FALSE(root.contains("apple"));
+    EXPECT_FALSE(root.contains(""));
+}
+
+TEST_F(BinaryJsonTest, MissingValuesChain) {
+    const JsonDocument& service = json_resources::getServiceJSONJson();
+    const auto missing = service["nope"]["deeper"][3];
+    EXPECT_FALSE(missing);
+    EXPECT_EQ(missing.type(), JsonType::Missing);
+    EXPECT_EQ(missing.as_int(42), 42);
+    EXPECT_EQ(missing.as_string("fallback"), "fallback");
+    EXPECT_EQ(missing.size(), 0u);
+
+    // Lookups of the wrong kind are misses too
+    EXPECT_FALSE(service["hosts"]["alpha"]);
+    EXPECT_FALSE(service["hosts"][3]);
+    EXPECT_FALSE(service["server"][0]);
+    EXPECT_EQ(service["name"].as_int(7), 7);
+    EXPECT_EQ(service["version"].as_string("none"), "none");
+    EXPECT_FALSE(service["proxy"].as_bool());
+    EXPECT_TRUE(service["nope"].key(0).empty());
+}
+
+TEST_F(BinaryJsonTest, SparseDocumentWithArrayRoot) {
+    const JsonDocument& records = json_sparse_resources::getRecordsJSONJson();
+    ASSERT_TRUE(records);
+    const auto root = records.root();
+    ASSERT_TRUE(root.is_array());
+    ASSERT_EQ(root.size(), 2u);
+    EXPECT_EQ(root[0]["id"].as_int(), 1);
+    EXPECT_EQ(root[1]["name"].as_string(), "id");
+    EXPECT_FALSE(records["id"]);
+}
+
+TEST_F(BinaryJsonTest, DocumentIsCacheLineAligned) {
+    const auto resource = json_resources::getServiceJSON();
+    ASSERT_TRUE(resource);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(resource.data) % 64, 0u);
+}
+
+// ============================================================================
+// BUILD STEP
+// ============================================================================
+
+TEST_F(BinaryJsonTest, ScalarRoots) {
+    const fs::path output = work_ / "out.bin";
+    ASSERT_EQ(pack("\xEF\xBB\xBF  42 \r\n", output), 0);
+    auto bytes = readFile(output);
+    EXPECT_EQ(JsonDocument(view(bytes)).root().as_int(), 42);
+
+    ASSERT_EQ(pack("\"only\"", output), 0);
+    bytes = readFile(output);
+    EXPECT_EQ(JsonDocument(view(bytes)).root().as_string(), "only");
+
+    ASSERT_EQ(pack("null", output), 0);
+    bytes = readFile(output);
+    EXPECT_TRUE(JsonDocument(view(bytes)).root().is_null());
+
+    ASSERT_EQ(pack("-0.0e+0", output), 0);
+    bytes = readFile(output);
+    EXPECT_EQ(JsonDocument(view(bytes)).root().type(), JsonType::Double);
+
+    ASSERT_EQ(pack("-9223372036854775808", output), 0);
+    bytes = readFile(output);
+    EXPECT_EQ(JsonDocument(view(bytes)).root().as_int(), std::numeric_limits<int64_t>::min());
+}
+
+TEST_F(BinaryJsonTest, SmallIntegersAreInline) {
+    const fs::path output = work_ / "out.bin";
+    ASSERT_EQ(pack("[1152921504606846975, -1152921504606846976, 1152921504606846976, -1152921504606846977, 0, -1]",
+                   output),
+              0);
+    const auto bytes = readFile(output);
+    const auto root = JsonDocument(view(bytes)).root();
+    ASSERT_EQ(root.size(), 6u);
+    EXPECT_EQ(root[0].as_int(), (int64_t{1} << 60) - 1);
+    EXPECT_EQ(root[1].as_int(), -(int64_t{1} << 60));
+    EXPECT_EQ(root[2].as_int(), int64_t{1} << 60);
+    EXPECT_EQ(root[3].as_int(), -(int64_t{1} << 60) - 1);
+    EXPECT_EQ(root[4].as_int(), 0);
+    EXPECT_EQ(root[5].as_int(), -1);
+    EXPECT_DOUBLE_EQ(root[5].as_double(), -1.0);
+    for (size_t i = 0; i < root.size(); ++i) {
+        EXPECT_EQ(root[i].type(), JsonType::Int);
+    }
+
+    // Header, array count and six references, plus records for the two
+    // integers outside the inline range
+    EXPECT_EQ(bytes.size(), resource_tools::binary_json::kHeaderSize + 8 + 6 * 8 + 2 * 8);
+
+    const fs::path literals = work_ / "literals.bin";
+    ASSERT_EQ(pack("[null, false, true, 7]", literals), 0);
+    EXPECT_EQ(fs::file_size(literals), resource_tools::binary_json::kHeaderSize + 8 + 4 * 8);
+}
+
+TEST_F(BinaryJsonTest, EqualStringsAreStoredOnce) {
+    const fs::path once = work_ / "once.bin";
+    const fs::path repeated = work_ / "repeated.bin";
+    const std::string value = "\"" + std::string(1000, 'x') + "\"";
+    ASSERT_EQ(pack("[" + value + "]", once), 0);
+    ASSERT_EQ(pack("[" + value + "," + value + ",{" + value + ":" + value + "}]", repeated), 0);
+    EXPECT_LT(fs::file_size(repeated), fs::file_size(once) + 100);
+}
+
+TEST_F(BinaryJsonTest, MalformedJsonFailsTheBuild) {
+    const fs::path output = work_ / "out.bin";
+    for (const char* json : {
+             "",
+             "{",
+             "[1, 2,]",
+             "{\"a\": 1,}",
+             "{\"a\" 1}",
+             "{a: 1}",
+             "{\"a\": 1, \"a\": 2}",
+             "[01]",
+             "[1.]",
+             "[.5]",
+             "[1e]",
+             "[+1]",
+             "[1e400]",
+             "[NaN]",
+             "[tru]",
+             "\"tab\there\"",
+             "\"bad \\x escape\"",
+             "\"\\u12\"",
+             "\"\\ud83d alone\"",
+             "\"\\ude00 alone\"",
+             "\"\xC3\x28\"",
+             "\"\xED\xA0\x80\"",
+             "\"unterminated",
+             "{} {}",
+             "[1] x",
+         }) {
+        EXPECT_NE(pack(json, output), 0) << json;
+        EXPECT_FALSE(fs::exists(output)) << json;
+    }
+}
+
+TEST_F(BinaryJsonTest, ErrorsNameTheLineAndColumn) {
+    const fs::path output = work_ / "out.bin";
+    ASSERT_NE(pack("{\n  \"a\": 1,\n  \"b\": [1, 2,, 3]\n}\n", output), 0);
+    EXPECT_NE(errors().find("input.json:3:14: expected a value"), std::string::npos) << errors();
+
+    ASSERT_NE(pack("{\"key\": 1,\n \"key\": 2}", output), 0);
+    EXPECT_NE(errors().find("input.json:2:2: duplicate key \"key\""), std::string::npos) << errors();
+}
+
+TEST_F(BinaryJsonTest, NestingIsLimited) {
+    const fs::path output = work_ / "out.bin";
+    ASSERT_EQ(pack(std::string(512, '[') + std::string(512, ']'), output), 0);
+    const auto bytes = readFile(output);
+    JsonDocument deep(view(bytes));
+    auto value = deep.root();
+    for (int i = 0; i < 511; ++i) {
+        ASSERT_EQ(value.size(), 1u);
+        value = value[0];
+    }
+    EXPECT_TRUE(value.is_array());
+    EXPECT_EQ(value.size(), 0u);
+
+    EXPECT_NE(pack(std::string(513, '[') + std::string(513, ']'), output), 0);
+}
+
+TEST_F(BinaryJsonTest, CorruptDocumentIsRejected) {
+    const fs::path output = work_ / "doc.bin";
+    ASSERT_EQ(pack("{\"list\": [1, 2, 3], \"name\": \"value\"}", output), 0);
+    auto bytes = readFile(output);
+    ASSERT_TRUE(JsonDocument(view(bytes)));
+
+    auto bad_magic = bytes;
+    bad_magic[0] ^= 0xFF;
+    EXPECT_EQ(JsonDocument(view(bad_magic)).error(), ResourceError::CorruptData);
+
+    auto bad_version = bytes;
+    bad_version[4] = static_cast<uint8_t>(resource_tools::binary_json::kVersion + 1);
+    EXPECT_EQ(JsonDocument(view(bad_version)).error(), ResourceError::CorruptData);
+
+    // A root reference past the end of the document
+    auto bad_root = bytes;
+    bad_root[14] = 0x7F;
+    EXPECT_EQ(JsonDocument(view(bad_root)).error(), ResourceError::CorruptData);
+
+    // An array count larger than the document reads as Missing; the rest
+    // of the document is still readable
+    auto bad_count = bytes;
+    const uint64_t root = resource_tools::packed::load_le64(bytes.data() + 8) & ~uint64_t{7};
+    const uint64_t list = resource_tools::packed::load_le64(bytes.data() + root + 16) & ~uint64_t{7};
+    ASSERT_EQ(resource_tools::packed::load_le64(bytes.data() + list), 3u);
+    resource_tools::packed::store_le64(bad_count.data() + list, 1000);
+    JsonDocument damaged(view(bad_count));
+    ASSERT_TRUE(damaged);
+    EXPECT_FALSE(damaged["list"]);
+    EXPECT_EQ(damaged["name"].as_string(), "value");
+
+    // Unknown constants and the unused tag read as Missing
+    auto bad_constant = bytes;
+    resource_tools::packed::store_le64(bad_constant.data() + 8, 3 << 3);
+    EXPECT_EQ(JsonDocument(view(bad_constant)).error(), ResourceError::CorruptData);
+    auto bad_tag = bytes;
+    resource_tools::packed::store_le64(bad_tag.data() + 8, 2);
+    EXPECT_EQ(JsonDocument(view(bad_tag)).error(), ResourceError::CorruptData);
+
+    bytes.resize(bytes.size() - 1);
+    EXPECT_EQ(JsonDocument(view(bytes)).error(), ResourceError::CorruptData);
+
+    EXPECT_EQ(JsonDocument({nullptr, 0, ResourceError::NotFound}).error(), ResourceError::NotFound);
+}
+
+TEST_F(BinaryJsonTest, LargeDocument) {
+    constexpr int kRecords = 20000;
+    std::string json = "{\"records\": [";
+    for (int i = 0; i < kRecords; ++i) {
+        json += (i > 0 ? ",\n" : "") + std::string("{\"id\": ") + std::to_string(i) + ", \"name\": \"record-" +
+                std::to_string(i) + "\", \"score\": " + std::to_string(i) + ".5, \"tags\": [\"t" +
+                std::to_string(i % 10) + "\"]}";
+    }
+    json += "], \"count\": " + std::to_string(kRecords) + "}";
+
+    const fs::path output = work_ / "large.bin";
+    ASSERT_EQ(pack(json, output), 0);
+    const auto bytes = readFile(output);
+    JsonDocument document(view(bytes));
+    ASSERT_TRUE(document);
+    ASSERT_EQ(document["count"].as_int(), kRecords);
+    const auto records = document["records"];
+    ASSERT_EQ(records.size(), static_cast<size_t>(kRecords));
+    for (int i = 0; i < kRecords; ++i) {
+        const auto record = records[i];
+        ASSERT_EQ(record["id"].as_int(), i);
+        ASSERT_EQ(record["name"].as_string(), "record-" + std::to_string(i));
+        ASSERT_DOUBLE_EQ(record["score"].as_double(), i + 0.5);
+        ASSERT_EQ(record["tags"][0].as_string(), "t" + std::to_string(i % 10));
+    }
+}
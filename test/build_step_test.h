@@ -0,0 +1,79 @@
+#ifndef RESOURCE_TOOLS_BUILD_STEP_TEST_H
+#define RESOURCE_TOOLS_BUILD_STEP_TEST_H
+
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Fixture shared by the tests that run build steps: a scratch directory per
+// test and the packer, run the way the build runs it
+class BuildStepTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        work_ = std::filesystem::path(::testing::TempDir()) /
+                (std::string("resource_tools_") + info->test_suite_name() + "_" + info->name());
+        std::filesystem::remove_all(work_);
+        std::filesystem::create_directories(work_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(work_); }
+
+    static auto readFile(const std::filesystem::path& path) -> std::vector<uint8_t> {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    static auto readText(const std::filesystem::path& path) -> std::string {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    static void writeFile(const std::filesystem::path& path, const std::string& contents) {
+        std::ofstream(path, std::ios::binary) << contents;
+    }
+
+    static void writeFile(const std::filesystem::path& path, const std::vector<uint8_t>& bytes) {
+        std::ofstream(path, std::ios::binary)
+            .write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    static auto view(const std::vector<uint8_t>& bytes) -> resource_tools::ResourceResult {
+        return {bytes.data(), bytes.size(), resource_tools::ResourceError::Success};
+    }
+
+    // The bytes of a resource, empty if it failed
+    static auto text(const resource_tools::ResourceResult& resource) -> std::string {
+        return resource ? std::string(reinterpret_cast<const char*>(resource.data), resource.size) : std::string();
+    }
+
+    // Run `resource_tools_packer <command> <input> <output>`, keeping what it
+    // reports for errors()
+    auto packFile(const std::string& command, const std::filesystem::path& input,
+                  const std::filesystem::path& output) const -> int {
+        const std::string line = std::string("\"") + RESOURCE_TOOLS_TEST_PACKER + "\" " + command + " \"" +
+                                 input.string() + "\" \"" + output.string() + "\" 2> \"" +
+                                 (work_ / "errors.txt").string() + "\"";
+        return std::system(line.c_str());
+    }
+
+    // Write `contents` to a scratch file named `input` and pack it
+    auto pack(const std::string& command, const std::string& contents, const std::filesystem::path& output,
+              const std::string& input = "input") const -> int {
+        writeFile(work_ / input, contents);
+        return packFile(command, work_ / input, output);
+    }
+
+    // What the last packer run wrote to stderr
+    auto errors() const -> std::string { return readText(work_ / "errors.txt"); }
+
+    std::filesystem::path work_;
+};
+
+#endif // RESOURCE_TOOLS_BUILD_STEP_TEST_H
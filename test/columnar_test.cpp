@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+#include <resource_tools/columnar.h>
+#include <resource_tools/embedded_resource.h>
+#include <columnar_resources/embedded_data.h>
+#include <columnar_tsv_resources/embedded_data.h>
+#include "build_step_test.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace fs = std::filesystem;
+using resource_tools::ColumnType;
+using resource_tools::ResourceError;
+
+class ColumnarTest : public BuildStepTest {
+protected:
+    // Convert a table the way the build does
+    auto convert(const std::string& csv, const std::string& schema, const fs::path& output) const -> int {
+        return pack("columnar --schema " + schema, csv, output, "input.csv");
+    }
+
+    // Configure a project embedding a table with `schema`
+    auto configure(const std::string& schema) const -> int {
+        const fs::path project = work_ / "project";
+        fs::create_directories(project);
+        writeFile(project / "table.csv", "id\n1\n");
+        writeFile(project / "CMakeLists.txt",
+                  "cmake_minimum_required(VERSION 3.25)\n"
+                  "project(schema_test LANGUAGES NONE)\n"
+                  "include(\"" RESOURCE_TOOLS_EMBED_MODULE "\")\n"
+                  "embed_resources(TARGET table RESOURCES table.csv FORMAT columnar SCHEMA " +
+                      schema + ")\n");
+        const std::string line = std::string("\"") + RESOURCE_TOOLS_CMAKE_COMMAND + "\" -S \"" + project.string() +
+                                 "\" -B \"" + (project / "build").string() + "\" > \"" +
+                                 (work_ / "errors.txt").string() + "\" 2>&1";
+        return std::system(line.c_str());
+    }
+};
+
+// ============================================================================
+// GENERATED ACCESSORS
+// ============================================================================
+
+TEST_F(ColumnarTest, GeneratedStructHasTypedColumns) {
+    const auto& cities = columnar_resources::getCitiesCSVTable();
+
+    ASSERT_TRUE(cities);
+    static_assert(std::is_same_v<decltype(cities.population), std::span<const uint32_t>>);
+    static_assert(std::is_same_v<decltype(cities.founded), std::span<const int16_t>>);
+    static_assert(std::is_same_v<decltype(cities.latitude), std::span<const double>>);
+    static_assert(std::is_same_v<decltype(cities.longitude), std::span<const float>>);
+    static_assert(std::is_same_v<decltype(cities.city), resource_tools::StringColumn>);
+
+    EXPECT_EQ(cities.rows, 8u);
+    ASSERT_EQ(cities.population.size(), 8u);
+    EXPECT_EQ(cities.population[0], 37400068u);
+    EXPECT_EQ(cities.founded[1], -300);
+    EXPECT_DOUBLE_EQ(cities.latitude[3], -23.5505);
+    EXPECT_FLOAT_EQ(cities.longitude[5], 151.2093f);
+    EXPECT_EQ(cities.city[0], "Tokyo");
+    EXPECT_EQ(cities.city[3], "São Paulo");
+}
+
+TEST_F(ColumnarTest, AccessorReturnsTheSameColumnsEveryTime) {
+    const auto& first = columnar_resources::getCitiesCSVTable();
+    const auto& second = columnar_resources::getCitiesCSVTable();
+
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(first.population.data(), second.population.data());
+}
+
+TEST_F(ColumnarTest, QuotedFieldsAreUnescaped) {
+    const auto& cities = columnar_resources::getCitiesCSVTable();
+
+    EXPECT_EQ(cities.city[4], "Washington, D.C.");
+    EXPECT_EQ(cities.city[6], "The \"Big Apple\"");
+    // A quoted newline in a dropped column does not split the row
+    EXPECT_EQ(cities.city[7], "Atlantis");
+    EXPECT_EQ(cities.founded[7], -9600);
+}
+
+TEST_F(ColumnarTest, EmptyFloatIsNaN) {
+    const auto& cities = columnar_resources::getCitiesCSVTable();
+
+    EXPECT_TRUE(std::isnan(cities.latitude[7]));
+    EXPECT_TRUE(std::isnan(cities.longitude[7]));
+}
+
+TEST_F(ColumnarTest, StringColumnsAreDictionaryEncoded) {
+    const auto& cities = columnar_resources::getCitiesCSVTable();
+
+    // Eight rows, seven distinct countries, sorted
+    ASSERT_EQ(cities.country.dictionary_size(), 7u);
+    EXPECT_EQ(cities.country.dictionary(0), "Australia");
+    EXPECT_EQ(cities.country.dictionary(5), "United States");
+    EXPECT_EQ(cities.country.dictionary(6), "Unknown");
+
+    auto code = cities.country.find("United States");
+    ASSERT_TRUE(code.has_value());
+    size_t matches = 0;
+    for (uint32_t row_code : cities.country.codes()) {
+        matches += row_code == *code;
+    }
+    EXPECT_EQ(matches, 2u);
+    EXPECT_FALSE(cities.country.find("Canada").has_value());
+}
+
+TEST_F(ColumnarTest, ColumnsAreAligned) {
+    const auto& cities = columnar_resources::getCitiesCSVTable();
+    auto raw = columnar_resources::getCitiesCSV();
+
+    // The table is used in place, from the start of a 64-byte aligned section
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(raw.data) % resource_tools::columnar::kAlignment, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(cities.population.data()) % resource_tools::columnar::kAlignment, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(cities.latitude.data()) % resource_tools::columnar::kAlignment, 0u);
+    EXPECT_GE(reinterpret_cast<const uint8_t*>(cities.population.data()), raw.data);
+    EXPECT_LT(reinterpret_cast<const uint8_t*>(cities.population.data()), raw.data + raw.size);
+}
+
+TEST_F(ColumnarTest, TsvWithStorageModeIsConverted) {
+    const auto& stations = columnar_tsv_resources::getStationsTSVTable();
+
+    ASSERT_TRUE(stations);
+    ASSERT_EQ(stations.rows, 5u);
+    EXPECT_EQ(stations.station[4], "Canary Wharf");
+    EXPECT_EQ(stations.line[2], "Central");
+    EXPECT_EQ(stations.depth_m[1], 58u);
+    EXPECT_EQ(stations.platforms[2], 10);
+    EXPECT_EQ(stations.passengers[2], 61250000u);
+}
+
+TEST_F(ColumnarTest, DecodedTableIsAligned) {
+    // DEDUPLICATE tables are decoded into a copy, which keeps the alignment
+    const auto& stations = columnar_tsv_resources::getStationsTSVTable();
+    auto raw = columnar_tsv_resources::getStationsTSV();
+
+    ASSERT_TRUE(stations);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(raw.data) % resource_tools::columnar::kAlignment, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(stations.passengers.data()) % resource_tools::columnar::kAlignment, 0u);
+}
+
+// ============================================================================
+// COLUMNAR TABLE VIEW
+// ============================================================================
+
+TEST_F(ColumnarTest, SchemaPicksAndOrdersColumns) {
+    resource_tools::ColumnarTable table(columnar_resources::getCitiesCSV());
+
+    ASSERT_TRUE(table);
+    ASSERT_EQ(table.columns(), 6u);
+    EXPECT_EQ(table.column_name(0), "city");
+    EXPECT_EQ(table.column_name(2), "founded");
+    EXPECT_EQ(table.column_name(5), "country");
+    EXPECT_EQ(table.column_type(3), ColumnType::Float64);
+    EXPECT_EQ(table.index_of("notes"), table.columns());
+    EXPECT_EQ(table.column<uint32_t>("population")[1], 28514000u);
+}
+
+TEST_F(ColumnarTest, WrongTypeGivesEmptyColumn) {
+    resource_tools::ColumnarTable table(columnar_resources::getCitiesCSV());
+
+    EXPECT_TRUE(table.column<int32_t>("population").empty());
+    EXPECT_TRUE(table.column<double>("missing").empty());
+    EXPECT_TRUE(table.strings("population").empty());
+    EXPECT_TRUE(table.column<double>(99).empty());
+}
+
+TEST_F(ColumnarTest, MisalignedTableIsCopied) {
+    auto raw = columnar_resources::getCitiesCSV();
+    std::vector<uint8_t> buffer(raw.size + 1);
+    std::memcpy(buffer.data() + 1, raw.data, raw.size);
+
+    resource_tools::ColumnarTable table({buffer.data() + 1, raw.size, ResourceError::Success});
+
+    ASSERT_TRUE(table);
+    auto population = table.column<uint32_t>("population");
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(population.data()) % alignof(uint32_t), 0u);
+    EXPECT_EQ(population[0], 37400068u);
+    EXPECT_EQ(table.strings("city")[6], "The \"Big Apple\"");
+}
+
+TEST_F(ColumnarTest, CorruptTableIsRejected) {
+    auto raw = columnar_resources::getCitiesCSV();
+    std::vector<uint8_t> bytes(raw.data, raw.data + raw.size);
+
+    std::vector<uint8_t> truncated(bytes.begin(), bytes.begin() + 200);
+    EXPECT_EQ(resource_tools::ColumnarTable(view(truncated)).error(), ResourceError::CorruptData);
+
+    std::vector<uint8_t> bad_magic = bytes;
+    bad_magic[0] ^= 0xFF;
+    EXPECT_EQ(resource_tools::ColumnarTable(view(bad_magic)).error(), ResourceError::CorruptData);
+
+    // A dictionary that runs past the end of the table
+    std::vector<uint8_t> bad_dictionary = bytes;
+    uint8_t* entry = bad_dictionary.data() + resource_tools::columnar::kHeaderSize;
+    resource_tools::packed::store_le64(entry + 24, bytes.size());
+    resource_tools::ColumnarTable table(view(bad_dictionary));
+    EXPECT_EQ(table.error(), ResourceError::CorruptData);
+    EXPECT_EQ(table.rows(), 0u);
+    EXPECT_TRUE(table.strings(0).empty());
+}
+
+TEST_F(ColumnarTest, BadStringCodeReadsAsEmpty) {
+    auto raw = columnar_resources::getCitiesCSV();
+    std::vector<uint8_t> bytes(raw.data, raw.data + raw.size);
+
+    // Codes are checked on lookup rather than on open, which would read every row
+    std::vector<uint8_t> bad_code = bytes;
+    const uint64_t codes_at = resource_tools::packed::load_le64(bad_code.data() + resource_tools::columnar::kHeaderSize + 16);
+    resource_tools::packed::store_le32(bad_code.data() + codes_at, 1000);
+    resource_tools::ColumnarTable table(view(bad_code));
+    ASSERT_TRUE(table);
+    auto city = table.strings(0);
+    EXPECT_EQ(city.codes()[0], 1000u);
+    EXPECT_EQ(city[0], "");
+    EXPECT_EQ(city.dictionary(1000), "");
+    EXPECT_EQ(city[1], city.dictionary(city.codes()[1]));
+    EXPECT_FALSE(city[1].empty());
+}
+
+TEST_F(ColumnarTest, BadDictionaryOffsetReadsAsEmpty) {
+    auto raw = columnar_resources::getCitiesCSV();
+    std::vector<uint8_t> bytes(raw.data, raw.data + raw.size);
+
+    std::vector<uint8_t> bad_offset = bytes;
+    const uint64_t offsets_at = resource_tools::packed::load_le64(bad_offset.data() + resource_tools::columnar::kHeaderSize + 32);
+    resource_tools::packed::store_le64(bad_offset.data() + offsets_at + 8, bytes.size() * 2);
+    resource_tools::ColumnarTable table(view(bad_offset));
+    ASSERT_TRUE(table);
+    auto city = table.strings(0);
+    EXPECT_EQ(city.dictionary(0), "");
+    EXPECT_EQ(city.dictionary(1), "");
+}
+
+TEST_F(ColumnarTest, FailedResourceKeepsItsError) {
+    resource_tools::ColumnarTable table({nullptr, 0, ResourceError::NotFound});
+
+    EXPECT_FALSE(table);
+    EXPECT_EQ(table.error(), ResourceError::NotFound);
+    EXPECT_EQ(table.columns(), 0u);
+}
+
+// ============================================================================
+// BUILD-TIME CONVERSION
+// ============================================================================
+
+TEST_F(ColumnarTest, InvalidValueFailsConversion) {
+    EXPECT_NE(convert("id,name\n1,a\nx,b\n", "id:int32,name:string", work_ / "out.bin"), 0);
+    EXPECT_NE(convert("id\n300\n", "id:uint8", work_ / "out.bin"), 0);
+    EXPECT_NE(convert("id\n1\n", "missing:int32", work_ / "out.bin"), 0);
+    EXPECT_NE(convert("id\n\"1\n", "id:int32", work_ / "out.bin"), 0);
+}
+
+TEST_F(ColumnarTest, KeywordColumnNameFailsAtConfigureTime) {
+    EXPECT_NE(configure("class:int32"), 0);
+    EXPECT_NE(errors().find("SCHEMA column name 'class' is a C++ keyword"), std::string::npos) << errors();
+
+    EXPECT_NE(configure("default:string"), 0);
+    EXPECT_NE(errors().find("'default' is a C++ keyword"), std::string::npos) << errors();
+
+    EXPECT_NE(configure("rows:uint8"), 0);
+    EXPECT_EQ(errors().find("C++ keyword"), std::string::npos) << errors();
+}
+
+TEST_F(ColumnarTest, HeaderOnlyTableHasNoRows) {
+    ASSERT_EQ(convert("id,name\n", "id:int64,name:string", work_ / "out.bin"), 0);
+    auto bytes = readFile(work_ / "out.bin");
+
+    resource_tools::ColumnarTable table(view(bytes));
+
+    ASSERT_TRUE(table);
+    EXPECT_EQ(table.rows(), 0u);
+    EXPECT_EQ(table.columns(), 2u);
+    EXPECT_EQ(table.strings("name").dictionary_size(), 0u);
+}
+
+// ============================================================================
+// COLUMNAR SCAN
+// ============================================================================
+
+TEST_F(ColumnarTest, ColumnarScanMatchesParsing) {
+    constexpr size_t kRows = 1000;
+    std::string csv = "id,price,quantity,region\n";
+    double parsed_total = 0;
+    for (size_t i = 0; i < kRows; ++i) {
+        const double price = (i % 1000) * 0.25;
+        const int32_t quantity = static_cast<int32_t>(i % 97);
+        csv += std::to_string(i) + "," + std::to_string(price) + "," + std::to_string(quantity) + ",region" +
+               std::to_string(i % 16) + "\n";
+        parsed_total += price * quantity;
+    }
+    ASSERT_EQ(convert(csv, "id:uint32,price:float64,quantity:int32,region:string", work_ / "table.bin"), 0);
+    const auto bytes = readFile(work_ / "table.bin");
+
+    resource_tools::ColumnarTable table(view(bytes));
+    auto price = table.column<double>("price");
+    auto quantity = table.column<int32_t>("quantity");
+    double columnar_total = 0;
+    for (size_t i = 0; i < price.size(); ++i) {
+        columnar_total += price[i] * quantity[i];
+    }
+
+    ASSERT_EQ(price.size(), kRows);
+    EXPECT_DOUBLE_EQ(columnar_total, parsed_total);
+    EXPECT_EQ(table.strings("region")[kRows - 1], "region" + std::to_string((kRows - 1) % 16));
+}
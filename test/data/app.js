@@ -0,0 +1,287 @@
+"use strict";
+
+function formatSize0(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize1(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize2(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize3(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize4(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize5(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize6(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize7(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize8(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize9(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize10(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize11(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize12(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize13(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize14(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize15(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize16(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize17(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize18(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize19(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize20(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize21(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize22(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize23(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize24(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize25(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize26(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize27(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize28(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize29(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize30(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize31(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize32(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize33(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize34(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize35(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize36(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+function formatSize37(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function formatSize38(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(2) + " KB";
+}
+
+function formatSize39(bytes) {
+    if (bytes < 1024) {
+        return bytes + " bytes";
+    }
+    return (bytes / 1024).toFixed(0) + " KB";
+}
+
+document.addEventListener("DOMContentLoaded", () => {
+    for (const cell of document.querySelectorAll("td.size")) {
+        cell.textContent = formatSize0(parseInt(cell.textContent, 10));
+    }
+});
@@ -0,0 +1,4 @@
+# resource_tools access profile
+# accesses namespace resource
+5000 tiered_resources tier_hot.json
+1 tiered_resources tier_cold.json
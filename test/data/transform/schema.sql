@@ -0,0 +1,11 @@
+-- Users of the service
+create table users (
+    id integer primary key, -- rowid alias
+    name text not null
+);
+
+-- Sessions expire after a day
+create table sessions (
+    user_id integer references users(id),
+    expires integer
+);
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+#include <dedup_resources/embedded_data.h>
+#include "test_data.h"
+#include <string>
+
+using test_data::asString;
+using test_data::readDataFile;
+
+class DedupResourceTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+// ============================================================================
+// RECONSTRUCTION
+// ============================================================================
+
+TEST_F(DedupResourceTest, ResourcesRoundTrip) {
+    auto en = dedup_resources::getBundleEnJSON();
+    auto fr = dedup_resources::getBundleFrJSON();
+
+    ASSERT_TRUE(en);
+    ASSERT_TRUE(fr);
+    EXPECT_EQ(asString(en), readDataFile("bundle_en.json"));
+    EXPECT_EQ(asString(fr), readDataFile("bundle_fr.json"));
+}
+
+TEST_F(DedupResourceTest, RepeatedAccessReturnsSameBuffer) {
+    auto first = dedup_resources::getBundleFrJSON();
+    auto second = dedup_resources::getBundleFrJSON();
+
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first.data, second.data);
+}
+
+// ============================================================================
+// STORAGE SAVINGS
+// ============================================================================
+
+TEST_F(DedupResourceTest, ChunkStoreIsSmallerThanResources) {
+    auto store = dedup_resources::getDedupTestChunksBIN();
+    auto en = dedup_resources::getBundleEnJSON();
+    auto fr = dedup_resources::getBundleFrJSON();
+
+    ASSERT_TRUE(store);
+    ASSERT_TRUE(en);
+    ASSERT_TRUE(fr);
+    // The bundles differ in a handful of lines, so the second one should add
+    // far less than its full size to the store
+    EXPECT_LT(store.size, en.size + fr.size / 2);
+    EXPECT_GE(store.size, en.size);
+}
+
+TEST_F(DedupResourceTest, RecipesAreSmall) {
+    auto packed = dedup_resources::getBundleFrJSONPacked();
+
+    ASSERT_TRUE(packed);
+    resource_tools::packed::Header header;
+    ASSERT_EQ(resource_tools::packed::readHeader(packed, header), resource_tools::ResourceError::Success);
+    EXPECT_EQ(header.encoding, resource_tools::packed::Encoding::Chunked);
+    EXPECT_LT(packed.size, header.size / 4);
+}
+
+// ============================================================================
+// CHUNK ITERATION
+// ============================================================================
+
+TEST_F(DedupResourceTest, ChunkIteratorReassemblesResource) {
+    auto chunks = dedup_resources::getBundleEnJSONChunks();
+
+    ASSERT_TRUE(chunks);
+    EXPECT_GT(chunks.count(), 1u);
+
+    std::string assembled;
+    for (auto chunk : chunks) {
+        ASSERT_TRUE(chunk);
+        assembled.append(reinterpret_cast<const char*>(chunk.data), chunk.size);
+    }
+    EXPECT_EQ(assembled.size(), chunks.size());
+    EXPECT_EQ(assembled, readDataFile("bundle_en.json"));
+}
+
+TEST_F(DedupResourceTest, ChunksPointIntoSharedStore) {
+    auto store = dedup_resources::getDedupTestChunksBIN();
+    ASSERT_TRUE(store);
+
+    for (auto chunk : dedup_resources::getBundleFrJSONChunks()) {
+        EXPECT_GE(chunk.data, store.data);
+        EXPECT_LE(chunk.data + chunk.size, store.data + store.size);
+    }
+}
+
+TEST_F(DedupResourceTest, ChunkRangeWithoutStoreIsInvalid) {
+    resource_tools::ChunkRange chunks(dedup_resources::getBundleEnJSONPacked(), {});
+
+    EXPECT_FALSE(chunks);
+    EXPECT_EQ(chunks.error(), resource_tools::ResourceError::CorruptData);
+    EXPECT_EQ(chunks.begin(), chunks.end());
+}
+
+TEST_F(DedupResourceTest, DecodeWithoutStoreFails) {
+    resource_tools::PackedResource resource(dedup_resources::getBundleEnJSONPacked());
+
+    EXPECT_FALSE(resource.get());
+    EXPECT_EQ(resource.get().error, resource_tools::ResourceError::CorruptData);
+}
@@ -138,6 +138,11 @@ TEST_F(ErrorHandlingTest, ErrorToStringAllCases) {
     EXPECT_STREQ(resource_tools::to_string(resource_tools::ResourceError::InvalidSize), "Invalid resource size (end < start)");
     EXPECT_STREQ(resource_tools::to_string(resource_tools::ResourceError::IntegerOverflow), "Resource size exceeds uint32_t limit");
     EXPECT_STREQ(resource_tools::to_string(resource_tools::ResourceError::NotFound), "Resource not found");
+    EXPECT_STREQ(resource_tools::to_string(resource_tools::ResourceError::CorruptData), "Embedded resource data is corrupt");
+    EXPECT_STREQ(resource_tools::to_string(resource_tools::ResourceError::OutOfMemory), "Out of memory decoding resource");
+    EXPECT_STREQ(resource_tools::to_string(resource_tools::ResourceError::Unsupported), "Operation not supported on this platform");
+    EXPECT_STREQ(resource_tools::to_string(resource_tools::ResourceError::SystemError), "Operating system call failed");
+    EXPECT_STREQ(resource_tools::to_string(resource_tools::ResourceError::InvalidArgument), "Invalid argument");
 }
 
 // ============================================================================
@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+#include <resource_tools/content_hash.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/extract_cache.h>
+#include <test_resources/embedded_data.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using resource_tools::ResourceError;
+
+class ExtractCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    // Fresh cache directory per test, removed with the fixture
+    struct CacheDirectory {
+        std::string path;
+        CacheDirectory()
+            : path(::testing::TempDir() + "resource_tools_extract_" + std::to_string(getpid()) + "/cache") {}
+        ~CacheDirectory() { std::filesystem::remove_all(std::filesystem::path(path).parent_path()); }
+    };
+
+    static auto fileContents(const std::string& path) -> std::string {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    static auto sameBytes(const std::string& path, const resource_tools::ResourceResult& resource) -> bool {
+        return fileContents(path) == std::string(reinterpret_cast<const char*>(resource.data), resource.size);
+    }
+
+    static auto inode(const std::string& path) -> ino_t {
+        struct stat st {};
+        return stat(path.c_str(), &st) == 0 ? st.st_ino : 0;
+    }
+};
+
+// ============================================================================
+// EXTRACTION
+// ============================================================================
+
+TEST_F(ExtractCacheTest, ExtractsIntoPrivateDirectoryByContentHash) {
+    CacheDirectory cache;
+    auto resource = test_resources::getBinaryDataBIN();
+
+    auto extracted = resource_tools::extractToCache(resource, ".bin", cache.path);
+
+    ASSERT_TRUE(extracted);
+    const auto hex = resource_tools::toHex(resource_tools::contentHash(resource));
+    EXPECT_EQ(extracted.path, cache.path + "/" + std::string(hex.data(), 64) + ".bin");
+    EXPECT_TRUE(sameBytes(extracted.path, resource));
+
+    struct stat st {};
+    ASSERT_EQ(stat(cache.path.c_str(), &st), 0);
+    EXPECT_EQ(st.st_mode & 0777, 0700u);
+    ASSERT_EQ(stat(extracted.path.c_str(), &st), 0);
+    EXPECT_EQ(st.st_mode & 0777, 0500u);
+}
+
+TEST_F(ExtractCacheTest, ExistingExtractionIsReused) {
+    CacheDirectory cache;
+    auto resource = test_resources::getTestFileTXT();
+    auto first = resource_tools::extractToCache(resource, "", cache.path);
+    ASSERT_TRUE(first);
+    const ino_t original = inode(first.path);
+
+    auto second = resource_tools::extractToCache(resource, "", cache.path);
+
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second.path, first.path);
+    EXPECT_EQ(inode(second.path), original);
+}
+
+TEST_F(ExtractCacheTest, IdenticalContentSharesOneFile) {
+    CacheDirectory cache;
+    auto resource = test_resources::getTestFileTXT();
+    // A copy at another address, as another binary embedding the same file has
+    const std::string copy(reinterpret_cast<const char*>(resource.data), resource.size);
+    resource_tools::ResourceResult other{reinterpret_cast<const uint8_t*>(copy.data()), copy.size(),
+                                         ResourceError::Success};
+
+    auto first = resource_tools::extractToCache(resource, "", cache.path);
+    auto second = resource_tools::extractToCache(other, "", cache.path);
+
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_EQ(first.path, second.path);
+}
+
+TEST_F(ExtractCacheTest, TruncatedExtractionIsReplaced) {
+    CacheDirectory cache;
+    auto resource = test_resources::getBinaryDataBIN();
+    auto first = resource_tools::extractToCache(resource, "", cache.path);
+    ASSERT_TRUE(first);
+    std::filesystem::permissions(first.path, std::filesystem::perms::owner_write, std::filesystem::perm_options::add);
+    std::filesystem::resize_file(first.path, resource.size / 2);
+
+    auto second = resource_tools::extractToCache(resource, "", cache.path);
+
+    ASSERT_TRUE(second);
+    EXPECT_TRUE(sameBytes(second.path, resource));
+}
+
+TEST_F(ExtractCacheTest, CorruptedExtractionOfTheRightSizeIsReplaced) {
+    // Editing the read-only file means changing its mode first, which is
+    // what gives it away
+    CacheDirectory cache;
+    auto resource = test_resources::getBinaryDataBIN();
+    auto first = resource_tools::extractToCache(resource, "", cache.path);
+    ASSERT_TRUE(first);
+    std::filesystem::permissions(first.path, std::filesystem::perms::owner_write, std::filesystem::perm_options::add);
+    {
+        std::fstream file(first.path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(resource.size - 1));
+        file.put(static_cast<char>(~resource.data[resource.size - 1]));
+    }
+
+    auto second = resource_tools::extractToCache(resource, "", cache.path);
+
+    ASSERT_TRUE(second);
+    EXPECT_TRUE(sameBytes(second.path, resource));
+}
+
+TEST_F(ExtractCacheTest, ReusedBufferIsKeyedByItsNewContent) {
+    CacheDirectory cache;
+    // The same address holding different bytes, as a freed and reused buffer would
+    std::vector<uint8_t> buffer(4096, 'a');
+    resource_tools::ResourceResult resource{buffer.data(), buffer.size(), ResourceError::Success};
+    auto first = resource_tools::extractToCache(resource, "", cache.path);
+    std::fill(buffer.begin(), buffer.end(), 'b');
+
+    auto second = resource_tools::extractToCache(resource, "", cache.path);
+
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_NE(first.path, second.path);
+    EXPECT_TRUE(sameBytes(second.path, resource));
+}
+
+// ============================================================================
+// CONCURRENT EXTRACTORS
+// ============================================================================
+
+TEST_F(ExtractCacheTest, ConcurrentThreadsAgreeOnOneFile) {
+    CacheDirectory cache;
+    auto resource = test_resources::getBinaryDataBIN();
+    std::vector<std::string> paths(8);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        threads.emplace_back([&, i] { paths[i] = resource_tools::extractToCache(resource, "", cache.path).path; });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(std::set<std::string>(paths.begin(), paths.end()).size(), 1u);
+    EXPECT_TRUE(sameBytes(paths[0], resource));
+    // No temporary files are left behind
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(cache.path), std::filesystem::directory_iterator()),
+              1);
+}
+
+TEST_F(ExtractCacheTest, ConcurrentProcessesAgreeOnOneFile) {
+    CacheDirectory cache;
+    auto resource = test_resources::getBinaryDataBIN();
+
+    std::vector<pid_t> children;
+    for (int i = 0; i < 4; ++i) {
+        const pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {
+            auto extracted = resource_tools::extractToCache(resource, "", cache.path);
+            _exit(extracted && sameBytes(extracted.path, resource) ? 0 : 1);
+        }
+        children.push_back(pid);
+    }
+    for (const pid_t pid : children) {
+        int status = 0;
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+        EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(cache.path), std::filesystem::directory_iterator()),
+              1);
+}
+
+// ============================================================================
+// VALIDATION
+// ============================================================================
+
+TEST_F(ExtractCacheTest, FailedResourceKeepsItsError) {
+    CacheDirectory cache;
+    auto extracted = resource_tools::extractToCache(
+        resource_tools::ResourceResult{nullptr, 0, ResourceError::NotFound}, "", cache.path);
+
+    EXPECT_FALSE(extracted);
+    EXPECT_EQ(extracted.error, ResourceError::NotFound);
+    EXPECT_TRUE(extracted.path.empty());
+}
+
+TEST_F(ExtractCacheTest, ExtensionWithSlashIsRejected) {
+    CacheDirectory cache;
+    auto extracted = resource_tools::extractToCache(test_resources::getTestFileTXT(), "/../escape", cache.path);
+
+    EXPECT_EQ(extracted.error, ResourceError::InvalidArgument);
+    EXPECT_FALSE(std::filesystem::exists(cache.path));
+}
+
+TEST_F(ExtractCacheTest, SharedDirectoryIsRefused) {
+    CacheDirectory cache;
+    std::filesystem::create_directories(cache.path);
+    chmod(cache.path.c_str(), 0777);
+
+    auto extracted = resource_tools::extractToCache(test_resources::getTestFileTXT(), "", cache.path);
+
+    EXPECT_EQ(extracted.error, ResourceError::SystemError);
+}
+
+TEST_F(ExtractCacheTest, DirectoryComesFromEnvironment) {
+    setenv("RESOURCE_TOOLS_EXTRACT_DIR", "/tmp/resource_tools_override", 1);
+    EXPECT_EQ(resource_tools::extractionDirectory(), "/tmp/resource_tools_override");
+    unsetenv("RESOURCE_TOOLS_EXTRACT_DIR");
+
+    const char* xdg = std::getenv("XDG_CACHE_HOME");
+    const std::string saved = xdg ? xdg : "";
+    setenv("XDG_CACHE_HOME", "/var/cache/someone", 1);
+    EXPECT_EQ(resource_tools::extractionDirectory(), "/var/cache/someone/resource_tools");
+    if (xdg) {
+        setenv("XDG_CACHE_HOME", saved.c_str(), 1);
+    } else {
+        unsetenv("XDG_CACHE_HOME");
+    }
+}
+
+// ============================================================================
+// COLD AND WARM START
+// ============================================================================
+
+TEST_F(ExtractCacheTest, WarmStartSkipsTheWrite) {
+    CacheDirectory cache;
+    std::vector<uint8_t> bytes(1024 * 1024);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 131);
+    }
+    resource_tools::ResourceResult resource{bytes.data(), bytes.size(), ResourceError::Success};
+
+    auto cold = resource_tools::extractToCache(resource, "", cache.path);
+    ASSERT_TRUE(cold);
+    const ino_t original = inode(cold.path);
+
+    auto warm = resource_tools::extractToCache(resource, "", cache.path);
+
+    ASSERT_TRUE(warm);
+    EXPECT_EQ(inode(warm.path), original);
+}
+
+#endif // __unix__ || __APPLE__
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/frozen_map.h>
+#include <frozen_map_resources/embedded_data.h>
+#include "build_step_test.h"
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+using resource_tools::FrozenMap;
+using resource_tools::ResourceError;
+
+class FrozenMapTest : public BuildStepTest {
+protected:
+    // Build a map the way the build does
+    auto build(const std::string& tsv, const fs::path& output) const -> int {
+        return pack("frozen-map", tsv, output, "input.tsv");
+    }
+};
+
+// ============================================================================
+// EMBEDDED MAP
+// ============================================================================
+
+TEST_F(FrozenMapTest, LooksUpEveryKey) {
+    const FrozenMap& skus = frozen_map_resources::getSkusTSVMap();
+    ASSERT_TRUE(skus);
+    EXPECT_EQ(skus.size(), 7u);
+    EXPECT_EQ(skus.get("SKU-10001"), "Stainless steel water bottle, 750 ml");
+    EXPECT_EQ(skus.get("SKU-10003"), "Cast iron skillet, 26 cm");
+    EXPECT_EQ(skus.get("SKU-10006"), "Café au lait bowl");
+    EXPECT_EQ(skus.get("SKU-10007"), "Knife block");
+}
+
+TEST_F(FrozenMapTest, ValuesKeepLaterTabsAndMayBeEmpty) {
+    const FrozenMap& skus = frozen_map_resources::getSkusTSVMap();
+    EXPECT_EQ(skus.get("SKU-10005"), "Tea towel set\twith tabs");
+    ASSERT_TRUE(skus.find("SKU-10004").has_value());
+    EXPECT_EQ(*skus.find("SKU-10004"), "");
+}
+
+TEST_F(FrozenMapTest, MissingKeys) {
+    const FrozenMap& skus = frozen_map_resources::getSkusTSVMap();
+    EXPECT_FALSE(skus.contains("SKU-10008"));
+    EXPECT_FALSE(skus.contains("SKU-1000"));
+    EXPECT_FALSE(skus.contains(""));
+    EXPECT_EQ(skus.get("SKU-99999", "unknown"), "unknown");
+}
+
+TEST_F(FrozenMapTest, BucketsAreCacheLineAligned) {
+    const auto resource = frozen_map_resources::getSkusTSV();
+    ASSERT_TRUE(resource);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(resource.data) % 64, 0u);
+}
+
+// ============================================================================
+// BUILD STEP
+// ============================================================================
+
+TEST_F(FrozenMapTest, MalformedInputFailsTheBuild) {
+    const char* invalid[] = {
+        "a\t1\nno tab here\n",  // No tab
+        "a\t1\nb\t2\na\t3\n",   // Duplicate key
+    };
+    for (const char* tsv : invalid) {
+        const fs::path output = work_ / "out.bin";
+        EXPECT_NE(build(tsv, output), 0) << tsv;
+        EXPECT_FALSE(fs::exists(output));
+    }
+}
+
+TEST_F(FrozenMapTest, EmptyInput) {
+    const fs::path output = work_ / "empty.bin";
+    ASSERT_EQ(build("\n", output), 0);
+    const auto bytes = readFile(output);
+    FrozenMap map(view(bytes));
+    ASSERT_TRUE(map);
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains("anything"));
+}
+
+TEST_F(FrozenMapTest, CorruptMapIsRejected) {
+    const fs::path output = work_ / "map.bin";
+    ASSERT_EQ(build("a\t1\nb\t2\n", output), 0);
+    auto bytes = readFile(output);
+    ASSERT_TRUE(FrozenMap(view(bytes)));
+
+    auto bad_magic = bytes;
+    bad_magic[0] ^= 0xFF;
+    EXPECT_EQ(FrozenMap(view(bad_magic)).error(), ResourceError::CorruptData);
+
+    // More buckets than the resource holds
+    auto bad_buckets = bytes;
+    bad_buckets[16] = 100;
+    EXPECT_EQ(FrozenMap(view(bad_buckets)).error(), ResourceError::CorruptData);
+
+    // A slot pointing past the records reads as a miss
+    auto bad_slot = bytes;
+    for (size_t i = 0; i < 7; ++i) {
+        bad_slot[resource_tools::frozen_map::kHeaderSize + 8 + i * 8 + 7] = 0x7F;
+    }
+    FrozenMap damaged(view(bad_slot));
+    ASSERT_TRUE(damaged);
+    EXPECT_FALSE(damaged.contains("a"));
+
+    bytes.resize(bytes.size() - 1);
+    EXPECT_EQ(FrozenMap(view(bytes)).error(), ResourceError::CorruptData);
+}
+
+TEST_F(FrozenMapTest, FullBucketsProbeOn) {
+    // Enough keys that some buckets overflow into the next
+    constexpr size_t kKeys = 50000;
+    std::string tsv;
+    for (size_t i = 0; i < kKeys; ++i) {
+        tsv += "key" + std::to_string(i) + "\tvalue" + std::to_string(i * 7) + "\n";
+    }
+    const fs::path output = work_ / "large.bin";
+    ASSERT_EQ(build(tsv, output), 0);
+    const auto bytes = readFile(output);
+    FrozenMap map(view(bytes));
+    ASSERT_TRUE(map);
+    ASSERT_EQ(map.size(), kKeys);
+    EXPECT_LE(map.size(), map.bucket_count() * resource_tools::frozen_map::kSlotsPerBucket * 4 / 5 + 7);
+    for (size_t i = 0; i < kKeys; ++i) {
+        ASSERT_EQ(map.get("key" + std::to_string(i)), "value" + std::to_string(i * 7));
+    }
+    for (size_t i = kKeys; i < kKeys + 1000; ++i) {
+        ASSERT_FALSE(map.contains("key" + std::to_string(i)));
+    }
+}
+
+// ============================================================================
+// AGAINST A HASH MAP
+// ============================================================================
+
+TEST_F(FrozenMapTest, LookupsMatchUnorderedMap) {
+    constexpr size_t kKeys = 1000;
+    std::string tsv;
+    std::unordered_map<std::string, std::string> map;
+    for (size_t i = 0; i < kKeys; ++i) {
+        const std::string key = "SKU-" + std::to_string(1000000 + i);
+        tsv += key + "\tProduct " + std::to_string(i) + "\n";
+        map.emplace(key, "Product " + std::to_string(i));
+    }
+    const fs::path output = work_ / "map.bin";
+    ASSERT_EQ(build(tsv, output), 0);
+    const auto bytes = readFile(output);
+
+    FrozenMap frozen(view(bytes));
+    std::mt19937 rng(47);
+    for (size_t i = 0; i < 2000; ++i) {
+        const std::string key = "SKU-" + std::to_string(1000000 + rng() % (kKeys + kKeys / 4));
+        const auto found = map.find(key);
+        ASSERT_EQ(frozen.contains(key), found != map.end()) << key;
+        if (found != map.end()) {
+            ASSERT_EQ(frozen.get(key), found->second);
+        }
+    }
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/frozen_set.h>
+#include <set_resources/embedded_data.h>
+#include <set_unfiltered_resources/embedded_data.h>
+#include "build_step_test.h"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace fs = std::filesystem;
+using resource_tools::FrozenSet;
+using resource_tools::ResourceError;
+
+class FrozenSetTest : public BuildStepTest {
+protected:
+    // Build a set the way the build does
+    auto build(const std::string& words, const fs::path& output, const std::string& bloom_bits = "10") const -> int {
+        return pack("set --bloom-bits " + bloom_bits, words, output, "input.txt");
+    }
+};
+
+// ============================================================================
+// EMBEDDED SETS
+// ============================================================================
+
+TEST_F(FrozenSetTest, ContainsEveryEntry) {
+    const FrozenSet& blocked = set_resources::getBlocklistTXTSet();
+    ASSERT_TRUE(blocked);
+    EXPECT_TRUE(blocked.has_filter());
+    EXPECT_EQ(blocked.size(), 9u);
+    for (const char* host : {"ad.example.com", "ads.example.co", "ads.example.com", "adserver.example.com",
+                             "metrics.example.org", "pixel.example.net", "tracker.example.net", "bücher.example",
+                             "bücher.example.de"}) {
+        EXPECT_TRUE(blocked.may_contain(host)) << host;
+        EXPECT_TRUE(blocked.contains(host)) << host;
+    }
+}
+
+TEST_F(FrozenSetTest, PrefixNeighboursAreMisses) {
+    const FrozenSet& blocked = set_resources::getBlocklistTXTSet();
+    for (const char* host : {"", "ad", "ads.example.c", "ads.example.comm", "ads.example.cn", "adserver",
+                             "bücher.exampl", "bücher.example.d", "bücher.example.dd", "zzz", "\xff"}) {
+        EXPECT_FALSE(blocked.contains(host)) << host;
+    }
+}
+
+TEST_F(FrozenSetTest, CommentsAndSpacesAreNotEntries) {
+    const FrozenSet& blocked = set_resources::getBlocklistTXTSet();
+    EXPECT_FALSE(blocked.contains("# Hosts that are never fetched"));
+    EXPECT_FALSE(blocked.contains("  metrics.example.org  "));
+}
+
+TEST_F(FrozenSetTest, SetWithoutFilter) {
+    // Stored SPARSE, so the set is read from the decoded container
+    const FrozenSet& allowed = set_unfiltered_resources::getAllowlistTXTSet();
+    ASSERT_TRUE(allowed);
+    EXPECT_FALSE(allowed.has_filter());
+    EXPECT_EQ(allowed.size(), 3u);
+    EXPECT_TRUE(allowed.contains("alpha"));
+    EXPECT_TRUE(allowed.contains("gamma"));
+    EXPECT_FALSE(allowed.contains("alpha\r"));
+    EXPECT_FALSE(allowed.contains("delta"));
+}
+
+TEST_F(FrozenSetTest, FilterIsCacheLineAligned) {
+    const auto resource = set_resources::getBlocklistTXT();
+    ASSERT_TRUE(resource);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(resource.data) % 64, 0u);
+}
+
+// ============================================================================
+// BUILD STEP
+// ============================================================================
+
+TEST_F(FrozenSetTest, EmptyInput) {
+    const fs::path output = work_ / "empty.bin";
+    ASSERT_EQ(build("# nothing\n\n", output), 0);
+    const auto bytes = readFile(output);
+    FrozenSet set(view(bytes));
+    ASSERT_TRUE(set);
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(""));
+    EXPECT_FALSE(set.may_contain("anything"));
+}
+
+TEST_F(FrozenSetTest, InvalidFilterSizeFailsTheBuild) {
+    const fs::path output = work_ / "out.bin";
+    EXPECT_NE(build("a\n", output, "65"), 0);
+    EXPECT_FALSE(fs::exists(output));
+}
+
+TEST_F(FrozenSetTest, CorruptSetIsRejected) {
+    const fs::path output = work_ / "set.bin";
+    ASSERT_EQ(build("apple\napricot\nbanana\n", output), 0);
+    auto bytes = readFile(output);
+    ASSERT_TRUE(FrozenSet(view(bytes)));
+
+    auto bad_magic = bytes;
+    bad_magic[0] ^= 0xFF;
+    EXPECT_EQ(FrozenSet(view(bad_magic)).error(), ResourceError::CorruptData);
+
+    // A count that does not match the restart index
+    auto bad_count = bytes;
+    bad_count[8] = 40;
+    EXPECT_EQ(FrozenSet(view(bad_count)).error(), ResourceError::CorruptData);
+
+    // More filter blocks than the resource holds
+    auto bad_filter = bytes;
+    bad_filter[32] = 100;
+    EXPECT_EQ(FrozenSet(view(bad_filter)).error(), ResourceError::CorruptData);
+
+    // An entry length running past the data reads as a miss
+    auto bad_entry = bytes;
+    const size_t data_offset = bytes.size() - 22;
+    ASSERT_EQ(bad_entry[data_offset + 1], 5u);
+    bad_entry[data_offset + 1] = 0x7F;
+    FrozenSet damaged(view(bad_entry));
+    ASSERT_TRUE(damaged);
+    EXPECT_FALSE(damaged.contains("apple"));
+
+    bytes.resize(bytes.size() - 1);
+    EXPECT_EQ(FrozenSet(view(bytes)).error(), ResourceError::CorruptData);
+
+    EXPECT_EQ(FrozenSet({nullptr, 0, ResourceError::NotFound}).error(), ResourceError::NotFound);
+}
+
+TEST_F(FrozenSetTest, LargeSetMatchesStdSet) {
+    // Few letters, so entries share long prefixes and many are prefixes of
+    // others; the high bytes check that entries sort unsigned
+    const std::string alphabet = "ab\x7f\x80\xff";
+    std::mt19937 rng(48);
+    auto randomWord = [&] {
+        std::string word(1 + rng() % 12, ' ');
+        for (auto& c : word) {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        return word;
+    };
+
+    std::set<std::string> expected;
+    std::string words;
+    while (expected.size() < 20000) {
+        const std::string word = randomWord();
+        expected.insert(word);
+        words += word + "\n";
+    }
+    for (const fs::path& output : {work_ / "filtered.bin", work_ / "unfiltered.bin"}) {
+        ASSERT_EQ(build(words, output, output.stem() == "filtered" ? "10" : "0"), 0);
+        const auto bytes = readFile(output);
+        FrozenSet set(view(bytes));
+        ASSERT_TRUE(set);
+        ASSERT_EQ(set.size(), expected.size());
+        for (const auto& word : expected) {
+            ASSERT_TRUE(set.contains(word)) << output;
+        }
+        for (int i = 0; i < 20000; ++i) {
+            const std::string word = randomWord();
+            ASSERT_EQ(set.contains(word), expected.count(word) == 1) << output;
+        }
+    }
+}
+
+TEST_F(FrozenSetTest, FilterRejectsMostMisses) {
+    constexpr size_t kWords = 50000;
+    std::string words;
+    for (size_t i = 0; i < kWords; ++i) {
+        words += "member-" + std::to_string(i) + "\n";
+    }
+    const fs::path output = work_ / "filter.bin";
+    ASSERT_EQ(build(words, output), 0);
+    const auto bytes = readFile(output);
+    FrozenSet set(view(bytes));
+    ASSERT_TRUE(set);
+
+    size_t false_positives = 0;
+    for (size_t i = 0; i < kWords; ++i) {
+        ASSERT_TRUE(set.may_contain("member-" + std::to_string(i)));
+        false_positives += set.may_contain("stranger-" + std::to_string(i)) ? 1 : 0;
+    }
+    // About 1% at 10 bits per entry
+    EXPECT_LT(false_positives, kWords / 50);
+}
+
+// ============================================================================
+// AGAINST A HASH SET
+// ============================================================================
+
+TEST_F(FrozenSetTest, LookupsMatchUnorderedSet) {
+    constexpr size_t kWords = 1000;
+    std::string words;
+    std::unordered_set<std::string> parsed;
+    for (size_t i = 0; i < kWords; ++i) {
+        parsed.insert("host" + std::to_string(i * 7) + ".example.com");
+        words += "host" + std::to_string(i * 7) + ".example.com\n";
+    }
+    const fs::path output = work_ / "set.bin";
+    ASSERT_EQ(build(words, output), 0);
+    const auto bytes = readFile(output);
+
+    // Mostly misses, as for a blocklist
+    FrozenSet set(view(bytes));
+    std::mt19937 rng(48);
+    for (size_t i = 0; i < 2000; ++i) {
+        const std::string key = "host" + std::to_string(rng() % (kWords * 70)) + ".example.com";
+        ASSERT_EQ(set.contains(key), parsed.count(key) != 0) << key;
+    }
+}
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include <resource_tools/content_hash.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/http_resource.h>
+#include <http_resources/embedded_data.h>
+#include "test_data.h"
+#include <string>
+#include <vector>
+
+using resource_tools::ContentCoding;
+using test_data::asString;
+using test_data::readDataFile;
+
+class HttpResourceTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    static auto hexOf(const std::string& data) -> std::string {
+        auto hex = resource_tools::toHex(resource_tools::sha256(reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+        return std::string(hex.data(), 64);
+    }
+};
+
+// ============================================================================
+// CONTENT HASH
+// ============================================================================
+
+TEST_F(HttpResourceTest, Sha256MatchesKnownVectors) {
+    EXPECT_EQ(hexOf(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(hexOf("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(hexOf(std::string(1000, 'a')), "41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3");
+}
+
+TEST_F(HttpResourceTest, ContentHashMatchesFile) {
+    const auto& resource = http_resources::getIndexHTMLHttp();
+
+    ASSERT_TRUE(resource);
+    EXPECT_EQ(resource.content_hash(), hexOf(readDataFile("index.html")));
+    EXPECT_EQ(resource.etag(), "\"" + hexOf(readDataFile("index.html")) + "\"");
+}
+
+TEST_F(HttpResourceTest, EncodedVariantsHaveDistinctETags) {
+    const auto& resource = http_resources::getAppJSHttp();
+    auto gzip = resource.variant(ContentCoding::Gzip);
+
+    ASSERT_TRUE(gzip);
+    EXPECT_EQ(gzip.etag, "\"" + std::string(resource.content_hash()) + "-gzip\"");
+    EXPECT_NE(gzip.etag, resource.etag());
+}
+
+// ============================================================================
+// METADATA
+// ============================================================================
+
+TEST_F(HttpResourceTest, MimeTypeFromExtension) {
+    EXPECT_EQ(http_resources::getIndexHTMLHttp().mime_type(), "text/html; charset=utf-8");
+    EXPECT_EQ(http_resources::getAppJSHttp().mime_type(), "text/javascript; charset=utf-8");
+    EXPECT_EQ(http_resources::getRobotsTXTHttp().mime_type(), "text/plain; charset=utf-8");
+}
+
+TEST_F(HttpResourceTest, PlainAccessorReturnsIdentityBody) {
+    auto result = http_resources::getIndexHTML();
+
+    ASSERT_TRUE(result);
+    EXPECT_EQ(asString(result), readDataFile("index.html"));
+    EXPECT_EQ(result.data, http_resources::getIndexHTMLHttp().identity().body.data);
+}
+
+// ============================================================================
+// PRECOMPRESSED VARIANTS
+// ============================================================================
+
+TEST_F(HttpResourceTest, GzipVariantIsSmallerGzipStream) {
+    auto identity = http_resources::getIndexHTMLHttp().identity();
+    auto gzip = http_resources::getIndexHTMLHttp().variant(ContentCoding::Gzip);
+
+    ASSERT_TRUE(gzip);
+    ASSERT_GE(gzip.body.size, 2u);
+    EXPECT_EQ(gzip.body.data[0], 0x1f);
+    EXPECT_EQ(gzip.body.data[1], 0x8b);
+    EXPECT_LT(gzip.body.size, identity.body.size);
+}
+
+TEST_F(HttpResourceTest, ZstdVariantIsSmallerZstdStream) {
+    auto identity = http_resources::getAppJSHttp().identity();
+    auto zstd = http_resources::getAppJSHttp().variant(ContentCoding::Zstd);
+
+    ASSERT_TRUE(zstd);
+    ASSERT_GE(zstd.body.size, 4u);
+    EXPECT_EQ(std::vector<uint8_t>(zstd.body.data, zstd.body.data + 4), (std::vector<uint8_t>{0x28, 0xb5, 0x2f, 0xfd}));
+    EXPECT_LT(zstd.body.size, identity.body.size);
+}
+
+TEST_F(HttpResourceTest, VariantsThatDoNotShrinkAreDropped) {
+    const auto& resource = http_resources::getRobotsTXTHttp();
+
+    ASSERT_TRUE(resource);
+    EXPECT_EQ(resource.variant_count(), 1u);
+    EXPECT_EQ(resource.variant(ContentCoding::Gzip).error, resource_tools::ResourceError::NotFound);
+    EXPECT_EQ(resource.select("gzip, br, zstd").coding, ContentCoding::Identity);
+}
+
+// ============================================================================
+// PREBUILT RESPONSES
+// ============================================================================
+
+TEST_F(HttpResourceTest, ResponseEndsWithBody) {
+    auto gzip = http_resources::getIndexHTMLHttp().variant(ContentCoding::Gzip);
+
+    ASSERT_TRUE(gzip);
+    ASSERT_GT(gzip.response.size, gzip.body.size);
+    EXPECT_EQ(gzip.response.data + gzip.response.size, gzip.body.data + gzip.body.size);
+}
+
+TEST_F(HttpResourceTest, ResponseHeaderDescribesVariant) {
+    auto gzip = http_resources::getIndexHTMLHttp().variant(ContentCoding::Gzip);
+    ASSERT_TRUE(gzip);
+
+    std::string header(reinterpret_cast<const char*>(gzip.response.data), gzip.response.size - gzip.body.size);
+    EXPECT_EQ(header.rfind("HTTP/1.1 200 OK\r\n", 0), 0u);
+    EXPECT_NE(header.find("Content-Type: text/html; charset=utf-8\r\n"), std::string::npos);
+    EXPECT_NE(header.find("Content-Length: " + std::to_string(gzip.body.size) + "\r\n"), std::string::npos);
+    EXPECT_NE(header.find("Content-Encoding: gzip\r\n"), std::string::npos);
+    EXPECT_NE(header.find("ETag: " + std::string(gzip.etag) + "\r\n"), std::string::npos);
+    EXPECT_NE(header.find("Vary: Accept-Encoding\r\n"), std::string::npos);
+    EXPECT_EQ(header.substr(header.size() - 4), "\r\n\r\n");
+}
+
+TEST_F(HttpResourceTest, IdentityResponseHasNoContentEncoding) {
+    auto identity = http_resources::getIndexHTMLHttp().identity();
+    std::string header(reinterpret_cast<const char*>(identity.response.data), identity.response.size - identity.body.size);
+
+    EXPECT_EQ(header.find("Content-Encoding"), std::string::npos);
+}
+
+// ============================================================================
+// ACCEPT-ENCODING NEGOTIATION
+// ============================================================================
+
+TEST_F(HttpResourceTest, SelectWithoutHeaderReturnsIdentity) {
+    EXPECT_EQ(http_resources::getAppJSHttp().select("").coding, ContentCoding::Identity);
+}
+
+TEST_F(HttpResourceTest, SelectSingleCoding) {
+    const auto& resource = http_resources::getAppJSHttp();
+
+    EXPECT_EQ(resource.select("gzip").coding, ContentCoding::Gzip);
+    EXPECT_EQ(resource.select("x-gzip").coding, ContentCoding::Gzip);
+    EXPECT_EQ(resource.select("GZIP").coding, ContentCoding::Gzip);
+    EXPECT_EQ(resource.select("zstd").coding, ContentCoding::Zstd);
+}
+
+TEST_F(HttpResourceTest, SelectHonoursQualityValues) {
+    const auto& resource = http_resources::getAppJSHttp();
+
+    EXPECT_EQ(resource.select("gzip;q=0.5, zstd;q=0.8").coding, ContentCoding::Zstd);
+    EXPECT_EQ(resource.select("gzip;q=1.0, zstd;q=0.8").coding, ContentCoding::Gzip);
+    EXPECT_EQ(resource.select("gzip;q=0, zstd;q=0").coding, ContentCoding::Identity);
+}
+
+TEST_F(HttpResourceTest, SelectPrefersSmallerBodyOnTie) {
+    const auto& resource = http_resources::getAppJSHttp();
+    auto chosen = resource.select("gzip, deflate, br, zstd");
+
+    for (auto coding : {ContentCoding::Gzip, ContentCoding::Brotli, ContentCoding::Zstd}) {
+        auto variant = resource.variant(coding);
+        if (variant) {
+            EXPECT_LE(chosen.body.size, variant.body.size);
+        }
+    }
+}
+
+TEST_F(HttpResourceTest, SelectWildcard) {
+    const auto& resource = http_resources::getAppJSHttp();
+
+    EXPECT_NE(resource.select("*").coding, ContentCoding::Identity);
+    // An explicit q=0 refuses a coding even when the wildcard accepts it
+    EXPECT_EQ(resource.select("*;q=0.5, zstd;q=0").coding, ContentCoding::Gzip);
+}
+
+TEST_F(HttpResourceTest, SelectWeighsIdentity) {
+    const auto& resource = http_resources::getAppJSHttp();
+
+    // identity competes on its own quality value
+    EXPECT_EQ(resource.select("gzip;q=0.1, identity;q=1").coding, ContentCoding::Identity);
+    EXPECT_EQ(resource.select("zstd;q=0.5, identity").coding, ContentCoding::Identity);
+    EXPECT_EQ(resource.select("*;q=0.2, identity;q=0.9").coding, ContentCoding::Identity);
+    // and loses ties to the smaller body
+    EXPECT_EQ(resource.select("zstd;q=0.5, identity;q=0.5").coding, ContentCoding::Zstd);
+    // Unlisted, it ranks below anything the client accepts
+    EXPECT_EQ(resource.select("gzip;q=0.001").coding, ContentCoding::Gzip);
+    // Refused, any accepted coding wins; with nothing accepted it is the fallback
+    EXPECT_EQ(resource.select("gzip;q=0.1, identity;q=0").coding, ContentCoding::Gzip);
+    EXPECT_EQ(resource.select("gzip;q=0, identity;q=0").coding, ContentCoding::Identity);
+}
+
+// ============================================================================
+// BUNDLE VALIDATION
+// ============================================================================
+
+TEST_F(HttpResourceTest, RejectsForeignBlob) {
+    std::vector<uint8_t> bytes(64, 0);
+    resource_tools::HttpResource resource({bytes.data(), bytes.size(), resource_tools::ResourceError::Success});
+
+    EXPECT_FALSE(resource);
+    EXPECT_EQ(resource.error(), resource_tools::ResourceError::CorruptData);
+    EXPECT_EQ(resource.variant_count(), 0u);
+    EXPECT_EQ(resource.identity().body.error, resource_tools::ResourceError::CorruptData);
+}
+
+TEST_F(HttpResourceTest, RejectsTruncatedBundle) {
+    auto packed = http_resources::getIndexHTMLPacked();
+    ASSERT_TRUE(packed);
+
+    resource_tools::HttpResource resource({packed.data, packed.size - 1, resource_tools::ResourceError::Success});
+    EXPECT_EQ(resource.error(), resource_tools::ResourceError::CorruptData);
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <huge_page_resources/embedded_data.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/huge_pages.h>
+#include <sparse_huge_page_resources/embedded_data.h>
+#include <test_resources/embedded_data.h>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+
+using resource_tools::HugePagePolicy;
+using resource_tools::HugePageResource;
+using resource_tools::PageBacking;
+using resource_tools::ResourceError;
+
+class HugePagesTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    static constexpr size_t kLine = 64;
+    static constexpr size_t kLines = 65537;
+
+    static auto hugePageSize() -> size_t { return resource_tools::detail::huge_page_size(); }
+
+    // The generated resource repeats one 64 byte line
+    static auto matchesHugeTable(const resource_tools::ResourceResult& resource) -> bool {
+        const char* line = "resource_tools huge page test data, 64 bytes per line..........\n";
+        if (!resource || resource.size != kLine * kLines) {
+            return false;
+        }
+        for (size_t offset = 0; offset < resource.size; offset += kLine) {
+            if (std::memcmp(resource.data + offset, line, kLine) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static auto reservedHugePages() -> long {
+        long pages = 0;
+        if (FILE* file = std::fopen("/proc/sys/vm/nr_hugepages", "r")) {
+            if (std::fscanf(file, "%ld", &pages) != 1) {
+                pages = 0;
+            }
+            std::fclose(file);
+        }
+        return pages;
+    }
+};
+
+// ============================================================================
+// EMBED-TIME ALIGNMENT
+// ============================================================================
+
+TEST_F(HugePagesTest, LargeResourceStartsOnHugePageBoundary) {
+    auto resource = huge_page_resources::getHugeTableBIN();
+
+    ASSERT_TRUE(matchesHugeTable(resource));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(resource.data) % (size_t{2} * 1024 * 1024), 0u);
+}
+
+TEST_F(HugePagesTest, AlignmentFollowsEmbeddedSize) {
+    // 5 MB of zeros, which the sparse container stores in a few bytes
+    auto packed = sparse_huge_page_resources::getSparseHugeZerosBINPacked();
+    auto resource = sparse_huge_page_resources::getSparseHugeZerosBIN();
+
+    ASSERT_TRUE(packed);
+    ASSERT_TRUE(resource);
+    EXPECT_LT(packed.size, size_t{4096});
+    EXPECT_EQ(resource.size, size_t{5} * 1024 * 1024);
+    EXPECT_NE(reinterpret_cast<uintptr_t>(packed.data) % (size_t{2} * 1024 * 1024), 0u);
+}
+
+// ============================================================================
+// HUGE PAGE COPIES
+// ============================================================================
+
+TEST_F(HugePagesTest, CopyMatchesSource) {
+    if (!resource_tools::detail::transparent_huge_pages_enabled() && reservedHugePages() == 0) {
+        GTEST_SKIP() << "No huge pages on this system";
+    }
+    auto source = huge_page_resources::getHugeTableBIN();
+    HugePageResource copy(source);
+
+    ASSERT_NE(copy.backing(), PageBacking::Source);
+    EXPECT_NE(copy.get().data, source.data);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(copy.get().data) % hugePageSize(), 0u);
+    EXPECT_TRUE(matchesHugeTable(copy.get()));
+}
+
+TEST_F(HugePagesTest, CopyIsReadOnly) {
+    if (!resource_tools::detail::transparent_huge_pages_enabled()) {
+        GTEST_SKIP() << "Transparent huge pages are disabled";
+    }
+    HugePageResource copy(huge_page_resources::getHugeTableBIN(), HugePagePolicy::Transparent);
+    ASSERT_EQ(copy.backing(), PageBacking::Transparent);
+
+    EXPECT_DEATH(const_cast<uint8_t*>(copy.get().data)[0] = 0, "");
+}
+
+TEST_F(HugePagesTest, HugeTlbWithoutReservedPagesUsesSource) {
+    if (reservedHugePages() != 0) {
+        GTEST_SKIP() << "Huge pages are reserved on this system";
+    }
+    auto source = huge_page_resources::getHugeTableBIN();
+    HugePageResource copy(source, HugePagePolicy::HugeTlb);
+
+    EXPECT_EQ(copy.backing(), PageBacking::Source);
+    EXPECT_EQ(copy.get().data, source.data);
+}
+
+TEST_F(HugePagesTest, SmallResourceIsNotCopied) {
+    auto source = test_resources::getBinaryDataBIN();
+    HugePageResource copy(source);
+
+    EXPECT_EQ(copy.backing(), PageBacking::Source);
+    EXPECT_EQ(copy.get().data, source.data);
+    EXPECT_EQ(copy.get().size, source.size);
+}
+
+TEST_F(HugePagesTest, FailedResourceKeepsItsError) {
+    HugePageResource copy(resource_tools::ResourceResult{nullptr, 0, ResourceError::NotFound});
+
+    EXPECT_EQ(copy.get().error, ResourceError::NotFound);
+    EXPECT_EQ(copy.backing(), PageBacking::Source);
+}
+
+TEST_F(HugePagesTest, MovedResourceKeepsCopy) {
+    HugePageResource first(huge_page_resources::getHugeTableBIN());
+    const auto* data = first.get().data;
+    const PageBacking backing = first.backing();
+
+    HugePageResource second(std::move(first));
+
+    EXPECT_EQ(second.get().data, data);
+    EXPECT_EQ(second.backing(), backing);
+    EXPECT_TRUE(matchesHugeTable(second.get()));
+}
+
+// ============================================================================
+// REMAPPING IN PLACE
+// ============================================================================
+
+TEST_F(HugePagesTest, RemapKeepsAddressAndBytes) {
+    if (!resource_tools::detail::transparent_huge_pages_enabled()) {
+        GTEST_SKIP() << "Transparent huge pages are disabled";
+    }
+    auto resource = huge_page_resources::getHugeTableBIN();
+
+    ASSERT_EQ(resource_tools::remapToHugePages(resource), ResourceError::Success);
+
+    auto after = huge_page_resources::getHugeTableBIN();
+    EXPECT_EQ(after.data, resource.data);
+    EXPECT_TRUE(matchesHugeTable(after));
+}
+
+TEST_F(HugePagesTest, RemapRejectsSharedMemory) {
+    const size_t size = hugePageSize() * 2;
+    void* shared = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(shared, MAP_FAILED);
+    std::memset(shared, 'x', size);
+
+    resource_tools::ResourceResult resource{static_cast<const uint8_t*>(shared), size, ResourceError::Success};
+    EXPECT_EQ(resource_tools::remapToHugePages(resource), ResourceError::Unsupported);
+    EXPECT_EQ(static_cast<const char*>(shared)[size - 1], 'x');
+    munmap(shared, size);
+}
+
+TEST_F(HugePagesTest, RemapRejectsSmallResource) {
+    EXPECT_EQ(resource_tools::remapToHugePages(test_resources::getBinaryDataBIN()), ResourceError::Unsupported);
+    EXPECT_EQ(resource_tools::remapToHugePages(resource_tools::ResourceResult{nullptr, 0, ResourceError::NotFound}),
+              ResourceError::NotFound);
+}
+
+// ============================================================================
+// NORMAL PAGE SOURCES
+// ============================================================================
+
+TEST_F(HugePagesTest, CopyOfNormalPagesMatches) {
+    if (!resource_tools::detail::transparent_huge_pages_enabled() && reservedHugePages() == 0) {
+        GTEST_SKIP() << "No huge pages on this system";
+    }
+    const size_t size = hugePageSize() * 2;
+    void* small_pages = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(small_pages, MAP_FAILED);
+    madvise(small_pages, size, MADV_NOHUGEPAGE);
+    for (size_t i = 0; i < size; ++i) {
+        static_cast<uint8_t*>(small_pages)[i] = static_cast<uint8_t>(i * 7);
+    }
+    resource_tools::ResourceResult source{static_cast<const uint8_t*>(small_pages), size, ResourceError::Success};
+
+    {
+        HugePageResource copy(source);
+        ASSERT_NE(copy.backing(), PageBacking::Source);
+        ASSERT_EQ(copy.get().size, size);
+        EXPECT_EQ(std::memcmp(copy.get().data, small_pages, size), 0);
+    }
+    munmap(small_pages, size);
+}
+
+#endif // __linux__
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/memfd.h>
+#include <test_resources/embedded_data.h>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using resource_tools::ResourceError;
+
+class MemfdTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    // Read a file from disk, standing in for an embedded binary
+    static auto readFile(const char* path) -> std::vector<uint8_t> {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    static auto asResource(const std::vector<uint8_t>& bytes) -> resource_tools::ResourceResult {
+        return {bytes.data(), bytes.size(), ResourceError::Success};
+    }
+};
+
+// ============================================================================
+// MEMFD
+// ============================================================================
+
+TEST_F(MemfdTest, DescriptorHoldsResource) {
+    auto resource = test_resources::getTestFileTXT();
+    auto memfd = resource_tools::asMemfd(resource);
+    ASSERT_TRUE(memfd);
+
+    std::vector<uint8_t> contents(resource.size + 1);
+    const ssize_t n = pread(memfd.fd, contents.data(), contents.size(), 0);
+
+    ASSERT_EQ(n, static_cast<ssize_t>(resource.size));
+    EXPECT_EQ(std::memcmp(contents.data(), resource.data, resource.size), 0);
+}
+
+TEST_F(MemfdTest, RepeatedCallsReturnSameDescriptor) {
+    auto first = resource_tools::asMemfd(test_resources::getTestFileTXT());
+    auto second = resource_tools::asMemfd(test_resources::getTestFileTXT());
+    auto other = resource_tools::asMemfd(test_resources::getBinaryDataBIN());
+
+    ASSERT_TRUE(first);
+    EXPECT_EQ(second.fd, first.fd);
+    EXPECT_NE(other.fd, first.fd);
+}
+
+TEST_F(MemfdTest, DescriptorIsSealed) {
+    auto memfd = resource_tools::asMemfd(test_resources::getTestFileTXT());
+    ASSERT_TRUE(memfd);
+
+    const int seals = fcntl(memfd.fd, F_GET_SEALS);
+    EXPECT_EQ(seals, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+    EXPECT_EQ(pwrite(memfd.fd, "x", 1, 0), -1);
+    EXPECT_NE(ftruncate(memfd.fd, 0), 0);
+    EXPECT_EQ(mmap(nullptr, 1, PROT_READ | PROT_WRITE, MAP_SHARED, memfd.fd, 0), MAP_FAILED);
+}
+
+TEST_F(MemfdTest, NothingTouchesDisk) {
+    auto memfd = resource_tools::asMemfd(test_resources::getTestFileTXT());
+    ASSERT_TRUE(memfd);
+
+    char target[256] = {};
+    const std::string link = "/proc/self/fd/" + std::to_string(memfd.fd);
+    ASSERT_GT(readlink(link.c_str(), target, sizeof(target) - 1), 0);
+    EXPECT_EQ(std::string(target).rfind("/memfd:", 0), 0u) << target;
+    EXPECT_EQ(resource_tools::memfdPath(test_resources::getTestFileTXT()), link);
+}
+
+TEST_F(MemfdTest, FailedResourceKeepsItsError) {
+    auto memfd = resource_tools::asMemfd(resource_tools::ResourceResult{nullptr, 0, ResourceError::NotFound});
+
+    EXPECT_FALSE(memfd);
+    EXPECT_EQ(memfd.error, ResourceError::NotFound);
+    EXPECT_EQ(memfd.fd, -1);
+    EXPECT_EQ(resource_tools::memfdPath(resource_tools::ResourceResult{nullptr, 0, ResourceError::NotFound}), "");
+}
+
+// ============================================================================
+// DLOPEN AND FEXECVE
+// ============================================================================
+
+TEST_F(MemfdTest, LoadsSharedLibraryFromMemory) {
+    static const std::vector<uint8_t> plugin = readFile(RESOURCE_TOOLS_TEST_PLUGIN);
+    ASSERT_FALSE(plugin.empty());
+
+    void* handle = resource_tools::dlopenResource(asResource(plugin));
+    ASSERT_NE(handle, nullptr) << dlerror();
+
+    auto answer = reinterpret_cast<int (*)()>(dlsym(handle, "resource_tools_test_plugin_answer"));
+    ASSERT_NE(answer, nullptr);
+    EXPECT_EQ(answer(), 42);
+    dlclose(handle);
+}
+
+TEST_F(MemfdTest, ExecutesEmbeddedBinary) {
+    static const std::vector<uint8_t> shell = readFile("/bin/sh");
+    if (shell.empty()) {
+        GTEST_SKIP() << "/bin/sh is not available";
+    }
+
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        char arg0[] = "sh";
+        char arg1[] = "-c";
+        char arg2[] = "exit 7";
+        char* argv[] = {arg0, arg1, arg2, nullptr};
+        char* envp[] = {nullptr};
+        resource_tools::execResource(asResource(shell), argv, envp);
+        _exit(99);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 7);
+}
+
+#endif // __linux__
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/memory_advice.h>
+#include <resource_tools/packed_resource.h>
+#include <resource_tools/shared_cache.h>
+#include <sparse_resources/embedded_data.h>
+#include <test_resources/embedded_data.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using resource_tools::Advice;
+using resource_tools::ResourceError;
+
+class MemoryAdviceTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    static auto sameBytes(const resource_tools::ResourceResult& a, const resource_tools::ResourceResult& b) -> bool {
+        return a && b && a.size == b.size && std::memcmp(a.data, b.data, a.size) == 0;
+    }
+
+    // Locked memory of this process in kB, from /proc/self/status
+    static auto lockedKb() -> long {
+        std::ifstream status("/proc/self/status");
+        for (std::string line; std::getline(status, line);) {
+            if (line.rfind("VmLck:", 0) == 0) {
+                return std::stol(line.substr(6));
+            }
+        }
+        return -1;
+    }
+
+    static auto minorFaults() -> long {
+        struct rusage usage {};
+        getrusage(RUSAGE_THREAD, &usage);
+        return usage.ru_minflt;
+    }
+
+    static auto touchPages(const resource_tools::ResourceResult& resource) -> uint8_t {
+        uint8_t sum = 0;
+        for (size_t offset = 0; offset < resource.size; offset += 4096) {
+            sum ^= static_cast<const volatile uint8_t*>(resource.data)[offset];
+        }
+        return sum;
+    }
+};
+
+// ============================================================================
+// STORAGE KINDS
+// ============================================================================
+
+TEST_F(MemoryAdviceTest, EveryAdviceWorksOnEmbeddedData) {
+    auto resource = test_resources::getBinaryDataBIN();
+
+    for (auto advice : {Advice::Normal, Advice::WillNeed, Advice::Sequential, Advice::Random, Advice::DontNeed}) {
+        EXPECT_EQ(resource_tools::advise(resource, advice), ResourceError::Success);
+    }
+    // Back to the default for the rest of the tests
+    EXPECT_EQ(resource_tools::advise(resource, Advice::Normal), ResourceError::Success);
+}
+
+TEST_F(MemoryAdviceTest, WorksOnDecodedAndSharedCopies) {
+    auto copy = sparse_resources::getSparseTableBINDecoded(std::pmr::new_delete_resource());
+    const std::string directory = ::testing::TempDir() + "resource_tools_advice_" + std::to_string(getpid());
+    std::filesystem::create_directories(directory);
+    {
+        resource_tools::SharedCache cache(directory);
+        auto shared = cache.get(sparse_resources::getSparseTableBINPacked());
+        ASSERT_EQ(cache.stats().created, 1u);
+
+        EXPECT_EQ(resource_tools::advise(copy.get(), Advice::WillNeed), ResourceError::Success);
+        EXPECT_EQ(resource_tools::advise(shared.get(), Advice::WillNeed), ResourceError::Success);
+        EXPECT_EQ(resource_tools::advise(shared.get(), Advice::Sequential), ResourceError::Success);
+    }
+    std::filesystem::remove_all(directory);
+}
+
+TEST_F(MemoryAdviceTest, DontNeedKeepsDecodedData) {
+    auto copy = sparse_resources::getSparseTableBINDecoded(std::pmr::new_delete_resource());
+
+    ASSERT_EQ(resource_tools::advise(copy.get(), Advice::DontNeed), ResourceError::Success);
+
+    EXPECT_TRUE(sameBytes(copy.get(), sparse_resources::getSparseTableBIN()));
+}
+
+// ============================================================================
+// PINNING
+// ============================================================================
+
+TEST_F(MemoryAdviceTest, PinLocksPagesUntilUnpinned) {
+    auto copy = sparse_resources::getSparseTableBINDecoded(std::pmr::new_delete_resource());
+    const long before = lockedKb();
+
+    ASSERT_EQ(resource_tools::pin(copy.get()), ResourceError::Success);
+    EXPECT_GE(lockedKb(), before + 64);
+
+    ASSERT_EQ(resource_tools::unpin(copy.get()), ResourceError::Success);
+    EXPECT_EQ(lockedKb(), before);
+}
+
+// ============================================================================
+// VALIDATION
+// ============================================================================
+
+TEST_F(MemoryAdviceTest, FailedResourceKeepsItsError) {
+    resource_tools::ResourceResult missing{nullptr, 0, ResourceError::NotFound};
+
+    EXPECT_EQ(resource_tools::advise(missing, Advice::WillNeed), ResourceError::NotFound);
+    EXPECT_EQ(resource_tools::pin(missing), ResourceError::NotFound);
+    EXPECT_EQ(resource_tools::unpin(missing), ResourceError::NotFound);
+}
+
+TEST_F(MemoryAdviceTest, NullDataIsRejected) {
+    resource_tools::ResourceResult null_data{nullptr, 16, ResourceError::Success};
+
+    EXPECT_EQ(resource_tools::advise(null_data, Advice::WillNeed), ResourceError::NullPointer);
+    EXPECT_EQ(resource_tools::pin(null_data), ResourceError::NullPointer);
+}
+
+TEST_F(MemoryAdviceTest, EmptyResourceIsNoOp) {
+    static const uint8_t byte = 0;
+    resource_tools::ResourceResult empty{&byte, 0, ResourceError::Success};
+
+    EXPECT_EQ(resource_tools::advise(empty, Advice::DontNeed), ResourceError::Success);
+    EXPECT_EQ(resource_tools::pin(empty), ResourceError::Success);
+}
+
+// ============================================================================
+// PAGE FAULTS
+// ============================================================================
+
+TEST_F(MemoryAdviceTest, WillNeedAvoidsFirstTouchFaults) {
+    // A file-backed read-only mapping behaves like data embedded in .rodata
+    constexpr size_t size = size_t{4} * 1024 * 1024;
+    const std::string path = ::testing::TempDir() + "resource_tools_advice_" + std::to_string(getpid()) + ".bin";
+    {
+        std::vector<char> data(size, 'x');
+        std::ofstream out(path, std::ios::binary);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    int fd = open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    void* cold_map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    void* warm_map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    std::filesystem::remove(path);
+    ASSERT_NE(cold_map, MAP_FAILED);
+    ASSERT_NE(warm_map, MAP_FAILED);
+    resource_tools::ResourceResult cold{static_cast<const uint8_t*>(cold_map), size, ResourceError::Success};
+    resource_tools::ResourceResult warm{static_cast<const uint8_t*>(warm_map), size, ResourceError::Success};
+
+    long start = minorFaults();
+    touchPages(cold);
+    const long cold_faults = minorFaults() - start;
+
+    ASSERT_EQ(resource_tools::advise(warm, Advice::WillNeed), ResourceError::Success);
+    start = minorFaults();
+    touchPages(warm);
+    const long warm_faults = minorFaults() - start;
+
+    munmap(cold_map, size);
+    munmap(warm_map, size);
+
+    EXPECT_LE(warm_faults, cold_faults);
+}
+
+#endif // __linux__
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+#include <resource_tools/resource_cache.h>
+#include <dedup_resources/embedded_data.h>
+#include <sparse_resources/embedded_data.h>
+#include <tiered_resources/embedded_data.h>
+#include <variant_resources/embedded_data.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+
+// ============================================================================
+// GLOBAL ALLOCATION COUNTING
+// ============================================================================
+
+// Replaces the global allocation functions for the whole test binary; they
+// only count calls, so other tests are unaffected
+namespace {
+std::atomic<size_t> g_global_new_calls{0};
+}
+
+void* operator new(size_t size) {
+    g_global_new_calls.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size > 0 ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    g_global_new_calls.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size > 0 ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    g_global_new_calls.fetch_add(1, std::memory_order_relaxed);
+    const size_t align = static_cast<size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+// Forwards to new/delete and counts what passes through
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytes = 0;
+
+private:
+    void* do_allocate(size_t size, size_t alignment) override {
+        ++allocations;
+        bytes += size;
+        return std::pmr::new_delete_resource()->allocate(size, alignment);
+    }
+
+    void do_deallocate(void* p, size_t size, size_t alignment) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+    }
+
+    auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override {
+        return this == &other;
+    }
+};
+
+} // namespace
+
+class MemoryResourceTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    static auto newCalls() -> size_t { return g_global_new_calls.load(std::memory_order_relaxed); }
+
+    static auto sameBytes(const resource_tools::ResourceResult& a, const resource_tools::ResourceResult& b) -> bool {
+        return a && b && a.size == b.size && std::memcmp(a.data, b.data, a.size) == 0;
+    }
+};
+
+// ============================================================================
+// DECODING INTO CALLER MEMORY
+// ============================================================================
+
+TEST_F(MemoryResourceTest, DecodingDoesNotCallGlobalNew) {
+    // Decode-once copies to compare against, made before counting starts
+    auto sparse = sparse_resources::getSparseTableBIN();
+    auto chunked = dedup_resources::getBundleFrJSON();
+    auto delta = variant_resources::getConfigAcmeJSON();
+    auto lz = tiered_resources::getTierColdJSON();
+
+    alignas(std::max_align_t) static uint8_t arena_buffer[512 * 1024];
+    std::pmr::monotonic_buffer_resource arena(arena_buffer, sizeof(arena_buffer), std::pmr::null_memory_resource());
+
+    const size_t before = newCalls();
+    resource_tools::PackedResource sparse_copy(sparse_resources::getSparseTableBINPacked(), {}, &arena);
+    resource_tools::PackedResource chunked_copy(dedup_resources::getBundleFrJSONPacked(),
+                                                dedup_resources::getDedupTestChunksBINPacked(), &arena);
+    resource_tools::PackedResource delta_copy(variant_resources::getConfigAcmeJSONPacked(),
+                                              variant_resources::getConfigBaseJSONPacked(), &arena);
+    resource_tools::PackedResource lz_copy(tiered_resources::getTierColdJSONPacked(), {}, &arena);
+    const size_t after = newCalls();
+
+    EXPECT_EQ(after, before);
+    EXPECT_TRUE(sameBytes(sparse_copy.get(), sparse));
+    EXPECT_TRUE(sameBytes(chunked_copy.get(), chunked));
+    EXPECT_TRUE(sameBytes(delta_copy.get(), delta));
+    EXPECT_TRUE(sameBytes(lz_copy.get(), lz));
+
+    // The copies really live in the arena
+    EXPECT_GE(sparse_copy.get().data, arena_buffer);
+    EXPECT_LT(sparse_copy.get().data, arena_buffer + sizeof(arena_buffer));
+}
+
+TEST_F(MemoryResourceTest, CacheDoesNotCallGlobalNew) {
+    alignas(std::max_align_t) static uint8_t arena_buffer[1024 * 1024];
+    std::pmr::monotonic_buffer_resource arena(arena_buffer, sizeof(arena_buffer), std::pmr::null_memory_resource());
+
+    const size_t before = newCalls();
+    {
+        // Room for one of the two resources, so the second insert evicts
+        resource_tools::ResourceCache cache(70 * 1024, 4, &arena);
+        auto first = cache.get(sparse_resources::getSparseTableBINPacked());
+        auto hit = cache.get(sparse_resources::getSparseTableBINPacked());
+        auto second = cache.get(dedup_resources::getBundleFrJSONPacked(), dedup_resources::getDedupTestChunksBINPacked());
+
+        EXPECT_TRUE(first);
+        EXPECT_TRUE(hit);
+        EXPECT_TRUE(second);
+        EXPECT_EQ(cache.stats().evictions, 1u);
+    }
+    EXPECT_EQ(newCalls(), before);
+}
+
+TEST_F(MemoryResourceTest, DecodedAccessorAllocatesFromCallerResource) {
+    CountingResource counting;
+    {
+        auto copy = sparse_resources::getSparseTableBINDecoded(&counting);
+
+        EXPECT_TRUE(sameBytes(copy.get(), sparse_resources::getSparseTableBIN()));
+        EXPECT_NE(copy.get().data, sparse_resources::getSparseTableBIN().data);
+        EXPECT_EQ(counting.allocations, 1u);
+        EXPECT_EQ(counting.bytes, 65536u);
+    }
+    EXPECT_EQ(counting.deallocations, 1u);
+}
+
+TEST_F(MemoryResourceTest, MovedResourceKeepsBuffer) {
+    CountingResource counting;
+    {
+        auto copy = sparse_resources::getSparseTableBINDecoded(&counting);
+        const uint8_t* data = copy.get().data;
+
+        resource_tools::PackedResource moved(std::move(copy));
+        EXPECT_EQ(moved.get().data, data);
+        EXPECT_FALSE(copy.get());
+    }
+    EXPECT_EQ(counting.deallocations, 1u);
+}
+
+// ============================================================================
+// ALLOCATION FAILURE
+// ============================================================================
+
+TEST_F(MemoryResourceTest, ExhaustedResourceReportsOutOfMemory) {
+    resource_tools::PackedResource resource(sparse_resources::getSparseTableBINPacked(), {},
+                                            std::pmr::null_memory_resource());
+
+    EXPECT_FALSE(resource.get());
+    EXPECT_EQ(resource.get().error, resource_tools::ResourceError::OutOfMemory);
+}
+
+TEST_F(MemoryResourceTest, ExhaustedCacheReportsOutOfMemory) {
+    alignas(std::max_align_t) static uint8_t arena_buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(arena_buffer, sizeof(arena_buffer), std::pmr::null_memory_resource());
+    resource_tools::ResourceCache cache(1024 * 1024, 1, &arena);
+
+    auto handle = cache.get(sparse_resources::getSparseTableBINPacked());
+
+    EXPECT_FALSE(handle);
+    EXPECT_EQ(handle.error(), resource_tools::ResourceError::OutOfMemory);
+}
+
+// ============================================================================
+// DEFAULT RESOURCE
+// ============================================================================
+
+TEST_F(MemoryResourceTest, ZeroedResourceReturnsZeroedAlignedMemory) {
+    auto* memory = resource_tools::zeroedMemoryResource();
+
+    for (size_t alignment : {size_t{8}, size_t{64}, size_t{4096}}) {
+        auto* p = static_cast<uint8_t*>(memory->allocate(1000, alignment));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignment, 0u);
+        EXPECT_TRUE(std::all_of(p, p + 1000, [](uint8_t b) { return b == 0; }));
+        memory->deallocate(p, 1000, alignment);
+    }
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/mutable_view.h>
+#include <resource_tools/shared_cache.h>
+#include <sparse_resources/embedded_data.h>
+#include <test_resources/embedded_data.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using resource_tools::ResourceError;
+using resource_tools::ViewBacking;
+
+class MutableViewTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    static auto sameBytes(const resource_tools::MutableView& view, const resource_tools::ResourceResult& resource)
+        -> bool {
+        return view && resource && view.size() == resource.size &&
+               std::memcmp(view.data(), resource.data, resource.size) == 0;
+    }
+
+    // Anonymous (private, written) kB of the mapping at `address`, from /proc/self/smaps
+    static auto anonymousKb(const void* address) -> long {
+        std::ifstream smaps("/proc/self/smaps");
+        const auto target = reinterpret_cast<uintptr_t>(address);
+        bool inside = false;
+        for (std::string line; std::getline(smaps, line);) {
+            unsigned long low = 0;
+            unsigned long high = 0;
+            if (std::sscanf(line.c_str(), "%lx-%lx ", &low, &high) == 2) {
+                inside = target >= low && target < high;
+            } else if (inside && line.rfind("Anonymous:", 0) == 0) {
+                return std::stol(line.substr(10));
+            }
+        }
+        return -1;
+    }
+
+    // A read-only file mapping stands in for a large resource in the binary
+    struct MappedFile {
+        std::string path;
+        void* data = MAP_FAILED;
+        size_t size = 0;
+        ~MappedFile() {
+            if (data != MAP_FAILED) {
+                munmap(data, size);
+            }
+            std::filesystem::remove(path);
+        }
+        auto resource() const -> resource_tools::ResourceResult {
+            return {static_cast<const uint8_t*>(data), size, ResourceError::Success};
+        }
+    };
+
+    static auto mapFile(size_t size, MappedFile& mapped) -> bool {
+        const std::string path =
+            ::testing::TempDir() + "resource_tools_view_" + std::to_string(getpid()) + ".bin";
+        mapped.path = path;
+        {
+            std::vector<char> block(size_t{1} << 20);
+            for (size_t i = 0; i < block.size(); ++i) {
+                block[i] = static_cast<char>(i * 31);
+            }
+            std::ofstream out(path, std::ios::binary);
+            for (size_t written = 0; written < size; written += block.size()) {
+                out.write(block.data(), static_cast<std::streamsize>(block.size()));
+            }
+        }
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        mapped.data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        mapped.size = size;
+        close(fd);
+        return mapped.data != MAP_FAILED;
+    }
+};
+
+// ============================================================================
+// VIEWS OF EMBEDDED DATA
+// ============================================================================
+
+TEST_F(MutableViewTest, EmbeddedDataIsMappedFromTheBinary) {
+    auto resource = test_resources::getTestFileTXT();
+    auto view = resource_tools::mutableView(resource);
+
+    ASSERT_TRUE(view);
+    EXPECT_EQ(view.backing(), ViewBacking::File);
+    EXPECT_NE(view.data(), resource.data);
+    EXPECT_TRUE(sameBytes(view, resource));
+}
+
+TEST_F(MutableViewTest, WritesStayInTheView) {
+    auto resource = test_resources::getTestFileTXT();
+    const std::string original(reinterpret_cast<const char*>(resource.data), resource.size);
+    auto first = resource_tools::mutableView(resource);
+    auto second = resource_tools::mutableView(resource);
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+
+    first.data()[0] = '#';
+    first.span().back() = '!';
+
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(resource.data), resource.size), original);
+    EXPECT_TRUE(sameBytes(second, resource));
+    EXPECT_EQ(first.data()[0], '#');
+    EXPECT_EQ(first.data()[resource.size - 1], '!');
+}
+
+TEST_F(MutableViewTest, SharedSegmentIsMappedFromItsFile) {
+    const std::string directory = ::testing::TempDir() + "resource_tools_view_" + std::to_string(getpid());
+    std::filesystem::create_directories(directory);
+    {
+        resource_tools::SharedCache cache(directory);
+        auto shared = cache.get(sparse_resources::getSparseTableBINPacked());
+        ASSERT_TRUE(shared.get());
+
+        auto view = resource_tools::mutableView(shared.get());
+        ASSERT_TRUE(view);
+        EXPECT_EQ(view.backing(), ViewBacking::File);
+        view.data()[0] ^= 0xff;
+
+        EXPECT_TRUE(sameBytes(resource_tools::mutableView(shared.get()), shared.get()));
+    }
+    std::filesystem::remove_all(directory);
+}
+
+// ============================================================================
+// VIEWS OF DECODED DATA
+// ============================================================================
+
+TEST_F(MutableViewTest, DecodedCopyIsViewedThroughMemfd) {
+    auto copy = sparse_resources::getSparseTableBINDecoded(std::pmr::new_delete_resource());
+    auto view = resource_tools::mutableView(copy.get());
+
+    ASSERT_TRUE(view);
+    EXPECT_EQ(view.backing(), ViewBacking::Memfd);
+    EXPECT_TRUE(sameBytes(view, copy.get()));
+
+    view.data()[100] ^= 0xff;
+    EXPECT_NE(view.data()[100], copy.get().data[100]);
+}
+
+TEST_F(MutableViewTest, MovedViewKeepsPages) {
+    auto resource = test_resources::getBinaryDataBIN();
+    auto first = resource_tools::mutableView(resource);
+    uint8_t* data = first.data();
+
+    resource_tools::MutableView second(std::move(first));
+
+    EXPECT_EQ(second.data(), data);
+    EXPECT_TRUE(sameBytes(second, resource));
+    EXPECT_EQ(first.data(), nullptr);
+}
+
+// ============================================================================
+// VALIDATION
+// ============================================================================
+
+TEST_F(MutableViewTest, FailedResourceKeepsItsError) {
+    auto view = resource_tools::mutableView(resource_tools::ResourceResult{nullptr, 0, ResourceError::NotFound});
+
+    EXPECT_FALSE(view);
+    EXPECT_EQ(view.error(), ResourceError::NotFound);
+    EXPECT_EQ(view.backing(), ViewBacking::None);
+}
+
+TEST_F(MutableViewTest, NullDataIsRejected) {
+    auto view = resource_tools::mutableView(resource_tools::ResourceResult{nullptr, 16, ResourceError::Success});
+
+    EXPECT_EQ(view.error(), ResourceError::NullPointer);
+}
+
+// ============================================================================
+// LARGE RESOURCES
+// ============================================================================
+
+TEST_F(MutableViewTest, OnlyWrittenPagesTakeMemory) {
+    constexpr size_t size = size_t{16} * 1024 * 1024;
+    MappedFile mapped;
+    ASSERT_TRUE(mapFile(size, mapped));
+
+    auto view = resource_tools::mutableView(mapped.resource());
+    ASSERT_TRUE(view);
+    ASSERT_EQ(view.backing(), ViewBacking::File);
+
+    // Patch one byte in each of 16 pages spread over the view
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t i = 0; i < 16; ++i) {
+        view.data()[i * (size / 16)] = 0xab;
+    }
+
+    EXPECT_EQ(anonymousKb(view.data()), static_cast<long>(16 * page / 1024));
+    EXPECT_EQ(view.data()[1], static_cast<const uint8_t*>(mapped.data)[1]);
+    EXPECT_EQ(static_cast<const uint8_t*>(mapped.data)[size / 16], 0);
+}
+
+#endif // __linux__
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/numa.h>
+#include <test_resources/embedded_data.h>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using resource_tools::NumaTopology;
+using resource_tools::ReplicatedResource;
+using resource_tools::ResourceError;
+
+namespace {
+
+// Fake topology: each test thread says which node it runs on
+thread_local unsigned t_node = 0;
+
+auto fakeNode() -> unsigned { return t_node; }
+
+std::mutex g_mutex;
+std::vector<std::string> g_messages;
+
+void recordMessage(const char* message) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_messages.emplace_back(message);
+}
+
+} // namespace
+
+class NumaTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        t_node = 0;
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_messages.clear();
+    }
+
+    void TearDown() override { resource_tools::setDiagnosticCallback(nullptr); }
+
+    static auto fakeTopology(size_t nodes) -> NumaTopology { return {nodes, &fakeNode, false}; }
+
+    static auto sameBytes(const resource_tools::ResourceResult& a, const resource_tools::ResourceResult& b) -> bool {
+        return a && b && a.size == b.size && std::memcmp(a.data, b.data, a.size) == 0;
+    }
+};
+
+// ============================================================================
+// TOPOLOGY
+// ============================================================================
+
+TEST_F(NumaTest, SystemTopologyHasAtLeastOneNode) {
+    auto topology = resource_tools::systemNumaTopology();
+
+    EXPECT_GE(topology.node_count, 1u);
+#if defined(__linux__)
+    ASSERT_NE(topology.current_node, nullptr);
+    EXPECT_LT(topology.current_node(), topology.node_count);
+#endif
+}
+
+TEST_F(NumaTest, SingleNodeReadsSource) {
+    auto source = test_resources::getBinaryDataBIN();
+    ReplicatedResource resource(source, fakeTopology(1));
+
+    EXPECT_EQ(resource.get().data, source.data);
+    EXPECT_EQ(resource.replica_count(), 0u);
+}
+
+// ============================================================================
+// REPLICAS
+// ============================================================================
+
+#if defined(__linux__)
+
+TEST_F(NumaTest, ReplicaIsMadeOnFirstUsePerNode) {
+    auto source = test_resources::getBinaryDataBIN();
+    ReplicatedResource resource(source, fakeTopology(4));
+    EXPECT_EQ(resource.replica_count(), 0u);
+
+    t_node = 2;
+    auto on_two = resource.get();
+    EXPECT_NE(on_two.data, source.data);
+    EXPECT_TRUE(sameBytes(on_two, source));
+    EXPECT_EQ(resource.replica_count(), 1u);
+    EXPECT_EQ(resource.get().data, on_two.data);
+
+    t_node = 0;
+    auto on_zero = resource.get();
+    EXPECT_NE(on_zero.data, on_two.data);
+    EXPECT_TRUE(sameBytes(on_zero, source));
+    EXPECT_EQ(resource.replica_count(), 2u);
+}
+
+TEST_F(NumaTest, ThreadsOnDifferentNodesReadDifferentReplicas) {
+    auto source = test_resources::getBinaryDataBIN();
+    ReplicatedResource resource(source, fakeTopology(4));
+    std::vector<const uint8_t*> seen(4);
+
+    std::vector<std::thread> threads;
+    for (unsigned node = 0; node < 4; ++node) {
+        threads.emplace_back([&, node] {
+            t_node = node;
+            seen[node] = resource.get().data;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(std::set<const uint8_t*>(seen.begin(), seen.end()).size(), 4u);
+    EXPECT_EQ(resource.replica_count(), 4u);
+    for (unsigned node = 0; node < 4; ++node) {
+        EXPECT_TRUE(sameBytes(resource.get(node), source));
+    }
+}
+
+TEST_F(NumaTest, ConcurrentFirstUseMakesOneReplica) {
+    ReplicatedResource resource(test_resources::getBinaryDataBIN(), fakeTopology(2));
+    std::atomic<bool> go{false};
+    std::vector<const uint8_t*> seen(8);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < seen.size(); ++i) {
+        threads.emplace_back([&, i] {
+            t_node = 1;
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            seen[i] = resource.get().data;
+        });
+    }
+    go = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(std::set<const uint8_t*>(seen.begin(), seen.end()).size(), 1u);
+    EXPECT_EQ(resource.replica_count(), 1u);
+}
+
+TEST_F(NumaTest, ReplicasAreReadOnly) {
+    ReplicatedResource resource(test_resources::getBinaryDataBIN(), fakeTopology(2));
+    auto replica = resource.get(1);
+
+    EXPECT_DEATH(const_cast<uint8_t*>(replica.data)[0] = 0, "");
+}
+
+TEST_F(NumaTest, BindingToMissingNodeFallsBackToFirstTouch) {
+    resource_tools::setDiagnosticCallback(recordMessage);
+    auto source = test_resources::getBinaryDataBIN();
+    // Node 0 exists everywhere; a node past the last one does not
+    const auto missing = static_cast<unsigned>(resource_tools::systemNumaTopology().node_count);
+    ReplicatedResource resource(source, {missing + 1, &fakeNode, true});
+
+    EXPECT_TRUE(sameBytes(resource.get(0), source));
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        EXPECT_TRUE(g_messages.empty());
+    }
+
+    EXPECT_TRUE(sameBytes(resource.get(missing), source));
+    EXPECT_NE(resource.get(missing).data, source.data);
+    std::lock_guard<std::mutex> lock(g_mutex);
+    ASSERT_EQ(g_messages.size(), 1u);
+    EXPECT_NE(g_messages[0].find("mbind failed"), std::string::npos);
+}
+
+#endif // __linux__
+
+// ============================================================================
+// EDGE CASES
+// ============================================================================
+
+TEST_F(NumaTest, NodeOutsideTopologyReadsSource) {
+    auto source = test_resources::getBinaryDataBIN();
+    ReplicatedResource resource(source, fakeTopology(2));
+
+    t_node = 7;
+    EXPECT_EQ(resource.get().data, source.data);
+    EXPECT_EQ(resource.replica_count(), 0u);
+}
+
+TEST_F(NumaTest, FailedResourceKeepsItsError) {
+    ReplicatedResource resource(resource_tools::ResourceResult{nullptr, 0, ResourceError::NotFound}, fakeTopology(2));
+
+    EXPECT_EQ(resource.get().error, ResourceError::NotFound);
+    EXPECT_EQ(resource.replica_count(), 0u);
+}
+
+TEST_F(NumaTest, GeneratedLocalAccessorMatchesResource) {
+    auto local = test_resources::getTestFileTXTLocal();
+
+    EXPECT_TRUE(sameBytes(local, test_resources::getTestFileTXT()));
+    EXPECT_EQ(test_resources::getTestFileTXTLocal().data, local.data);
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/preload.h>
+#include <resource_tools/resource_registry.h>
+#include <dedup_resources/embedded_data.h>
+#include <sparse_resources/embedded_data.h>
+#include <test_resources/embedded_data.h>
+#include <tiered_resources/embedded_data.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using resource_tools::PreloadPool;
+using resource_tools::PreloadPriority;
+using resource_tools::ResourceEntry;
+
+namespace {
+
+std::mutex g_mutex;
+std::vector<std::string> g_messages;
+std::vector<std::string> g_order;
+std::atomic<bool> g_blocked{false};
+std::atomic<bool> g_release{false};
+
+void recordMessage(const char* message) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_messages.emplace_back(message);
+}
+
+// Test accessors; each records that it ran
+auto recorded(const char* name) -> resource_tools::ResourceResult {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_order.emplace_back(name);
+    static const uint8_t byte = 1;
+    return {&byte, 1, resource_tools::ResourceError::Success};
+}
+
+auto getBlocker() -> resource_tools::ResourceResult {
+    g_blocked = true;
+    while (!g_release.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return recorded("blocker");
+}
+
+auto getHigh() -> resource_tools::ResourceResult { return recorded("high"); }
+auto getLow() -> resource_tools::ResourceResult { return recorded("low"); }
+
+auto getMissing() -> resource_tools::ResourceResult {
+    return {nullptr, 0, resource_tools::ResourceError::NotFound};
+}
+
+} // namespace
+
+class PreloadTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_messages.clear();
+        g_order.clear();
+        g_blocked = false;
+        g_release = false;
+    }
+
+    void TearDown() override {
+        g_release = true;
+        resource_tools::setDiagnosticCallback(nullptr);
+    }
+};
+
+// ============================================================================
+// REGISTRY
+// ============================================================================
+
+TEST_F(PreloadTest, GeneratedListCoversNamespace) {
+    auto entries = test_resources::allResources();
+
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_STREQ(entries[0].ns, "test_resources");
+    EXPECT_STREQ(entries[0].name, "test_file.txt");
+    EXPECT_EQ(entries[0].get().data, test_resources::getTestFileTXT().data);
+    EXPECT_STREQ(entries[1].name, "binary_data.bin");
+}
+
+TEST_F(PreloadTest, IncludedNamespacesAreRegistered) {
+    const ResourceEntry* entry = resource_tools::findResource("tiered_resources", "tier_cold.json");
+
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->get().data, tiered_resources::getTierColdJSON().data);
+    EXPECT_EQ(resource_tools::findResource("tiered_resources", "missing.json"), nullptr);
+    EXPECT_GE(resource_tools::registeredResources().size(), dedup_resources::allResources().size());
+}
+
+// ============================================================================
+// PRELOADING
+// ============================================================================
+
+TEST_F(PreloadTest, PreloadDecodesResources) {
+    auto handle = resource_tools::preload(dedup_resources::allResources());
+
+    handle.wait();
+
+    EXPECT_TRUE(handle.done());
+    EXPECT_EQ(handle.total(), dedup_resources::allResources().size());
+    EXPECT_EQ(handle.loaded(), handle.total());
+    EXPECT_EQ(handle.failed(), 0u);
+}
+
+TEST_F(PreloadTest, WarmUpTimesGoToDiagnosticCallback) {
+    resource_tools::setDiagnosticCallback(recordMessage);
+
+    resource_tools::preload(sparse_resources::allResources()).wait();
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    ASSERT_EQ(g_messages.size(), 1u);
+    EXPECT_EQ(g_messages[0].rfind("resource_tools: preloaded sparse_resources/sparse_table.bin (65536 bytes) in ", 0),
+              0u);
+    EXPECT_EQ(g_messages[0].substr(g_messages[0].size() - 3), " us");
+}
+
+TEST_F(PreloadTest, FailuresAreCounted) {
+    static const ResourceEntry entries[] = {{"test", "missing", &getMissing}, {"test", "present", &getHigh}};
+    resource_tools::setDiagnosticCallback(recordMessage);
+
+    auto handle = resource_tools::preload(entries);
+    handle.wait();
+
+    EXPECT_EQ(handle.loaded(), 1u);
+    EXPECT_EQ(handle.failed(), 1u);
+    std::lock_guard<std::mutex> lock(g_mutex);
+    EXPECT_NE(std::find(g_messages.begin(), g_messages.end(), "resource_tools: failed to preload test/missing"),
+              g_messages.end());
+}
+
+TEST_F(PreloadTest, EmptyPreloadIsDone) {
+    auto handle = resource_tools::preload({});
+
+    EXPECT_TRUE(handle.done());
+    EXPECT_TRUE(PreloadPool::global().submit({}).wait_for(std::chrono::seconds(0)));
+}
+
+// ============================================================================
+// SCHEDULING
+// ============================================================================
+
+TEST_F(PreloadTest, HigherPriorityRunsFirst) {
+    static const ResourceEntry blocker[] = {{"test", "blocker", &getBlocker}};
+    static const ResourceEntry low[] = {{"test", "low", &getLow}, {"test", "low", &getLow}};
+    static const ResourceEntry high[] = {{"test", "high", &getHigh}, {"test", "high", &getHigh}};
+    PreloadPool pool(1);
+
+    auto first = pool.submit(blocker);
+    while (!g_blocked) {
+        std::this_thread::yield();
+    }
+    // The only worker is busy, so both batches queue up behind it
+    auto background = pool.submit(low, PreloadPriority::Low);
+    auto urgent = pool.submit(high, PreloadPriority::High);
+    EXPECT_FALSE(urgent.wait_for(std::chrono::milliseconds(10)));
+    g_release = true;
+    first.wait();
+    background.wait();
+    urgent.wait();
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    EXPECT_EQ(g_order, (std::vector<std::string>{"blocker", "high", "high", "low", "low"}));
+}
+
+TEST_F(PreloadTest, IdleWorkersStealQueuedWork) {
+    static const ResourceEntry blocker[] = {{"test", "blocker", &getBlocker}};
+    static const ResourceEntry work[] = {{"test", "high", &getHigh}, {"test", "high", &getHigh},
+                                         {"test", "high", &getHigh}, {"test", "high", &getHigh}};
+    PreloadPool pool(2);
+
+    // One worker is stuck on the blocker; the other must take every task,
+    // including the ones dealt onto the blocked worker's queue
+    auto stuck = pool.submit(blocker);
+    auto handle = pool.submit(work);
+
+    EXPECT_TRUE(handle.wait_for(std::chrono::seconds(10)));
+    EXPECT_FALSE(stuck.done());
+    g_release = true;
+    stuck.wait();
+}
+
+#if defined(__linux__)
+TEST_F(PreloadTest, PreloadAllLeavesNoThreadsBehind) {
+    auto threadCount = [] {
+        auto tasks = std::filesystem::directory_iterator("/proc/self/task");
+        return std::distance(std::filesystem::begin(tasks), std::filesystem::end(tasks));
+    };
+    PreloadPool::global();  // Make sure the shared pool already exists
+    const auto before = threadCount();
+
+    auto handle = resource_tools::preloadAllAndWait();
+
+    EXPECT_TRUE(handle.done());
+    EXPECT_EQ(handle.total(), resource_tools::registeredResources().size());
+    EXPECT_EQ(handle.failed(), 0u);
+    EXPECT_EQ(threadCount(), before);
+}
+#endif
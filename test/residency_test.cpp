@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/memory_advice.h>
+#include <resource_tools/residency.h>
+#include <sparse_resources/embedded_data.h>
+#include <test_resources/embedded_data.h>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+
+using resource_tools::ResourceError;
+
+class ResidencyTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    static constexpr size_t kPages = 16;
+
+    static auto pageSize() -> size_t { return static_cast<size_t>(sysconf(_SC_PAGESIZE)); }
+
+    static auto findInReport(const resource_tools::ResidencyReport& report, const std::string& ns,
+                             const std::string& name) -> const resource_tools::ResourceResidency* {
+        for (const auto& item : report.resources) {
+            if (item.entry.ns == ns && item.entry.name == name) {
+                return &item;
+            }
+        }
+        return nullptr;
+    }
+};
+
+// ============================================================================
+// SINGLE RESOURCES
+// ============================================================================
+
+TEST_F(ResidencyTest, UntouchedMemoryIsNotResident) {
+    const size_t size = kPages * pageSize();
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(memory, MAP_FAILED);
+    resource_tools::ResourceResult resource{static_cast<const uint8_t*>(memory), size, ResourceError::Success};
+
+    auto before = resource_tools::residency(resource);
+    ASSERT_TRUE(before);
+    EXPECT_EQ(before.resident_bytes, 0u);
+    EXPECT_EQ(before.size, size);
+
+    std::memset(memory, 1, size / 2);
+    auto after = resource_tools::residency(resource);
+    EXPECT_EQ(after.resident_bytes, size / 2);
+    EXPECT_DOUBLE_EQ(after.fraction(), 0.5);
+
+    munmap(memory, size);
+}
+
+TEST_F(ResidencyTest, PartialPagesCountOnlyTheResource) {
+    const size_t size = kPages * pageSize();
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(memory, MAP_FAILED);
+    std::memset(memory, 1, size);
+
+    // Starts 100 bytes into the first page and ends 100 bytes into the last
+    resource_tools::ResourceResult resource{static_cast<const uint8_t*>(memory) + 100, size - pageSize(),
+                                            ResourceError::Success};
+    auto measured = resource_tools::residency(resource);
+
+    EXPECT_EQ(measured.resident_bytes, resource.size);
+    EXPECT_DOUBLE_EQ(measured.fraction(), 1.0);
+    munmap(memory, size);
+}
+
+TEST_F(ResidencyTest, DecodedCopyIsResident) {
+    auto copy = sparse_resources::getSparseTableBINDecoded(std::pmr::new_delete_resource());
+    ASSERT_TRUE(copy.get());
+
+    auto measured = resource_tools::residency(copy.get());
+
+    EXPECT_TRUE(measured);
+    EXPECT_EQ(measured.size, copy.get().size);
+    EXPECT_GT(measured.resident_bytes, 0u);
+}
+
+TEST_F(ResidencyTest, WillNeedMakesResourceResident) {
+    auto resource = test_resources::getBinaryDataBIN();
+    ASSERT_EQ(resource_tools::advise(resource, resource_tools::Advice::WillNeed), ResourceError::Success);
+
+    auto measured = resource_tools::residency(resource);
+
+    EXPECT_EQ(measured.resident_bytes, resource.size);
+}
+
+TEST_F(ResidencyTest, UnmappedMemoryReportsSystemError) {
+    const size_t size = kPages * pageSize();
+    void* memory = mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(memory, MAP_FAILED);
+    munmap(memory, size);
+    resource_tools::ResourceResult resource{static_cast<const uint8_t*>(memory), size, ResourceError::Success};
+
+    EXPECT_EQ(resource_tools::residency(resource).error, ResourceError::SystemError);
+}
+
+TEST_F(ResidencyTest, FailedResourceKeepsItsError) {
+    auto measured = resource_tools::residency(resource_tools::ResourceResult{nullptr, 0, ResourceError::NotFound});
+
+    EXPECT_FALSE(measured);
+    EXPECT_EQ(measured.error, ResourceError::NotFound);
+}
+
+// ============================================================================
+// PROCESS-WIDE REPORT
+// ============================================================================
+
+TEST_F(ResidencyTest, ReportListsEveryRegisteredResource) {
+    auto report = resource_tools::residencyReport();
+
+    EXPECT_EQ(report.resources.size(), resource_tools::registeredResources().size());
+    const auto* binary = findInReport(report, "test_resources", "binary_data.bin");
+    ASSERT_NE(binary, nullptr);
+    EXPECT_TRUE(binary->residency);
+    EXPECT_EQ(binary->residency.size, test_resources::getBinaryDataBIN().size);
+    EXPECT_LE(report.resident_bytes, report.size);
+}
+
+TEST_F(ResidencyTest, ReportMeasuresEmbeddedBytesOfPackedResources) {
+    auto report = resource_tools::residencyReport();
+
+    const auto* sparse = findInReport(report, "sparse_resources", "sparse_table.bin");
+    ASSERT_NE(sparse, nullptr);
+    EXPECT_EQ(sparse->residency.size, sparse_resources::getSparseTableBINPacked().size);
+}
+
+TEST_F(ResidencyTest, ReportIsSortedByResidentBytes) {
+    auto report = resource_tools::residencyReport();
+
+    for (size_t i = 1; i < report.resources.size(); ++i) {
+        EXPECT_GE(report.resources[i - 1].residency.resident_bytes, report.resources[i].residency.resident_bytes);
+    }
+}
+
+TEST_F(ResidencyTest, FormattedReportHasOneLinePerResourceAndTotal) {
+    auto report = resource_tools::residencyReport();
+    const std::string text = resource_tools::formatResidencyReport(report);
+
+    EXPECT_NE(text.find("test_resources/binary_data.bin"), std::string::npos);
+    EXPECT_NE(text.find("total ("), std::string::npos);
+    size_t lines = 0;
+    for (char c : text) {
+        lines += c == '\n' ? 1 : 0;
+    }
+    EXPECT_EQ(lines, report.resources.size() + 1);
+}
+
+#endif // __linux__
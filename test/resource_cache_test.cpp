@@ -0,0 +1,334 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+#include <resource_tools/resource_cache.h>
+#include <dedup_resources/embedded_data.h>
+#include <sparse_edge_case_resources/embedded_data.h>
+#include <sparse_resources/embedded_data.h>
+#include "test_data.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using resource_tools::ResourceCache;
+using resource_tools::ResourceResult;
+using test_data::readDataFile;
+
+class ResourceCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    // Sparse container of `size` bytes whose first 16 bytes are `fill`
+    static auto makeResource(size_t size, uint8_t fill) -> std::vector<uint8_t> {
+        std::vector<uint8_t> payload(8 + 16 + 16, fill);
+        resource_tools::packed::store_le64(payload.data(), 1);
+        resource_tools::packed::store_le64(payload.data() + 8, 0);
+        resource_tools::packed::store_le64(payload.data() + 16, 16);
+
+        std::vector<uint8_t> out(resource_tools::packed::kHeaderSize);
+        resource_tools::packed::Header header;
+        header.encoding = resource_tools::packed::Encoding::Sparse;
+        header.size = size;
+        header.payload_size = payload.size();
+        resource_tools::packed::writeHeader(out.data(), header);
+        out.insert(out.end(), payload.begin(), payload.end());
+        return out;
+    }
+
+    static auto asResult(const std::vector<uint8_t>& bytes) -> ResourceResult {
+        return {bytes.data(), bytes.size(), resource_tools::ResourceError::Success};
+    }
+};
+
+// ============================================================================
+// LOOKUP
+// ============================================================================
+
+TEST_F(ResourceCacheTest, DecodesOnMissAndHitsAfterwards) {
+    ResourceCache cache(1024 * 1024);
+    auto a = makeResource(1000, 7);
+
+    auto first = cache.get(asResult(a));
+    auto second = cache.get(asResult(a));
+
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_EQ(first.get().data, second.get().data);
+    EXPECT_EQ(first.get().size, 1000u);
+    EXPECT_EQ(first.get().data[15], 7);
+    EXPECT_EQ(first.get().data[16], 0);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.bytes, 1000u);
+    EXPECT_EQ(stats.entries, 1u);
+}
+
+TEST_F(ResourceCacheTest, StoredResourceIsReturnedInPlace) {
+    ResourceCache cache(1024 * 1024);
+    auto packed = sparse_edge_case_resources::getTestFileWithSpacesTXTPacked();
+
+    auto handle = cache.get(packed);
+
+    ASSERT_TRUE(handle);
+    EXPECT_EQ(handle.get().data, packed.data + resource_tools::packed::kHeaderSize);
+    EXPECT_EQ(cache.stats().bytes, 0u);
+}
+
+TEST_F(ResourceCacheTest, CorruptResourceReportsError) {
+    ResourceCache cache(1024 * 1024);
+    auto a = makeResource(8, 1);  // Segment is longer than the resource
+
+    auto handle = cache.get(asResult(a));
+
+    EXPECT_FALSE(handle);
+    EXPECT_EQ(handle.error(), resource_tools::ResourceError::CorruptData);
+    EXPECT_EQ(handle.get().data, nullptr);
+    EXPECT_EQ(cache.stats().entries, 0u);
+}
+
+TEST_F(ResourceCacheTest, DefaultHandleIsEmpty) {
+    resource_tools::ResourceHandle handle;
+
+    EXPECT_FALSE(handle);
+    EXPECT_EQ(handle.get().data, nullptr);
+}
+
+// ============================================================================
+// EVICTION
+// ============================================================================
+
+TEST_F(ResourceCacheTest, EvictsLeastRecentlyUsed) {
+    ResourceCache cache(2500, 1);
+    auto a = makeResource(1000, 1);
+    auto b = makeResource(1000, 2);
+    auto c = makeResource(1000, 3);
+
+    cache.get(asResult(a));
+    cache.get(asResult(b));
+    cache.get(asResult(a));  // b is now least recently used
+    cache.get(asResult(c));
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.bytes, 2000u);
+
+    cache.get(asResult(a));
+    EXPECT_EQ(cache.stats().hits, stats.hits + 1);
+    cache.get(asResult(b));
+    EXPECT_EQ(cache.stats().misses, stats.misses + 1);
+}
+
+TEST_F(ResourceCacheTest, BudgetHoldsAcrossShards) {
+    ResourceCache cache(10000, 8);
+    std::vector<std::vector<uint8_t>> resources;
+    for (int i = 0; i < 40; ++i) {
+        resources.push_back(makeResource(1000, static_cast<uint8_t>(i)));
+    }
+
+    for (const auto& r : resources) {
+        ASSERT_TRUE(cache.get(asResult(r)));
+        EXPECT_LE(cache.stats().bytes, 10000u);
+    }
+    EXPECT_EQ(cache.stats().evictions, 30u);
+}
+
+TEST_F(ResourceCacheTest, HandleOutlivesEviction) {
+    ResourceCache cache(1024 * 1024);
+    auto a = makeResource(4096, 0x5A);
+
+    auto handle = cache.get(asResult(a));
+    ASSERT_TRUE(handle);
+    cache.clear();
+
+    EXPECT_EQ(cache.stats().bytes, 0u);
+    EXPECT_EQ(handle.get().size, 4096u);
+    EXPECT_EQ(handle.get().data[0], 0x5A);
+    EXPECT_EQ(handle.get().data[4095], 0);
+}
+
+TEST_F(ResourceCacheTest, OversizedResourceIsNotCached) {
+    ResourceCache cache(500);
+    auto a = makeResource(1000, 9);
+
+    auto handle = cache.get(asResult(a));
+
+    ASSERT_TRUE(handle);
+    EXPECT_EQ(handle.get().data[0], 9);
+    EXPECT_EQ(cache.stats().bytes, 0u);
+    EXPECT_EQ(cache.stats().evictions, 0u);
+}
+
+TEST_F(ResourceCacheTest, ShrinkingBudgetEvicts) {
+    ResourceCache cache(1024 * 1024);
+    auto a = makeResource(1000, 1);
+    auto b = makeResource(1000, 2);
+    cache.get(asResult(a));
+    cache.get(asResult(b));
+
+    cache.set_budget(1000);
+
+    EXPECT_EQ(cache.budget(), 1000u);
+    EXPECT_LE(cache.stats().bytes, 1000u);
+    EXPECT_EQ(cache.stats().evictions, 1u);
+}
+
+// ============================================================================
+// GENERATED ACCESSORS
+// ============================================================================
+
+TEST_F(ResourceCacheTest, CachedAccessorMatchesFile) {
+    auto handle = dedup_resources::getBundleEnJSONCached();
+
+    ASSERT_TRUE(handle);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(handle.get().data), handle.get().size),
+              readDataFile("bundle_en.json"));
+}
+
+TEST_F(ResourceCacheTest, CachedAccessorUsesGlobalCache) {
+    auto before = ResourceCache::global().stats();
+
+    auto first = sparse_resources::getSparseTableBINCached();
+    auto second = sparse_resources::getSparseTableBINCached();
+
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first.get().data, second.get().data);
+    EXPECT_GE(ResourceCache::global().stats().hits, before.hits + 1);
+}
+
+// ============================================================================
+// CONCURRENCY
+// ============================================================================
+
+TEST_F(ResourceCacheTest, ConcurrentReadsDifferentResources) {
+    constexpr int num_threads = 16;
+    constexpr int num_resources = 256;
+    constexpr int reads_per_thread = 500;
+    constexpr size_t resource_size = 16 * 1024;
+
+    // Room for a quarter of the working set, so threads evict each other
+    ResourceCache cache(resource_size * num_resources / 4);
+    std::vector<std::vector<uint8_t>> resources;
+    for (int i = 0; i < num_resources; ++i) {
+        resources.push_back(makeResource(resource_size, static_cast<uint8_t>(i)));
+    }
+
+    std::atomic<int> total_success{0};
+    std::atomic<int> corrupt{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            uint32_t state = static_cast<uint32_t>(t) * 2654435761u + 1;
+            for (int j = 0; j < reads_per_thread; ++j) {
+                state = state * 1664525u + 1013904223u;
+                // Skewed access: most reads hit a small hot set
+                const int index = (state >> 24) < 200 ? static_cast<int>((state >> 8) % 32)
+                                                      : static_cast<int>((state >> 8) % num_resources);
+                auto handle = cache.get(asResult(resources[index]));
+                if (!handle) {
+                    continue;
+                }
+                const auto result = handle.get();
+                if (result.size != resource_size || result.data[0] != static_cast<uint8_t>(index) ||
+                    result.data[resource_size - 1] != 0) {
+                    corrupt++;
+                }
+                total_success++;
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(total_success, num_threads * reads_per_thread);
+    EXPECT_EQ(corrupt, 0);
+
+    auto stats = cache.stats();
+    EXPECT_LE(stats.bytes, cache.budget());
+    EXPECT_GT(stats.evictions, 0u);
+    EXPECT_GT(stats.hits, stats.misses);
+}
+
+TEST_F(ResourceCacheTest, ConcurrentMissesDecodeOnce) {
+    constexpr int num_threads = 32;
+    ResourceCache cache(1024 * 1024);
+    auto a = makeResource(64 * 1024, 0x33);
+
+    std::atomic<int> ready{0};
+    std::vector<const uint8_t*> data(num_threads, nullptr);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            ready++;
+            while (ready.load() < num_threads) {
+                std::this_thread::yield();
+            }
+            auto handle = cache.get(asResult(a));
+            if (handle) {
+                data[t] = handle.get().data;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, static_cast<uint64_t>(num_threads - 1));
+    EXPECT_EQ(stats.entries, 1u);
+    for (int t = 0; t < num_threads; ++t) {
+        EXPECT_EQ(data[t], data[0]);
+    }
+    EXPECT_NE(data[0], nullptr);
+}
+
+TEST_F(ResourceCacheTest, ClearDuringReadsKeepsAccounting) {
+    constexpr int num_threads = 8;
+    constexpr int num_resources = 32;
+    constexpr size_t resource_size = 4096;
+    ResourceCache cache(resource_size * num_resources);
+    std::vector<std::vector<uint8_t>> resources;
+    for (int i = 0; i < num_resources; ++i) {
+        resources.push_back(makeResource(resource_size, static_cast<uint8_t>(i)));
+    }
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int j = 0; j < 2000; ++j) {
+                auto handle = cache.get(asResult(resources[(t * 7 + j) % num_resources]));
+                EXPECT_TRUE(handle);
+            }
+        });
+    }
+    std::thread clearer([&]() {
+        while (!done.load()) {
+            cache.clear();
+            std::this_thread::yield();
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    clearer.join();
+
+    EXPECT_EQ(cache.budget(), resource_size * num_resources);
+    cache.clear();
+    EXPECT_EQ(cache.stats().bytes, 0u);
+    EXPECT_EQ(cache.stats().entries, 0u);
+
+    // A drifted byte count would evict some of these
+    for (const auto& resource : resources) {
+        ASSERT_TRUE(cache.get(asResult(resource)));
+    }
+    EXPECT_EQ(cache.stats().entries, static_cast<size_t>(num_resources));
+}
@@ -0,0 +1,277 @@
+#include <gtest/gtest.h>
+#include <resource_tools/content_hash.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+#include <resource_tools/shared_cache.h>
+#include <dedup_resources/embedded_data.h>
+#include <sparse_resources/embedded_data.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if RESOURCE_TOOLS_HAS_SHARED_CACHE
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using resource_tools::SharedCache;
+
+class SharedCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        directory_ = ::testing::TempDir() + "resource_tools_shared_" + std::to_string(getpid()) + "_" + info->name();
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override {
+        // Segments are read-only once complete, which remove_all handles
+        std::filesystem::remove_all(directory_);
+    }
+
+    static auto sameBytes(const resource_tools::ResourceResult& a, const resource_tools::ResourceResult& b) -> bool {
+        return a && b && a.size == b.size && std::memcmp(a.data, b.data, a.size) == 0;
+    }
+
+    std::string directory_;
+};
+
+// ============================================================================
+// SHARING
+// ============================================================================
+
+TEST_F(SharedCacheTest, FirstUserCreatesLaterUsersAttach) {
+    SharedCache first(directory_);
+    SharedCache second(directory_);
+
+    auto created = first.get(sparse_resources::getSparseTableBINPacked());
+    auto attached = second.get(sparse_resources::getSparseTableBINPacked());
+    auto hit = first.get(sparse_resources::getSparseTableBINPacked());
+
+    ASSERT_TRUE(created);
+    EXPECT_TRUE(sameBytes(created.get(), sparse_resources::getSparseTableBIN()));
+    EXPECT_TRUE(sameBytes(attached.get(), sparse_resources::getSparseTableBIN()));
+    EXPECT_EQ(hit.get().data, created.get().data);
+    EXPECT_EQ(first.stats().created, 1u);
+    EXPECT_EQ(first.stats().hits, 1u);
+    EXPECT_EQ(second.stats().attached, 1u);
+    EXPECT_EQ(second.stats().created, 0u);
+}
+
+TEST_F(SharedCacheTest, SegmentIsNamedByThePackerKey) {
+    SharedCache cache(directory_);
+    auto packed = dedup_resources::getBundleFrJSONPacked();
+    auto chunks = dedup_resources::getDedupTestChunksBINPacked();
+
+    auto handle = cache.get(packed, chunks);
+
+    ASSERT_TRUE(handle);
+    EXPECT_TRUE(sameBytes(handle.get(), dedup_resources::getBundleFrJSON()));
+
+    // The key identifies the decoded bytes, so it matches the packer's own hash of them
+    const auto digest = resource_tools::sha256(handle.get().data, handle.get().size);
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx",
+                  static_cast<unsigned long long>(resource_tools::packed::load_le64(digest.data())));
+    EXPECT_EQ(cache.segment_path(packed),
+              directory_ + "/resource_tools-" + key + "-" + std::to_string(handle.get().size));
+    EXPECT_TRUE(std::filesystem::exists(cache.segment_path(packed)));
+}
+
+TEST_F(SharedCacheTest, ConcurrentFirstUseMapsOnce) {
+    constexpr int num_threads = 16;
+    SharedCache cache(directory_);
+    std::vector<const uint8_t*> data(num_threads, nullptr);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            auto handle = cache.get(sparse_resources::getSparseTableBINPacked());
+            data[t] = handle.get().data;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(cache.stats().created, 1u);
+    EXPECT_EQ(cache.stats().hits, static_cast<uint64_t>(num_threads - 1));
+    for (int t = 0; t < num_threads; ++t) {
+        EXPECT_EQ(data[t], data[0]);
+    }
+}
+
+TEST_F(SharedCacheTest, CompleteSegmentIsReadOnly) {
+    SharedCache cache(directory_);
+    auto packed = sparse_resources::getSparseTableBINPacked();
+    ASSERT_TRUE(cache.get(packed));
+
+    struct stat st {};
+    ASSERT_EQ(stat(cache.segment_path(packed).c_str(), &st), 0);
+    EXPECT_EQ(st.st_mode & 0777, 0400u);
+    EXPECT_EQ(static_cast<size_t>(st.st_size), 65536u + resource_tools::detail::kSegmentTrailerSize);
+}
+
+TEST_F(SharedCacheTest, ForkedWorkersShareOneCopy) {
+    constexpr int num_workers = 4;
+    std::vector<pid_t> workers;
+
+    for (int i = 0; i < num_workers; ++i) {
+        pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {
+            SharedCache cache(directory_);
+            auto handle = cache.get(sparse_resources::getSparseTableBINPacked());
+            if (!sameBytes(handle.get(), sparse_resources::getSparseTableBIN())) {
+                _exit(3);
+            }
+            _exit(cache.stats().created == 1 ? 1 : cache.stats().attached == 1 ? 2 : 3);
+        }
+        workers.push_back(pid);
+    }
+
+    int created = 0;
+    int attached = 0;
+    for (pid_t pid : workers) {
+        int status = 0;
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+        ASSERT_TRUE(WIFEXITED(status));
+        created += WEXITSTATUS(status) == 1;
+        attached += WEXITSTATUS(status) == 2;
+    }
+    EXPECT_EQ(created, 1);
+    EXPECT_EQ(attached, num_workers - 1);
+}
+
+// ============================================================================
+// CLEANUP
+// ============================================================================
+
+TEST_F(SharedCacheTest, RemoveKeepsExistingMappings) {
+    SharedCache cache(directory_);
+    auto packed = sparse_resources::getSparseTableBINPacked();
+    auto handle = cache.get(packed);
+    ASSERT_TRUE(handle);
+
+    EXPECT_TRUE(cache.remove(packed));
+    EXPECT_FALSE(std::filesystem::exists(cache.segment_path(packed)));
+    EXPECT_FALSE(cache.remove(packed));
+    EXPECT_TRUE(sameBytes(handle.get(), sparse_resources::getSparseTableBIN()));
+
+    // A later process decodes it again
+    SharedCache later(directory_);
+    ASSERT_TRUE(later.get(packed));
+    EXPECT_EQ(later.stats().created, 1u);
+}
+
+TEST_F(SharedCacheTest, PurgeRemovesOnlySegments) {
+    SharedCache cache(directory_);
+    ASSERT_TRUE(cache.get(sparse_resources::getSparseTableBINPacked()));
+    ASSERT_TRUE(cache.get(dedup_resources::getBundleFrJSONPacked(), dedup_resources::getDedupTestChunksBINPacked()));
+    std::ofstream(directory_ + "/unrelated") << "keep";
+
+    EXPECT_EQ(cache.purge(), 2u);
+    EXPECT_EQ(cache.purge(), 0u);
+    EXPECT_TRUE(std::filesystem::exists(directory_ + "/unrelated"));
+}
+
+// ============================================================================
+// CRASH RECOVERY
+// ============================================================================
+
+TEST_F(SharedCacheTest, RedecodesSegmentAbandonedByDeadWriter) {
+    SharedCache cache(directory_);
+    auto packed = sparse_resources::getSparseTableBINPacked();
+    const std::string path = cache.segment_path(packed);
+
+    // A writer that locks the segment, writes half of it and dies
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        int fd = open(path.c_str(), O_RDWR | O_CREAT, 0600);
+        if (fd < 0 || flock(fd, LOCK_EX) != 0 || ftruncate(fd, 4096) != 0) {
+            _exit(1);
+        }
+        const char junk[] = "half-written";
+        _exit(write(fd, junk, sizeof(junk)) == static_cast<ssize_t>(sizeof(junk)) ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    auto handle = cache.get(packed);
+
+    ASSERT_TRUE(handle);
+    EXPECT_TRUE(sameBytes(handle.get(), sparse_resources::getSparseTableBIN()));
+    EXPECT_EQ(cache.stats().created, 1u);
+}
+
+// ============================================================================
+// FALLBACK
+// ============================================================================
+
+TEST_F(SharedCacheTest, MissingDirectoryFallsBackToPrivateCopy) {
+    SharedCache cache(directory_ + "/does/not/exist");
+
+    auto handle = cache.get(sparse_resources::getSparseTableBINPacked());
+
+    ASSERT_TRUE(handle);
+    EXPECT_TRUE(sameBytes(handle.get(), sparse_resources::getSparseTableBIN()));
+    EXPECT_EQ(cache.stats().fallbacks, 1u);
+}
+
+TEST_F(SharedCacheTest, EmptyDirectoryDisablesSharing) {
+    SharedCache cache("");
+
+    ASSERT_TRUE(cache.get(sparse_resources::getSparseTableBINPacked()));
+    EXPECT_EQ(cache.stats().fallbacks, 1u);
+    EXPECT_EQ(cache.stats().created, 0u);
+}
+
+TEST_F(SharedCacheTest, ContainerWithoutKeyIsDecodedPrivately) {
+    SharedCache cache(directory_);
+    auto packed = sparse_resources::getSparseTableBINPacked();
+    std::vector<uint8_t> unkeyed(packed.data, packed.data + packed.size);
+    resource_tools::packed::store_le64(unkeyed.data() + 24, 0);
+    const resource_tools::ResourceResult blob{unkeyed.data(), unkeyed.size(), resource_tools::ResourceError::Success};
+
+    auto handle = cache.get(blob);
+
+    ASSERT_TRUE(handle);
+    EXPECT_TRUE(sameBytes(handle.get(), sparse_resources::getSparseTableBIN()));
+    EXPECT_EQ(cache.segment_path(blob), "");
+    EXPECT_EQ(cache.stats().fallbacks, 1u);
+}
+
+TEST_F(SharedCacheTest, CorruptResourceReportsError) {
+    SharedCache cache(directory_);
+    auto packed = sparse_resources::getSparseTableBINPacked();
+    std::vector<uint8_t> truncated(packed.data, packed.data + packed.size - 1);
+
+    auto handle = cache.get({truncated.data(), truncated.size(), resource_tools::ResourceError::Success});
+
+    EXPECT_FALSE(handle);
+    EXPECT_EQ(handle.error(), resource_tools::ResourceError::CorruptData);
+}
+
+// ============================================================================
+// GENERATED ACCESSORS
+// ============================================================================
+
+TEST_F(SharedCacheTest, SharedAccessorMatchesDecodedResource) {
+    auto handle = dedup_resources::getBundleEnJSONShared();
+
+    ASSERT_TRUE(handle);
+    EXPECT_TRUE(sameBytes(handle.get(), dedup_resources::getBundleEnJSON()));
+
+    // The global cache uses the host-wide directory; do not leave the segment behind
+    SharedCache::global().remove(dedup_resources::getBundleEnJSONPacked());
+}
+
+#endif // RESOURCE_TOOLS_HAS_SHARED_CACHE
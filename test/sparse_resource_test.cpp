@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+#include <sparse_edge_case_resources/embedded_data.h>
+#include <sparse_resources/embedded_data.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+class SparseResourceTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    // Build a container in memory the same way the packer does
+    static auto makeContainer(resource_tools::packed::Encoding encoding, uint64_t size,
+                              const std::vector<uint8_t>& payload) -> std::vector<uint8_t> {
+        std::vector<uint8_t> out(resource_tools::packed::kHeaderSize);
+        resource_tools::packed::Header header;
+        header.encoding = encoding;
+        header.size = size;
+        header.payload_size = payload.size();
+        resource_tools::packed::writeHeader(out.data(), header);
+        out.insert(out.end(), payload.begin(), payload.end());
+        return out;
+    }
+
+    static auto asResult(const std::vector<uint8_t>& bytes) -> resource_tools::ResourceResult {
+        return {bytes.data(), bytes.size(), resource_tools::ResourceError::Success};
+    }
+};
+
+// ============================================================================
+// ALL-ZERO RESOURCES
+// ============================================================================
+
+TEST_F(SparseResourceTest, AllZeroResourceIsNotStoredInBinary) {
+    auto packed = sparse_edge_case_resources::getLargeFileBINPacked();
+
+    ASSERT_TRUE(packed);
+    // 5MB of zeros is stored as a header and an empty segment table
+    EXPECT_LT(packed.size, 64u);
+}
+
+TEST_F(SparseResourceTest, AllZeroResourceDecodesToZeros) {
+    auto result = sparse_edge_case_resources::getLargeFileBIN();
+
+    ASSERT_TRUE(result);
+    ASSERT_EQ(result.size, 5u * 1024u * 1024u);
+    EXPECT_TRUE(std::all_of(result.data, result.data + result.size, [](uint8_t b) { return b == 0; }));
+}
+
+TEST_F(SparseResourceTest, RepeatedAccessReturnsSameBuffer) {
+    auto first = sparse_edge_case_resources::getLargeFileBIN();
+    auto second = sparse_edge_case_resources::getLargeFileBIN();
+
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_EQ(first.data, second.data);
+}
+
+// ============================================================================
+// MOSTLY-ZERO RESOURCES
+// ============================================================================
+
+TEST_F(SparseResourceTest, MostlyZeroResourceIsSmallerThanOriginal) {
+    auto packed = sparse_resources::getSparseTableBINPacked();
+
+    ASSERT_TRUE(packed);
+    EXPECT_LT(packed.size, 1024u);
+
+    resource_tools::packed::Header header;
+    ASSERT_EQ(resource_tools::packed::readHeader(packed, header), resource_tools::ResourceError::Success);
+    EXPECT_EQ(header.encoding, resource_tools::packed::Encoding::Sparse);
+    EXPECT_EQ(header.size, 65536u);
+}
+
+TEST_F(SparseResourceTest, MostlyZeroResourceRoundTrips) {
+    auto result = sparse_resources::getSparseTableBIN();
+
+    ASSERT_TRUE(result);
+    ASSERT_EQ(result.size, 65536u);
+
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(result.data), 16), "SPARSE_TABLE_HDR");
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(result.data + 65528), 8), "TAILDATA");
+    for (int i = 0; i < 256; ++i) {
+        uint8_t expected = static_cast<uint8_t>((i * 7 + 1) & 0xff);
+        EXPECT_EQ(result.data[20000 + i], expected == 0 ? 1 : expected);
+    }
+    EXPECT_EQ(result.data[16], 0);
+    EXPECT_EQ(result.data[19999], 0);
+    EXPECT_EQ(result.data[20256], 0);
+    EXPECT_EQ(result.data[65527], 0);
+}
+
+// ============================================================================
+// STORED FALLBACK
+// ============================================================================
+
+TEST_F(SparseResourceTest, NonSparseResourceIsReturnedInPlace) {
+    auto packed = sparse_edge_case_resources::getTestFileWithSpacesTXTPacked();
+    auto result = sparse_edge_case_resources::getTestFileWithSpacesTXT();
+
+    ASSERT_TRUE(packed);
+    ASSERT_TRUE(result);
+    // Stored resources point straight into the embedded container
+    EXPECT_EQ(result.data, packed.data + resource_tools::packed::kHeaderSize);
+    EXPECT_EQ(result.size, packed.size - resource_tools::packed::kHeaderSize);
+}
+
+// ============================================================================
+// DECODER VALIDATION
+// ============================================================================
+
+TEST_F(SparseResourceTest, DecodeRejectsBadMagic) {
+    auto bytes = makeContainer(resource_tools::packed::Encoding::Stored, 4, {'a', 'b', 'c', 'd'});
+    bytes[0] = 'X';
+
+    resource_tools::PackedResource resource(asResult(bytes));
+    auto result = resource.get();
+
+    EXPECT_FALSE(result);
+    EXPECT_EQ(result.error, resource_tools::ResourceError::CorruptData);
+    EXPECT_EQ(result.data, nullptr);
+}
+
+TEST_F(SparseResourceTest, DecodeRejectsTruncatedContainer) {
+    auto bytes = makeContainer(resource_tools::packed::Encoding::Stored, 4, {'a', 'b', 'c', 'd'});
+    bytes.pop_back();
+
+    resource_tools::PackedResource resource(asResult(bytes));
+    EXPECT_EQ(resource.get().error, resource_tools::ResourceError::CorruptData);
+}
+
+TEST_F(SparseResourceTest, DecodeRejectsSegmentOutsideResource) {
+    std::vector<uint8_t> payload(8 + 16 + 4);
+    resource_tools::packed::store_le64(payload.data(), 1);
+    resource_tools::packed::store_le64(payload.data() + 8, 10);   // offset
+    resource_tools::packed::store_le64(payload.data() + 16, 4);   // length
+    auto bytes = makeContainer(resource_tools::packed::Encoding::Sparse, 12, payload);
+
+    resource_tools::PackedResource resource(asResult(bytes));
+    EXPECT_EQ(resource.get().error, resource_tools::ResourceError::CorruptData);
+}
+
+TEST_F(SparseResourceTest, DecodeIntoUnzeroedBuffer) {
+    std::vector<uint8_t> payload(8 + 16 + 2);
+    resource_tools::packed::store_le64(payload.data(), 1);
+    resource_tools::packed::store_le64(payload.data() + 8, 3);
+    resource_tools::packed::store_le64(payload.data() + 16, 2);
+    payload[24] = 'h';
+    payload[25] = 'i';
+    auto bytes = makeContainer(resource_tools::packed::Encoding::Sparse, 8, payload);
+
+    std::vector<uint8_t> out(8, 0xAA);
+    auto err = resource_tools::decodePacked(asResult(bytes), out.data(), out.size());
+
+    ASSERT_EQ(err, resource_tools::ResourceError::Success);
+    EXPECT_EQ(out, (std::vector<uint8_t>{0, 0, 0, 'h', 'i', 0, 0, 0}));
+}
+
+TEST_F(SparseResourceTest, DecodeRejectsSmallOutputBuffer) {
+    auto bytes = makeContainer(resource_tools::packed::Encoding::Stored, 4, {'a', 'b', 'c', 'd'});
+    uint8_t out[2];
+
+    auto err = resource_tools::decodePacked(asResult(bytes), out, sizeof(out));
+    EXPECT_EQ(err, resource_tools::ResourceError::InvalidSize);
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/string_table.h>
+#include <string_table_resources/embedded_data.h>
+#include "build_step_test.h"
+#include <cstring>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+using resource_tools::ResourceError;
+using resource_tools::StringTable;
+
+class StringTableTest : public BuildStepTest {
+protected:
+    // Compile a catalog the way the build does
+    auto compile(const std::string& catalog, const fs::path& output) const -> int {
+        return pack("string-table", catalog, output, "input.strings");
+    }
+};
+
+// ============================================================================
+// EMBEDDED CATALOGS
+// ============================================================================
+
+TEST_F(StringTableTest, LooksUpEveryKey) {
+    const StringTable& en = string_table_resources::getEnSTRINGSStrings();
+    ASSERT_TRUE(en);
+    EXPECT_EQ(en.size(), 9u);
+    EXPECT_EQ(en.get("menu.file"), "File");
+    EXPECT_EQ(en.get("menu.open"), "Open…");
+    EXPECT_EQ(en.get("status.progress"), "Copying %d of %d files");
+    EXPECT_EQ(en.get("shared.ok"), "OK");
+}
+
+TEST_F(StringTableTest, EscapesAreDecoded) {
+    const StringTable& en = string_table_resources::getEnSTRINGSStrings();
+    EXPECT_EQ(en.get("dialog.unsaved"), "You have unsaved changes.\nSave them before closing?");
+    EXPECT_EQ(en.get("status.tabbed"), "Name\tSize");
+    EXPECT_EQ(en.get("hint.escape"), "Use \\ to separate folders # not a comment");
+}
+
+TEST_F(StringTableTest, MissingKeys) {
+    const StringTable& en = string_table_resources::getEnSTRINGSStrings();
+    EXPECT_FALSE(en.find("menu.edit").has_value());
+    EXPECT_FALSE(en.contains(""));
+    EXPECT_FALSE(en.contains("menu.fil"));
+    EXPECT_FALSE(en.contains("menu.file "));
+    EXPECT_EQ(en.get("menu.edit", "Edit"), "Edit");
+}
+
+TEST_F(StringTableTest, TablesByLocale) {
+    const StringTable& fr = string_table_resources::stringTable("fr");
+    ASSERT_TRUE(fr);
+    EXPECT_EQ(&fr, &string_table_resources::getFrSTRINGSStrings());
+    EXPECT_EQ(fr.get("menu.save"), "Enregistrer");
+    EXPECT_EQ(string_table_resources::stringTable("ja").get("menu.open"), "開く…");
+
+    // Keys a locale lacks fall back to another table
+    const StringTable& en = string_table_resources::stringTable("en");
+    EXPECT_EQ(fr.get("status.tabbed", en.get("status.tabbed")), "Name\tSize");
+
+    const StringTable& missing = string_table_resources::stringTable("de");
+    EXPECT_EQ(missing.error(), ResourceError::NotFound);
+    EXPECT_FALSE(missing.contains("menu.file"));
+}
+
+TEST_F(StringTableTest, EntriesCoverEveryKeyOnce) {
+    const StringTable& fr = string_table_resources::getFrSTRINGSStrings();
+    std::set<std::string_view> keys;
+    for (size_t i = 0; i < fr.size(); ++i) {
+        keys.insert(fr.key(i));
+        EXPECT_EQ(fr.get(fr.key(i)), fr.value(i));
+    }
+    EXPECT_EQ(keys.size(), fr.size());
+    EXPECT_EQ(fr.key(fr.size()), "");
+}
+
+TEST_F(StringTableTest, StringsAreNulTerminated) {
+    const std::string_view ok = string_table_resources::getJaSTRINGSStrings().get("shared.ok");
+    EXPECT_EQ(std::strlen(ok.data()), ok.size());
+}
+
+// ============================================================================
+// BUILD STEP
+// ============================================================================
+
+TEST_F(StringTableTest, MalformedCatalogsFailTheBuild) {
+    const char* invalid[] = {
+        "a = 1\nb\n",             // No '='
+        "= orphan\n",             // No key
+        "a = 1\nb = 2\na = 3\n",  // Duplicate key
+        "a = bad \\q escape\n",   // Unknown escape
+    };
+    for (const char* catalog : invalid) {
+        const fs::path output = work_ / "out.bin";
+        EXPECT_NE(compile(catalog, output), 0) << catalog;
+        EXPECT_FALSE(fs::exists(output));
+    }
+}
+
+TEST_F(StringTableTest, EmptyCatalog) {
+    const fs::path output = work_ / "empty.bin";
+    ASSERT_EQ(compile("# nothing yet\n\n", output), 0);
+    const auto bytes = readFile(output);
+    StringTable table(view(bytes));
+    ASSERT_TRUE(table);
+    EXPECT_TRUE(table.empty());
+    EXPECT_FALSE(table.contains("anything"));
+}
+
+TEST_F(StringTableTest, CorruptTableIsRejected) {
+    const fs::path output = work_ / "table.bin";
+    ASSERT_EQ(compile("a = 1\nb = 2\n", output), 0);
+    auto bytes = readFile(output);
+    ASSERT_TRUE(StringTable(view(bytes)));
+
+    auto bad_magic = bytes;
+    bad_magic[0] ^= 0xFF;
+    EXPECT_EQ(StringTable(view(bad_magic)).error(), ResourceError::CorruptData);
+
+    // A count that does not match the index
+    auto bad_count = bytes;
+    bad_count[8] = 9;
+    EXPECT_EQ(StringTable(view(bad_count)).error(), ResourceError::CorruptData);
+
+    bytes.resize(bytes.size() - 1);
+    EXPECT_EQ(StringTable(view(bytes)).error(), ResourceError::CorruptData);
+}
+
+TEST_F(StringTableTest, LargeCatalogIsPerfectlyHashed) {
+    constexpr size_t kKeys = 20000;
+    std::string catalog;
+    for (size_t i = 0; i < kKeys; ++i) {
+        catalog += "message." + std::to_string(i) + " = Message number " + std::to_string(i) + "\n";
+    }
+    const fs::path output = work_ / "large.bin";
+    ASSERT_EQ(compile(catalog, output), 0);
+    const auto bytes = readFile(output);
+    StringTable table(view(bytes));
+    ASSERT_TRUE(table);
+    ASSERT_EQ(table.size(), kKeys);
+    for (size_t i = 0; i < kKeys; ++i) {
+        ASSERT_EQ(table.get("message." + std::to_string(i)), "Message number " + std::to_string(i));
+    }
+    EXPECT_FALSE(table.contains("message." + std::to_string(kKeys)));
+}
@@ -0,0 +1,26 @@
+#ifndef RESOURCE_TOOLS_TEST_DATA_H
+#define RESOURCE_TOOLS_TEST_DATA_H
+
+#include <resource_tools/embedded_resource.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+// Helpers shared by the tests that compare embedded resources with the
+// files under test/data
+namespace test_data {
+
+// Contents of `name`, relative to test/data
+inline auto readDataFile(const std::string& name) -> std::string {
+    std::ifstream in(std::string(RESOURCE_TOOLS_TEST_DATA_DIR) + "/" + name, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// The bytes of a resource, for comparing with readDataFile()
+inline auto asString(const resource_tools::ResourceResult& result) -> std::string {
+    return std::string(reinterpret_cast<const char*>(result.data), result.size);
+}
+
+} // namespace test_data
+
+#endif // RESOURCE_TOOLS_TEST_DATA_H
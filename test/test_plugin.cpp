@@ -0,0 +1,4 @@
+// Shared library loaded from memory by memfd_test.cpp
+extern "C" auto resource_tools_test_plugin_answer() -> int {
+    return 42;
+}
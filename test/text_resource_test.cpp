@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/text_resource.h>
+#include <text_raw_resources/embedded_data.h>
+#include <text_resources/embedded_data.h>
+#include "build_step_test.h"
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace fs = std::filesystem;
+using resource_tools::ResourceError;
+using resource_tools::TextResource;
+
+class TextResourceTest : public BuildStepTest {
+protected:
+    // Index a file the way the build does
+    auto convert(const std::string& text, const fs::path& output, bool normalize = false) const -> int {
+        return pack(normalize ? "text --normalize-newlines" : "text", text, output, "input.txt");
+    }
+};
+
+// ============================================================================
+// EMBEDDED TEXT
+// ============================================================================
+
+TEST_F(TextResourceTest, LinesOfNormalizedText) {
+    const TextResource& poem = text_resources::getPoemTXTText();
+    ASSERT_TRUE(poem);
+    EXPECT_TRUE(poem.normalized());
+    ASSERT_EQ(poem.line_count(), 8u);
+    EXPECT_EQ(poem.line(0), "Ozymandias");
+    EXPECT_EQ(poem.line(1), "");
+    EXPECT_EQ(poem.line(3), "Who said—“Two vast and trunkless legs of stone");
+    EXPECT_EQ(poem.line(7), "— Percy Bysshe Shelley, 1818 \U0001F5FF");
+    EXPECT_EQ(poem.text().find('\r'), std::string_view::npos);
+}
+
+TEST_F(TextResourceTest, LoneCarriageReturnEndsLineWhenNormalized) {
+    const TextResource& notes = text_resources::getNotesMDText();
+    ASSERT_TRUE(notes);
+    const std::vector<std::string_view> lines(notes.begin(), notes.end());
+    EXPECT_EQ(lines, (std::vector<std::string_view>{"# Notes", "", "- café", "- naïve", "résumé", "",
+                                                    "no newline at the end"}));
+    EXPECT_EQ(notes.text().back(), 'd');
+}
+
+TEST_F(TextResourceTest, TextAsWrittenStillStripsCarriageReturns) {
+    // Stored SPARSE, so the index is read from the decoded container
+    const TextResource& raw = text_raw_resources::getPoemTXTText();
+    const TextResource& normalized = text_resources::getPoemTXTText();
+    ASSERT_TRUE(raw);
+    EXPECT_FALSE(raw.normalized());
+    EXPECT_EQ(raw.text().size(), normalized.text().size() + raw.line_count());
+
+    const std::string original = readText(fs::path(RESOURCE_TOOLS_TEST_DATA_DIR) / "text" / "poem.txt");
+    EXPECT_EQ(raw.text(), original);
+
+    ASSERT_EQ(raw.line_count(), normalized.line_count());
+    for (size_t i = 0; i < raw.line_count(); ++i) {
+        EXPECT_EQ(raw.line(i), normalized.line(i)) << "line " << i;
+    }
+}
+
+TEST_F(TextResourceTest, LineIteratorIsForward) {
+    static_assert(std::forward_iterator<TextResource::LineIterator>);
+    const TextResource& poem = text_resources::getPoemTXTText();
+    auto it = poem.begin();
+    ++it;
+    ++it;
+    EXPECT_EQ(it.index(), 2u);
+    EXPECT_EQ(*it, "I met a traveller from an antique land,");
+    EXPECT_EQ(std::distance(poem.begin(), poem.end()), 8);
+}
+
+TEST_F(TextResourceTest, OutOfRangeLineIsEmpty) {
+    const TextResource& poem = text_resources::getPoemTXTText();
+    EXPECT_EQ(poem.line(poem.line_count()), "");
+    EXPECT_EQ(poem.line(SIZE_MAX), "");
+}
+
+// ============================================================================
+// BUILD STEP
+// ============================================================================
+
+TEST_F(TextResourceTest, InvalidUtf8FailsTheBuild) {
+    const char* invalid[] = {
+        "ok\n\xff\n",          // Never valid
+        "\xc0\xaf",            // Overlong "/"
+        "\xed\xa0\x80",        // Surrogate
+        "\xf4\x90\x80\x80",    // Above U+10FFFF
+        "caf\xc3",             // Truncated
+    };
+    for (const char* text : invalid) {
+        const fs::path output = work_ / "out.bin";
+        EXPECT_NE(convert(text, output), 0) << text;
+        EXPECT_FALSE(fs::exists(output));
+    }
+}
+
+TEST_F(TextResourceTest, EmptyText) {
+    const fs::path output = work_ / "empty.bin";
+    ASSERT_EQ(convert("", output), 0);
+    const auto bytes = readFile(output);
+    TextResource text(view(bytes));
+    ASSERT_TRUE(text);
+    EXPECT_EQ(text.line_count(), 0u);
+    EXPECT_EQ(text.begin(), text.end());
+}
+
+TEST_F(TextResourceTest, CorruptContainerIsRejected) {
+    const fs::path output = work_ / "lines.bin";
+    ASSERT_EQ(convert("one\ntwo\n", output), 0);
+    auto bytes = readFile(output);
+    ASSERT_TRUE(TextResource(view(bytes)));
+
+    auto bad_magic = bytes;
+    bad_magic[0] ^= 0xFF;
+    EXPECT_EQ(TextResource(view(bad_magic)).error(), ResourceError::CorruptData);
+
+    // A line count that does not fit in the index
+    auto bad_count = bytes;
+    bad_count[16] = 200;
+    EXPECT_EQ(TextResource(view(bad_count)).error(), ResourceError::CorruptData);
+
+    bytes.resize(bytes.size() - 1);
+    EXPECT_EQ(TextResource(view(bytes)).error(), ResourceError::CorruptData);
+
+    EXPECT_EQ(TextResource({nullptr, 0, ResourceError::NotFound}).error(), ResourceError::NotFound);
+}
+
+TEST_F(TextResourceTest, IndexedLinesMatchGetline) {
+    std::string text;
+    std::mt19937 rng(45);
+    for (int i = 0; i < 500; ++i) {
+        text += std::string(rng() % 40, 'a' + static_cast<char>(i % 26));
+        text += (i % 7 == 0) ? "\r\n" : "\n";
+    }
+    const fs::path output = work_ / "lines.bin";
+    ASSERT_EQ(convert(text, output, true), 0);
+    const auto bytes = readFile(output);
+    TextResource indexed(view(bytes));
+    ASSERT_TRUE(indexed);
+
+    std::istringstream in(text);
+    std::string expected;
+    size_t i = 0;
+    while (std::getline(in, expected)) {
+        if (!expected.empty() && expected.back() == '\r') {
+            expected.pop_back();
+        }
+        EXPECT_EQ(indexed.line(i++), expected);
+    }
+    EXPECT_EQ(indexed.line_count(), i);
+}
+
+// ============================================================================
+// RANDOM ACCESS
+// ============================================================================
+
+TEST_F(TextResourceTest, IndexedLinesMatchScanning) {
+    constexpr size_t kLines = 1000;
+    std::string text;
+    for (size_t i = 0; i < kLines; ++i) {
+        text += "line " + std::to_string(i) + "\n";
+    }
+    const fs::path output = work_ / "lines.bin";
+    ASSERT_EQ(convert(text, output), 0);
+    const auto bytes = readFile(output);
+
+    TextResource indexed(view(bytes));
+    std::mt19937 rng(7);
+    for (size_t i = 0; i < 100; ++i) {
+        const size_t lookup = rng() % kLines;
+        size_t pos = 0;
+        for (size_t line = 0; line < lookup; ++line) {
+            pos = text.find('\n', pos) + 1;
+        }
+        ASSERT_EQ(indexed.line(lookup), std::string_view(text).substr(pos, text.find('\n', pos) - pos));
+    }
+}
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <resource_tools/access_profile.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+#include <resource_tools/preload.h>
+#include <resource_tools/residency.h>
+#include <profiled_raw_resources/embedded_data.h>
+#include <tiered_resources/embedded_data.h>
+#include "test_data.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+using test_data::asString;
+using test_data::readDataFile;
+
+class TieredResourceTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    static auto makeLzContainer(uint64_t size, const std::vector<uint8_t>& payload) -> std::vector<uint8_t> {
+        std::vector<uint8_t> out(resource_tools::packed::kHeaderSize);
+        resource_tools::packed::Header header;
+        header.encoding = resource_tools::packed::Encoding::Lz;
+        header.size = size;
+        header.payload_size = payload.size();
+        resource_tools::packed::writeHeader(out.data(), header);
+        out.insert(out.end(), payload.begin(), payload.end());
+        return out;
+    }
+
+    static auto decode(const std::vector<uint8_t>& container, std::vector<uint8_t>& out) -> resource_tools::ResourceError {
+        return resource_tools::decodePacked({container.data(), container.size(), resource_tools::ResourceError::Success},
+                                            out.data(), out.size());
+    }
+};
+
+// ============================================================================
+// STORAGE TIERS
+// ============================================================================
+
+TEST_F(TieredResourceTest, HotResourceIsStoredRaw) {
+    auto packed = tiered_resources::getTierHotJSONPacked();
+    auto result = tiered_resources::getTierHotJSON();
+
+    ASSERT_TRUE(packed);
+    ASSERT_TRUE(result);
+    resource_tools::packed::Header header;
+    ASSERT_EQ(resource_tools::packed::readHeader(packed, header), resource_tools::ResourceError::Success);
+    EXPECT_EQ(header.encoding, resource_tools::packed::Encoding::Stored);
+    // Hot resources are served straight from the binary
+    EXPECT_EQ(result.data, packed.data + resource_tools::packed::kHeaderSize);
+}
+
+TEST_F(TieredResourceTest, ColdResourceIsCompressed) {
+    auto packed = tiered_resources::getTierColdJSONPacked();
+
+    ASSERT_TRUE(packed);
+    resource_tools::packed::Header header;
+    ASSERT_EQ(resource_tools::packed::readHeader(packed, header), resource_tools::ResourceError::Success);
+    EXPECT_EQ(header.encoding, resource_tools::packed::Encoding::Lz);
+    EXPECT_LT(packed.size, header.size / 2);
+}
+
+TEST_F(TieredResourceTest, BothTiersRoundTrip) {
+    EXPECT_EQ(asString(tiered_resources::getTierHotJSON()), readDataFile("tier_hot.json"));
+    EXPECT_EQ(asString(tiered_resources::getTierColdJSON()), readDataFile("tier_cold.json"));
+}
+
+// ============================================================================
+// ACCESS PROFILING
+// ============================================================================
+
+TEST_F(TieredResourceTest, AccessesAreCounted) {
+    const auto before = resource_tools::profile::accessCount("tiered_resources", "tier_hot.json");
+
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(tiered_resources::getTierHotJSON());
+    }
+
+    EXPECT_EQ(resource_tools::profile::accessCount("tiered_resources", "tier_hot.json"), before + 3);
+}
+
+TEST_F(TieredResourceTest, RawContainerAccessIsNotCounted) {
+    ASSERT_TRUE(tiered_resources::getTierColdJSON());
+    const auto before = resource_tools::profile::accessCount("tiered_resources", "tier_cold.json");
+
+    ASSERT_TRUE(tiered_resources::getTierColdJSONPacked());
+
+    EXPECT_EQ(resource_tools::profile::accessCount("tiered_resources", "tier_cold.json"), before);
+}
+
+TEST_F(TieredResourceTest, RawResourceAccessesAreCounted) {
+    const auto before = resource_tools::profile::accessCount("profiled_raw_resources", "profiled_raw.json");
+
+    ASSERT_TRUE(profiled_raw_resources::getProfiledRawJSON());
+    ASSERT_TRUE(profiled_raw_resources::getProfiledRawJSON());
+
+    EXPECT_EQ(resource_tools::profile::accessCount("profiled_raw_resources", "profiled_raw.json"), before + 2);
+}
+
+TEST_F(TieredResourceTest, LocalAccessesAreCountedOnce) {
+    const auto before = resource_tools::profile::accessCount("profiled_raw_resources", "profiled_raw.json");
+
+    // The first call also builds the replica from the resource, uncounted
+    ASSERT_TRUE(profiled_raw_resources::getProfiledRawJSONLocal());
+    ASSERT_TRUE(profiled_raw_resources::getProfiledRawJSONLocal());
+
+    EXPECT_EQ(resource_tools::profile::accessCount("profiled_raw_resources", "profiled_raw.json"), before + 2);
+}
+
+TEST_F(TieredResourceTest, PreloadAndResidencyAreNotCounted) {
+    ASSERT_TRUE(tiered_resources::getTierHotJSON());
+    ASSERT_TRUE(profiled_raw_resources::getProfiledRawJSON());
+    const auto hot = resource_tools::profile::accessCount("tiered_resources", "tier_hot.json");
+    const auto cold = resource_tools::profile::accessCount("tiered_resources", "tier_cold.json");
+    const auto raw = resource_tools::profile::accessCount("profiled_raw_resources", "profiled_raw.json");
+
+    auto tiered = resource_tools::preload(tiered_resources::allResources());
+    auto profiled = resource_tools::preload(profiled_raw_resources::allResources());
+    tiered.wait();
+    profiled.wait();
+    EXPECT_EQ(tiered.failed(), 0u);
+    EXPECT_EQ(profiled.failed(), 0u);
+    static_cast<void>(resource_tools::residencyReport());
+
+    EXPECT_EQ(resource_tools::profile::accessCount("tiered_resources", "tier_hot.json"), hot);
+    EXPECT_EQ(resource_tools::profile::accessCount("tiered_resources", "tier_cold.json"), cold);
+    EXPECT_EQ(resource_tools::profile::accessCount("profiled_raw_resources", "profiled_raw.json"), raw);
+}
+
+TEST_F(TieredResourceTest, WritesProfileReadableByEmbedResources) {
+    resource_tools::profile::resetAccessCounts();
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(tiered_resources::getTierHotJSON());
+    }
+    ASSERT_TRUE(tiered_resources::getTierColdJSON());
+
+    const std::string path = ::testing::TempDir() + "tiered_test.profile";
+    ASSERT_TRUE(resource_tools::profile::writeAccessProfile(path.c_str()));
+
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        // Other profiled namespaces in this binary are written too
+        if (!line.empty() && line[0] != '#' && line.find(" tiered_resources ") != std::string::npos) {
+            lines.push_back(line);
+        }
+    }
+    ASSERT_EQ(lines.size(), 2u);
+    // Most accessed first
+    EXPECT_EQ(lines[0], "5 tiered_resources tier_hot.json");
+    EXPECT_EQ(lines[1], "1 tiered_resources tier_cold.json");
+}
+
+TEST_F(TieredResourceTest, ResourcesNeverAccessedAreListed) {
+    // Nothing in this program calls getProfiledUnusedJSON()
+    const std::string path = ::testing::TempDir() + "unused_test.profile";
+    ASSERT_TRUE(resource_tools::profile::writeAccessProfile(path.c_str()));
+
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        if (line.find(" profiled_unused.json") != std::string::npos) {
+            lines.push_back(line);
+        }
+    }
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0], "0 profiled_raw_resources profiled_unused.json");
+}
+
+// ============================================================================
+// LZ DECODER VALIDATION
+// ============================================================================
+
+TEST_F(TieredResourceTest, OverlappingMatchRepeatsPattern) {
+    // "ab" literals, then a 10 byte match one pattern back
+    auto container = makeLzContainer(12, {0x26, 'a', 'b', 0x02, 0x00});
+    std::vector<uint8_t> out(12);
+
+    ASSERT_EQ(decode(container, out), resource_tools::ResourceError::Success);
+    EXPECT_EQ(std::string(out.begin(), out.end()), "abababababab");
+}
+
+TEST_F(TieredResourceTest, LongLengthsUseExtensionBytes) {
+    std::vector<uint8_t> payload = {0xF0, 5};  // 15 + 5 literals
+    for (int i = 0; i < 20; ++i) {
+        payload.push_back(static_cast<uint8_t>('a' + i));
+    }
+    auto container = makeLzContainer(20, payload);
+    std::vector<uint8_t> out(20);
+
+    ASSERT_EQ(decode(container, out), resource_tools::ResourceError::Success);
+    EXPECT_EQ(std::string(out.begin(), out.end()), "abcdefghijklmnopqrst");
+}
+
+TEST_F(TieredResourceTest, RejectsMatchBeforeStartOfOutput) {
+    auto container = makeLzContainer(8, {0x10, 'a', 0x05, 0x00});
+    std::vector<uint8_t> out(8);
+
+    EXPECT_EQ(decode(container, out), resource_tools::ResourceError::CorruptData);
+}
+
+TEST_F(TieredResourceTest, RejectsTruncatedStream) {
+    auto container = makeLzContainer(12, {0x26, 'a', 'b', 0x02});
+    std::vector<uint8_t> out(12);
+
+    EXPECT_EQ(decode(container, out), resource_tools::ResourceError::CorruptData);
+}
+
+TEST_F(TieredResourceTest, RejectsTrailingBytes) {
+    auto container = makeLzContainer(2, {0x20, 'a', 'b', 0x00});
+    std::vector<uint8_t> out(2);
+
+    EXPECT_EQ(decode(container, out), resource_tools::ResourceError::CorruptData);
+}
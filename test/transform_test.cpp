@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <transform_resources/embedded_data.h>
+#include "build_step_test.h"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace fs = std::filesystem;
+
+class TransformTest : public BuildStepTest {
+protected:
+    static auto countLines(const fs::path& path) -> size_t {
+        const std::string contents = readText(path);
+        return static_cast<size_t>(std::count(contents.begin(), contents.end(), '\n'));
+    }
+
+    // Run one transform step the way the build does
+    auto runStep(const fs::path& input, const fs::path& output, const std::string& command) const -> int {
+        const std::string line = std::string("\"") + RESOURCE_TOOLS_CMAKE_COMMAND + "\" -DINPUT=\"" + input.string() +
+                                 "\" -DOUTPUT=\"" + output.string() + "\" -DCACHE_DIR=\"" +
+                                 (work_ / "cache").string() + "\" -P \"" + RESOURCE_TOOLS_TRANSFORM_SCRIPT +
+                                 "\" -- " + command;
+        return std::system(line.c_str());
+    }
+
+    // The test minifier, logging each real run to `log`
+    auto minifyCommand(const fs::path& script, const fs::path& log) const -> std::string {
+        return std::string("\"") + RESOURCE_TOOLS_CMAKE_COMMAND + "\" -DINPUT=@INPUT@ -DOUTPUT=@OUTPUT@ -DLOG=\"" +
+               log.string() + "\" -P \"" + script.string() + "\"";
+    }
+
+    auto cacheEntries() const -> size_t {
+        return fs::exists(work_ / "cache")
+                   ? static_cast<size_t>(std::distance(fs::directory_iterator(work_ / "cache"), fs::directory_iterator()))
+                   : 0;
+    }
+};
+
+// ============================================================================
+// EMBEDDED RESULTS
+// ============================================================================
+
+TEST_F(TransformTest, JsonIsMinified) {
+    EXPECT_EQ(text(transform_resources::getSettingsJSON()),
+              R"({"theme":"dark","font_size":14,"panels":["explorer","search","terminal"],"telemetry":false})");
+}
+
+TEST_F(TransformTest, MatchingStepsRunInOrder) {
+    // Comments are stripped first, then everything is upper-cased
+    EXPECT_EQ(text(transform_resources::getSchemaSQL()),
+              "CREATE TABLE USERS (\n"
+              "    ID INTEGER PRIMARY KEY,\n"
+              "    NAME TEXT NOT NULL\n"
+              ");\n"
+              "CREATE TABLE SESSIONS (\n"
+              "    USER_ID INTEGER REFERENCES USERS(ID),\n"
+              "    EXPIRES INTEGER\n"
+              ");\n");
+}
+
+TEST_F(TransformTest, FilterCommandReadsStdinAndWritesStdout) {
+    EXPECT_EQ(text(transform_resources::getNotesTXT()), "EMBEDDED IN UPPER CASE\n");
+}
+
+TEST_F(TransformTest, UnmatchedResourceIsEmbeddedAsWritten) {
+    EXPECT_EQ(text(transform_resources::getReadmeMD()),
+              readText(fs::path(RESOURCE_TOOLS_TEST_DATA_DIR) / "transform" / "readme.md"));
+}
+
+// ============================================================================
+// TRANSFORM CACHE
+// ============================================================================
+
+TEST_F(TransformTest, CachedOutputIsReused) {
+    const fs::path input = work_ / "in.json";
+    const fs::path log = work_ / "runs.log";
+    const fs::path script = fs::path(RESOURCE_TOOLS_TEST_TRANSFORMS_DIR) / "minify_json.cmake";
+    writeFile(input, "{ \"a\": [ 1, 2 ] }\n");
+
+    ASSERT_EQ(runStep(input, work_ / "first.json", minifyCommand(script, log)), 0);
+    // A clean build in another tree sees the same input and transform
+    ASSERT_EQ(runStep(input, work_ / "second.json", minifyCommand(script, log)), 0);
+
+    EXPECT_EQ(countLines(log), 1u);
+    EXPECT_EQ(readText(work_ / "first.json"), "{\"a\":[1,2]}");
+    EXPECT_EQ(readText(work_ / "second.json"), "{\"a\":[1,2]}");
+    EXPECT_EQ(cacheEntries(), 1u);
+}
+
+TEST_F(TransformTest, CacheIgnoresWhereTheTransformLives) {
+    const fs::path input = work_ / "in.json";
+    const fs::path log = work_ / "runs.log";
+    // The same script in two checkouts
+    fs::create_directories(work_ / "a");
+    fs::create_directories(work_ / "b");
+    fs::copy_file(fs::path(RESOURCE_TOOLS_TEST_TRANSFORMS_DIR) / "minify_json.cmake", work_ / "a" / "minify.cmake");
+    fs::copy_file(fs::path(RESOURCE_TOOLS_TEST_TRANSFORMS_DIR) / "minify_json.cmake", work_ / "b" / "minify.cmake");
+    writeFile(input, "{ \"a\": 1 }");
+
+    ASSERT_EQ(runStep(input, work_ / "first.json", minifyCommand(work_ / "a" / "minify.cmake", log)), 0);
+    ASSERT_EQ(runStep(input, work_ / "second.json", minifyCommand(work_ / "b" / "minify.cmake", log)), 0);
+
+    EXPECT_EQ(countLines(log), 1u);
+    EXPECT_EQ(readText(work_ / "second.json"), "{\"a\":1}");
+    EXPECT_EQ(cacheEntries(), 1u);
+}
+
+TEST_F(TransformTest, ChangedInputRunsAgain) {
+    const fs::path input = work_ / "in.json";
+    const fs::path log = work_ / "runs.log";
+    const fs::path script = fs::path(RESOURCE_TOOLS_TEST_TRANSFORMS_DIR) / "minify_json.cmake";
+    writeFile(input, "{ \"a\": 1 }");
+    ASSERT_EQ(runStep(input, work_ / "out.json", minifyCommand(script, log)), 0);
+
+    writeFile(input, "{ \"a\": 2 }");
+    ASSERT_EQ(runStep(input, work_ / "out.json", minifyCommand(script, log)), 0);
+
+    EXPECT_EQ(countLines(log), 2u);
+    EXPECT_EQ(readText(work_ / "out.json"), "{\"a\":2}");
+}
+
+TEST_F(TransformTest, EditedTransformScriptRunsAgain) {
+    const fs::path input = work_ / "in.json";
+    const fs::path log = work_ / "runs.log";
+    const fs::path script = work_ / "minify.cmake";
+    fs::copy_file(fs::path(RESOURCE_TOOLS_TEST_TRANSFORMS_DIR) / "minify_json.cmake", script);
+    writeFile(input, "{ \"a\": 1 }");
+    ASSERT_EQ(runStep(input, work_ / "out.json", minifyCommand(script, log)), 0);
+
+    std::ofstream(script, std::ios::app) << "# edited\n";
+    ASSERT_EQ(runStep(input, work_ / "out.json", minifyCommand(script, log)), 0);
+
+    EXPECT_EQ(countLines(log), 2u);
+    EXPECT_EQ(cacheEntries(), 2u);
+}
+
+TEST_F(TransformTest, FailedTransformLeavesNoOutput) {
+    const fs::path input = work_ / "in.json";
+    writeFile(input, "{}");
+
+    EXPECT_NE(runStep(input, work_ / "out.json", std::string("\"") + RESOURCE_TOOLS_CMAKE_COMMAND + "\" -E false"), 0);
+
+    EXPECT_FALSE(fs::exists(work_ / "out.json"));
+    EXPECT_FALSE(fs::exists(work_ / "out.json.partial"));
+    EXPECT_EQ(cacheEntries(), 0u);
+}
+
+TEST_F(TransformTest, EmptyOutputFails) {
+    const fs::path input = work_ / "in.json";
+    writeFile(input, "{}");
+
+    EXPECT_NE(runStep(input, work_ / "out.json", std::string("\"") + RESOURCE_TOOLS_CMAKE_COMMAND + "\" -E touch @OUTPUT@"),
+              0);
+
+    EXPECT_FALSE(fs::exists(work_ / "out.json"));
+    EXPECT_FALSE(fs::exists(work_ / "out.json.partial"));
+    EXPECT_EQ(cacheEntries(), 0u);
+}
@@ -0,0 +1,16 @@
+# minify_json.cmake
+# Test transform: drops the whitespace around JSON punctuation. Good enough
+# for the test data, whose strings hold no punctuation.
+#
+# Usage:
+#   cmake -DINPUT=<file> -DOUTPUT=<file> [-DLOG=<file>] -P minify_json.cmake
+#
+# LOG, if given, gets a line per run, so tests can tell whether it ran.
+
+file(READ "${INPUT}" Json)
+string(REGEX REPLACE "[ \t\r\n]*([][{},:])[ \t\r\n]*" "\\1" Json "${Json}")
+file(WRITE "${OUTPUT}" "${Json}")
+
+if(LOG)
+    file(APPEND "${LOG}" "${INPUT}\n")
+endif()
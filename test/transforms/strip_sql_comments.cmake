@@ -0,0 +1,12 @@
+# strip_sql_comments.cmake
+# Test transform: removes "--" comments and the blank lines they leave.
+#
+# Usage:
+#   cmake -DINPUT=<file> -DOUTPUT=<file> -P strip_sql_comments.cmake
+
+file(READ "${INPUT}" Sql)
+string(REGEX REPLACE "--[^\n]*" "" Sql "${Sql}")
+string(REGEX REPLACE "[ \t]+\n" "\n" Sql "${Sql}")
+string(REGEX REPLACE "\n\n+" "\n" Sql "${Sql}")
+string(REGEX REPLACE "^\n+" "" Sql "${Sql}")
+file(WRITE "${OUTPUT}" "${Sql}")
@@ -0,0 +1,10 @@
+// Test transform: copies stdin to stdout in upper case (ASCII only)
+#include <cctype>
+#include <cstdio>
+
+auto main() -> int {
+    for (int c = std::getchar(); c != EOF; c = std::getchar()) {
+        std::putchar(std::toupper(c));
+    }
+    return 0;
+}
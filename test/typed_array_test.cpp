@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/typed_array.h>
+#include <array_be_resources/embedded_data.h>
+#include <array_resources/embedded_data.h>
+#include "build_step_test.h"
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace fs = std::filesystem;
+using resource_tools::ResourceError;
+
+class TypedArrayTest : public BuildStepTest {
+protected:
+    // Convert a file the way the build does
+    auto convert(const std::string& contents, const std::string& args) const -> int {
+        return pack("array " + args, contents, work_ / "output.bin");
+    }
+};
+
+// ============================================================================
+// GENERATED ACCESSORS
+// ============================================================================
+
+TEST_F(TypedArrayTest, FloatArrayIsUsedInPlace) {
+    auto weights = array_resources::getWeightsF32Array();
+    static_assert(std::is_same_v<decltype(weights), std::span<const float>>);
+
+    ASSERT_EQ(weights.size(), 256u);
+    EXPECT_FLOAT_EQ(weights[0], -3.0f);
+    EXPECT_FLOAT_EQ(weights[10], 2.0f);
+    EXPECT_FLOAT_EQ(weights[255], 124.5f);
+
+    // No copy: the span is the embedded resource, on a 64-byte boundary
+    auto raw = array_resources::getWeightsF32();
+    EXPECT_EQ(reinterpret_cast<const uint8_t*>(weights.data()), raw.data);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(weights.data()) % 64, 0u);
+}
+
+TEST_F(TypedArrayTest, BigEndianFileIsSwappedAtBuildTime) {
+    auto samples = array_be_resources::getSamplesI32Array();
+    static_assert(std::is_same_v<decltype(samples), std::span<const int32_t>>);
+
+    ASSERT_EQ(samples.size(), 64u + 1024u + 2u);
+    EXPECT_EQ(samples[1], -1000003);
+    EXPECT_EQ(samples[2], 2000006);
+    EXPECT_EQ(samples[500], 0);
+    EXPECT_EQ(samples[1088], 123456789);
+    EXPECT_EQ(samples[1089], -987654321);
+
+    // Stored SPARSE, so this is a decoded copy, aligned like the embedded one
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(samples.data()) % 64, 0u);
+}
+
+TEST_F(TypedArrayTest, AccessorReturnsTheSameSpanEveryTime) {
+    EXPECT_EQ(array_be_resources::getSamplesI32Array().data(), array_be_resources::getSamplesI32Array().data());
+}
+
+// ============================================================================
+// TYPED ARRAY VIEW
+// ============================================================================
+
+TEST_F(TypedArrayTest, MisalignedResourceIsCopied) {
+    std::vector<uint8_t> buffer(1 + 4 * sizeof(double));
+    const double values[] = {1.5, -2.25, 1e300, 0.0};
+    std::memcpy(buffer.data() + 1, values, sizeof(values));
+
+    resource_tools::TypedArray<double> array({buffer.data() + 1, sizeof(values), ResourceError::Success});
+
+    ASSERT_TRUE(array);
+    EXPECT_TRUE(array.copied());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(array.span().data()) % alignof(double), 0u);
+    EXPECT_EQ(array.span()[2], 1e300);
+}
+
+TEST_F(TypedArrayTest, PartialElementIsRejected) {
+    const uint8_t bytes[8] = {};
+    resource_tools::TypedArray<int32_t> array({bytes, 7, ResourceError::Success});
+
+    EXPECT_EQ(array.error(), ResourceError::InvalidSize);
+    EXPECT_TRUE(array.span().empty());
+}
+
+TEST_F(TypedArrayTest, FailedResourceKeepsItsError) {
+    resource_tools::TypedArray<float> array({nullptr, 0, ResourceError::NotFound});
+
+    EXPECT_FALSE(array);
+    EXPECT_EQ(array.error(), ResourceError::NotFound);
+    EXPECT_EQ(array.size(), 0u);
+}
+
+// ============================================================================
+// BUILD-TIME VALIDATION
+// ============================================================================
+
+TEST_F(TypedArrayTest, PartialElementFailsTheBuild) {
+    EXPECT_EQ(convert(std::string(8, '\x01'), "--element-type float64"), 0);
+    EXPECT_NE(convert(std::string(6, '\x01'), "--element-type float32"), 0);
+    EXPECT_NE(convert(std::string(4, '\x01'), "--element-type string"), 0);
+    EXPECT_NE(convert(std::string(4, '\x01'), "--element-type int32 --source-endian middle"), 0);
+}
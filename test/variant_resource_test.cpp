@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <resource_tools/embedded_resource.h>
+#include <resource_tools/packed_resource.h>
+#include <variant_resources/embedded_data.h>
+#include "test_data.h"
+#include <string>
+#include <vector>
+
+using test_data::asString;
+using test_data::readDataFile;
+
+class VariantResourceTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+// ============================================================================
+// RECONSTRUCTION
+// ============================================================================
+
+TEST_F(VariantResourceTest, BaseIsAccessible) {
+    auto base = variant_resources::getConfigBaseJSON();
+
+    ASSERT_TRUE(base);
+    EXPECT_EQ(asString(base), readDataFile("config_base.json"));
+}
+
+TEST_F(VariantResourceTest, VariantsRoundTrip) {
+    auto acme = variant_resources::getConfigAcmeJSON();
+    auto globex = variant_resources::getConfigGlobexJSON();
+
+    ASSERT_TRUE(acme);
+    ASSERT_TRUE(globex);
+    EXPECT_EQ(asString(acme), readDataFile("config_acme.json"));
+    EXPECT_EQ(asString(globex), readDataFile("config_globex.json"));
+}
+
+TEST_F(VariantResourceTest, VariantIsReconstructedOnce) {
+    auto first = variant_resources::getConfigAcmeJSON();
+    auto second = variant_resources::getConfigAcmeJSON();
+
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first.data, second.data);
+}
+
+// ============================================================================
+// STORAGE SAVINGS
+// ============================================================================
+
+TEST_F(VariantResourceTest, DeltasAreSmall) {
+    for (auto packed : {variant_resources::getConfigAcmeJSONPacked(), variant_resources::getConfigGlobexJSONPacked()}) {
+        ASSERT_TRUE(packed);
+
+        resource_tools::packed::Header header;
+        ASSERT_EQ(resource_tools::packed::readHeader(packed, header), resource_tools::ResourceError::Success);
+        EXPECT_EQ(header.encoding, resource_tools::packed::Encoding::Delta);
+        // A few edited lines should cost a few hundred bytes, not a full copy
+        EXPECT_LT(packed.size, 1024u);
+    }
+}
+
+TEST_F(VariantResourceTest, UnrelatedVariantIsStoredWhole) {
+    auto packed = variant_resources::getBinaryDataBINPacked();
+    ASSERT_TRUE(packed);
+
+    resource_tools::packed::Header header;
+    ASSERT_EQ(resource_tools::packed::readHeader(packed, header), resource_tools::ResourceError::Success);
+    EXPECT_EQ(header.encoding, resource_tools::packed::Encoding::Stored);
+    EXPECT_EQ(header.payload_size, header.size);
+
+    auto unrelated = variant_resources::getBinaryDataBIN();
+    ASSERT_TRUE(unrelated);
+    EXPECT_EQ(asString(unrelated), readDataFile("binary_data.bin"));
+}
+
+// ============================================================================
+// DECODER VALIDATION
+// ============================================================================
+
+TEST_F(VariantResourceTest, DecodeWithoutBaseFails) {
+    resource_tools::PackedResource resource(variant_resources::getConfigAcmeJSONPacked());
+
+    EXPECT_EQ(resource.get().error, resource_tools::ResourceError::CorruptData);
+}
+
+TEST_F(VariantResourceTest, DecodeAgainstWrongBaseFails) {
+    // The globex delta copies from offsets that only exist in the real base
+    std::vector<uint8_t> tiny_base(resource_tools::packed::kHeaderSize + 4, 'x');
+    resource_tools::packed::Header header;
+    header.size = 4;
+    header.payload_size = 4;
+    resource_tools::packed::writeHeader(tiny_base.data(), header);
+
+    resource_tools::PackedResource resource(variant_resources::getConfigGlobexJSONPacked(),
+                                            {tiny_base.data(), tiny_base.size(), resource_tools::ResourceError::Success});
+    EXPECT_EQ(resource.get().error, resource_tools::ResourceError::CorruptData);
+}